@@ -9,9 +9,29 @@
 #include "Diegetic/Components/Dieg_3DInventoryComponent.h"
 #include "Diegetic/Components/Dieg_InventoryInputHandler.h"
 #include "Diegetic/Interfaces/Dieg_Interactor.h"
+#include "Diegetic/Subsystems/Dieg_AssetStreamingSubsystem.h"
 #include "Diegetic/UObjects/Dieg_ItemInstance.h"
 #include "Diegetic/Widgets/Dieg_Slot.h"
+#include "Inventory.h"
 
+DECLARE_CYCLE_STAT(TEXT("Solve Item Actor Transforms"), STAT_Dieg_SolveItemTransforms, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Actor Transform Requests"), STAT_Dieg_ItemTransformRequests, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Actor Component Transform Updates"), STAT_Dieg_ItemComponentTransformUpdates, STATGROUP_DiegInventory);
+
+namespace
+{
+	/** Sets a relative transform only if it changed, one propagation instead of one per part. */
+	void SetRelativeTransformIfChanged(USceneComponent* Component, const FTransform& Transform)
+	{
+		if (Component->GetRelativeTransform().Equals(Transform))
+		{
+			return;
+		}
+
+		INC_DWORD_STAT(STAT_Dieg_ItemComponentTransformUpdates);
+		Component->SetRelativeTransform(Transform);
+	}
+}
 
 // Sets default values
 ADieg_WorldItemActor::ADieg_WorldItemActor()
@@ -62,6 +82,21 @@ void ADieg_WorldItemActor::BeginPlay()
 	Super::BeginPlay();
 }
 
+void ADieg_WorldItemActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+	PendingTransformRequest.Reset();
+
+	if (UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get())
+	{
+		Streamer->ReleaseHolderAssets(this);
+	}
+	StreamedItemDataAsset = TObjectKey<UDieg_ItemDefinitionDataAsset>();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 
 UDieg_ItemInstance* ADieg_WorldItemActor::GetItemInstance() const
 {
@@ -100,37 +135,62 @@ void ADieg_WorldItemActor::SetFromInventorySlot_Implementation(const FDieg_Inven
 	SetFromItemInstance(InventorySlot.ItemInstance);
 	const FDieg_ItemDefinition& ItemDefinition = ItemInstance->GetItemDefinitionDataAsset()->ItemDefinition;
 	CurrentRotation = InventorySlot.Rotation;
-	HandleDragHoverEnterInventory(nullptr, nullptr, nullptr, {0,0});
-	AdjustMeshRelativeRotation();
 	ModifyTextQuantity();
-	AdjustActorLocation();
+
+	// Resting in the inventory, no grab offset. Solved now, callers read the transforms right after.
+	FDieg_ItemTransformRequest Request;
+	Request.RootMode = EDieg_ItemRootMode::Grid;
+	Request.bPlaceAtCoordinates = true;
+	Request.bUpdateText = true;
+	RequestTransformUpdate(Request);
+	FlushTransformUpdate();
 }
 
 bool ADieg_WorldItemActor::SetMesh(const UDieg_ItemDefinitionDataAsset* InItemDataAsset) const
 {
 	// Check soft reference validation
-	const TSoftObjectPtr<UStaticMesh> StaticMeshSoftRef = InItemDataAsset->ItemDefinition.WorldMesh;
-	TObjectPtr<UStaticMesh> StaticMeshObject;
-
-	// Returns true if the pointer has an asset path but the asset is not loaded yet.
+	const TSoftObjectPtr<UStaticMesh>& StaticMeshSoftRef = InItemDataAsset->ItemDefinition.WorldMesh;
 	if (StaticMeshSoftRef.IsNull())
 	{
 		return false;
 	}
 
-	// Since it is loading synchronously: IsValid() and not async: IsPending().
-	if (StaticMeshSoftRef.IsValid())
+	// Construction scripts in the editor need the real mesh right away
+	if (!GetWorld() || !GetWorld()->IsGameWorld())
 	{
-		StaticMeshObject = StaticMeshSoftRef.Get();
+		StaticMeshComponent->SetStaticMesh(StaticMeshSoftRef.LoadSynchronous());
+		return true;
 	}
-	else
+
+	UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get();
+	if (!Streamer)
 	{
-		UPlugInv_DoubleLogger::Log("ADieg_WorldItemActor::InitializeFromDataAsset Loading Mesh");
-		StaticMeshObject = StaticMeshSoftRef.LoadSynchronous();
+		StaticMeshComponent->SetStaticMesh(UDieg_AssetStreamingSubsystem::LoadBlocking(StaticMeshSoftRef, TEXT("ADieg_WorldItemActor::SetMesh")));
+		return true;
 	}
 
-	// Set the static mesh to desired from item data
-	StaticMeshComponent->SetStaticMesh(StaticMeshObject);
+	// Swap in the mesh once it streamed in, unless the actor shows another item by then
+	TWeakObjectPtr<const ADieg_WorldItemActor> WeakThis(this);
+	const bool bResident = Streamer->RequestItemAssets(InItemDataAsset, this, FSimpleDelegate::CreateLambda([WeakThis, InItemDataAsset]()
+	{
+		const ADieg_WorldItemActor* This = WeakThis.Get();
+		if (This && IsValid(This->ItemInstance) && This->ItemInstance->GetItemDefinitionDataAsset() == InItemDataAsset)
+		{
+			This->StaticMeshComponent->SetStaticMesh(InItemDataAsset->ItemDefinition.WorldMesh.Get());
+		}
+	}));
+
+	// Resident meshes are shown right away, the placeholder only while the load is in flight
+	UStaticMesh* ResidentMesh = bResident ? StaticMeshSoftRef.Get() : nullptr;
+	StaticMeshComponent->SetStaticMesh(ResidentMesh ? ResidentMesh : PlaceholderMesh.Get());
+
+	// Released after the request, so an actor showing the same item again never drops its last hold
+	const TObjectKey<UDieg_ItemDefinitionDataAsset> RequestedItemDataAsset(InItemDataAsset);
+	if (StreamedItemDataAsset != RequestedItemDataAsset)
+	{
+		Streamer->ReleaseItemAssets(StreamedItemDataAsset.ResolveObjectPtr(), this);
+		StreamedItemDataAsset = RequestedItemDataAsset;
+	}
 	return true;
 }
 
@@ -141,32 +201,6 @@ void ADieg_WorldItemActor::UpdateFromDataAsset_Implementation(UDieg_ItemDefiniti
 	TextRendererComponent->SetText(InItemDataAsset->ItemDefinition.Name);
 }
 
-void ADieg_WorldItemActor::AdjustText() const
-{
-	const FRotator Rotation = FRotator(90.0, -CurrentRotation, 0.0);
-	TextRendererComponent->SetRelativeRotation(Rotation);
-
-	const FDieg_ItemDefinition& ItemDefinition = ItemInstance->GetItemDefinition();
-	FIntPoint ShapeRootOut = ItemDefinition.DefaultShapeRoot;
-	TArray<FIntPoint> RotatedShape = UDieg_UtilityLibrary::Rotate2DArrayWithRoot(ItemDefinition.DefaultShape,
-		CurrentRotation, ItemDefinition.DefaultShapeRoot, ShapeRootOut);
-	const FIntPoint ShapeSpan = UDieg_UtilityLibrary::GetShapeSpan(RotatedShape);
-	int32 MaxX = ShapeSpan.X;
-	int32 MaxY = ShapeSpan.Y;
-
-	const FIntPoint TextCoordinates = ShapeRootOut; //GetTextCoordinates(RotatedShape, EDieg_TextLocation::None);
-	const UDieg_Slot* DefaultSlot = GetDefault<UDieg_Slot>();
-	
-	const float GridSize3D = DefaultSlot->GetGridSize3D();
-	const float GridSize3DHalfNegative = GridSize3D * -0.5f;
-	
-	FIntPoint TextCoordinatesWithOffset = TextCoordinates * GridSize3D;
-	TextCoordinatesWithOffset = TextCoordinatesWithOffset - GridSize3DHalfNegative;
-	
-	FVector Location = FVector(TextCoordinatesWithOffset.X, TextCoordinatesWithOffset.Y, TextRendererComponent->GetRelativeLocation().Z);
-	TextRendererComponent->SetRelativeLocation(Location);
-}
-
 void ADieg_WorldItemActor::ModifyTextQuantity()
 {
 	TextRendererComponent->SetText(FText::AsNumber(ItemInstance->GetQuantity()));
@@ -177,31 +211,28 @@ FIntPoint ADieg_WorldItemActor::GetTextCoordinates(const TArray<FIntPoint>& Shap
 	return FIntPoint::ZeroValue;
 }
 
-void ADieg_WorldItemActor::AdjustActorLocation()
+FVector ADieg_WorldItemActor::GetInventoryRootLocation(const FIntPoint& Coordinates) const
 {
-	const FIntPoint Coordinates = GetCoordinates();
 	const UDieg_Slot* DefaultSlot = GetDefault<UDieg_Slot>();
 	const float InventoryScale3D = DefaultSlot->GetInventoryScale3D();
 	const float UnitScaled = InventoryScale3D * GetUnitScaled();
-	const FVector Location = FVector(0.0f, Coordinates.X * UnitScaled * -1.0, Coordinates.Y * UnitScaled * -1.0);
-	SetActorRelativeLocation(Location);
+	return FVector(0.0f, Coordinates.X * UnitScaled * -1.0, Coordinates.Y * UnitScaled * -1.0);
 }
 
-void ADieg_WorldItemActor::AdjustMeshRelativeRotation() const
+FVector ADieg_WorldItemActor::GetMeshRelativeLocation(const UDieg_ItemDefinitionDataAsset* InItemDataAsset, const float Rotation) const
 {
-	const FRotator Rotation = FRotator(0, CurrentRotation, 0);
-	StaticMeshComponent->SetRelativeRotation(Rotation);
+	return GetMeshRelativeLocation(InItemDataAsset, Rotation, GetUnitScaled());
+}
 
-	const FDieg_ItemDefinition& ItemDefinition = ItemInstance->GetItemDefinition();
-	FIntPoint ShapeRootOut = ItemDefinition.DefaultShapeRoot;
-	TArray<FIntPoint> RotatedShape = UDieg_UtilityLibrary::Rotate2DArrayWithRoot(ItemDefinition.DefaultShape,
-		CurrentRotation, ItemDefinition.DefaultShapeRoot, ShapeRootOut);
-	const FIntPoint ShapeSpan = UDieg_UtilityLibrary::GetShapeSpan(RotatedShape);
+FVector ADieg_WorldItemActor::GetMeshRelativeLocation(const UDieg_ItemDefinitionDataAsset* InItemDataAsset, const float Rotation, const float UnitScaled)
+{
+	const FDieg_RotatedShape& RotatedShape = InItemDataAsset->GetRotatedShape(Rotation);
+	const FIntPoint ShapeRootOut = RotatedShape.Root;
+	const FIntPoint ShapeSpan = RotatedShape.Span;
 
 	// Position the mesh so that the root (0,0 after normalization) aligns with the actor's root
 	// We need to account for both the shape span and the root position
-	const float UnitScaled = GetUnitScaled();
-	const FVector Multiplier = GetLocationMultiplier();
+	const FVector Multiplier = FVector(UDieg_UtilityLibrary::GetOffsetBasedOnRotation(Rotation));
 	
 	// Calculate the mesh position using shape span (as before) but offset by the root position
 	// to ensure the root aligns with the actor's root
@@ -213,189 +244,184 @@ void ADieg_WorldItemActor::AdjustMeshRelativeRotation() const
 	) * Multiplier;
 	
 	// Combine both offsets to position the mesh correctly
-	StaticMeshComponent->SetRelativeLocation(ShapeSpanOffset - RootOffset);
-}
-
-void ADieg_WorldItemActor::AdjustForGrabPoint(const FVector2D& GrabPoint) const
-{
-	FVector2D LocalGrabPoint = GrabPoint + FVector2D{0.5, 0.5};
-	LocalGrabPoint = LocalGrabPoint * GetUnitScaled();
-
-	// Convert 2D coordinates to 3D space. X and Y are not the same in both.
-	FVector LocationGrabPoint = FVector{LocalGrabPoint.Y, -LocalGrabPoint.X, 0.0f};
-	if (IsOwnedByInventory())
-	{
-		LocationGrabPoint.Z = OffsetZ;
-	}
-	
-	StaticMeshComponent->AddRelativeLocation(-LocationGrabPoint);
-}
-
-void ADieg_WorldItemActor::AdjustRootTransformForGrid() const
-{
-	TextRendererComponent->SetHiddenInGame(false,false);
-
-	// In local zero rotation: Pitch is Y, Yaw is Z and Roll is X
-	// So they are aligned with the grid plane or mesh
-	const FRotator Rotation{-90.0f, 0.0, 0.0};
-	Root->SetRelativeRotation(Rotation);
-
-	const UDieg_Slot* DefaultSlot = GetDefault<UDieg_Slot>();
-	const float InventoryScale3D = DefaultSlot->GetInventoryScale3D();
-	Root->SetRelativeScale3D(FVector(InventoryScale3D));
+	return ShapeSpanOffset - RootOffset;
 }
 
-void ADieg_WorldItemActor::AdjustRootTransformForWorld()
+FTransform ADieg_WorldItemActor::GetInventoryMeshTransform(const UDieg_ItemDefinitionDataAsset* InItemDataAsset, const FIntPoint& Coordinates, const float Rotation) const
 {
-	TextRendererComponent->SetHiddenInGame(true,false);
-	SetActorScale3D(FVector::OneVector);
-	StaticMeshComponent->SetRelativeScale3D(FVector::OneVector);
+	// Same result as SetFromInventorySlot leaves on the mesh component, relative to the attach parent.
+	// The shape comes from the given data asset so this can run on the class default object.
+	const FTransform MeshRelative(FRotator(0, Rotation, 0), GetMeshRelativeLocation(InItemDataAsset, Rotation),
+		StaticMeshComponent->GetRelativeScale3D());
+	const FTransform RootRelative(FRotator(-90.0f, 0.0, 0.0), GetInventoryRootLocation(Coordinates),
+		FVector(GetDefault<UDieg_Slot>()->GetInventoryScale3D()));
+	return MeshRelative * RootRelative;
 }
 
-void ADieg_WorldItemActor::BindEventsToHandler_Implementation(UDieg_InventoryInputHandler* Handler)
+void ADieg_WorldItemActor::RequestTransformUpdate(const FDieg_ItemTransformRequest& Request)
 {
-	if (!IsValid(Handler))
-	{
-		return;
-	}
+	INC_DWORD_STAT(STAT_Dieg_ItemTransformRequests);
 
-	if (!Handler->OnDragHoverInventory.IsAlreadyBound(this, &ThisClass::HandleDragHoverEnterInventory))
+	if (PendingTransformRequest.IsSet())
 	{
-		Handler->OnDragHoverInventory.AddDynamic(this, &ThisClass::HandleDragHoverEnterInventory);
+		PendingTransformRequest->Merge(Request);
 	}
-	if (!Handler->OnDragUnHoverInventory.IsAlreadyBound(this, &ThisClass::HandleDragHoverLeaveInventory))
+	else
 	{
-		Handler->OnDragUnHoverInventory.AddDynamic(this, &ThisClass::HandleDragHoverLeaveInventory);
+		PendingTransformRequest = Request;
 	}
 
-	if (!Handler->OnStartDragInventory.IsAlreadyBound(this, &ThisClass::HandleStartDragInventory))
+	// Outside a game world there is no actor tick to wait for
+	const UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld())
 	{
-		Handler->OnStartDragInventory.AddDynamic(this, &ThisClass::HandleStartDragInventory);
-	}
-	if (!Handler->OnStartDragWorld.IsAlreadyBound(this, &ThisClass::HandleStartDragWorld))
-	{
-		Handler->OnStartDragWorld.AddDynamic(this, &ThisClass::HandleStartDragWorld);
+		FlushTransformUpdate();
+		return;
 	}
 
-	if (!Handler->OnDropInInventory.IsAlreadyBound(this, &ThisClass::HandleStopDragInventory))
+	if (!PostActorTickHandle.IsValid())
 	{
-		Handler->OnDropInInventory.AddDynamic(this, &ThisClass::HandleStopDragInventory);
-	}
-	if (!Handler->OnDropWorld.IsAlreadyBound(this, &ThisClass::HandleStopDragWorld))
-	{
-		Handler->OnDropWorld.AddDynamic(this, &ThisClass::HandleStopDragWorld);
+		PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &ThisClass::HandleWorldPostActorTick);
 	}
+}
 
-	if (!Handler->OnResetDragInventory.IsAlreadyBound(this, &ThisClass::HandleResetDragInventory))
-	{
-		Handler->OnResetDragInventory.AddDynamic(this, &ThisClass::HandleResetDragInventory);
-	}
-	if (!Handler->OnResetDragWorld.IsAlreadyBound(this, &ThisClass::HandleResetDragWorld))
+void ADieg_WorldItemActor::FlushTransformUpdate()
+{
+	if (PostActorTickHandle.IsValid())
 	{
-		Handler->OnResetDragWorld.AddDynamic(this, &ThisClass::HandleResetDragWorld);
+		FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+		PostActorTickHandle.Reset();
 	}
 
-	if (!Handler->OnRotateItem.IsAlreadyBound(this, &ThisClass::HandleRotateItemInventory))
+	if (PendingTransformRequest.IsSet())
 	{
-		Handler->OnRotateItem.AddDynamic(this, &ThisClass::HandleRotateItemInventory);
+		const FDieg_ItemTransformRequest Request = PendingTransformRequest.GetValue();
+		PendingTransformRequest.Reset();
+		SolveTransforms(Request);
 	}
-	if (!Handler->OnMergeItem.IsAlreadyBound(this, &ThisClass::HandleMergeItemInventory))
-	{
-		Handler->OnMergeItem.AddDynamic(this, &ThisClass::HandleMergeItemInventory);
-	}
-	if (!Handler->OnConsumedItemInMerge.IsAlreadyBound(this, &ThisClass::HandleConsumedItemInventory))
+}
+
+void ADieg_WorldItemActor::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
 	{
-		Handler->OnConsumedItemInMerge.AddDynamic(this, &ThisClass::HandleConsumedItemInventory);
+		FlushTransformUpdate();
 	}
-
 }
 
-void ADieg_WorldItemActor::UnBindEventsFromHandler_Implementation(UDieg_InventoryInputHandler* Handler)
+void ADieg_WorldItemActor::SolveTransforms(const FDieg_ItemTransformRequest& Request)
 {
-	if (!IsValid(Handler))
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_SolveItemTransforms);
+
+	const UDieg_ItemDefinitionDataAsset* ItemDataAsset = IsValid(ItemInstance) ? ItemInstance->GetItemDefinitionDataAsset() : nullptr;
+	if (!IsValid(ItemDataAsset))
 	{
 		return;
 	}
 
-	if (Handler->OnDragHoverInventory.IsAlreadyBound(this, &ThisClass::HandleDragHoverEnterInventory))
-	{
-		Handler->OnDragHoverInventory.RemoveDynamic(this, &ThisClass::HandleDragHoverEnterInventory);
-	}
-	if (Handler->OnDragUnHoverInventory.IsAlreadyBound(this, &ThisClass::HandleDragHoverLeaveInventory))
-	{
-		Handler->OnDragUnHoverInventory.RemoveDynamic(this, &ThisClass::HandleDragHoverLeaveInventory);
-	}
+	const UDieg_Slot* DefaultSlot = GetDefault<UDieg_Slot>();
+	const float GridSize3D = DefaultSlot->GetGridSize3D();
 
-	if (Handler->OnStartDragInventory.IsAlreadyBound(this, &ThisClass::HandleStartDragInventory))
-	{
-		Handler->OnStartDragInventory.RemoveDynamic(this, &ThisClass::HandleStartDragInventory);
-	}
-	if (Handler->OnStartDragWorld.IsAlreadyBound(this, &ThisClass::HandleStartDragWorld))
-	{
-		Handler->OnStartDragWorld.RemoveDynamic(this, &ThisClass::HandleStartDragWorld);
-	}
+	// Children are moved once, when the scope ends
+	FScopedMovementUpdate ScopedRootUpdate(Root, EScopedUpdate::DeferredUpdates);
 
-	if (Handler->OnDropInInventory.IsAlreadyBound(this, &ThisClass::HandleStopDragInventory))
-	{
-		Handler->OnDropInInventory.RemoveDynamic(this, &ThisClass::HandleStopDragInventory);
-	}
-	if (Handler->OnDropWorld.IsAlreadyBound(this, &ThisClass::HandleStopDragWorld))
+	// Root
+	switch (Request.RootMode)
 	{
-		Handler->OnDropWorld.RemoveDynamic(this, &ThisClass::HandleStopDragWorld);
+	case EDieg_ItemRootMode::Grid:
+		TextRendererComponent->SetHiddenInGame(false, false);
+		break;
+	case EDieg_ItemRootMode::World:
+		TextRendererComponent->SetHiddenInGame(true, false);
+		if (!GetActorScale3D().Equals(FVector::OneVector))
+		{
+			INC_DWORD_STAT(STAT_Dieg_ItemComponentTransformUpdates);
+			SetActorScale3D(FVector::OneVector);
+		}
+		break;
+	case EDieg_ItemRootMode::Keep:
+		break;
 	}
 
-	if (Handler->OnResetDragInventory.IsAlreadyBound(this, &ThisClass::HandleResetDragInventory))
+	FTransform RootTransform = Root->GetRelativeTransform();
+	if (Request.RootMode == EDieg_ItemRootMode::Grid)
 	{
-		Handler->OnResetDragInventory.RemoveDynamic(this, &ThisClass::HandleResetDragInventory);
+		// In local zero rotation: Pitch is Y, Yaw is Z and Roll is X
+		// So they are aligned with the grid plane or mesh
+		RootTransform.SetRotation(FRotator(-90.0f, 0.0, 0.0).Quaternion());
+		RootTransform.SetScale3D(FVector(DefaultSlot->GetInventoryScale3D()));
 	}
-	if (Handler->OnResetDragWorld.IsAlreadyBound(this, &ThisClass::HandleResetDragWorld))
+	if (Request.bPlaceAtCoordinates)
 	{
-		Handler->OnResetDragWorld.RemoveDynamic(this, &ThisClass::HandleResetDragWorld);
+		RootTransform.SetLocation(GetInventoryRootLocation(GetCoordinates()));
 	}
+	SetRelativeTransformIfChanged(Root, RootTransform);
 
-	if (Handler->OnRotateItem.IsAlreadyBound(this, &ThisClass::HandleRotateItemInventory))
-	{
-		Handler->OnRotateItem.RemoveDynamic(this, &ThisClass::HandleRotateItemInventory);
-	}
-	if (Handler->OnMergeItem.IsAlreadyBound(this, &ThisClass::HandleMergeItemInventory))
+	// Mesh, sized for the root mode it ends up in
+	const FVector MeshScale = Request.RootMode == EDieg_ItemRootMode::World ? FVector::OneVector : StaticMeshComponent->GetRelativeScale3D();
+	const float UnitScaled = MeshScale.X * GridSize3D;
+	FVector MeshLocation = GetMeshRelativeLocation(ItemDataAsset, CurrentRotation, UnitScaled);
+	if (Request.GrabPoint.IsSet())
 	{
-		Handler->OnMergeItem.RemoveDynamic(this, &ThisClass::HandleMergeItemInventory);
+		const FVector2D LocalGrabPoint = (Request.GrabPoint.GetValue() + FVector2D{0.5, 0.5}) * UnitScaled;
+
+		// Convert 2D coordinates to 3D space. X and Y are not the same in both.
+		FVector LocationGrabPoint = FVector{LocalGrabPoint.Y, -LocalGrabPoint.X, 0.0f};
+		if (IsOwnedByInventory())
+		{
+			LocationGrabPoint.Z = OffsetZ;
+		}
+		MeshLocation -= LocationGrabPoint;
 	}
-	if (Handler->OnConsumedItemInMerge.IsAlreadyBound(this, &ThisClass::HandleConsumedItemInventory))
+	SetRelativeTransformIfChanged(StaticMeshComponent, FTransform(FRotator(0, CurrentRotation, 0), MeshLocation, MeshScale));
+
+	// Text, on the root of the rotated shape
+	if (Request.bUpdateText)
 	{
-		Handler->OnConsumedItemInMerge.RemoveDynamic(this, &ThisClass::HandleConsumedItemInventory);
+		const FDieg_RotatedShape& RotatedShape = ItemDataAsset->GetRotatedShape(CurrentRotation);
+		const float GridSize3DHalfNegative = GridSize3D * -0.5f;
+		FIntPoint TextCoordinatesWithOffset = RotatedShape.Root * GridSize3D;
+		TextCoordinatesWithOffset = TextCoordinatesWithOffset - GridSize3DHalfNegative;
+
+		const FVector TextLocation(TextCoordinatesWithOffset.X, TextCoordinatesWithOffset.Y, TextRendererComponent->GetRelativeLocation().Z);
+		SetRelativeTransformIfChanged(TextRendererComponent,
+			FTransform(FRotator(90.0, -CurrentRotation, 0.0), TextLocation, TextRendererComponent->GetRelativeScale3D()));
 	}
 }
 
-void ADieg_WorldItemActor::HandleDragHoverEnterInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor* DraggedItem, FIntPoint GrabPoint)
+void ADieg_WorldItemActor::OnDragHoverEnterInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint GrabPoint)
 {
-	AdjustRootTransformForGrid();
-	AdjustMeshRelativeRotation(); 
-	AdjustForGrabPoint(GrabPoint);
-	AdjustText();
+	FDieg_ItemTransformRequest Request;
+	Request.RootMode = EDieg_ItemRootMode::Grid;
+	Request.GrabPoint = FVector2D(GrabPoint);
+	Request.bUpdateText = true;
+	RequestTransformUpdate(Request);
 }
 
-void ADieg_WorldItemActor::HandleDragHoverLeaveInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor* DraggedItem, FIntPoint GrabPoint)
+void ADieg_WorldItemActor::OnDragHoverLeaveInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint GrabPoint)
 {
-	AdjustRootTransformForWorld();
-	AdjustMeshRelativeRotation();
-	AdjustForGrabPoint(GrabPoint);
+	FDieg_ItemTransformRequest Request;
+	Request.RootMode = EDieg_ItemRootMode::World;
+	Request.GrabPoint = FVector2D(GrabPoint);
+	RequestTransformUpdate(Request);
 }
 
-void ADieg_WorldItemActor::HandleStartDragInventory(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DraggedItem, FIntPoint GrabPoint, FIntPoint Coordinates)
+void ADieg_WorldItemActor::OnStartDragInventory(UDieg_InventoryInputHandler* Handler, FIntPoint GrabPoint, FIntPoint Coordinates)
 {
-	AdjustMeshRelativeRotation();
-	AdjustForGrabPoint(GrabPoint);
-	AdjustText();
+	FDieg_ItemTransformRequest Request;
+	Request.GrabPoint = FVector2D(GrabPoint);
+	Request.bUpdateText = true;
+	RequestTransformUpdate(Request);
 }
 
-void ADieg_WorldItemActor::HandleStartDragWorld(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DraggedItem, FIntPoint GrabPoint, FVector WorldLocation)
+void ADieg_WorldItemActor::OnStartDragWorld(UDieg_InventoryInputHandler* Handler, FIntPoint GrabPoint, FVector WorldLocation)
 {
-	AdjustMeshRelativeRotation();
-	AdjustForGrabPoint(GrabPoint);
+	FDieg_ItemTransformRequest Request;
+	Request.GrabPoint = FVector2D(GrabPoint);
+	RequestTransformUpdate(Request);
 }
 
-void ADieg_WorldItemActor::HandleStopDragInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor* DroppedItem, FIntPoint DroppedCoordinates, float DroppedRotation)
+void ADieg_WorldItemActor::OnDropInInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint DroppedCoordinates, float DroppedRotation)
 {
 	const UDieg_3DInventoryComponent* OwningInventory3dComponent = GetOwnerComponent();
 	if (IsValid(OwningInventory3dComponent) && OwningInventory3dComponent != InventoryComponent3D)
@@ -403,18 +429,19 @@ void ADieg_WorldItemActor::HandleStopDragInventory(UDieg_InventoryInputHandler*
 		
 	}
 	
-	AdjustActorLocation();
-	AdjustMeshRelativeRotation();
-	AdjustText();
+	FDieg_ItemTransformRequest Request;
+	Request.bPlaceAtCoordinates = true;
+	Request.bUpdateText = true;
+	RequestTransformUpdate(Request);
 }
 
-void ADieg_WorldItemActor::HandleStopDragWorld(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DroppedItem, FVector DroppedLocation)
+void ADieg_WorldItemActor::OnDropWorld(UDieg_InventoryInputHandler* Handler, FVector DroppedLocation)
 {
 	SetCoordinates(FIntPoint(-1, -1));
 	SetCurrentRotation(0.0f);
 }
 
-void ADieg_WorldItemActor::HandleResetDragInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor* RestItem, FIntPoint ResetCoordinates, float ResetRotation)
+void ADieg_WorldItemActor::OnResetDragInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint ResetCoordinates, float ResetRotation)
 {
 	const UDieg_3DInventoryComponent* OwningInventory3dComponent = GetOwnerComponent();
 	if (IsValid(OwningInventory3dComponent) && OwningInventory3dComponent != InventoryComponent3D)
@@ -423,12 +450,14 @@ void ADieg_WorldItemActor::HandleResetDragInventory(UDieg_InventoryInputHandler*
 	}
 
 	SetCurrentRotation(GetLastSlotData().Rotation);
-	AdjustActorLocation();
-	AdjustMeshRelativeRotation();
-	AdjustText();
+
+	FDieg_ItemTransformRequest Request;
+	Request.bPlaceAtCoordinates = true;
+	Request.bUpdateText = true;
+	RequestTransformUpdate(Request);
 }
 
-void ADieg_WorldItemActor::HandleResetDragWorld(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* ResetItem, FVector ResetLocation)
+void ADieg_WorldItemActor::OnResetDragWorld(UDieg_InventoryInputHandler* Handler, FVector ResetLocation)
 {
 	SetActorLocation(ResetLocation);
 	
@@ -437,26 +466,24 @@ void ADieg_WorldItemActor::HandleResetDragWorld(UDieg_InventoryInputHandler* Inv
 	SetActorScale3D(FVector::OneVector);
 	SetActorRelativeScale3D(FVector::OneVector);
 	SetActorRotation(FRotator::ZeroRotator);
-	AdjustMeshRelativeRotation();
+	RequestTransformUpdate(FDieg_ItemTransformRequest());
 
 	SetActorEnableCollision(true);
 	SetCoordinates(FIntPoint(-1, -1));
 	SetCurrentRotation(0.0f);
 }
 
-void ADieg_WorldItemActor::HandleRotateItemInventory(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* RotatedItem, float NewRotation, FIntPoint GripPoint)
+void ADieg_WorldItemActor::OnRotateDragged(UDieg_InventoryInputHandler* Handler, float NewRotation, FIntPoint GripPoint)
 {
 	SetCurrentRotation(NewRotation);
-	AdjustMeshRelativeRotation();
-	AdjustForGrabPoint(GripPoint);
-	AdjustText();
-}
 
-void ADieg_WorldItemActor::HandleMergeItemInventory(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DroppedItem, TArray<AActor*> MergedActors, int32 OldQuantity, int32 NewQuantity)
-{
+	FDieg_ItemTransformRequest Request;
+	Request.GrabPoint = FVector2D(GripPoint);
+	Request.bUpdateText = true;
+	RequestTransformUpdate(Request);
 }
 
-void ADieg_WorldItemActor::HandleConsumedItemInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor* ConsumedActor)
+void ADieg_WorldItemActor::OnConsumedInMerge(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D)
 {
 	Destroy();
 }
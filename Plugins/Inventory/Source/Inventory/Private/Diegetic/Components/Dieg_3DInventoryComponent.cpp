@@ -3,11 +3,23 @@
 
 #include "Diegetic/Components/Dieg_3DInventoryComponent.h"
 
+#include "Inventory.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/WidgetComponent.h"
 #include "Diegetic/Actors/Dieg_WorldItemActor.h"
 #include "Diegetic/Components/Dieg_InventoryComponent.h"
+#include "Diegetic/UObjects/Dieg_ItemDefinitionDataAsset.h"
+#include "Diegetic/UObjects/Dieg_ItemInstance.h"
+#include "Diegetic/Subsystems/Dieg_ActorPoolSubsystem.h"
+#include "Diegetic/Subsystems/Dieg_AssetStreamingSubsystem.h"
 #include "Diegetic/Widgets/Dieg_Grid.h"
 
+DECLARE_CYCLE_STAT(TEXT("Sync Item Actors"), STAT_Dieg_SyncItemActors, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Actors Updated"), STAT_Dieg_ItemActorsUpdated, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Mesh Instances Updated"), STAT_Dieg_ItemMeshInstancesUpdated, STATGROUP_DiegInventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Mesh Instances"), STAT_Dieg_ItemMeshInstances, STATGROUP_DiegInventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Instancers"), STAT_Dieg_ItemInstancers, STATGROUP_DiegInventory);
+
 
 // Sets default values for this component's properties
 UDieg_3DInventoryComponent::UDieg_3DInventoryComponent()
@@ -28,6 +40,17 @@ void UDieg_3DInventoryComponent::BeginPlay()
 	PreInitialize();
 }
 
+void UDieg_3DInventoryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get())
+	{
+		Streamer->ReleaseHolderAssets(this);
+	}
+	PendingItemMeshes.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 
 // Called every frame
 void UDieg_3DInventoryComponent::TickComponent(float DeltaTime, ELevelTick TickType,
@@ -107,31 +130,474 @@ void UDieg_3DInventoryComponent::Populate3D()
 	}
 	
 	GridWidget->CreateEmptyGrid(InventoryComponentRef->GetTotalSlots(), InventoryComponentRef->GetMaxColumns());
-	const FVector ZeroLocation = FVector::ZeroVector;
-	const FRotator ZeroRotation = FRotator::ZeroRotator;
+	SyncItemActors();
+}
+
+void UDieg_3DInventoryComponent::SyncItemActors()
+{
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_SyncItemActors);
+
+	if (!IsValid(ItemClass) || !IsValid(InventoryComponentRef) || !WidgetComponentRef.IsValid())
+	{
+		return;
+	}
+
+	const FDieg_SlotStorage& SlotStorage = InventoryComponentRef->GetSlotStorage();
+
+	// Only touch the items that changed since the last sync
+	TArray<FDieg_InventoryChange> Changes;
+	if (SyncedChangeVersion != INDEX_NONE && InventoryComponentRef->GetChangesSince(SyncedChangeVersion, Changes))
+	{
+		SyncChangedItems(Changes, nullptr);
+	}
+	else
+	{
+		// Full rebuild, still reusing actors that already show a placed item
+		TMap<const UDieg_ItemInstance*, ADieg_WorldItemActor*> PreviousActors;
+		PreviousActors.Reserve(Items.Num());
+		for (ADieg_WorldItemActor* ItemActor : Items)
+		{
+			if (IsValid(ItemActor))
+			{
+				PreviousActors.Add(ItemActor->GetItemInstance(), ItemActor);
+			}
+		}
+
+		// One batch of async loads for everything about to be shown
+		if (UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get())
+		{
+			Streamer->RequestInventoryAssets(InventoryComponentRef, this);
+		}
+
+		ResetItemMeshInstances();
+		Items.Reset(SlotStorage.NumItems());
+		ItemActorsByInstance.Reset();
+		for (FDieg_SlotStorage::FItemIterator It = SlotStorage.CreateItemIterator(); It; ++It)
+		{
+			ADieg_WorldItemActor* ItemActor = nullptr;
+			if (PreviousActors.RemoveAndCopyValue(It->ItemInstance, ItemActor))
+			{
+				AddItemActor(ItemActor);
+			}
+			SyncItem(It->ItemInstance, It->RootIndex);
+		}
+
+		UDieg_ActorPoolSubsystem* Pool = UDieg_ActorPoolSubsystem::Get(this);
+		for (const TPair<const UDieg_ItemInstance*, ADieg_WorldItemActor*>& Leftover : PreviousActors)
+		{
+			if (Pool)
+			{
+				Pool->ReleaseActor(Leftover.Value);
+			}
+			else
+			{
+				Leftover.Value->Destroy();
+			}
+		}
+	}
+
+	SyncedChangeVersion = InventoryComponentRef->GetChangeVersion();
+}
+
+int32 UDieg_3DInventoryComponent::FindItemActorIndex(const UDieg_ItemInstance* ItemInstance) const
+{
+	ADieg_WorldItemActor* ItemActor = FindItemActor(ItemInstance);
+	return ItemActor ? Items.Find(ItemActor) : INDEX_NONE;
+}
+
+ADieg_WorldItemActor* UDieg_3DInventoryComponent::FindItemActor(const UDieg_ItemInstance* ItemInstance) const
+{
+	ADieg_WorldItemActor* const* ItemActor = ItemActorsByInstance.Find(ItemInstance);
+	return ItemActor && IsValid(*ItemActor) ? *ItemActor : nullptr;
+}
+
+void UDieg_3DInventoryComponent::AddItemActor(ADieg_WorldItemActor* ItemActor)
+{
+	Items.Add(ItemActor);
+	ItemActorsByInstance.Add(ItemActor->GetItemInstance(), ItemActor);
+}
+
+void UDieg_3DInventoryComponent::UnindexItemActor(const ADieg_WorldItemActor* ItemActor)
+{
+	const UDieg_ItemInstance* ItemInstance = ItemActor->GetItemInstance();
+	if (ADieg_WorldItemActor* const* Indexed = ItemActorsByInstance.Find(ItemInstance); Indexed && *Indexed == ItemActor)
+	{
+		ItemActorsByInstance.Remove(ItemInstance);
+	}
+}
+
+void UDieg_3DInventoryComponent::SyncItem(UDieg_ItemInstance* ItemInstance, const int32 RootIndex)
+{
+	const FDieg_InventorySlot InventorySlot = InventoryComponentRef->GetSlotStorage().MakeSlot(RootIndex);
+
+	// Promoted or dragged items keep their actor
+	if (ADieg_WorldItemActor* ItemActor = FindItemActor(ItemInstance))
+	{
+		INC_DWORD_STAT(STAT_Dieg_ItemActorsUpdated);
+		ItemActor->SetFromInventorySlot(InventorySlot);
+		return;
+	}
+
+	if (RenderMode == EDieg_ItemRenderMode::Instanced && UpdateItemMeshInstance(InventorySlot))
+	{
+		return;
+	}
+
+	AcquireItemActor(InventorySlot);
+}
+
+void UDieg_3DInventoryComponent::ReleaseItem(const UDieg_ItemInstance* ItemInstance)
+{
+	ReleaseItemMeshInstance(ItemInstance);
+	if (const int32 Index = FindItemActorIndex(ItemInstance); Index != INDEX_NONE)
+	{
+		ReleaseItemActor(Index);
+	}
+}
+
+ADieg_WorldItemActor* UDieg_3DInventoryComponent::AcquireItemActor(const FDieg_InventorySlot& InventorySlot)
+{
+	INC_DWORD_STAT(STAT_Dieg_ItemActorsUpdated);
+
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.Owner = GetOwner();
-	const TArray<FDieg_InventorySlot*> InventoryRootSlots = InventoryComponentRef->GetRootSlotsMutable();
-	for (const FDieg_InventorySlot* RootSlot : InventoryRootSlots)
+	ADieg_WorldItemActor* ItemActor = nullptr;
+	if (UDieg_ActorPoolSubsystem* Pool = UDieg_ActorPoolSubsystem::Get(this))
+	{
+		ItemActor = Pool->AcquireActor<ADieg_WorldItemActor>(ItemClass, FTransform::Identity, SpawnParams);
+	}
+	else
 	{
-		ADieg_WorldItemActor* ItemActor = GetWorld()->SpawnActor<ADieg_WorldItemActor>(ItemClass, ZeroLocation, ZeroRotation, SpawnParams);
-		ItemActor->SetFromInventorySlot(*RootSlot);
-		Items.Add(ItemActor);
-		ItemActor->AttachToComponent(WidgetComponentRef.Get(), FAttachmentTransformRules::KeepRelativeTransform);
+		ItemActor = GetWorld()->SpawnActor<ADieg_WorldItemActor>(ItemClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	}
+
+	if (!IsValid(ItemActor))
+	{
+		return nullptr;
+	}
+
+	ItemActor->SetFromInventorySlot(InventorySlot);
+	AddItemActor(ItemActor);
+	ItemActor->AttachToComponent(WidgetComponentRef.Get(), FAttachmentTransformRules::KeepRelativeTransform);
+	return ItemActor;
+}
+
+void UDieg_3DInventoryComponent::ReleaseItemActor(const int32 Index)
+{
+	ADieg_WorldItemActor* ItemActor = Items[Index];
+	Items.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	UnindexItemActor(ItemActor);
+
+	if (UDieg_ActorPoolSubsystem* Pool = UDieg_ActorPoolSubsystem::Get(this))
+	{
+		Pool->ReleaseActor(ItemActor);
+	}
+	else
+	{
+		ItemActor->Destroy();
+	}
+}
+
+void UDieg_3DInventoryComponent::SyncChangedItems(const TArray<FDieg_InventoryChange>& Changes, const UDieg_ItemInstance* IgnoredItem)
+{
+	const FDieg_SlotStorage& SlotStorage = InventoryComponentRef->GetSlotStorage();
+
+	TSet<UDieg_ItemInstance*> ChangedItems;
+	ChangedItems.Reserve(Changes.Num());
+	for (const FDieg_InventoryChange& Change : Changes)
+	{
+		if (Change.ItemInstance != IgnoredItem)
+		{
+			ChangedItems.Add(Change.ItemInstance);
+		}
+	}
+
+	// Several changes to one item collapse into its current state
+	for (UDieg_ItemInstance* ItemInstance : ChangedItems)
+	{
+		const int32 Handle = SlotStorage.FindHandle(ItemInstance);
+		if (Handle != INDEX_NONE)
+		{
+			SyncItem(ItemInstance, SlotStorage.GetStoredItem(Handle).RootIndex);
+		}
+		else
+		{
+			ReleaseItem(ItemInstance);
+		}
+	}
+}
+
+void UDieg_3DInventoryComponent::AcknowledgeOwnChange(const int32 VersionBefore, const UDieg_ItemInstance* OwnItem)
+{
+	if (SyncedChangeVersion == INDEX_NONE || SyncedChangeVersion != VersionBefore)
+	{
+		return;
+	}
+
+	// The caller already updated the actor of its own item; stacking may still have changed others
+	TArray<FDieg_InventoryChange> Changes;
+	if (InventoryComponentRef->GetChangesSince(VersionBefore, Changes))
+	{
+		SyncChangedItems(Changes, OwnItem);
+		SyncedChangeVersion = InventoryComponentRef->GetChangeVersion();
 	}
 }
 
 void UDieg_3DInventoryComponent::DeInitializeInventory()
 {
-	for (const TWeakObjectPtr<ADieg_WorldItemActor>& ItemActor : Items)
+	UDieg_ActorPoolSubsystem* Pool = UDieg_ActorPoolSubsystem::Get(this);
+	for (ADieg_WorldItemActor* ItemActor : Items)
 	{
-		if (IsValid(ItemActor.Get()))
+		if (!IsValid(ItemActor))
+		{
+			continue;
+		}
+
+		if (Pool)
+		{
+			Pool->ReleaseActor(ItemActor);
+		}
+		else
 		{
 			ItemActor->Destroy();
 		}
 	}
 
-	Items.Empty(); // clears all weak pointers
+	Items.Empty();
+	ItemActorsByInstance.Empty();
+	ResetItemMeshInstances();
+	SyncedChangeVersion = INDEX_NONE;
+
+	// Nothing is shown anymore, the item assets can be collected
+	if (UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get())
+	{
+		Streamer->ReleaseHolderAssets(this);
+	}
+	PendingItemMeshes.Reset();
+}
+
+bool UDieg_3DInventoryComponent::UpdateItemMeshInstance(const FDieg_InventorySlot& InventorySlot)
+{
+	UDieg_ItemInstance* ItemInstance = InventorySlot.ItemInstance;
+	const UDieg_ItemDefinitionDataAsset* ItemDataAsset = ItemInstance->GetItemDefinitionDataAsset();
+	const TSoftObjectPtr<UStaticMesh>& MeshSoftRef = ItemDataAsset->ItemDefinition.WorldMesh;
+	if (MeshSoftRef.IsNull())
+	{
+		return false;
+	}
+
+	const ADieg_WorldItemActor* Template = ItemClass->GetDefaultObject<ADieg_WorldItemActor>();
+	UStaticMesh* Mesh = MeshSoftRef.Get();
+	if (!Mesh)
+	{
+		UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get();
+		if (!Streamer)
+		{
+			Mesh = UDieg_AssetStreamingSubsystem::LoadBlocking(MeshSoftRef, TEXT("UDieg_3DInventoryComponent::UpdateItemMeshInstance"));
+		}
+		else if (!PendingItemMeshes.Contains(ItemDataAsset))
+		{
+			if (Streamer->RequestItemAssets(ItemDataAsset, this, FSimpleDelegate::CreateUObject(this, &ThisClass::HandleItemMeshStreamed, ItemDataAsset)))
+			{
+				// Finished loading between the check and the request
+				Mesh = MeshSoftRef.Get();
+			}
+			else
+			{
+				PendingItemMeshes.Add(ItemDataAsset);
+			}
+		}
+
+		if (!Mesh)
+		{
+			Mesh = Template->PlaceholderMesh;
+		}
+		if (!Mesh)
+		{
+			// Nothing to show yet, HandleItemMeshStreamed instances it
+			ReleaseItemMeshInstance(ItemInstance);
+			return true;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_Dieg_ItemMeshInstancesUpdated);
+
+	// Placed where an ItemClass actor would put its mesh
+	const FTransform InstanceTransform = Template->GetInventoryMeshTransform(ItemDataAsset, InventorySlot.Coordinates, InventorySlot.Rotation);
+	const float Quantity = ItemInstance->GetQuantity();
+
+	if (const FDieg_ItemMeshInstance* MeshInstance = ItemMeshInstances.Find(ItemInstance))
+	{
+		if (MeshInstance->Mesh == Mesh)
+		{
+			const FDieg_ItemInstancer& Instancer = ItemInstancers.FindChecked(Mesh);
+			Instancer.Component->UpdateInstanceTransform(MeshInstance->InstanceIndex, InstanceTransform, false, true, true);
+			Instancer.Component->SetCustomDataValue(MeshInstance->InstanceIndex, 0, Quantity, true);
+			return true;
+		}
+		ReleaseItemMeshInstance(ItemInstance);
+	}
+
+	FDieg_ItemInstancer& Instancer = GetOrCreateItemInstancer(Mesh);
+	int32 InstanceIndex = INDEX_NONE;
+	if (!Instancer.FreeInstances.IsEmpty())
+	{
+		InstanceIndex = Instancer.FreeInstances.Pop(EAllowShrinking::No);
+		Instancer.Component->UpdateInstanceTransform(InstanceIndex, InstanceTransform, false, true, true);
+		Instancer.InstanceItems[InstanceIndex] = ItemInstance;
+	}
+	else
+	{
+		InstanceIndex = Instancer.Component->AddInstance(InstanceTransform, false);
+		Instancer.InstanceItems.Add(ItemInstance);
+	}
+	Instancer.Component->SetCustomDataValue(InstanceIndex, 0, Quantity, true);
+
+	FDieg_ItemMeshInstance& MeshInstance = ItemMeshInstances.Add(ItemInstance);
+	MeshInstance.Mesh = Mesh;
+	MeshInstance.InstanceIndex = InstanceIndex;
+	INC_DWORD_STAT(STAT_Dieg_ItemMeshInstances);
+	return true;
+}
+
+void UDieg_3DInventoryComponent::HandleItemMeshStreamed(const UDieg_ItemDefinitionDataAsset* ItemDataAsset)
+{
+	PendingItemMeshes.Remove(ItemDataAsset);
+	if (RenderMode != EDieg_ItemRenderMode::Instanced || !IsValid(InventoryComponentRef))
+	{
+		return;
+	}
+
+	// Items promoted to actors in the meantime got the mesh through their actor
+	const FDieg_SlotStorage& SlotStorage = InventoryComponentRef->GetSlotStorage();
+	for (FDieg_SlotStorage::FItemIterator It = SlotStorage.CreateItemIterator(); It; ++It)
+	{
+		if (It->ItemInstance->GetItemDefinitionDataAsset() == ItemDataAsset && FindItemActorIndex(It->ItemInstance) == INDEX_NONE)
+		{
+			UpdateItemMeshInstance(SlotStorage.MakeSlot(It->RootIndex));
+		}
+	}
+}
+
+void UDieg_3DInventoryComponent::ReleaseItemMeshInstance(const UDieg_ItemInstance* ItemInstance)
+{
+	FDieg_ItemMeshInstance MeshInstance;
+	if (!ItemMeshInstances.RemoveAndCopyValue(ItemInstance, MeshInstance))
+	{
+		return;
+	}
+
+	// Removing would reorder the other instances, collapse it and reuse the index instead
+	FDieg_ItemInstancer& Instancer = ItemInstancers.FindChecked(MeshInstance.Mesh);
+	Instancer.Component->UpdateInstanceTransform(MeshInstance.InstanceIndex, FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), false, true, true);
+	Instancer.InstanceItems[MeshInstance.InstanceIndex] = nullptr;
+	Instancer.FreeInstances.Add(MeshInstance.InstanceIndex);
+	DEC_DWORD_STAT(STAT_Dieg_ItemMeshInstances);
+}
+
+void UDieg_3DInventoryComponent::ResetItemMeshInstances()
+{
+	for (TPair<TObjectPtr<UStaticMesh>, FDieg_ItemInstancer>& Pair : ItemInstancers)
+	{
+		Pair.Value.Component->ClearInstances();
+		Pair.Value.InstanceItems.Reset();
+		Pair.Value.FreeInstances.Reset();
+	}
+
+	DEC_DWORD_STAT_BY(STAT_Dieg_ItemMeshInstances, ItemMeshInstances.Num());
+	ItemMeshInstances.Reset();
+}
+
+FDieg_ItemInstancer& UDieg_3DInventoryComponent::GetOrCreateItemInstancer(UStaticMesh* Mesh)
+{
+	FDieg_ItemInstancer& Instancer = ItemInstancers.FindOrAdd(Mesh);
+	if (!IsValid(Instancer.Component))
+	{
+		// Traced and collided like the mesh of an ItemClass actor
+		const ADieg_WorldItemActor* Template = ItemClass->GetDefaultObject<ADieg_WorldItemActor>();
+		UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(GetOwner(), NAME_None, RF_Transient);
+		Component->SetStaticMesh(Mesh);
+		Component->NumCustomDataFloats = 1;
+		Component->SetCollisionProfileName(Template->StaticMeshComponent->GetCollisionProfileName());
+		Component->SetupAttachment(WidgetComponentRef.Get());
+		Component->RegisterComponent();
+
+		Instancer.Component = Component;
+		INC_DWORD_STAT(STAT_Dieg_ItemInstancers);
+	}
+	return Instancer;
+}
+
+ADieg_WorldItemActor* UDieg_3DInventoryComponent::PromoteInstancedItem(const UPrimitiveComponent* HitComponent, const int32 InstanceIndex)
+{
+	if (RenderMode != EDieg_ItemRenderMode::Instanced || !HitComponent || !IsValid(InventoryComponentRef))
+	{
+		return nullptr;
+	}
+
+	for (const TPair<TObjectPtr<UStaticMesh>, FDieg_ItemInstancer>& Pair : ItemInstancers)
+	{
+		if (Pair.Value.Component != HitComponent)
+		{
+			continue;
+		}
+
+		UDieg_ItemInstance* ItemInstance = Pair.Value.InstanceItems.IsValidIndex(InstanceIndex) ? Pair.Value.InstanceItems[InstanceIndex].Get() : nullptr;
+		const FDieg_SlotStorage& SlotStorage = InventoryComponentRef->GetSlotStorage();
+		const int32 Handle = ItemInstance ? SlotStorage.FindHandle(ItemInstance) : INDEX_NONE;
+		if (Handle == INDEX_NONE)
+		{
+			return nullptr;
+		}
+
+		ReleaseItemMeshInstance(ItemInstance);
+		return AcquireItemActor(SlotStorage.MakeSlot(SlotStorage.GetStoredItem(Handle).RootIndex));
+	}
+
+	return nullptr;
+}
+
+void UDieg_3DInventoryComponent::DemoteItemActor(ADieg_WorldItemActor* ItemActor)
+{
+	if (RenderMode != EDieg_ItemRenderMode::Instanced || !IsValid(ItemActor) || !IsValid(InventoryComponentRef))
+	{
+		return;
+	}
+
+	const int32 Index = Items.Find(ItemActor);
+	const FDieg_SlotStorage& SlotStorage = InventoryComponentRef->GetSlotStorage();
+	const int32 Handle = SlotStorage.FindHandle(ItemActor->GetItemInstance());
+	if (Index == INDEX_NONE || Handle == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (UpdateItemMeshInstance(SlotStorage.MakeSlot(SlotStorage.GetStoredItem(Handle).RootIndex)))
+	{
+		ReleaseItemActor(Index);
+	}
+}
+
+void UDieg_3DInventoryComponent::SetItemCollisionEnabled(const bool bEnabled)
+{
+	for (ADieg_WorldItemActor* ItemActor : Items)
+	{
+		if (IsValid(ItemActor))
+		{
+			ItemActor->SetActorEnableCollision(bEnabled);
+		}
+	}
+
+	if (ItemInstancers.IsEmpty())
+	{
+		return;
+	}
+
+	const ECollisionEnabled::Type Enabled = ItemClass->GetDefaultObject<ADieg_WorldItemActor>()->StaticMeshComponent->GetCollisionEnabled();
+	for (const TPair<TObjectPtr<UStaticMesh>, FDieg_ItemInstancer>& Pair : ItemInstancers)
+	{
+		Pair.Value.Component->SetCollisionEnabled(bEnabled ? Enabled : ECollisionEnabled::NoCollision);
+	}
 }
 
 void UDieg_3DInventoryComponent::AddItemToInventory(ADieg_WorldItemActor* ItemActor)
@@ -141,9 +607,11 @@ void UDieg_3DInventoryComponent::AddItemToInventory(ADieg_WorldItemActor* ItemAc
 		return;
 	}
 
+	const int32 VersionBefore = InventoryComponentRef->GetChangeVersion();
 	int32 Remaining = INT32_MAX;
 	InventoryComponentRef->TryAddItem(ItemActor->GetItemInstanceMutable(), Remaining);
-	Items.Add(ItemActor);
+	AddItemActor(ItemActor);
+	AcknowledgeOwnChange(VersionBefore, ItemActor->GetItemInstance());
 }
 
 void UDieg_3DInventoryComponent::AddItemToInventorySlot(ADieg_WorldItemActor* ItemActor, const FIntPoint& SlotCoordinates, int32 RotationUsed)
@@ -155,9 +623,10 @@ void UDieg_3DInventoryComponent::AddItemToInventorySlot(ADieg_WorldItemActor* It
 
 	if (InventoryComponentRef->CanAddItemInstanceToSlot(SlotCoordinates, ItemActor->GetItemInstance(), RotationUsed))
 	{
-		int32 Remaining = INT32_MAX;
+		const int32 VersionBefore = InventoryComponentRef->GetChangeVersion();
 		InventoryComponentRef->AddItemToInventory(ItemActor->GetItemInstanceMutable(), SlotCoordinates, RotationUsed);
-		Items.Add(ItemActor);
+		AddItemActor(ItemActor);
+		AcknowledgeOwnChange(VersionBefore, ItemActor->GetItemInstance());
 	}
 }
 
@@ -168,8 +637,12 @@ void UDieg_3DInventoryComponent::RemoveItemFromInventory(ADieg_WorldItemActor* I
 		return;
 	}
 
+	const int32 VersionBefore = InventoryComponentRef->GetChangeVersion();
 	InventoryComponentRef->TryRemoveItem(ItemActor->GetItemInstance());
 	Items.Remove(ItemActor);
+	UnindexItemActor(ItemActor);
+	ReleaseItemMeshInstance(ItemActor->GetItemInstance());
+	AcknowledgeOwnChange(VersionBefore, ItemActor->GetItemInstance());
 }
 
 void UDieg_3DInventoryComponent::WidgetSlotHover(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent,
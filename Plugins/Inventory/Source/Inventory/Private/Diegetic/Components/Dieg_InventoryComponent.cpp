@@ -5,10 +5,18 @@
 
 #include "BPF_PlugInv_DoubleLogger.h"
 #include "Algo/ForEach.h"
+#include "Algo/StableSort.h"
 #include "Diegetic/Dieg_UtilityLibrary.h"
 #include "Diegetic/UObjects/Dieg_ItemInstance.h"
 #include "Diegetic/UStructs/Dieg_InventorySlot.h"
 
+DECLARE_CYCLE_STAT(TEXT("Fit Test"), STAT_Dieg_FitTest, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Find First Fit"), STAT_Dieg_FindFirstFit, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Find Placement"), STAT_Dieg_FindPlacement, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Try Add Items Batch"), STAT_Dieg_TryAddItemsBatch, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Placements Scored"), STAT_Dieg_PlacementsScored, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Slot Scan"), STAT_Dieg_SlotScan, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Merge Into Items"), STAT_Dieg_MergeIntoItems, STATGROUP_DiegInventory);
 
 // Sets default values for this component's properties
 UDieg_InventoryComponent::UDieg_InventoryComponent()
@@ -29,58 +37,55 @@ void UDieg_InventoryComponent::BeginPlay()
 }
 
 
-TArray<FDieg_InventorySlot*> UDieg_InventoryComponent::GetRootSlotsMutable()
+TArray<FDieg_InventorySlot> UDieg_InventoryComponent::GetRootSlots() const
 {
-	TArray<FDieg_InventorySlot*> RootSlots;
-	for (FDieg_InventorySlot& Slot : InventorySlots)
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_SlotScan);
+
+	TArray<FDieg_InventorySlot> RootSlots;
+	RootSlots.Reserve(SlotStorage.NumItems());
+	for (FDieg_SlotStorage::FItemIterator It = SlotStorage.CreateItemIterator(); It; ++It)
 	{
-		if (Slot.IsRootSlot())
-			RootSlots.Add(&Slot);
+		RootSlots.Add(SlotStorage.MakeSlot(It->RootIndex));
 	}
-	// TArray<FDieg_InventorySlot*> RootSlots;
-	//
-	// // Lambda as predicate
-	// Algo::ForEach(InventorySlots, [&RootSlots](FDieg_InventorySlot& Slot)
-	// {
-	// 	if (Slot.IsRootSlot())
-	// 	{
-	// 		RootSlots.Add(&Slot);
-	// 	}
-	// });
-
 	return RootSlots;
 }
 
-TArray<FDieg_InventorySlot*> UDieg_InventoryComponent::GetSlotsMutable()
+TArray<FDieg_InventorySlot> UDieg_InventoryComponent::GetSlots() const
 {
-	TArray<FDieg_InventorySlot*> RootSlots;
-	for (FDieg_InventorySlot& Slot : InventorySlots)
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_SlotScan);
+
+	TArray<FDieg_InventorySlot> Slots;
+	Slots.Reserve(SlotStorage.Num());
+	for (int32 Index = 0; Index < SlotStorage.Num(); Index++)
 	{
-		RootSlots.Add(&Slot);
+		Slots.Add(SlotStorage.MakeSlot(Index));
 	}
-	return RootSlots;
+	return Slots;
 }
 
 TArray<FDieg_InventorySlot> UDieg_InventoryComponent::GetRootSlotsMutableBP()
 {
-	TArray<FDieg_InventorySlot*> PointerArray = GetRootSlotsMutable();
-	TArray<FDieg_InventorySlot> StructArray;
-	for (FDieg_InventorySlot* SlotPtr : PointerArray)
+	if (CachedRootSlotsVersion != SlotsVersion)
 	{
-		StructArray.Add(*SlotPtr);
+		CachedRootSlots = GetRootSlots();
+		CachedRootSlotsVersion = SlotsVersion;
 	}
-	return StructArray;
+	return CachedRootSlots;
 }
 
 TArray<FDieg_InventorySlot> UDieg_InventoryComponent::GetSlotsMutableBP()
 {
-	TArray<FDieg_InventorySlot*> PointerArray = GetSlotsMutable();
-	TArray<FDieg_InventorySlot> StructArray;
-	for (FDieg_InventorySlot* SlotPtr : PointerArray)
+	return GetInventorySlots();
+}
+
+const TArray<FDieg_InventorySlot>& UDieg_InventoryComponent::GetInventorySlots() const
+{
+	if (CachedSlotsVersion != SlotsVersion)
 	{
-		StructArray.Add(*SlotPtr);
+		CachedSlots = GetSlots();
+		CachedSlotsVersion = SlotsVersion;
 	}
-	return StructArray;
+	return CachedSlots;
 }
 
 // Called every frame
@@ -105,23 +110,18 @@ void UDieg_InventoryComponent::Initialize(const int32 NumSlots, const int32 NumC
 	if (bDebugLogs)
 		UPlugInv_DoubleLogger::Log(5.0f, TEXT("InitializeSlots in {0}. NumSlots: {1}, NumColumns: {2}"), FColor::Turquoise, TempName, NumSlots, NumColumns);
 	
-	// Generate grid coordinates
-	TArray<FIntPoint> Slots = UDieg_UtilityLibrary::GetSlotPoints(NumSlots, NumColumns);
-	const int32 Size = Slots.Num();
-	InventorySlots.Empty();
-	InventorySlots.Reserve(Size);
-	SlotsOccupation.Empty();
-	SlotsOccupation.Reserve(Size);
+	// Fill inventory with empty slots, all sharing the same tags
+	SlotStorage.Initialize(NumSlots, NumColumns, Tags);
+	Occupancy.Initialize(NumSlots, NumColumns);
+	StackIndex.Reset();
+	SlotsVersion++;
 
-	// Fill inventory with empty slots
-	for (int32 i = 0; i < Slots.Num(); i++)
-	{
-		const FIntPoint& SlotCoordinates = Slots[i];
-		FDieg_InventorySlot Slot;
-		Slot.Initialize(SlotCoordinates, Tags);
-		InventorySlots.EmplaceAt(i, Slot);
-		SlotsOccupation.Emplace(SlotCoordinates, false);
-	}
+	// Views synced before this point have to rebuild
+	ChangeJournal.Reset();
+	JournalBaseVersion = ++ChangeVersion;
+
+	if (bDebugLogs)
+		UPlugInv_DoubleLogger::Log(5.0f, TEXT("InitializeSlots in {0}. Storage bytes per slot: {1}"), FColor::Turquoise, TempName, GetStorageBytesPerSlot());
 
 	if (PrePopulateData.IsEmpty())
 	{
@@ -132,12 +132,14 @@ void UDieg_InventoryComponent::Initialize(const int32 NumSlots, const int32 NumC
 		UPlugInv_DoubleLogger::Log(5.0f, TEXT("InitializeSlots in {0}. Prepopulating"), FColor::Turquoise, TempName);
 	
 	// Prepopulate inventory from saved data
+	TArray<UDieg_ItemInstance*> NewItems;
+	NewItems.Reserve(PrePopulateData.Num());
 	for (const FDieg_PrePopulate& Data : PrePopulateData)
 	{
-		UDieg_ItemInstance* NewItem = MakeInstanceFromPrePopulateData(Data);
-		int32 Remaining = INT32_MAX;
-		TryAddItem(NewItem, Remaining);
+		NewItems.Add(MakeInstanceFromPrePopulateData(Data));
 	}
+	TArray<int32> Remaining;
+	TryAddItemsBatch(NewItems, Remaining);
 
 	if (ItemRotationPriority != 0 && ItemRotationPriority != 90 && ItemRotationPriority != 180 && ItemRotationPriority != -90)
 	{
@@ -170,13 +172,17 @@ bool UDieg_InventoryComponent::TryAddItem(UDieg_ItemInstance* ItemToAdd, int32&
 	}
 
 	// First try stacking on existing items of same type
-	TArray<FDieg_InventorySlot*> FoundRootInstances = FindRootSlotByItemType(ItemToAdd);
-	if (!FoundRootInstances.IsEmpty())
+	if (const TArray<FIntPoint>* RootCoordinates = StackIndex.Find(ItemToAdd->GetItemDefinitionDataAsset()))
 	{
-		for (FDieg_InventorySlot* RootSlots : FoundRootInstances)
+		for (const FIntPoint& RootCoordinate : *RootCoordinates)
 		{
 			if (ToAdd <= 0) break;
-			ToAdd -= AddQuantityToSlot(RootSlots->ItemInstance, ToAdd);
+
+			const UDieg_ItemInstance* RootItem = GetRootItem(RootCoordinate);
+			if (RootItem && RootItem->CanStackWith(ItemToAdd))
+			{
+				ToAdd -= AddQuantityToSlot(RootItem, ToAdd);
+			}
 		}
 	}
 
@@ -188,17 +194,19 @@ bool UDieg_InventoryComponent::TryAddItem(UDieg_ItemInstance* ItemToAdd, int32&
 	}
 
 	// Attempt to place in new slots
-	const TArray<FIntPoint> Shape = ItemToAdd->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShape;
-	const FIntPoint ShapeRoot = ItemToAdd->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShapeRoot;
-	for (const FDieg_InventorySlot& Slot : InventorySlots)
+	TArray<const FDieg_RotatedShape*, TInlineAllocator<4>> Shapes;
+	GetPlacementShapes(ItemToAdd->GetItemDefinitionDataAsset(), Shapes);
+
+	// The placed item only carries what the stacks didn't take
+	ItemToAdd->SetQuantity(ToAdd);
+
+	FIntPoint SlotCoordinates;
+	int32 RotationUsed = 0;
+	if (CouldEverFit(ItemToAdd->GetItemDefinitionDataAsset()) && FindPlacement(Shapes, SlotCoordinates, RotationUsed))
 	{
-		int32 RotationUsed = 0;
-		if (CanAddItemToSlot(Slot.Coordinates, Shape, ShapeRoot, RotationUsed))
-		{
-			AddItemToInventory(ItemToAdd, Slot.Coordinates, RotationUsed);
-			Remaining = 0;
-			return true;
-		}
+		AddItemToInventory(ItemToAdd, SlotCoordinates, RotationUsed);
+		Remaining = 0;
+		return true;
 	}
 
 	// Cannot place remaining quantity
@@ -213,7 +221,113 @@ bool UDieg_InventoryComponent::TryRemoveItem(UDieg_ItemInstance* ItemToRemove)
 	return true;
 }
 
-// Checks if an item can be added (stacking or new slots)
+// Adds many items at once, grouped by definition: stacks first, then placement of the leftovers
+bool UDieg_InventoryComponent::TryAddItemsBatch(const TArray<UDieg_ItemInstance*>& ItemsToAdd, TArray<int32>& RemainingOut)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_TryAddItemsBatch);
+
+	RemainingOut.Init(0, ItemsToAdd.Num());
+
+	// Group the items by definition, in first appearance order
+	TArray<const UDieg_ItemDefinitionDataAsset*> Definitions;
+	TMap<const UDieg_ItemDefinitionDataAsset*, TArray<int32>> ItemsByDefinition;
+	for (int32 i = 0; i < ItemsToAdd.Num(); i++)
+	{
+		const UDieg_ItemInstance* Item = ItemsToAdd[i];
+		if (!IsValid(Item))
+		{
+			continue;
+		}
+
+		const UDieg_ItemDefinitionDataAsset* Definition = Item->GetItemDefinitionDataAsset();
+		TArray<int32>* Group = ItemsByDefinition.Find(Definition);
+		if (!Group)
+		{
+			Definitions.Add(Definition);
+			Group = &ItemsByDefinition.Add(Definition);
+		}
+		Group->Add(i);
+	}
+
+	// Largest shapes first, they are the hardest to fit once the grid fills up
+	Algo::StableSortBy(Definitions, [](const UDieg_ItemDefinitionDataAsset* Definition)
+	{
+		return -Definition->GetRotatedShape(0.0f).Mask.NumCells;
+	});
+
+	bool bAllAdded = true;
+	int32 NumPlaced = 0;
+	TArray<const FDieg_RotatedShape*, TInlineAllocator<4>> Shapes;
+	for (const UDieg_ItemDefinitionDataAsset* Definition : Definitions)
+	{
+		const int32 MaxQuantity = Definition->ItemDefinition.StackSizeMax;
+		GetPlacementShapes(Definition, Shapes);
+
+		// Stacks of this definition before the cursor are full, items placed by the group are appended after it
+		int32 FirstOpenTarget = 0;
+		for (const int32 Index : ItemsByDefinition[Definition])
+		{
+			UDieg_ItemInstance* Item = ItemsToAdd[Index];
+			int32& Remaining = RemainingOut[Index];
+			Remaining = FMath::Clamp(Item->GetQuantity(), 1, MaxQuantity);
+
+			// Looked up per item, placing an item may grow the index
+			if (const TArray<FIntPoint>* RootCoordinates = StackIndex.Find(Definition))
+			{
+				for (int32 TargetIndex = FirstOpenTarget; TargetIndex < RootCoordinates->Num() && Remaining > 0; TargetIndex++)
+				{
+					const FIntPoint& RootCoordinate = (*RootCoordinates)[TargetIndex];
+					UDieg_ItemInstance* Target = GetRootItem(RootCoordinate);
+					if (!IsValid(Target)) continue;
+
+					const int32 Added = FMath::Min(MaxQuantity - Target->GetQuantity(), Remaining);
+					if (Added <= 0)
+					{
+						FirstOpenTarget += TargetIndex == FirstOpenTarget;
+						continue;
+					}
+
+					if (Target != Item && Target->CanStackWith(Item))
+					{
+						Target->SetQuantity(Target->GetQuantity() + Added);
+						RecordChange(EDieg_InventoryChangeType::QuantityChange, Target, RootCoordinate,
+							SlotStorage.GetRotation(SlotStorage.GetIndex(RootCoordinate)));
+						Remaining -= Added;
+					}
+				}
+			}
+
+			if (Remaining <= 0)
+			{
+				continue;
+			}
+
+			NumPlaced++;
+			FIntPoint SlotCoordinates;
+			int32 RotationUsed = 0;
+			Item->SetQuantity(Remaining);
+			if (CouldEverFit(Definition) && FindPlacement(Shapes, SlotCoordinates, RotationUsed))
+			{
+				AddItemToInventory(Item, SlotCoordinates, RotationUsed);
+				Remaining = 0;
+			}
+			else
+			{
+				bAllAdded = false;
+			}
+		}
+	}
+
+	if (bDebugLogs)
+	{
+		FString TempName = this->GetOwner()->GetActorNameOrLabel().Append(" " + this->GetName());
+		UPlugInv_DoubleLogger::Log(5.0f, TEXT("TryAddItemsBatch in {0}. Items: {1}, Definitions: {2}, Needed placement: {3}, All added: {4}"),
+		FColor::Turquoise, TempName, ItemsToAdd.Num(), Definitions.Num(), NumPlaced, bAllAdded);
+	}
+
+	return bAllAdded;
+}
+
 bool UDieg_InventoryComponent::CanAddItem(const UDieg_ItemInstance* ItemToAdd)
 {
 	if (!IsValid(ItemToAdd))
@@ -224,34 +338,61 @@ bool UDieg_InventoryComponent::CanAddItem(const UDieg_ItemInstance* ItemToAdd)
 	const int32 Quantity = FMath::Clamp(ItemToAdd->GetQuantity(), 1, ItemToAdd->GetItemDefinitionDataAsset()->ItemDefinition.StackSizeMax);
 
 	// Check stackable slots first
-	TArray<FDieg_InventorySlot*> FoundRootInstances = FindRootSlotByItemType(ItemToAdd);
-	for (FDieg_InventorySlot* RootSlot : FoundRootInstances)
+	if (const TArray<FIntPoint>* RootCoordinates = StackIndex.Find(ItemToAdd->GetItemDefinitionDataAsset()))
 	{
-		if (!RootSlot || !IsValid(RootSlot->ItemInstance)) continue;
+		for (const FIntPoint& RootCoordinate : *RootCoordinates)
+		{
+			const UDieg_ItemInstance* RootItem = GetRootItem(RootCoordinate);
+			if (!IsValid(RootItem) || !RootItem->CanStackWith(ItemToAdd)) continue;
 
-		const int32 Current = RootSlot->ItemInstance->GetQuantity();
-		const int32 Max = RootSlot->ItemInstance->GetItemDefinitionDataAsset()->ItemDefinition.StackSizeMax;
+			const int32 Current = RootItem->GetQuantity();
+			const int32 Max = RootItem->GetItemDefinitionDataAsset()->ItemDefinition.StackSizeMax;
 
-		if (Current < Max)
-		{
-			return true; // Can stack
+			if (Current < Max)
+			{
+				return true; // Can stack
+			}
 		}
 	}
 
+	// Reject from the free-space summary before searching the grid
+	if (!CouldEverFit(ItemToAdd->GetItemDefinitionDataAsset()))
+	{
+		return false;
+	}
+
 	// Check for available slots for new placement
-	const TArray<FIntPoint> Shape = ItemToAdd->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShape;
-	const FIntPoint ShapeRoot = ItemToAdd->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShapeRoot;
+	TArray<const FDieg_RotatedShape*, TInlineAllocator<4>> Shapes;
+	GetPlacementShapes(ItemToAdd->GetItemDefinitionDataAsset(), Shapes);
 
-	for (const FDieg_InventorySlot& Slot : InventorySlots)
+	FIntPoint SlotCoordinates;
+	int32 RotationUsed = 0;
+	return FindFirstFit(Shapes, SlotCoordinates, RotationUsed); // Found available placement, or no stacking or placement possible
+}
+
+int32 UDieg_InventoryComponent::GetLargestFreeRect(FIntPoint& OriginOut, FIntPoint& SizeOut) const
+{
+	const FIntRect LargestFreeRect = Occupancy.GetLargestFreeRect();
+	OriginOut = LargestFreeRect.Min;
+	SizeOut = LargestFreeRect.Size();
+	return LargestFreeRect.Area();
+}
+
+bool UDieg_InventoryComponent::CouldEverFit(const UDieg_ItemDefinitionDataAsset* ItemDataAsset) const
+{
+	if (!ItemDataAsset)
 	{
-		int32 RotationUsed = 0;
-		if (CanAddItemToSlot(Slot.Coordinates, Shape, ShapeRoot, RotationUsed))
+		return false;
+	}
+
+	for (const FDieg_RotatedShape& RotatedShape : ItemDataAsset->GetRotatedShapes())
+	{
+		if (Occupancy.CouldEverFit(RotatedShape.Mask))
 		{
-			return true; // Found available placement
+			return true;
 		}
 	}
-
-	return false; // No stacking or placement possible
+	return false;
 }
 
 bool UDieg_InventoryComponent::CanRemoveItem(UDieg_ItemInstance* ItemToRemove)
@@ -265,124 +406,239 @@ int32 UDieg_InventoryComponent::AddQuantityToSlot(const UDieg_ItemInstance* Item
 {
 	if (!ItemToAdd) return 0;
 
-	for (const FDieg_InventorySlot& Slot : InventorySlots)
+	const TArray<FIntPoint>* RootCoordinates = StackIndex.Find(ItemToAdd->GetItemDefinitionDataAsset());
+	if (!RootCoordinates) return 0;
+
+	for (const FIntPoint& RootCoordinate : *RootCoordinates)
 	{
-		if (Slot.IsRootSlot() && Slot.IsOccupied() && Slot.ItemInstance->CanStackWith(ItemToAdd))
+		UDieg_ItemInstance* Target = GetRootItem(RootCoordinate);
+		if (!IsValid(Target)) continue;
+
+		// Full stacks are skipped before the more expensive stack check
+		const int32 MaxStack = Target->GetItemDefinitionDataAsset()->ItemDefinition.StackSizeMax;
+		const int32 Added = FMath::Min(MaxStack - Target->GetQuantity(), QuantityIn);
+		if (Added > 0 && Target->CanStackWith(ItemToAdd))
 		{
-			const int32 MaxStack = Slot.ItemInstance->GetItemDefinitionDataAsset()->ItemDefinition.StackSizeMax;
-			const int32 Added = FMath::Min(MaxStack - Slot.ItemInstance->GetQuantity(), QuantityIn);
-			if (Added > 0)
-			{
-				Slot.ItemInstance->SetQuantity(Slot.ItemInstance->GetQuantity() + Added);
-				return Added;
-			}
+			Target->SetQuantity(Target->GetQuantity() + Added);
+			RecordChange(EDieg_InventoryChangeType::QuantityChange, Target, RootCoordinate,
+				SlotStorage.GetRotation(SlotStorage.GetIndex(RootCoordinate)));
+			return Added;
 		}
 	}
 
 	return 0;
 }
 
-// Returns true if slot coordinates are out of inventory bounds
-bool UDieg_InventoryComponent::IsSlotPointOutOfBounds(const FIntPoint& SlotPoint)
+int32 UDieg_InventoryComponent::MergeIntoItems(UDieg_ItemInstance* ItemToMerge, const TArray<FIntPoint>& RootSlotCoordinates,
+	TArray<UDieg_ItemInstance*>& MergedItemsOut)
 {
-	if (SlotsOccupation.Find(SlotPoint))
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_MergeIntoItems);
+
+	MergedItemsOut.Reset();
+	if (!IsValid(ItemToMerge))
 	{
-		return false;
+		return 0;
 	}
-	return true;
+
+	// Plan every transfer first, nothing is touched unless the whole merge is known
+	struct FMergeTransfer
+	{
+		UDieg_ItemInstance* Target;
+		FIntPoint RootCoordinates;
+		int32 Added;
+	};
+	TArray<FMergeTransfer, TInlineAllocator<8>> Transfers;
+
+	int32 Remaining = ItemToMerge->GetQuantity();
+	for (const FIntPoint& RootCoordinates : RootSlotCoordinates)
+	{
+		if (Remaining <= 0)
+		{
+			break;
+		}
+
+		UDieg_ItemInstance* Target = GetRootItem(RootCoordinates);
+		if (!IsValid(Target) || Target == ItemToMerge || !Target->CanStackWith(ItemToMerge)
+			|| Transfers.ContainsByPredicate([Target](const FMergeTransfer& Transfer) { return Transfer.Target == Target; }))
+		{
+			continue;
+		}
+
+		const int32 MaxStack = Target->GetItemDefinitionDataAsset()->ItemDefinition.StackSizeMax;
+		const int32 Added = FMath::Min(MaxStack - Target->GetQuantity(), Remaining);
+		if (Added > 0)
+		{
+			Transfers.Add({Target, RootCoordinates, Added});
+			Remaining -= Added;
+		}
+	}
+
+	// Apply them together; the journal gets one entry per target and callers sync once afterwards
+	for (const FMergeTransfer& Transfer : Transfers)
+	{
+		Transfer.Target->SetQuantity(Transfer.Target->GetQuantity() + Transfer.Added);
+		RecordChange(EDieg_InventoryChangeType::QuantityChange, Transfer.Target, Transfer.RootCoordinates,
+			SlotStorage.GetRotation(SlotStorage.GetIndex(Transfer.RootCoordinates)));
+		MergedItemsOut.Add(Transfer.Target);
+	}
+	ItemToMerge->SetQuantity(Remaining);
+
+	return Remaining;
+}
+
+// Returns true if slot coordinates are out of inventory bounds
+bool UDieg_InventoryComponent::IsSlotPointOutOfBounds(const FIntPoint& SlotPoint)
+{
+	return !Occupancy.IsInBounds(SlotPoint);
 }
 
 // Returns true if slot is occupied
 bool UDieg_InventoryComponent::IsSlotPointOccupied(const FIntPoint& SlotPoint)
 {
-	return *SlotsOccupation.Find(SlotPoint); 
+	return Occupancy.IsOccupied(SlotPoint); 
+}
+
+TMap<FIntPoint, bool> UDieg_InventoryComponent::GetSlotsOccupation() const
+{
+	TMap<FIntPoint, bool> OccupationMap;
+	OccupationMap.Reserve(SlotStorage.Num());
+	for (int32 Index = 0; Index < SlotStorage.Num(); Index++)
+	{
+		OccupationMap.Add(SlotStorage.GetCoordinates(Index), SlotStorage.IsOccupied(Index));
+	}
+	return OccupationMap;
 }
 
 
-// Finds root slots matching the same item type - C++ version (returns pointers)
-TArray<FDieg_InventorySlot*> UDieg_InventoryComponent::FindRootSlotByItemType(const UDieg_ItemInstance* ItemToCheck)
+// Finds root slots matching the same item type
+TArray<FDieg_InventorySlot> UDieg_InventoryComponent::FindRootSlotByItemType(const UDieg_ItemInstance* ItemToCheck) const
 {
-	TSet<FDieg_InventorySlot*> InventorySlotsFound;
-	for (FDieg_InventorySlot& InventorySlot : InventorySlots)
+	TArray<FDieg_InventorySlot> InventorySlotsFound;
+	if (!ItemToCheck)
 	{
-		if (InventorySlot.IsOccupied() && InventorySlot.IsRootSlot() && InventorySlot.ItemInstance->IsEqual(ItemToCheck))
+		return InventorySlotsFound;
+	}
+
+	if (const TArray<FIntPoint>* RootCoordinates = StackIndex.Find(ItemToCheck->GetItemDefinitionDataAsset()))
+	{
+		for (const FIntPoint& RootCoordinate : *RootCoordinates)
 		{
-			InventorySlotsFound.Add(&InventorySlot);
+			const UDieg_ItemInstance* RootItem = GetRootItem(RootCoordinate);
+			if (IsValid(RootItem) && RootItem->IsEqual(ItemToCheck))
+			{
+				InventorySlotsFound.Add(SlotStorage.MakeSlot(SlotStorage.GetIndex(RootCoordinate)));
+			}
 		}
 	}
-	return InventorySlotsFound.Array();
+	return InventorySlotsFound;
 }
 
-// Finds root slots matching the same item type - Blueprint version (returns structs by value)
-TArray<FDieg_InventorySlot> UDieg_InventoryComponent::FindRootSlotByItemTypeBP(const UDieg_ItemInstance* ItemToCheck)
+bool UDieg_InventoryComponent::DoesInventoryContainItem(const UDieg_ItemInstance* ItemToCheck)
 {
-	TArray<FDieg_InventorySlot*> PointerArray = FindRootSlotByItemType(ItemToCheck);
-	TArray<FDieg_InventorySlot> StructArray;
-	for (FDieg_InventorySlot* SlotPtr : PointerArray)
+	if (!ItemToCheck)
 	{
-		StructArray.Add(*SlotPtr);
+		return false;
 	}
-	return StructArray;
-}
 
-// Finds root slots containing a specific instance - C++ version (returns pointers)
-TArray<FDieg_InventorySlot*> UDieg_InventoryComponent::FindRootSlotByInstance(const UDieg_ItemInstance* ItemToCheck)
-{
-	TSet<FDieg_InventorySlot*> InventorySlotsFound;
-	for (FDieg_InventorySlot& InventorySlot : InventorySlots)
+	if (const TArray<FIntPoint>* RootCoordinates = StackIndex.Find(ItemToCheck->GetItemDefinitionDataAsset()))
 	{
-		if (InventorySlot.IsOccupied() && InventorySlot.IsRootSlot() && InventorySlot.ItemInstance == ItemToCheck)
+		for (const FIntPoint& RootCoordinate : *RootCoordinates)
 		{
-			InventorySlotsFound.Add(&InventorySlot);
+			const UDieg_ItemInstance* RootItem = GetRootItem(RootCoordinate);
+			if (IsValid(RootItem) && RootItem->IsEqual(ItemToCheck))
+			{
+				return true;
+			}
 		}
 	}
-	return InventorySlotsFound.Array();
+	return false;
+}
+
+TArray<FDieg_InventorySlot> UDieg_InventoryComponent::FindRootSlotByItemTypeBP(const UDieg_ItemInstance* ItemToCheck)
+{
+	return FindRootSlotByItemType(ItemToCheck);
+}
+
+// Finds the root slot containing a specific instance
+TArray<FDieg_InventorySlot> UDieg_InventoryComponent::FindRootSlotByInstance(const UDieg_ItemInstance* ItemToCheck) const
+{
+	TArray<FDieg_InventorySlot> InventorySlotsFound;
+	const int32 Handle = SlotStorage.FindHandle(ItemToCheck);
+	if (Handle != INDEX_NONE)
+	{
+		InventorySlotsFound.Add(SlotStorage.MakeSlot(SlotStorage.GetStoredItem(Handle).RootIndex));
+	}
+	return InventorySlotsFound;
 }
 
-// Finds root slots containing a specific instance - Blueprint version (returns structs by value)
 TArray<FDieg_InventorySlot> UDieg_InventoryComponent::FindRootSlotByInstanceBP(const UDieg_ItemInstance* ItemToCheck)
 {
-	TArray<FDieg_InventorySlot*> PointerArray = FindRootSlotByInstance(ItemToCheck);
-	TArray<FDieg_InventorySlot> StructArray;
-	for (FDieg_InventorySlot* SlotPtr : PointerArray)
+	return FindRootSlotByInstance(ItemToCheck);
+}
+
+UDieg_ItemInstance* UDieg_InventoryComponent::GetRootItem(const FIntPoint& SlotCoordinates) const
+{
+	if (!Occupancy.IsInBounds(SlotCoordinates))
 	{
-		StructArray.Add(*SlotPtr);
+		return nullptr;
 	}
-	return StructArray;
+	const int32 Index = SlotStorage.GetIndex(SlotCoordinates);
+	return SlotStorage.IsRoot(Index) ? SlotStorage.GetItem(Index) : nullptr;
 }
 
-FDieg_InventorySlot* UDieg_InventoryComponent::GetRootSlot(const FIntPoint& SlotCoordinates)
+bool UDieg_InventoryComponent::GetRootSlot(const FIntPoint& SlotCoordinates, FDieg_InventorySlot& SlotOut) const
 {
-	if (FDieg_InventorySlot* Slot = InventorySlots.FindByPredicate([&](const FDieg_InventorySlot& S){
-		return S.Coordinates == SlotCoordinates && S.RootSlot == SlotCoordinates;
-	}))
+	if (!GetRootItem(SlotCoordinates))
 	{
-		return Slot;
+		return false;
 	}
-	return nullptr;
+	SlotOut = SlotStorage.MakeSlot(SlotStorage.GetIndex(SlotCoordinates));
+	return true;
 }
 
 FDieg_InventorySlot UDieg_InventoryComponent::GetRootSlotBP(const FIntPoint& SlotCoordinates)
 {
-	FDieg_InventorySlot* SlotPtr = GetRootSlot(SlotCoordinates);
-	return SlotPtr ? *SlotPtr : FDieg_InventorySlot();
+	FDieg_InventorySlot Slot;
+	GetRootSlot(SlotCoordinates, Slot);
+	return Slot;
 }
 
-FDieg_InventorySlot* UDieg_InventoryComponent::GetSlot(const FIntPoint& SlotCoordinates)
+bool UDieg_InventoryComponent::GetSlot(const FIntPoint& SlotCoordinates, FDieg_InventorySlot& SlotOut) const
 {
-	if (FDieg_InventorySlot* Slot = InventorySlots.FindByPredicate([&](const FDieg_InventorySlot& S){
-		return S.Coordinates == SlotCoordinates;
-	}))
+	// Slots are stored in grid index order, so coordinates map straight to their index
+	if (!Occupancy.IsInBounds(SlotCoordinates))
 	{
-		return Slot;
+		return false;
 	}
-	return nullptr;
+	SlotOut = SlotStorage.MakeSlot(SlotStorage.GetIndex(SlotCoordinates));
+	return true;
 }
 
 FDieg_InventorySlot UDieg_InventoryComponent::GetSlotBP(const FIntPoint& SlotCoordinates)
 {
-	FDieg_InventorySlot* SlotPtr = GetSlot(SlotCoordinates);
-	return SlotPtr ? *SlotPtr : FDieg_InventorySlot();
+	FDieg_InventorySlot Slot;
+	GetSlot(SlotCoordinates, Slot);
+	return Slot;
+}
+
+bool UDieg_InventoryComponent::SetSlotTags(const FIntPoint& SlotCoordinates, const FGameplayTagContainer& Tags)
+{
+	if (!Occupancy.IsInBounds(SlotCoordinates))
+	{
+		return false;
+	}
+	SlotStorage.SetTags(SlotStorage.GetIndex(SlotCoordinates), Tags);
+	SlotsVersion++;
+	return true;
+}
+
+float UDieg_InventoryComponent::GetStorageBytesPerSlot() const
+{
+	if (SlotStorage.Num() == 0)
+	{
+		return 0.0f;
+	}
+	return static_cast<float>(SlotStorage.GetAllocatedSize()) / SlotStorage.Num();
 }
 
 // Checks if an item shape can fit starting from given slot
@@ -391,27 +647,55 @@ bool UDieg_InventoryComponent::CanAddItemToSlot(const FIntPoint& SlotCoordinates
                                                 const FIntPoint& ItemShapeRoot,
                                                 int32& RotationUsedOut)
 {
-	// Test default rotation first
-	TArray<FIntPoint> EmptyIgnore;
-	FIntPoint DefaultCoordsRoot;
-	const TArray<FIntPoint> DefaultCoords = GetRelevantCoordinates(SlotCoordinates, ItemShape, ItemShapeRoot, ItemRotationPriority, DefaultCoordsRoot);
-	if (DefaultCoords.Contains(SlotCoordinates) && AreSlotsAvailable(DefaultCoords, EmptyIgnore))
+	// Arbitrary shapes have no data asset cache, bake them here. Default rotation first, then the others
+	TArray<FDieg_RotatedShape, TInlineAllocator<4>> RotatedShapes;
+	TArray<const FDieg_RotatedShape*, TInlineAllocator<4>> Shapes;
+	RotatedShapes.Add(FDieg_RotatedShape::Build(ItemShape, ItemShapeRoot, ItemRotationPriority));
+	for (const int32 TestAngle : { 0, 90, 180, -90 })
 	{
-		RotationUsedOut = ItemRotationPriority;
-		return true;
+		if (TestAngle != ItemRotationPriority)
+		{
+			RotatedShapes.Add(FDieg_RotatedShape::Build(ItemShape, ItemShapeRoot, TestAngle));
+		}
+	}
+	for (const FDieg_RotatedShape& RotatedShape : RotatedShapes)
+	{
+		Shapes.Add(&RotatedShape);
+	}
+
+	return DoesAnyShapeFit(Shapes, SlotCoordinates, RotationUsedOut);
+}
+
+void UDieg_InventoryComponent::GetPlacementShapes(const UDieg_ItemDefinitionDataAsset* ItemDataAsset,
+	TArray<const FDieg_RotatedShape*, TInlineAllocator<4>>& ShapesOut) const
+{
+	ShapesOut.Reset();
+	if (!ItemDataAsset)
+	{
+		return;
 	}
 
-	// Test other rotations
-	const TArray<int32> PossibleRotations = { 0, 90, 180, -90 };
-	for (int32 TestAngle : PossibleRotations)
+	ShapesOut.Add(&ItemDataAsset->GetRotatedShape(ItemRotationPriority));
+	for (const int32 TestAngle : { 0, 90, 180, -90 })
 	{
-		if (TestAngle == ItemRotationPriority) continue;
+		if (TestAngle != ItemRotationPriority)
+		{
+			ShapesOut.Add(&ItemDataAsset->GetRotatedShape(TestAngle));
+		}
+	}
+}
 
-		FIntPoint TestCoordsRoot;
-		TArray<FIntPoint> TestCoords = GetRelevantCoordinates(SlotCoordinates, ItemShape, ItemShapeRoot, TestAngle, TestCoordsRoot);
-		if (TestCoords.Contains(SlotCoordinates) && AreSlotsAvailable(TestCoords, EmptyIgnore))
+bool UDieg_InventoryComponent::DoesAnyShapeFit(TConstArrayView<const FDieg_RotatedShape*> Shapes,
+	const FIntPoint& SlotCoordinates, int32& RotationUsedOut) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FitTest);
+
+	for (const FDieg_RotatedShape* Shape : Shapes)
+	{
+		// The rotated shape has to cover the slot it starts from
+		if (Shape->Mask.bContainsOrigin && Occupancy.DoesMaskFit(Shape->Mask, SlotCoordinates))
 		{
-			RotationUsedOut = TestAngle;
+			RotationUsedOut = Shape->Rotation;
 			return true;
 		}
 	}
@@ -419,35 +703,166 @@ bool UDieg_InventoryComponent::CanAddItemToSlot(const FIntPoint& SlotCoordinates
 	return false;
 }
 
-bool UDieg_InventoryComponent::CanAddItemInstanceToSlot(const FIntPoint& SlotCoordinates, UDieg_ItemInstance* ItemInstance,
-	int32 Rotation)
+bool UDieg_InventoryComponent::FindFirstFit(TConstArrayView<const FDieg_RotatedShape*> Shapes,
+	FIntPoint& SlotCoordinatesOut, int32& RotationUsedOut) const
 {
-	TArray<FIntPoint> EmptyIgnore;
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FindFirstFit);
 
-	const FDieg_ItemDefinition& ItemDefinition = ItemInstance->GetItemDefinition();
-	
-	// Test default rotation first
-	FIntPoint DefaultCoordsRoot;
-	const TArray<FIntPoint> DefaultCoords = GetRelevantCoordinates(SlotCoordinates, ItemDefinition.DefaultShape, ItemDefinition.DefaultShapeRoot, Rotation, DefaultCoordsRoot);
-	if (DefaultCoords.Contains(SlotCoordinates) && AreSlotsAvailable(DefaultCoords, EmptyIgnore))
+	for (int32 Index = 0; Index < SlotStorage.Num(); Index++)
 	{
-		return true;
+		const FIntPoint Coordinates = SlotStorage.GetCoordinates(Index);
+		for (const FDieg_RotatedShape* Shape : Shapes)
+		{
+			if (Shape->Mask.bContainsOrigin && Occupancy.DoesMaskFit(Shape->Mask, Coordinates))
+			{
+				SlotCoordinatesOut = Coordinates;
+				RotationUsedOut = Shape->Rotation;
+				return true;
+			}
+		}
 	}
 
 	return false;
 }
 
+bool UDieg_InventoryComponent::FindMaxRectsFit(TConstArrayView<const FDieg_RotatedShape*> Shapes,
+	FIntPoint& SlotCoordinatesOut, int32& RotationUsedOut) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FindPlacement);
+
+	int32 Candidates = 0;
+	int32 BestShortSide = MAX_int32;
+	int32 BestLongSide = MAX_int32;
+	bool bFound = false;
+
+	for (const FIntRect& FreeRect : Occupancy.GetMaximalFreeRects())
+	{
+		const FIntPoint FreeSize = FreeRect.Size();
+		for (const FDieg_RotatedShape* Shape : Shapes)
+		{
+			const FIntPoint& Span = Shape->Mask.Span;
+			if (!Shape->Mask.bContainsOrigin || Span.X > FreeSize.X || Span.Y > FreeSize.Y)
+			{
+				continue;
+			}
+
+			// Bounding box in the rectangle's corner, every cell under it is free
+			const FIntPoint Coordinates = FreeRect.Min - Shape->Mask.Min;
+			if (!Occupancy.DoesMaskFit(Shape->Mask, Coordinates))
+			{
+				continue;
+			}
+			++Candidates;
+
+			// Best short side fit, then best long side fit. Strictly better, so ties keep rectangle and rotation order
+			const int32 ShortSide = FMath::Min(FreeSize.X - Span.X, FreeSize.Y - Span.Y);
+			const int32 LongSide = FMath::Max(FreeSize.X - Span.X, FreeSize.Y - Span.Y);
+			if (!bFound || ShortSide < BestShortSide || (ShortSide == BestShortSide && LongSide < BestLongSide))
+			{
+				BestShortSide = ShortSide;
+				BestLongSide = LongSide;
+				SlotCoordinatesOut = Coordinates;
+				RotationUsedOut = Shape->Rotation;
+				bFound = true;
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_Dieg_PlacementsScored, Candidates);
+
+	// Irregular shapes can interlock with items without their bounding box fitting a free rectangle
+	return bFound || FindFirstFit(Shapes, SlotCoordinatesOut, RotationUsedOut);
+}
+
+bool UDieg_InventoryComponent::FindPlacement(TConstArrayView<const FDieg_RotatedShape*> Shapes,
+	FIntPoint& SlotCoordinatesOut, int32& RotationUsedOut) const
+{
+	if (PlacementStrategy == EDieg_PlacementStrategy::FirstFit)
+	{
+		return FindFirstFit(Shapes, SlotCoordinatesOut, RotationUsedOut);
+	}
+	if (PlacementStrategy == EDieg_PlacementStrategy::MaxRects)
+	{
+		return FindMaxRectsFit(Shapes, SlotCoordinatesOut, RotationUsedOut);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FindPlacement);
+
+	int32 Candidates = 0;
+	int64 BestScore = MIN_int64;
+	bool bFound = false;
+
+	for (int32 Index = 0; Index < SlotStorage.Num(); Index++)
+	{
+		const FIntPoint Coordinates = SlotStorage.GetCoordinates(Index);
+		for (const FDieg_RotatedShape* Shape : Shapes)
+		{
+			if (!Shape->Mask.bContainsOrigin || !Occupancy.DoesMaskFit(Shape->Mask, Coordinates))
+			{
+				continue;
+			}
+			++Candidates;
+
+			// Strictly greater, so ties keep grid order and rotation priority
+			const int64 Score = ScorePlacement(PlacementStrategy, *Shape, Coordinates);
+			if (!bFound || Score > BestScore)
+			{
+				BestScore = Score;
+				SlotCoordinatesOut = Coordinates;
+				RotationUsedOut = Shape->Rotation;
+				bFound = true;
+			}
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_Dieg_PlacementsScored, Candidates);
+	return bFound;
+}
+
+int64 UDieg_InventoryComponent::ScorePlacement(const EDieg_PlacementStrategy Strategy, const FDieg_RotatedShape& Shape,
+	const FIntPoint& SlotCoordinates) const
+{
+	const FIntPoint Origin = SlotCoordinates + Shape.Mask.Min;
+	switch (Strategy)
+	{
+	case EDieg_PlacementStrategy::BottomLeftSkyline:
+		{
+			// Lowest bottom edge first, then left-most
+			const int64 Bottom = Origin.Y + Shape.Mask.Span.Y;
+			return -(Bottom * Occupancy.GetColumns() + Origin.X);
+		}
+	case EDieg_PlacementStrategy::MinFragmentation:
+		{
+			// Edges touching items or the border can't become isolated gaps
+			return Occupancy.CountContactEdges(Shape.Mask, SlotCoordinates);
+		}
+	case EDieg_PlacementStrategy::FirstFit:
+	default:
+		return 0;
+	}
+}
+
+bool UDieg_InventoryComponent::CanAddItemInstanceToSlot(const FIntPoint& SlotCoordinates, UDieg_ItemInstance* ItemInstance,
+	int32 Rotation)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FitTest);
+
+	// Only the requested rotation, it has to cover the slot it starts from
+	const FDieg_RotatedShape& RotatedShape = ItemInstance->GetItemDefinitionDataAsset()->GetRotatedShape(Rotation);
+	return RotatedShape.Mask.bContainsOrigin && Occupancy.DoesMaskFit(RotatedShape.Mask, SlotCoordinates);
+}
+
 
 // Checks if all given slots are available (optionally ignoring some)
 bool UDieg_InventoryComponent::AreSlotsAvailable(const TArray<FIntPoint>& InputShape, const TArray<FIntPoint>& Ignore)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FitTest);
+
 	for (const FIntPoint& Point : InputShape)
 	{
 		if (!Ignore.IsEmpty() && Ignore.Contains(Point)) continue;
 
-		if (IsSlotPointOutOfBounds(Point)) return false;
-
-		if (IsSlotPointOccupied(Point)) return false; // Slot already occupied
+		if (!Occupancy.IsAvailable(Point)) return false; // Out of bounds or already occupied
 	}
 
 	return true;
@@ -455,102 +870,210 @@ bool UDieg_InventoryComponent::AreSlotsAvailable(const TArray<FIntPoint>& InputS
 
 bool UDieg_InventoryComponent::AreSlotsAvailableSimple(const TArray<FIntPoint>& InputShape)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FitTest);
+
 	for (const FIntPoint& Point : InputShape)
 	{
-		if (IsSlotPointOutOfBounds(Point)) return false;
-
-		if (IsSlotPointOccupied(Point)) return false; // Slot already occupied
+		if (!Occupancy.IsAvailable(Point)) return false; // Out of bounds or already occupied
 	}
 
 	return true;
 }
 
 // Places an item into inventory and sets root/rotation
-FDieg_InventorySlot* UDieg_InventoryComponent::AddItemToInventory(UDieg_ItemInstance* ItemToAdd, const FIntPoint& SlotCoordinates, const float RotationUsed)
+bool UDieg_InventoryComponent::AddItemToInventory(UDieg_ItemInstance* ItemToAdd, const FIntPoint& SlotCoordinates, const float RotationUsed)
 {
 	FString TempName = this->GetOwner()->GetActorNameOrLabel().Append(" " + this->GetName());
 	
-	// Get rotated coordinates and root
-	const TArray<FIntPoint> Shape = ItemToAdd->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShape;
-	const FIntPoint ShapeRoot = ItemToAdd->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShapeRoot;
-	FIntPoint RotatedShapeRoot;
-	TArray<FIntPoint> RotatedShapeCoordinates = GetRelevantCoordinates(SlotCoordinates, Shape, ShapeRoot, RotationUsed, RotatedShapeRoot);
-
+	const UDieg_ItemDefinitionDataAsset* ItemDataAsset = ItemToAdd->GetItemDefinitionDataAsset();
 	if (bDebugLogs)
 	{
 		UPlugInv_DoubleLogger::Log(5.0f, TEXT("AddItemToInventory in {0}. Item Name: {1}, Slot Coordinates: {2}, Rotation Used: {3}, Rotated Shape Root: {4}"),
-		FColor::Turquoise, TempName, ItemToAdd->GetItemDefinition().Name.ToString(), SlotCoordinates, RotationUsed, RotatedShapeRoot);
+		FColor::Turquoise, TempName, ItemToAdd->GetItemDefinition().Name.ToString(), SlotCoordinates, RotationUsed,
+		ItemDataAsset->GetRotatedShape(RotationUsed).Root + SlotCoordinates);
 	}
 
 	// Safety check: cannot place
 	int32 AssertRotation = 0;
-	if (!CanAddItemToSlot(SlotCoordinates, Shape, ShapeRoot, AssertRotation))
+	TArray<const FDieg_RotatedShape*, TInlineAllocator<4>> Shapes;
+	GetPlacementShapes(ItemDataAsset, Shapes);
+	if (!DoesAnyShapeFit(Shapes, SlotCoordinates, AssertRotation))
 	{
 		checkNoEntry();
-		return nullptr;
+		return false;
 	}
 
-	// Fill all slots with item instance
-	for (const FIntPoint& Coord : RotatedShapeCoordinates)
+	const FIntPoint RootSlot = PlaceItem(ItemToAdd, SlotCoordinates, RotationUsed);
+	RecordChange(EDieg_InventoryChangeType::Add, ItemToAdd, RootSlot, RotationUsed);
+
+	return true;
+}
+
+bool UDieg_InventoryComponent::RemoveItemFromInventory(UDieg_ItemInstance* ItemToRemove)
+{
+	if (!IsValid(ItemToRemove))
 	{
-		if (FDieg_InventorySlot* Slot = InventorySlots.FindByPredicate([&](const FDieg_InventorySlot& S) { return S.Coordinates == Coord; }))
+		return false;
+	}
+
+	const int32 Handle = SlotStorage.FindHandle(ItemToRemove);
+	if (Handle == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FDieg_StoredItem& StoredItem = SlotStorage.GetStoredItem(Handle);
+	const FIntPoint RootSlot = SlotStorage.GetCoordinates(StoredItem.RootIndex);
+	const float Rotation = StoredItem.GetRotation();
+	UnplaceItem(Handle);
+	RecordChange(EDieg_InventoryChangeType::Remove, ItemToRemove, RootSlot, Rotation);
+
+	return true;
+}
+
+bool UDieg_InventoryComponent::MoveItem(UDieg_ItemInstance* ItemToMove, const FIntPoint& SlotCoordinates, const float Rotation)
+{
+	const int32 Handle = SlotStorage.FindHandle(ItemToMove);
+	if (Handle == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FDieg_StoredItem& StoredItem = SlotStorage.GetStoredItem(Handle);
+	const FIntPoint PreviousRootSlot = SlotStorage.GetCoordinates(StoredItem.RootIndex);
+	const float PreviousRotation = StoredItem.GetRotation();
+	const FDieg_RotatedShape& PreviousShape = ItemToMove->GetItemDefinitionDataAsset()->GetRotatedShape(PreviousRotation);
+	const FIntPoint PreviousSlotCoordinates = PreviousRootSlot - PreviousShape.Root;
+
+	// Lift the item so its own slots don't block the new placement, put it back if it doesn't fit
+	UnplaceItem(Handle);
+	if (!CanAddItemInstanceToSlot(SlotCoordinates, ItemToMove, FMath::RoundToInt(Rotation)))
+	{
+		PlaceItem(ItemToMove, PreviousSlotCoordinates, PreviousRotation);
+		return false;
+	}
+
+	const FIntPoint RootSlot = PlaceItem(ItemToMove, SlotCoordinates, Rotation);
+	const bool bRotated = FDieg_RotatedShape::GetRotationIndex(Rotation) != FDieg_RotatedShape::GetRotationIndex(PreviousRotation);
+	RecordChange(bRotated ? EDieg_InventoryChangeType::Rotate : EDieg_InventoryChangeType::Move, ItemToMove, RootSlot,
+		Rotation, PreviousRootSlot);
+
+	return true;
+}
+
+FIntPoint UDieg_InventoryComponent::PlaceItem(UDieg_ItemInstance* ItemToAdd, const FIntPoint& SlotCoordinates, const float Rotation)
+{
+	const UDieg_ItemDefinitionDataAsset* ItemDataAsset = ItemToAdd->GetItemDefinitionDataAsset();
+	const FDieg_RotatedShape& RotatedShape = ItemDataAsset->GetRotatedShape(Rotation);
+	const FIntPoint RotatedShapeRoot = RotatedShape.Root + SlotCoordinates;
+
+	// One item entry, every covered cell points at it
+	const int32 Handle = SlotStorage.AddItem(ItemToAdd, SlotStorage.GetIndex(RotatedShapeRoot), Rotation);
+	for (const FIntPoint& Cell : RotatedShape.Cells)
+	{
+		const FIntPoint Coord = Cell + SlotCoordinates;
+		if (Occupancy.IsInBounds(Coord))
 		{
 			if (bDebugLogs)
-				UPlugInv_DoubleLogger::Log(5.0f, TEXT("Setting Inventory Slots in AddItemToInventory in {0}. Item Name: {1}, Slot Coordinates: {2}, Rotation Used: {3}, Root Slot: {4}"),
-			FColor::Green, TempName, ItemToAdd->GetItemDefinition().Name.ToString(), Coord, RotationUsed, RotatedShapeRoot);
+				UPlugInv_DoubleLogger::Log(5.0f, TEXT("Setting Inventory Slots in PlaceItem in {0}. Item Name: {1}, Slot Coordinates: {2}, Rotation Used: {3}, Root Slot: {4}"),
+			FColor::Green, GetOwner()->GetActorNameOrLabel().Append(" " + GetName()), ItemToAdd->GetItemDefinition().Name.ToString(), Coord, Rotation, RotatedShapeRoot);
 			
-			Slot->ItemInstance = ItemToAdd;
-			Slot->Rotation = RotationUsed;
-			Slot->RootSlot = RotatedShapeRoot;
-			SlotsOccupation.FindChecked(Coord) = true;
+			SlotStorage.SetCell(SlotStorage.GetIndex(Coord), Handle);
+			Occupancy.SetOccupied(Coord, true);
 		}
 	}
 
-	// Return the root slot
-	return InventorySlots.FindByPredicate([&](const FDieg_InventorySlot& S) { return S.IsRootSlot(); });
+	StackIndex.FindOrAdd(ItemDataAsset).Add(RotatedShapeRoot);
+	SlotsVersion++;
+
+	return RotatedShapeRoot;
 }
 
-FDieg_InventorySlot* UDieg_InventoryComponent::RemoveItemFromInventory(UDieg_ItemInstance* ItemToRemove)
+void UDieg_InventoryComponent::UnplaceItem(const int32 Handle)
 {
-	if (!IsValid(ItemToRemove))
+	// Clear the cells of the item's shape, placed so that its root lands on the stored root
+	const FDieg_StoredItem& StoredItem = SlotStorage.GetStoredItem(Handle);
+	const FIntPoint RootCoordinates = SlotStorage.GetCoordinates(StoredItem.RootIndex);
+	const UDieg_ItemDefinitionDataAsset* ItemDataAsset = StoredItem.ItemInstance->GetItemDefinitionDataAsset();
+	const FDieg_RotatedShape& RotatedShape = ItemDataAsset->GetRotatedShape(StoredItem.GetRotation());
+	const FIntPoint SlotCoordinates = RootCoordinates - RotatedShape.Root;
+	for (const FIntPoint& Cell : RotatedShape.Cells)
 	{
-		return nullptr;
+		const FIntPoint Coord = Cell + SlotCoordinates;
+		if (Occupancy.IsInBounds(Coord) && SlotStorage.GetHandle(SlotStorage.GetIndex(Coord)) == Handle)
+		{
+			SlotStorage.SetCell(SlotStorage.GetIndex(Coord), INDEX_NONE);
+			Occupancy.SetOccupied(Coord, false);
+		}
 	}
+	SlotStorage.RemoveItem(Handle);
+	SlotsVersion++;
 
-	FDieg_InventorySlot* RootSlot = nullptr;
-
-	// Iterate all slots and clear those that contain this item
-	for (FDieg_InventorySlot& Slot : InventorySlots)
+	if (TArray<FIntPoint>* RootCoordinatesFound = StackIndex.Find(ItemDataAsset))
 	{
-		if (Slot.ItemInstance == ItemToRemove)
+		RootCoordinatesFound->RemoveSingleSwap(RootCoordinates);
+		if (RootCoordinatesFound->IsEmpty())
 		{
-			// Capture root slot for return
-			if (Slot.IsRootSlot())
-			{
-				RootSlot = &Slot;
-			}
-
-			// Clear slot
-			Slot.ItemInstance = nullptr;
-			Slot.Rotation = 0.0f;
-			Slot.RootSlot = FIntPoint(-1, -1);
-			SlotsOccupation.FindChecked(Slot.Coordinates) = false;
+			StackIndex.Remove(ItemDataAsset);
 		}
 	}
+}
+
+void UDieg_InventoryComponent::RecordChange(const EDieg_InventoryChangeType Type, UDieg_ItemInstance* ItemInstance,
+	const FIntPoint& RootSlot, const float Rotation, const FIntPoint& PreviousRootSlot)
+{
+	FDieg_InventoryChange& Change = ChangeJournal.AddDefaulted_GetRef();
+	Change.Version = ++ChangeVersion;
+	Change.Type = Type;
+	Change.ItemInstance = ItemInstance;
+	Change.RootSlot = RootSlot;
+	Change.PreviousRootSlot = PreviousRootSlot;
+	Change.Rotation = Rotation;
+	Change.Quantity = ItemInstance ? ItemInstance->GetQuantity() : 0;
+
+	// Trim in chunks so dropping old entries stays amortized O(1) per change
+	const int32 MaxEntries = FMath::Max(MaxChangeJournalEntries, 1);
+	if (ChangeJournal.Num() >= MaxEntries * 2)
+	{
+		const int32 ToDrop = ChangeJournal.Num() - MaxEntries;
+		ChangeJournal.RemoveAt(0, ToDrop, EAllowShrinking::No);
+		JournalBaseVersion += ToDrop;
+	}
+}
+
+bool UDieg_InventoryComponent::GetChangesSince(const int32 Version, TArray<FDieg_InventoryChange>& ChangesOut) const
+{
+	ChangesOut.Reset();
+	if (Version < JournalBaseVersion || Version > ChangeVersion)
+	{
+		return false;
+	}
 
-	return RootSlot; // Return root slot if found, else nullptr
+	// Versions are contiguous, the first change after Version sits at a fixed offset
+	const int32 FirstIndex = Version - JournalBaseVersion;
+	ChangesOut.Append(ChangeJournal.GetData() + FirstIndex, ChangeJournal.Num() - FirstIndex);
+	return true;
 }
 
 FDieg_InventorySlot UDieg_InventoryComponent::AddItemToInventoryBP(UDieg_ItemInstance* ItemToAdd, const FIntPoint& SlotCoordinates, const float RotationUsed)
 {
-	FDieg_InventorySlot* SlotPtr = AddItemToInventory(ItemToAdd, SlotCoordinates, RotationUsed);
-	return SlotPtr ? *SlotPtr : FDieg_InventorySlot();
+	FDieg_InventorySlot RootSlot;
+	if (AddItemToInventory(ItemToAdd, SlotCoordinates, RotationUsed))
+	{
+		GetRootSlot(ItemToAdd->GetItemDefinitionDataAsset()->GetRotatedShape(RotationUsed).Root + SlotCoordinates, RootSlot);
+	}
+	return RootSlot;
 }
 
 FDieg_InventorySlot UDieg_InventoryComponent::RemoveItemFromInventoryBP(UDieg_ItemInstance* ItemToRemove)
 {
-	FDieg_InventorySlot* SlotPtr = RemoveItemFromInventory(ItemToRemove);
-	return SlotPtr ? *SlotPtr : FDieg_InventorySlot();
+	// Capture the root slot while the item is still placed
+	TArray<FDieg_InventorySlot> RootSlots = FindRootSlotByInstance(ItemToRemove);
+	if (RootSlots.IsEmpty() || !RemoveItemFromInventory(ItemToRemove))
+	{
+		return FDieg_InventorySlot();
+	}
+	return RootSlots[0];
 }
 
 // Returns all coordinates occupied by an item relative to a slot and rotation
@@ -568,53 +1091,39 @@ TArray<FIntPoint> UDieg_InventoryComponent::GetRelevantCoordinates(const FIntPoi
 TArray<FIntPoint> UDieg_InventoryComponent::GetRelevantItems(const TArray<FIntPoint>& ShapeCoordinates,
 	const UDieg_ItemInstance* ItemInstance)
 {
-	TSet<FIntPoint> Result;
-
-	// Convert input shape coordinates to a set for fast intersection checks
-	TSet<FIntPoint> InputCoordinates;
-	InputCoordinates.Append(ShapeCoordinates);
+	TArray<FIntPoint> Result;
+	if (!IsValid(ItemInstance))
+	{
+		return Result;
+	}
 
-	// Iterate all inventory slots
-	for (int32 i = 0; i < InventorySlots.Num(); i++)
+	// Each covered cell leads straight to its item's handle, a shape only ever touches a few items
+	TArray<int32, TInlineAllocator<8>> VisitedHandles;
+	for (const FIntPoint& Coordinates : ShapeCoordinates)
 	{
-		const int32 CurrentIndex = i;
-		FDieg_InventorySlot& CurrentSlot = InventorySlots[CurrentIndex];
-		
-		if (!CurrentSlot.IsOccupied())
+		if (!Occupancy.IsInBounds(Coordinates))
 		{
 			continue;
 		}
 
-		// Compute all coordinates occupied by this item instance in inventory
-		FIntPoint CurrentSlotRoot;
-		TSet<FIntPoint> CurrentInventoryItemCoordinates;
-		TArray<FIntPoint> CurrentRelevantCoordinates = GetRelevantCoordinates(
-			CurrentSlot.Coordinates,
-			CurrentSlot.ItemInstance->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShape,
-			CurrentSlot.ItemInstance->GetItemDefinitionDataAsset()->ItemDefinition.DefaultShapeRoot, 
-			CurrentSlot.Rotation, 
-			CurrentSlotRoot
-		);
-		CurrentInventoryItemCoordinates.Append(CurrentRelevantCoordinates);
-
-		// Check if this item instance matches the one we're searching for,
-		// has available quantity space, and overlaps input coordinates
-		bool bIsSameAndHasQuantitySpace = false;
-		if (CurrentSlot.ItemInstance->IsEqual(ItemInstance) 
-			&& CurrentSlot.ItemInstance->GetQuantity() != ItemInstance->GetQuantity()
-			&& InputCoordinates.Intersect(CurrentInventoryItemCoordinates).IsEmpty() == false)
+		const int32 Handle = SlotStorage.GetHandle(SlotStorage.GetIndex(Coordinates));
+		if (Handle == INDEX_NONE || VisitedHandles.Contains(Handle))
 		{
-			bIsSameAndHasQuantitySpace = true;
+			continue;
 		}
+		VisitedHandles.Add(Handle);
 
-		// If conditions met, add the slot index to result
-		if (bIsSameAndHasQuantitySpace)
+		// Same item type with room left in its stack
+		const FDieg_StoredItem& CurrentItem = SlotStorage.GetStoredItem(Handle);
+		const int32 MaxStack = CurrentItem.ItemInstance->GetItemDefinitionDataAsset()->ItemDefinition.StackSizeMax;
+		if (CurrentItem.ItemInstance != ItemInstance && CurrentItem.ItemInstance->GetQuantity() < MaxStack
+			&& CurrentItem.ItemInstance->CanStackWith(ItemInstance))
 		{
-			Result.Add(CurrentSlot.RootSlot);
+			Result.Add(SlotStorage.GetCoordinates(CurrentItem.RootIndex));
 		}
 	}
-	
-	return Result.Array(); // Return all slot indices with matching items and overlapping coordinates
+
+	return Result;
 }
 
 
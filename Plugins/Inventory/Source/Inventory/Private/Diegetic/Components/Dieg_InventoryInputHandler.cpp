@@ -4,19 +4,28 @@
 #include "Diegetic/Components/Dieg_InventoryInputHandler.h"
 
 #include "BPF_PlugInv_DoubleLogger.h"
+#include "Inventory.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/WidgetComponent.h"
 #include "Diegetic/Dieg_PlayerController.h"
 #include "Diegetic/Dieg_UtilityLibrary.h"
 #include "Diegetic/Actors/Dieg_Briefcase.h"
 #include "Diegetic/Actors/Dieg_WorldItemActor.h"
+#include "Diegetic/Interfaces/Dieg_DragEventListener.h"
 #include "Diegetic/Components/Dieg_3DInventoryComponent.h"
 #include "Diegetic/Components/Dieg_InventoryComponent.h"
+#include "Diegetic/Subsystems/Dieg_ActorPoolSubsystem.h"
+#include "Diegetic/Subsystems/Dieg_TraceSubsystem.h"
 #include "Diegetic/UObjects/Dieg_ItemInstance.h"
 #include "Diegetic/Widgets/Dieg_Grid.h"
 #include "Diegetic/Widgets/Dieg_Slot.h"
 #include "Kismet/GameplayStatics.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_CYCLE_STAT(TEXT("Start Drag"), STAT_Dieg_StartDrag, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Stop Drag"), STAT_Dieg_StopDrag, STATGROUP_DiegInventory);
 
 
 // Sets default values for this component's properties
@@ -98,24 +107,51 @@ void UDieg_InventoryInputHandler::OpenUserInterface()
 	{
 		const FTransform SpawnTransform = FTransform(RelativeSpawnRotation, RelativeSpawnLocation);
 
-		// Constructor
-		BriefcaseActor = GetWorld()->SpawnActorDeferred<ADieg_Briefcase>(BriefCaseActorClass, SpawnTransform);
-
+		// A briefcase closed earlier keeps its item actors, so it only has to catch up on what changed since
+		UDieg_ActorPoolSubsystem* Pool = UDieg_ActorPoolSubsystem::Get(this);
+		BriefcaseActor = Pool ? Cast<ADieg_Briefcase>(Pool->TryAcquireActor(BriefCaseActorClass)) : nullptr;
 		if (IsValid(BriefcaseActor))
 		{
-			// Safe place to set values BEFORE PreInitializeComponents → PostInitializeComponents → OnConstruction → BeginPlay
 			BriefcaseActor->AttachToActor(OwningPlayerController->GetPawn(), FAttachmentTransformRules::KeepRelativeTransform);
+			BriefcaseActor->SetActorRelativeTransform(SpawnTransform);
 			BriefcaseActor->Initialize(OwningPlayerController->GetInventoryComponent());
+			BriefcaseActor->InventoryComponent3D->SyncItemActors();
+			BriefcaseActor->OpenBriefcase();
+		}
+		else
+		{
+			// Constructor
+			BriefcaseActor = GetWorld()->SpawnActorDeferred<ADieg_Briefcase>(BriefCaseActorClass, SpawnTransform);
 
-			UGameplayStatics::FinishSpawningActor(BriefcaseActor, SpawnTransform);
+			if (IsValid(BriefcaseActor))
+			{
+				// Safe place to set values BEFORE PreInitializeComponents → PostInitializeComponents → OnConstruction → BeginPlay
+				BriefcaseActor->AttachToActor(OwningPlayerController->GetPawn(), FAttachmentTransformRules::KeepRelativeTransform);
+				BriefcaseActor->Initialize(OwningPlayerController->GetInventoryComponent());
+
+				UGameplayStatics::FinishSpawningActor(BriefcaseActor, SpawnTransform);
+			}
 		}
 	}
 
+	// Hover traces come batched while open, ticking only traces when batching is off
+	if (UDieg_TraceSubsystem* TraceSubsystem = UDieg_TraceSubsystem::Get(this); TraceSubsystem && MouseTraceId == INDEX_NONE)
+	{
+		MouseTraceId = TraceSubsystem->RegisterTrace(OwningPlayerController.Get(), EDieg_TraceOrigin::Mouse, ECC_Visibility, TraceLength,
+			FDieg_OnTraceResult::CreateUObject(this, &ThisClass::HandleMouseTraceResult));
+	}
+
 	SetComponentTickEnabled(true);
 }
 
 void UDieg_InventoryInputHandler::CloseUserInterface()
 {
+	if (UDieg_TraceSubsystem* TraceSubsystem = UDieg_TraceSubsystem::Get(this))
+	{
+		TraceSubsystem->UnregisterTrace(MouseTraceId);
+	}
+	MouseTraceId = INDEX_NONE;
+
 	if (OwningPlayerController.IsValid())
 	{
 		OwningPlayerController->SetInputMode(FInputModeGameOnly());
@@ -126,6 +162,13 @@ void UDieg_InventoryInputHandler::CloseUserInterface()
 	if (IsValid(BriefcaseActor))
 	{
 		BriefcaseActor->CloseBriefcase();
+		if (bPoolBriefcase && !BriefcaseActor->IsActorBeingDestroyed())
+		{
+			if (UDieg_ActorPoolSubsystem* Pool = UDieg_ActorPoolSubsystem::Get(this))
+			{
+				Pool->ReleaseActor(BriefcaseActor);
+			}
+		}
 		BriefcaseActor = nullptr;
 
 		OwningPlayerController->SetViewTargetWithBlend(OwningPlayerController.Get()->GetPawn(), 0.625f);
@@ -136,6 +179,12 @@ void UDieg_InventoryInputHandler::CloseUserInterface()
 
 bool UDieg_InventoryInputHandler::LineTraceFromMouse(FHitResult& HitResult) const
 {
+	// No controller or camera yet (handler not begun play), nothing to trace from
+	if (!OwningPlayerController.IsValid() || !OwningPlayerController->PlayerCameraManager)
+	{
+		return false;
+	}
+
 	FVector MouseWorldLocation = FVector::ZeroVector;
 	FVector MouseWorldDirection = FVector::ZeroVector;
 	OwningPlayerController->DeprojectMousePositionToWorld(MouseWorldLocation, MouseWorldDirection);
@@ -146,7 +195,12 @@ bool UDieg_InventoryInputHandler::LineTraceFromMouse(FHitResult& HitResult) cons
 	// LOG_DOUBLE_S(0.5f, FColor::Emerald, "LineTraceFromMouse in {0}. MouseWorldDirection: {1}, TraceStart: {2}, TraceEnd: {3}"
 	// 	,TempName, MouseWorldDirection, TraceStart, TraceEnd);
 	
-	const bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility);
+	bool bHit;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Dieg_SyncTraceTime);
+		INC_DWORD_STAT(STAT_Dieg_SyncTraces);
+		bHit = GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility);
+	}
 
 	if (bDebugDraw)
 	{
@@ -192,16 +246,19 @@ void UDieg_InventoryInputHandler::StartHoverInventory(UDieg_3DInventoryComponent
 		ConnectItemToInventory();
 
 		// Disable all currently placed items' collision.
-		TArray<ADieg_WorldItemActor*> ItemsInInventory = HoveringInventoryComponent3D->GetItems();
-		for (const TWeakObjectPtr<ADieg_WorldItemActor>& ItemActor : ItemsInInventory)
-		{
-			ItemActor->SetActorEnableCollision(false);
-		}
+		HoveringInventoryComponent3D->SetItemCollisionEnabled(false);
 
 		// We don't want now the mouse to change the state so lock the appearance
 		HoveringInventoryComponent3D->GetGridWidget()->ModifyAllSlotsAppearance(true,true, EDieg_SlotStatus::None);
 
-		OnDragHoverInventory.Broadcast(this, HoveringInventoryComponent3D.Get(), DraggingItem.Get(), RelativeCoordinates);
+		if (OnDragHoverInventory.IsBound())
+		{
+			OnDragHoverInventory.Broadcast(this, HoveringInventoryComponent3D.Get(), DraggingItem.Get(), RelativeCoordinates);
+		}
+		if (IDieg_DragEventListener* Listener = GetDragEventListener())
+		{
+			Listener->OnDragHoverEnterInventory(this, HoveringInventoryComponent3D.Get(), RelativeCoordinates);
+		}
 	}
 	else
 	{
@@ -228,20 +285,22 @@ void UDieg_InventoryInputHandler::StopHoverInventory(UDieg_3DInventoryComponent*
 	if (IsDraggingItem())
 	{
 		// Reset old inventory widget's slots
-		const TArray<FIntPoint> Empty;
-		HoveringInventoryComponent3D->GetGridWidget()->UpdateHoveringSlots(Empty,EDieg_SlotStatus::None, EDieg_SlotStatus::None);
+		HoveringInventoryComponent3D->GetGridWidget()->UpdateHoveringCoordinates({}, EDieg_SlotStatus::None, EDieg_SlotStatus::None);
 
 		// Reset item actors rotation to flat, since inventory no longer exists and item is in world
 		DraggingItem->SetActorRotation(FRotator::ZeroRotator);
 
-		// Disable all currently placed items' collision.
-		TArray<ADieg_WorldItemActor*> ItemsInInventory = HoveringInventoryComponent3D->GetItems();
-		for (const TWeakObjectPtr<ADieg_WorldItemActor>& ItemActor : ItemsInInventory)
+		// Enable all currently placed items' collision again.
+		HoveringInventoryComponent3D->SetItemCollisionEnabled(true);
+
+		if (OnDragUnHoverInventory.IsBound())
 		{
-			ItemActor->SetActorEnableCollision(true);
+			OnDragUnHoverInventory.Broadcast(this, HoveringInventoryComponent3D.Get(), DraggingItem.Get(), RelativeCoordinates);
+		}
+		if (IDieg_DragEventListener* Listener = GetDragEventListener())
+		{
+			Listener->OnDragHoverLeaveInventory(this, HoveringInventoryComponent3D.Get(), RelativeCoordinates);
 		}
-
-		OnDragUnHoverInventory.Broadcast(this, HoveringInventoryComponent3D.Get(), DraggingItem.Get(), RelativeCoordinates);
 	}
 	
 }
@@ -275,11 +334,43 @@ void UDieg_InventoryInputHandler::StopHoverItem(ADieg_WorldItemActor* HoveringWo
 	}
 	
 	HoveringItem->Reset();
+
+	// Back to a mesh instance unless it is still in hand
+	if (ItemIsInInventory && DraggingItem.Get() != HoveringWorldItem)
+	{
+		OwningInventory->DemoteItemActor(HoveringWorldItem);
+	}
+}
+
+void UDieg_InventoryInputHandler::HandleMouseTraceResult(const FHitResult& HitResult, const bool bIsBlockingHit)
+{
+	if (bDebugDraw)
+	{
+		DrawDebugLine(GetWorld(), HitResult.TraceStart, HitResult.TraceEnd, bIsBlockingHit ? FColor::Red : FColor::Green, false, 0.5f, 0, 0.1f);
+	}
+
+	// Same as the tick path, misses leave the hover state alone
+	if (bIsBlockingHit && bIsInventoryOpen && OwningPlayerController.IsValid())
+	{
+		HandleTraceHit(HitResult, true);
+	}
 }
 
 void UDieg_InventoryInputHandler::HandleTraceHit(const FHitResult& HitResult, bool bIsBlockingHit)
 {
 	AActor* HitActor = HitResult.GetActor();
+
+	// Items drawn as mesh instances become actors while hovered
+	if (IsValid(HitActor) && !IsDraggingItem() && Cast<UInstancedStaticMeshComponent>(HitResult.GetComponent()))
+	{
+		if (UDieg_3DInventoryComponent* HitInventory = HitActor->FindComponentByClass<UDieg_3DInventoryComponent>())
+		{
+			if (ADieg_WorldItemActor* PromotedItem = HitInventory->PromoteInstancedItem(HitResult.GetComponent(), HitResult.Item))
+			{
+				HitActor = PromotedItem;
+			}
+		}
+	}
 	
 	if (HitActor != LastHitActor)
 	{
@@ -418,18 +509,25 @@ void UDieg_InventoryInputHandler::TryRotateItem()
 
 void UDieg_InventoryInputHandler::InternalHandleInventorySlotHover(UDieg_3DInventoryComponent* Dieg_3DInventoryComponent, UDieg_Slot* Dieg_Slot)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDieg_InventoryInputHandler::InternalHandleInventorySlotHover);
+
 	if (IsDraggingItem())
 	{
 		CurrentMouseCoordinates = Dieg_Slot->GetCoordinatesInGrid();
-		const TArray<FIntPoint> RelevantCoordinates = GetRelevantCoordinates();
-		Dieg_3DInventoryComponent->GetGridWidget()->UpdateHoveringSlots(RelevantCoordinates, EDieg_SlotStatus::Occupied, EDieg_SlotStatus::None);
+		const FIntPoint PlacementCoordinates = UpdatePreviewCoordinates();
+		Dieg_3DInventoryComponent->GetGridWidget()->UpdateHoveringCoordinates(PreviewCoordinates, EDieg_SlotStatus::Occupied, EDieg_SlotStatus::None);
 
 		if (bDebugLogs)
-			UPlugInv_DoubleLogger::Log(5.0f, TEXT("HoverSlotHandler: Checking if slots are available {0}"), FColor::Emerald, RelevantCoordinates);
-		const bool SlotsAreValid = Dieg_3DInventoryComponent->GetInventoryComponent()->AreSlotsAvailableSimple(RelevantCoordinates);
+			UPlugInv_DoubleLogger::Log(5.0f, TEXT("HoverSlotHandler: Checking if slots are available {0}"), FColor::Emerald, TArray<FIntPoint>(PreviewCoordinates));
+
+		bool SlotsAreValid = false;
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(UDieg_InventoryInputHandler::ValidateDragPreview);
+			SlotsAreValid = DraggingShape && Dieg_3DInventoryComponent->GetInventoryComponent()->DoesShapeFit(DraggingShape->Mask, PlacementCoordinates);
+		}
 		if (SlotsAreValid)
 		{
-			ValidCoordinates = CurrentMouseCoordinates - GetRotatedGrabCoordinates(false);
+			ValidCoordinates = PlacementCoordinates;
 			ValidRotation = CurrentRotation;
 			ValidInventory3D = HoveringInventoryComponent3D;
 
@@ -442,7 +540,11 @@ void UDieg_InventoryInputHandler::InternalHandleInventorySlotHover(UDieg_3DInven
 				UPlugInv_DoubleLogger::Log(5.0f, TEXT("HoverSlotHandler: Not Available"), FColor::Emerald);
 		}
 
-		OnUpdateDragSlot.Broadcast(SlotsAreValid, this, DraggingItem.Get(), RelevantCoordinates, CurrentMouseCoordinates - GetRotatedGrabCoordinates(false), ValidRotation);
+		// The delegate needs a heap array, only build one when something listens
+		if (OnUpdateDragSlot.IsBound())
+		{
+			OnUpdateDragSlot.Broadcast(SlotsAreValid, this, DraggingItem.Get(), TArray<FIntPoint>(PreviewCoordinates), PlacementCoordinates, ValidRotation);
+		}
 	}
 	else
 	{
@@ -466,14 +568,15 @@ void UDieg_InventoryInputHandler::HandleHoveringInventorySlotUnHovered(const FPo
 
 void UDieg_InventoryInputHandler::StartDraggingItem()
 {
-	DraggingItem->BindEventsToHandler(this);
-	
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_StartDrag);
+
 	RelativeCoordinates = GetGrabCoordinates();
 
 	if (bDebugLogs)
 		UPlugInv_DoubleLogger::Log(5.0f, TEXT("Grab coordinates are: {0}. StartDraggingItem"), FColor::Emerald, RelativeCoordinates);
 	
 	DraggingItem->SetActorEnableCollision(false);
+	RefreshDragPreviewCache();
 	
 	// It's starting dragging from world, not inventory here
 	const FIntPoint RotatedGrabPoint = GetRotatedGrabCoordinates(false);
@@ -484,6 +587,7 @@ void UDieg_InventoryInputHandler::StartDraggingItem()
 		OwningInventory->RemoveItemFromInventory(DraggingItem.Get());
 		
 		ValidRotation = CurrentRotation = DraggingItem->GetCurrentRotation();
+		RefreshDragPreviewCache();
 		ValidCoordinates = DraggingItem->GetCoordinates();
 		// Due to mouse shenanigans (not the same clicking the same coordinate in top left corner than bottom right + other considerations)
 		CurrentMouseCoordinates = ValidCoordinates + RotatedGrabPoint;
@@ -495,11 +599,11 @@ void UDieg_InventoryInputHandler::StartDraggingItem()
 
 		UDieg_Grid* GridWidget = OwningInventory->GetGridWidget();
 		GridWidget->ModifyAllSlotsAppearance(true, true, EDieg_SlotStatus::None);
-		TArray<FIntPoint> RelevantCoordinates = GetRelevantCoordinates();
-		GridWidget->UpdateHoveringSlots(RelevantCoordinates, EDieg_SlotStatus::Occupied, EDieg_SlotStatus::None);
+		UpdatePreviewCoordinates();
+		GridWidget->UpdateHoveringCoordinates(PreviewCoordinates, EDieg_SlotStatus::Occupied, EDieg_SlotStatus::None);
 
 		// Later for when we drop the item, we reset the grid, still have it locked to native mouse events visuals and want to update its hover state visually.
-		// CurrentMouseSlot = GridWidget->GetSlotMap().FindRef(CurrentMouseCoordinates);
+		// CurrentMouseSlot = GridWidget->FindSlot(CurrentMouseCoordinates);
 		UDieg_Slot* RawSlotPtr = nullptr;
 		if (const bool SlotExists = GetCurrentSlot(RawSlotPtr))
 		{
@@ -510,24 +614,36 @@ void UDieg_InventoryInputHandler::StartDraggingItem()
 			CurrentMouseSlot = nullptr;
 		}
 		
-		TArray<ADieg_WorldItemActor*>Items = OwningInventory->GetItems();
-		for (ADieg_WorldItemActor* ItemActor : Items)
+		OwningInventory->SetItemCollisionEnabled(false);
+
+		if (OnStartDragInventory.IsBound())
 		{
-			ItemActor->SetActorEnableCollision(false);
+			OnStartDragInventory.Broadcast(this, DraggingItem.Get(), RotatedGrabPoint, ValidCoordinates);
+		}
+		if (IDieg_DragEventListener* Listener = GetDragEventListener())
+		{
+			Listener->OnStartDragInventory(this, RotatedGrabPoint, ValidCoordinates);
 		}
-
-		OnStartDragInventory.Broadcast(this, DraggingItem.Get(), RotatedGrabPoint, ValidCoordinates);
 	}
 	else
 	{
 		
 		ValidWorldLocation = DraggingItem.Get()->GetActorLocation();
-		OnStartDragWorld.Broadcast(this, DraggingItem.Get(), RotatedGrabPoint, ValidWorldLocation);
+		if (OnStartDragWorld.IsBound())
+		{
+			OnStartDragWorld.Broadcast(this, DraggingItem.Get(), RotatedGrabPoint, ValidWorldLocation);
+		}
+		if (IDieg_DragEventListener* Listener = GetDragEventListener())
+		{
+			Listener->OnStartDragWorld(this, RotatedGrabPoint, ValidWorldLocation);
+		}
 	}
 }
 
 void UDieg_InventoryInputHandler::StopDraggingItem()
 {
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_StopDrag);
+
 	if (bDebugLogs)
 		UPlugInv_DoubleLogger::Log("StopDraggingItem");
 
@@ -556,7 +672,14 @@ void UDieg_InventoryInputHandler::StopDraggingItem()
 				if (IsNotEmpty == false)
 				{
 					// Destroy item actor since its quantities have been all added.
-					OnConsumedItemInMerge.Broadcast(this, HoveringInventoryComponent3D.Get(), DraggingItem.Get());
+					if (OnConsumedItemInMerge.IsBound())
+					{
+						OnConsumedItemInMerge.Broadcast(this, HoveringInventoryComponent3D.Get(), DraggingItem.Get());
+					}
+					if (IDieg_DragEventListener* Listener = GetDragEventListener())
+					{
+						Listener->OnConsumedInMerge(this, HoveringInventoryComponent3D.Get());
+					}
 				}
 			}
 			
@@ -568,46 +691,77 @@ void UDieg_InventoryInputHandler::StopDraggingItem()
 					DraggingItem->SetCoordinates(ValidCoordinates);
 					DraggingItem->SetCurrentRotation(ValidRotation);
 					ValidInventory3D->AddItemToInventorySlot(DraggingItem.Get(), ValidCoordinates, ValidRotation);
-					OnDropInInventory.Broadcast(this, ValidInventory3D.Get(),
-						DraggingItem.Get(), ValidCoordinates, ValidRotation);
+					if (OnDropInInventory.IsBound())
+					{
+						OnDropInInventory.Broadcast(this, ValidInventory3D.Get(),
+							DraggingItem.Get(), ValidCoordinates, ValidRotation);
+					}
+					if (IDieg_DragEventListener* Listener = GetDragEventListener())
+					{
+						Listener->OnDropInInventory(this, ValidInventory3D.Get(), ValidCoordinates, ValidRotation);
+					}
 				}
 				else
 				{
 					// It hasn't moved, reset to its last valid data
 					ValidInventory3D->AddItemToInventorySlot(DraggingItem.Get(), ValidCoordinates, ValidRotation);
-					OnResetDragInventory.Broadcast(this, ValidInventory3D.Get(),
-						DraggingItem.Get(), DraggingItem->GetCoordinates(), DraggingItem->GetCurrentRotation());
+					if (OnResetDragInventory.IsBound())
+					{
+						OnResetDragInventory.Broadcast(this, ValidInventory3D.Get(),
+							DraggingItem.Get(), DraggingItem->GetCoordinates(), DraggingItem->GetCurrentRotation());
+					}
+					if (IDieg_DragEventListener* Listener = GetDragEventListener())
+					{
+						Listener->OnResetDragInventory(this, ValidInventory3D.Get(), DraggingItem->GetCoordinates(), DraggingItem->GetCurrentRotation());
+					}
 				}
 			}
 			else
 			{
 				// No valid place has been found
-				OnResetDragWorld.Broadcast(this, DraggingItem.Get(), ValidWorldLocation);
+				if (OnResetDragWorld.IsBound())
+				{
+					OnResetDragWorld.Broadcast(this, DraggingItem.Get(), ValidWorldLocation);
+				}
+				if (IDieg_DragEventListener* Listener = GetDragEventListener())
+				{
+					Listener->OnResetDragWorld(this, ValidWorldLocation);
+				}
 			}
 		}
 		
-		TArray<ADieg_WorldItemActor*> Items = HoveringInventoryComponent3D->GetItems();
-		for (ADieg_WorldItemActor* ItemActor : Items)
-		{
-			ItemActor->SetActorEnableCollision(true);
-		}
+		HoveringInventoryComponent3D->SetItemCollisionEnabled(true);
 	}
 	else if (DraggingItem.IsValid())
 	{
 		DisconnectItemToInventory();
-		OnDropWorld.Broadcast(this, DraggingItem.Get(), DraggingItem->GetActorLocation());
+		if (OnDropWorld.IsBound())
+		{
+			OnDropWorld.Broadcast(this, DraggingItem.Get(), DraggingItem->GetActorLocation());
+		}
+		if (IDieg_DragEventListener* Listener = GetDragEventListener())
+		{
+			Listener->OnDropWorld(this, DraggingItem->GetActorLocation());
+		}
 	}
 	
 	if (DraggingItem.IsValid())
 	{
 		DraggingItem->SetActorEnableCollision(true);
-		DraggingItem->UnBindEventsFromHandler(this);
+
+		// Dropped away from the cursor, nothing will unhover it
+		UDieg_3DInventoryComponent* DroppedInventory = nullptr;
+		if (DraggingItem != HoveringItem && IsItemInInventory(DraggingItem.Get(), DroppedInventory))
+		{
+			DroppedInventory->DemoteItemActor(DraggingItem.Get());
+		}
 		ValidCoordinates = FIntPoint(-1,-1);
 		CurrentRotation = ValidRotation = 0.0f;
 		Default3DInventory.Reset();
 	}
 
 	DraggingItem.Reset();
+	DraggingShape = nullptr;
 }
 
 bool UDieg_InventoryInputHandler::MergeItems(const TArray<FIntPoint>& RootSlotCoordinates)
@@ -617,51 +771,48 @@ bool UDieg_InventoryInputHandler::MergeItems(const TArray<FIntPoint>& RootSlotCo
 		return false;
 	}
 
-	int32 Quantity = 0;
-	int32 OldQuantity = Quantity = DraggingItem->GetItemInstance()->GetQuantity();
-	
-	TArray<ADieg_WorldItemActor*> Items3D = HoveringInventoryComponent3D->GetItems();
-	// TArray<FDieg_InventorySlot*> InventorySlots = HoveringInventoryComponent3D->GetInventoryComponent()->GetSlotsMutable();
-	TArray<FDieg_InventorySlot*> InventoryRootSlots = HoveringInventoryComponent3D->GetInventoryComponent()->GetRootSlotsMutable();
-	
+	UDieg_InventoryComponent* InventoryComponent = HoveringInventoryComponent3D->GetInventoryComponent();
+	UDieg_ItemInstance* DraggedInstance = DraggingItem->GetItemInstanceMutable();
+	const int32 OldQuantity = DraggedInstance->GetQuantity();
+
+	// One transaction for every target, then a single sync picks up all their quantity changes
+	TArray<UDieg_ItemInstance*> MergedItems;
+	const int32 Quantity = InventoryComponent->MergeIntoItems(DraggedInstance, RootSlotCoordinates, MergedItems);
+
+	// Items drawn as mesh instances have no actor, their instance picks up the quantity on sync
 	TArray<AActor*> MergedActors;
-	for (FIntPoint RootCoordinate : RootSlotCoordinates)
+	MergedActors.Reserve(MergedItems.Num());
+	for (const UDieg_ItemInstance* MergedItem : MergedItems)
 	{
-		if (ADieg_WorldItemActor** CurrentItem3D = Items3D.FindByPredicate(
-			[&](const TWeakObjectPtr<ADieg_WorldItemActor>& Item)
-			{
-				return Item.IsValid() &&
-					Item->GetCoordinates() == RootCoordinate;
-			}))
+		if (ADieg_WorldItemActor* MergedActor = HoveringInventoryComponent3D->FindItemActor(MergedItem))
 		{
-			MergedActors.Add(*CurrentItem3D);
-
-			if (FDieg_InventorySlot** FoundSlot = InventoryRootSlots.FindByPredicate(
-			[&](FDieg_InventorySlot* S)
-			{
-				return S && S->Coordinates == RootCoordinate;
-			}))
-			{
-				FDieg_InventorySlot* CurrentInventorySlot = *FoundSlot;
+			MergedActor->SetQuantity(MergedItem->GetQuantity());
+			MergedActors.Add(MergedActor);
+		}
+	}
 
-				const int32 Added = HoveringInventoryComponent3D->GetInventoryComponent()
-										->AddQuantityToSlot(CurrentInventorySlot->ItemInstance, Quantity);
+	HoveringInventoryComponent3D->SyncItemActors();
+	DraggingItem->SetQuantity(Quantity);
+	BroadcastMergeItem(MergedActors, OldQuantity, Quantity);
 
-				(*CurrentItem3D)->SetQuantity(CurrentInventorySlot->ItemInstance->GetQuantity());
-				Quantity -= Added;
+	return Quantity > 0;
+}
 
-				if (Quantity <= 0)
-				{
-					OnMergeItem.Broadcast(this, DraggingItem.Get(), MergedActors, OldQuantity, Quantity);
-					return false;
-				}
-			}
-		}
+void UDieg_InventoryInputHandler::BroadcastMergeItem(const TArray<AActor*>& MergedActors, const int32 OldQuantity, const int32 NewQuantity)
+{
+	if (OnMergeItem.IsBound())
+	{
+		OnMergeItem.Broadcast(this, DraggingItem.Get(), MergedActors, OldQuantity, NewQuantity);
 	}
-	DraggingItem->SetQuantity(DraggingItem->GetItemInstance()->GetQuantity());
-	OnMergeItem.Broadcast(this, DraggingItem.Get(), MergedActors, OldQuantity, Quantity);
+	if (IDieg_DragEventListener* Listener = GetDragEventListener())
+	{
+		Listener->OnMergeDragged(this, MergedActors, OldQuantity, NewQuantity);
+	}
+}
 
-	return true;
+IDieg_DragEventListener* UDieg_InventoryInputHandler::GetDragEventListener() const
+{
+	return DraggingItem.Get();
 }
 
 void UDieg_InventoryInputHandler::RotateItem()
@@ -674,8 +825,16 @@ void UDieg_InventoryInputHandler::RotateItem()
 	{
 		CurrentRotation = -90.0f;
 	}
-	const FIntPoint RotatedGrabPoint = GetRotatedGrabCoordinates(false);
-	OnRotateItem.Broadcast(this, DraggingItem.Get(), CurrentRotation, RotatedGrabPoint);
+	RefreshDragPreviewCache();
+	const FIntPoint RotatedGrabPoint = DraggingRotatedGrab;
+	if (OnRotateItem.IsBound())
+	{
+		OnRotateItem.Broadcast(this, DraggingItem.Get(), CurrentRotation, RotatedGrabPoint);
+	}
+	if (IDieg_DragEventListener* Listener = GetDragEventListener())
+	{
+		Listener->OnRotateDragged(this, CurrentRotation, RotatedGrabPoint);
+	}
 
 	UDieg_Slot* Slot = nullptr;
 	if (GetCurrentSlot(Slot))
@@ -723,8 +882,8 @@ FIntPoint UDieg_InventoryInputHandler::GetGrabCoordinates() const
 	const FVector ImpactPoint = HitResult.ImpactPoint - HitResult.Normal;
 	const TWeakObjectPtr<UPrimitiveComponent> HitComponent = HitResult.Component;
 
-	// Get the definition of the item being dragged.
-	const FDieg_ItemDefinition& DraggingItemDefinition = DraggingItem->GetItemInstance()->GetItemDefinition();
+	// Get the unrotated baked shape of the item being dragged.
+	const FDieg_RotatedShape& DraggingShape = DraggingItem->GetItemInstance()->GetItemDefinitionDataAsset()->GetRotatedShape(0.0f);
 
 	// NOTE:
 	// Even though items can be rotated, the local space of the PrimitiveShapeComponent 
@@ -733,7 +892,7 @@ FIntPoint UDieg_InventoryInputHandler::GetGrabCoordinates() const
 	// Rotation adjustments will be applied later in the pipeline when needed.
 
 	// Find the size (span) of the item's shape in grid units.
-	const FIntPoint ShapeSpan = UDieg_UtilityLibrary::GetShapeSpan(DraggingItemDefinition.DefaultShape);
+	const FIntPoint ShapeSpan = DraggingShape.Span;
 	const int32 XSpan = ShapeSpan.X;
 	const int32 YSpan = ShapeSpan.Y;
 
@@ -779,25 +938,16 @@ FIntPoint UDieg_InventoryInputHandler::GetRotatedGrabCoordinates(bool UseValidat
 	}
 
 	// Get the definition of the item being dragged.
-	const FDieg_ItemDefinition& DraggingItemDefinition = DraggingItem->GetItemInstance()->GetItemDefinition();
-	int32 Index = DraggingItemDefinition.DefaultShape.Find(RelativeCoordinates);
+	const UDieg_ItemDefinitionDataAsset* DraggingDataAsset = DraggingItem->GetItemInstance()->GetItemDefinitionDataAsset();
+	const int32 Index = DraggingDataAsset->ItemDefinition.DefaultShape.Find(RelativeCoordinates);
 
-	float RotationToUse = UseValidated ? ValidRotation : CurrentRotation;
-	FIntPoint RotatedRootOut;
-	TArray<FIntPoint> RotatedShape = UDieg_UtilityLibrary::Rotate2DArrayWithRoot(DraggingItemDefinition.DefaultShape, RotationToUse, RelativeCoordinates,RotatedRootOut);
+	const float RotationToUse = UseValidated ? ValidRotation : CurrentRotation;
+	const FDieg_RotatedShape& RotatedShape = DraggingDataAsset->GetRotatedShape(RotationToUse);
 
-	// It should be the same index as the default shape
-	if (RotatedShape.IsValidIndex(Index))
-	{
-		FinalResult = RotatedShape[Index];
-	}
-	
-	// Extra check
-	if (FinalResult != RotatedRootOut)
+	// Baked cells keep the order of the default shape, so it is the same index
+	if (RotatedShape.Cells.IsValidIndex(Index))
 	{
-		// Something or calculation are wrong
-		if (bDebugLogs)
-			UPlugInv_DoubleLogger::Log("FinalResult != RotatedRootOut, in GetRotatedGrabCoordinates()");
+		FinalResult = RotatedShape.Cells[Index];
 	}
 	
 	return FinalResult;
@@ -814,18 +964,51 @@ TArray<FIntPoint> UDieg_InventoryInputHandler::GetRelevantCoordinates() const
 
 	// In here technically the hovering and owning inventory should be the same
 	const FIntPoint ActualCoordinates = CurrentMouseCoordinates - GetRotatedGrabCoordinates(false);
-	const FDieg_ItemDefinition& DraggingItemDefinition = DraggingItem->GetItemInstance()->GetItemDefinition();
+	const FDieg_RotatedShape& RotatedShape = DraggingItem->GetItemInstance()->GetItemDefinitionDataAsset()->GetRotatedShape(CurrentRotation);
 
-	FIntPoint RotatedRootOut;
-	return HoveringInventoryComponent3D->GetInventoryComponent()->GetRelevantCoordinates(ActualCoordinates,
-		DraggingItemDefinition.DefaultShape, DraggingItemDefinition.DefaultShapeRoot, CurrentRotation,RotatedRootOut);
+	FinalResult.Reserve(RotatedShape.Cells.Num());
+	for (const FIntPoint& Cell : RotatedShape.Cells)
+	{
+		FinalResult.Add(Cell + ActualCoordinates);
+	}
+	return FinalResult;
+}
+
+void UDieg_InventoryInputHandler::RefreshDragPreviewCache()
+{
+	DraggingShape = nullptr;
+	DraggingRotatedGrab = FIntPoint::ZeroValue;
+	if (!DraggingItem.IsValid() || !DraggingItem->GetItemInstance())
+	{
+		return;
+	}
+
+	DraggingShape = &DraggingItem->GetItemInstance()->GetItemDefinitionDataAsset()->GetRotatedShape(CurrentRotation);
+	DraggingRotatedGrab = GetRotatedGrabCoordinates(false);
+}
+
+FIntPoint UDieg_InventoryInputHandler::UpdatePreviewCoordinates()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDieg_InventoryInputHandler::UpdatePreviewCoordinates);
+
+	// Same result as GetRelevantCoordinates, without rotating the shape or reallocating
+	const FIntPoint PlacementCoordinates = CurrentMouseCoordinates - DraggingRotatedGrab;
+	PreviewCoordinates.Reset();
+	if (DraggingShape)
+	{
+		for (const FIntPoint& Cell : DraggingShape->Cells)
+		{
+			PreviewCoordinates.Add(Cell + PlacementCoordinates);
+		}
+	}
+	return PlacementCoordinates;
 }
 
 bool UDieg_InventoryInputHandler::GetCurrentSlot(UDieg_Slot*& SlotOut) const
 {
 	if (HoveringInventoryComponent3D.IsValid())
 	{
-		if (UDieg_Slot* FoundSlot = HoveringInventoryComponent3D->GetGridWidget()->GetSlotMap().FindRef(CurrentMouseCoordinates))
+		if (UDieg_Slot* FoundSlot = HoveringInventoryComponent3D->GetGridWidget()->FindSlot(CurrentMouseCoordinates))
 		{
 			SlotOut = FoundSlot;
 			return true;
@@ -842,7 +1025,7 @@ void UDieg_InventoryInputHandler::TickComponent(float DeltaTime, ELevelTick Tick
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// ...
-	if (bIsInventoryOpen && OwningPlayerController.IsValid())
+	if (bIsInventoryOpen && OwningPlayerController.IsValid() && MouseTraceId == INDEX_NONE)
 	{
 		FHitResult HitResult;
 		if (LineTraceFromMouse(HitResult))
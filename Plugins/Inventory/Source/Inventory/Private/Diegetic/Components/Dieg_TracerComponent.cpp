@@ -3,8 +3,13 @@
 
 #include "Diegetic/Components/Dieg_TracerComponent.h"
 
+#include "Inventory.h"
 #include "Diegetic/Dieg_PlayerController.h"
-#include "Kismet/GameplayStatics.h"
+#include "Diegetic/Actors/Dieg_WorldItemActor.h"
+#include "Diegetic/Components/Dieg_InventoryComponent.h"
+#include "Diegetic/Subsystems/Dieg_AssetStreamingSubsystem.h"
+#include "Diegetic/Subsystems/Dieg_TraceSubsystem.h"
+#include "Diegetic/UObjects/Dieg_ItemInstance.h"
 
 UDieg_TracerComponent::UDieg_TracerComponent()
 {
@@ -24,6 +29,18 @@ void UDieg_TracerComponent::BeginPlay()
 {
 	Super::BeginPlay();
 	CacheOwningPlayerController();
+	RegisterTraces();
+}
+
+void UDieg_TracerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterTraces();
+	if (UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get())
+	{
+		Streamer->ReleaseHolderAssets(this);
+	}
+	PrefetchedDefinitions.Reset();
+	Super::EndPlay(EndPlayReason);
 }
 
 void UDieg_TracerComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
@@ -31,20 +48,54 @@ void UDieg_TracerComponent::TickComponent(float DeltaTime, enum ELevelTick TickT
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	DoMultipleTraces();
+	// Batched traces report through HandleTraceResult instead
+	if (RegisteredTraceIds.IsEmpty())
+	{
+		DoMultipleTraces();
+	}
+}
+
+void UDieg_TracerComponent::RegisterTraces()
+{
+	UnregisterTraces();
+
+	UDieg_TraceSubsystem* TraceSubsystem = UDieg_TraceSubsystem::Get(this);
+	if (!TraceSubsystem || !OwningPlayerController.IsValid())
+	{
+		return;
+	}
+
+	for (const TEnumAsByte<ECollisionChannel>& Channel : TraceChannels)
+	{
+		const int32 TraceId = TraceSubsystem->RegisterTrace(OwningPlayerController.Get(), EDieg_TraceOrigin::ViewportCenter, Channel, TraceLength,
+			FDieg_OnTraceResult::CreateUObject(this, &ThisClass::HandleTraceResult, Channel));
+		if (TraceId == INDEX_NONE)
+		{
+			// Batching is off, trace on tick
+			UnregisterTraces();
+			return;
+		}
+		RegisteredTraceIds.Add(TraceId);
+	}
+}
+
+void UDieg_TracerComponent::UnregisterTraces()
+{
+	if (UDieg_TraceSubsystem* TraceSubsystem = UDieg_TraceSubsystem::Get(this))
+	{
+		for (const int32 TraceId : RegisteredTraceIds)
+		{
+			TraceSubsystem->UnregisterTrace(TraceId);
+		}
+	}
+	RegisteredTraceIds.Reset();
 }
 
 void UDieg_TracerComponent::DoMultipleTraces()
 {
-	if (!OwningPlayerController.IsValid()|| !IsValid(GEngine) || !IsValid(GEngine->GameViewport)) return;
-	
-	FVector2D ViewportSize;
-	GEngine->GameViewport->GetViewportSize(ViewportSize);
-	const FVector2D ViewportCenter = ViewportSize/2.f;
 	FVector TraceStart;
 	FVector TraceForward;
-
-	if (!UGameplayStatics::DeprojectScreenToWorld(OwningPlayerController.Get(), ViewportCenter, TraceStart, TraceForward)) return;
+	if (!UDieg_TraceSubsystem::ComputeTraceRay(OwningPlayerController.Get(), EDieg_TraceOrigin::ViewportCenter, TraceStart, TraceForward)) return;
 
 	const FVector TraceEnd = TraceStart + TraceForward * TraceLength;
 	FHitResult HitResult;
@@ -60,15 +111,33 @@ FHitResult UDieg_TracerComponent::DoSingleTrace(
     const TEnumAsByte<ECollisionChannel> Channel)
 {
     FHitResult HitResult;
-    bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, Channel);
+    bool bHit;
+    {
+        SCOPE_CYCLE_COUNTER(STAT_Dieg_SyncTraceTime);
+        INC_DWORD_STAT(STAT_Dieg_SyncTraces);
+        bHit = GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, Channel);
+    }
+
+    if (!bHit)
+    {
+        // Misses don't fill the ray in, HandleTraceResult draws from it
+        HitResult.TraceStart = TraceStart;
+        HitResult.TraceEnd = TraceEnd;
+    }
+
+    HandleTraceResult(HitResult, bHit, Channel);
+    return HitResult;
+}
 
+void UDieg_TracerComponent::HandleTraceResult(const FHitResult& HitResult, const bool bHit, const TEnumAsByte<ECollisionChannel> Channel)
+{
 	if (bDebugDraw)
 	{
 		// Draw the trace line
 		DrawDebugLine(
 			GetWorld(),
-			TraceStart,
-			TraceEnd,
+			HitResult.TraceStart,
+			HitResult.TraceEnd,
 			bHit ? FColor::Red : FColor::Green,
 			false, // not persistent
 			0.5f,  // duration
@@ -119,6 +188,11 @@ FHitResult UDieg_TracerComponent::DoSingleTrace(
     // --- Handle normal in/out events ---
     if (CurrentActor != PreviousActor)
     {
+        if (bPrefetchOnHover)
+        {
+            PrefetchItemAssets();
+        }
+
         // New actor entered trace
         if (CurrentActor.IsValid() && OnActorInTrace.IsBound())
         {
@@ -131,8 +205,6 @@ FHitResult UDieg_TracerComponent::DoSingleTrace(
             OnActorOutTrace.Broadcast(PreviousActor.Get(), Channel);
         }
     }
-
-    return HitResult;
 }
 
 
@@ -149,6 +221,54 @@ ADieg_PlayerController* UDieg_TracerComponent::CacheOwningPlayerController()
 	return nullptr;
 }
 
+void UDieg_TracerComponent::PrefetchItemAssets()
+{
+	UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get();
+	if (!Streamer)
+	{
+		return;
+	}
+
+	// Definitions shown by the actors currently traced
+	TSet<TObjectKey<UDieg_ItemDefinitionDataAsset>> Definitions;
+	for (const TPair<TEnumAsByte<ECollisionChannel>, TWeakObjectPtr<AActor>>& Pair : CurrentTraceActor)
+	{
+		const AActor* Actor = Pair.Value.Get();
+		if (const ADieg_WorldItemActor* ItemActor = Cast<ADieg_WorldItemActor>(Actor))
+		{
+			if (const UDieg_ItemInstance* ItemInstance = ItemActor->GetItemInstance())
+			{
+				Definitions.Add(ItemInstance->GetItemDefinitionDataAsset());
+			}
+		}
+		else if (const UDieg_InventoryComponent* InventoryComponent = Actor ? Actor->FindComponentByClass<UDieg_InventoryComponent>() : nullptr)
+		{
+			const FDieg_SlotStorage& SlotStorage = InventoryComponent->GetSlotStorage();
+			for (FDieg_SlotStorage::FItemIterator It = SlotStorage.CreateItemIterator(); It; ++It)
+			{
+				if (IsValid(It->ItemInstance))
+				{
+					Definitions.Add(It->ItemInstance->GetItemDefinitionDataAsset());
+				}
+			}
+		}
+	}
+
+	// Request before releasing, so definitions still traced never lose their last holder
+	for (const TObjectKey<UDieg_ItemDefinitionDataAsset>& Definition : Definitions)
+	{
+		Streamer->RequestItemAssets(Definition.ResolveObjectPtr(), this);
+	}
+	for (const TObjectKey<UDieg_ItemDefinitionDataAsset>& Definition : PrefetchedDefinitions)
+	{
+		if (!Definitions.Contains(Definition))
+		{
+			Streamer->ReleaseItemAssets(Definition.ResolveObjectPtr(), this);
+		}
+	}
+	PrefetchedDefinitions = MoveTemp(Definitions);
+}
+
 TArray<AActor*> UDieg_TracerComponent::GetCurrentTraceActors() const
 {
 	TArray<AActor*> CurrentActors;
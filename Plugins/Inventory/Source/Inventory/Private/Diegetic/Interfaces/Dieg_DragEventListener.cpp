@@ -0,0 +1,7 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/Interfaces/Dieg_DragEventListener.h"
+
+
+// Add default functionality here for any IDieg_DragEventListener functions that are not pure virtual.
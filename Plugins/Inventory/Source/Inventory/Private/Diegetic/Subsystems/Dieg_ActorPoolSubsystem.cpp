@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/Subsystems/Dieg_ActorPoolSubsystem.h"
+
+#include "Inventory.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool Spawns"), STAT_Dieg_PoolSpawns, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool Spawns Avoided"), STAT_Dieg_PoolSpawnsAvoided, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool Releases"), STAT_Dieg_PoolReleases, STATGROUP_DiegInventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Actors"), STAT_Dieg_PooledActors, STATGROUP_DiegInventory);
+
+UDieg_ActorPoolSubsystem* UDieg_ActorPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UDieg_ActorPoolSubsystem>() : nullptr;
+}
+
+AActor* UDieg_ActorPoolSubsystem::TryAcquireActor(UClass* ActorClass)
+{
+	FDieg_ActorPoolBucket* Bucket = Pools.Find(ActorClass);
+	if (!Bucket)
+	{
+		return nullptr;
+	}
+
+	// Pooled actors can still be destroyed from outside, skip those
+	while (!Bucket->Actors.IsEmpty())
+	{
+		AActor* Actor = Bucket->Actors.Pop(EAllowShrinking::No);
+		DEC_DWORD_STAT(STAT_Dieg_PooledActors);
+		if (IsValid(Actor))
+		{
+			SetActorPooled(Actor, false);
+			INC_DWORD_STAT(STAT_Dieg_PoolSpawnsAvoided);
+			return Actor;
+		}
+	}
+
+	return nullptr;
+}
+
+AActor* UDieg_ActorPoolSubsystem::AcquireActor(UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParameters)
+{
+	if (!ActorClass)
+	{
+		return nullptr;
+	}
+
+	if (AActor* Actor = TryAcquireActor(ActorClass))
+	{
+		Actor->SetOwner(SpawnParameters.Owner);
+		Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+		return Actor;
+	}
+
+	INC_DWORD_STAT(STAT_Dieg_PoolSpawns);
+	return GetWorld()->SpawnActor<AActor>(ActorClass, Transform, SpawnParameters);
+}
+
+void UDieg_ActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+	if (!IsValid(Actor))
+	{
+		return;
+	}
+
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+	FDieg_ActorPoolBucket& Bucket = Pools.FindOrAdd(Actor->GetClass());
+	if (Bucket.Actors.Num() >= MaxPooledPerClass)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	SetActorPooled(Actor, true);
+	Actor->SetOwner(nullptr);
+	Bucket.Actors.Add(Actor);
+	INC_DWORD_STAT(STAT_Dieg_PoolReleases);
+	INC_DWORD_STAT(STAT_Dieg_PooledActors);
+}
+
+void UDieg_ActorPoolSubsystem::Prewarm(const TSubclassOf<AActor> ActorClass, const int32 Count)
+{
+	if (!ActorClass)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	const int32 ToSpawn = FMath::Min(Count, MaxPooledPerClass) - GetNumPooled(ActorClass);
+	for (int32 Index = 0; Index < ToSpawn; ++Index)
+	{
+		INC_DWORD_STAT(STAT_Dieg_PoolSpawns);
+		ReleaseActor(GetWorld()->SpawnActor<AActor>(ActorClass, FTransform::Identity, SpawnParams));
+	}
+}
+
+int32 UDieg_ActorPoolSubsystem::GetNumPooled(const TSubclassOf<AActor> ActorClass) const
+{
+	const FDieg_ActorPoolBucket* Bucket = Pools.Find(ActorClass.Get());
+	return Bucket ? Bucket->Actors.Num() : 0;
+}
+
+void UDieg_ActorPoolSubsystem::Deinitialize()
+{
+	for (const TPair<TObjectPtr<UClass>, FDieg_ActorPoolBucket>& Pair : Pools)
+	{
+		DEC_DWORD_STAT_BY(STAT_Dieg_PooledActors, Pair.Value.Actors.Num());
+	}
+	Pools.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDieg_ActorPoolSubsystem::SetActorPooled(AActor* Actor, const bool bPooled)
+{
+	// Hidden-ness does not propagate to attached actors, so walk them too
+	TArray<AActor*> AttachedActors;
+	Actor->GetAttachedActors(AttachedActors, true, true);
+	AttachedActors.Add(Actor);
+
+	for (AActor* Each : AttachedActors)
+	{
+		Each->SetActorHiddenInGame(bPooled);
+		Each->SetActorEnableCollision(!bPooled);
+		Each->SetActorTickEnabled(!bPooled && Each->PrimaryActorTick.bStartWithTickEnabled);
+	}
+}
@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/Subsystems/Dieg_AssetStreamingSubsystem.h"
+
+#include "BPF_PlugInv_DoubleLogger.h"
+#include "Inventory.h"
+#include "Diegetic/Components/Dieg_InventoryComponent.h"
+#include "Diegetic/UObjects/Dieg_ItemDefinitionDataAsset.h"
+#include "Diegetic/UObjects/Dieg_ItemInstance.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/StreamableManager.h"
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Item Asset Load Latency (ms)"), STAT_Dieg_ItemAssetLoadLatency, STATGROUP_DiegInventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Asset Loads In Flight"), STAT_Dieg_ItemAssetLoadsInFlight, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Item Asset Loads Completed"), STAT_Dieg_ItemAssetLoadsCompleted, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Blocking Item Asset Loads"), STAT_Dieg_BlockingItemAssetLoads, STATGROUP_DiegInventory);
+
+UDieg_AssetStreamingSubsystem* UDieg_AssetStreamingSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UDieg_AssetStreamingSubsystem>() : nullptr;
+}
+
+bool UDieg_AssetStreamingSubsystem::RequestItemAssets(const UDieg_ItemDefinitionDataAsset* ItemDataAsset, const UObject* Holder,
+	FSimpleDelegate OnLoaded)
+{
+	if (!IsValid(ItemDataAsset))
+	{
+		return false;
+	}
+
+	const TObjectKey<UDieg_ItemDefinitionDataAsset> Key(ItemDataAsset);
+	if (FDieg_ItemAssetRequest* Existing = Requests.Find(Key))
+	{
+		if (Holder)
+		{
+			Existing->Holders.Add(TObjectKey<UObject>(Holder));
+		}
+		if (!Existing->Handle.IsValid() || Existing->Handle->HasLoadCompleted())
+		{
+			return true;
+		}
+		if (OnLoaded.IsBound())
+		{
+			Existing->Callbacks.Add(MoveTemp(OnLoaded));
+		}
+		return false;
+	}
+
+	const FDieg_ItemDefinition& ItemDefinition = ItemDataAsset->ItemDefinition;
+	TArray<FSoftObjectPath> Paths;
+	if (!ItemDefinition.WorldMesh.IsNull())
+	{
+		Paths.Add(ItemDefinition.WorldMesh.ToSoftObjectPath());
+	}
+	if (!ItemDefinition.Icon2d.IsNull())
+	{
+		Paths.Add(ItemDefinition.Icon2d.ToSoftObjectPath());
+	}
+
+	// Added before requesting, the streamable manager may complete right away
+	FDieg_ItemAssetRequest& Request = Requests.Add(Key);
+	if (Holder)
+	{
+		Request.Holders.Add(TObjectKey<UObject>(Holder));
+	}
+	if (Paths.IsEmpty())
+	{
+		return true;
+	}
+
+	Request.RequestTime = FPlatformTime::Seconds();
+	INC_DWORD_STAT(STAT_Dieg_ItemAssetLoadsInFlight);
+
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		MoveTemp(Paths),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::HandleItemAssetsLoaded, Key),
+		FStreamableManager::AsyncLoadHighPriority);
+
+	// The request may have been completed, and the map grown, while loading
+	FDieg_ItemAssetRequest& Pending = Requests.FindChecked(Key);
+	Pending.Handle = Handle;
+	if (!Handle.IsValid())
+	{
+		// Nothing valid to load, the delegate won't come
+		DEC_DWORD_STAT(STAT_Dieg_ItemAssetLoadsInFlight);
+		return true;
+	}
+	if (Handle->HasLoadCompleted())
+	{
+		return true;
+	}
+
+	if (OnLoaded.IsBound())
+	{
+		Pending.Callbacks.Add(MoveTemp(OnLoaded));
+	}
+	return false;
+}
+
+void UDieg_AssetStreamingSubsystem::RequestInventoryAssets(const UDieg_InventoryComponent* InventoryComponent, const UObject* Holder)
+{
+	if (!IsValid(InventoryComponent))
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDieg_AssetStreamingSubsystem::RequestInventoryAssets);
+
+	const FDieg_SlotStorage& SlotStorage = InventoryComponent->GetSlotStorage();
+	for (FDieg_SlotStorage::FItemIterator It = SlotStorage.CreateItemIterator(); It; ++It)
+	{
+		if (IsValid(It->ItemInstance))
+		{
+			RequestItemAssets(It->ItemInstance->GetItemDefinitionDataAsset(), Holder);
+		}
+	}
+}
+
+void UDieg_AssetStreamingSubsystem::ReleaseItemAssets(const UDieg_ItemDefinitionDataAsset* ItemDataAsset, const UObject* Holder)
+{
+	const TObjectKey<UDieg_ItemDefinitionDataAsset> Key(ItemDataAsset);
+	FDieg_ItemAssetRequest* Request = Requests.Find(Key);
+	if (!Request || Request->Holders.Remove(TObjectKey<UObject>(Holder)) == 0 || !Request->Holders.IsEmpty())
+	{
+		return;
+	}
+
+	ReleaseRequest(*Request);
+	Requests.Remove(Key);
+}
+
+void UDieg_AssetStreamingSubsystem::ReleaseHolderAssets(const UObject* Holder)
+{
+	if (!Holder)
+	{
+		return;
+	}
+
+	const TObjectKey<UObject> HolderKey(Holder);
+	for (auto It = Requests.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Holders.Remove(HolderKey) > 0 && It->Value.Holders.IsEmpty())
+		{
+			ReleaseRequest(It->Value);
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UDieg_AssetStreamingSubsystem::ReleaseRequest(FDieg_ItemAssetRequest& Request)
+{
+	if (!Request.Handle.IsValid())
+	{
+		return;
+	}
+
+	if (Request.Handle->IsLoadingInProgress())
+	{
+		DEC_DWORD_STAT(STAT_Dieg_ItemAssetLoadsInFlight);
+		Request.Handle->CancelHandle();
+	}
+	else
+	{
+		Request.Handle->ReleaseHandle();
+	}
+	Request.Handle.Reset();
+}
+
+void UDieg_AssetStreamingSubsystem::Deinitialize()
+{
+	for (TPair<TObjectKey<UDieg_ItemDefinitionDataAsset>, FDieg_ItemAssetRequest>& Pair : Requests)
+	{
+		ReleaseRequest(Pair.Value);
+	}
+	Requests.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDieg_AssetStreamingSubsystem::HandleItemAssetsLoaded(const TObjectKey<UDieg_ItemDefinitionDataAsset> Key)
+{
+	FDieg_ItemAssetRequest* Request = Requests.Find(Key);
+	if (!Request)
+	{
+		return;
+	}
+
+	SET_FLOAT_STAT(STAT_Dieg_ItemAssetLoadLatency, (FPlatformTime::Seconds() - Request->RequestTime) * 1000.0);
+	DEC_DWORD_STAT(STAT_Dieg_ItemAssetLoadsInFlight);
+	INC_DWORD_STAT(STAT_Dieg_ItemAssetLoadsCompleted);
+
+	// Callbacks may request more assets and grow the map
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(Request->Callbacks);
+	for (const FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+void UDieg_AssetStreamingSubsystem::NoteBlockingLoad(const FSoftObjectPath& Path, const TCHAR* Context)
+{
+	INC_DWORD_STAT(STAT_Dieg_BlockingItemAssetLoads);
+	UPlugInv_DoubleLogger::LogWarning(FString::Printf(TEXT("%s: blocking load of %s, it was not prefetched"), Context, *Path.ToString()));
+}
@@ -0,0 +1,196 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/Subsystems/Dieg_TraceSubsystem.h"
+
+#include "Inventory.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/Engine.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+
+DECLARE_CYCLE_STAT(TEXT("Trace Service Tick"), STAT_Dieg_TraceServiceTick, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Traces Issued"), STAT_Dieg_TracesIssued, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Traces Skipped (Still)"), STAT_Dieg_TracesSkipped, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Trace Results Delivered"), STAT_Dieg_TraceResultsDelivered, STATGROUP_DiegInventory);
+
+UDieg_TraceSubsystem* UDieg_TraceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UDieg_TraceSubsystem>() : nullptr;
+}
+
+int32 UDieg_TraceSubsystem::RegisterTrace(APlayerController* PlayerController, const EDieg_TraceOrigin Origin, const ECollisionChannel Channel, const double Length, FDieg_OnTraceResult Callback)
+{
+	if (!bBatchTraces || !IsValid(PlayerController))
+	{
+		return INDEX_NONE;
+	}
+
+	FDieg_TraceGroup* Group = Groups.FindByPredicate([&](const FDieg_TraceGroup& Each)
+	{
+		return Each.PlayerController == PlayerController && Each.Origin == Origin && Each.Channel == Channel && Each.Length == Length;
+	});
+	if (!Group)
+	{
+		Group = &Groups.AddDefaulted_GetRef();
+		Group->PlayerController = PlayerController;
+		Group->Origin = Origin;
+		Group->Channel = Channel;
+		Group->Length = Length;
+	}
+
+	// Trace on the next batch even if the camera is still, the new listener has no result yet
+	Group->bHasLastTrace = false;
+
+	FDieg_TraceListener& Listener = Group->Listeners.AddDefaulted_GetRef();
+	Listener.TraceId = NextTraceId++;
+	Listener.Callback = MoveTemp(Callback);
+	return Listener.TraceId;
+}
+
+void UDieg_TraceSubsystem::UnregisterTrace(const int32 TraceId)
+{
+	if (TraceId == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Empty groups are dropped when the next batch is issued, not while results are delivered
+	for (FDieg_TraceGroup& Group : Groups)
+	{
+		if (Group.Listeners.RemoveAll([TraceId](const FDieg_TraceListener& Listener) { return Listener.TraceId == TraceId; }) > 0)
+		{
+			return;
+		}
+	}
+}
+
+bool UDieg_TraceSubsystem::ComputeTraceRay(const APlayerController* PlayerController, const EDieg_TraceOrigin Origin, FVector& OutStart, FVector& OutDirection)
+{
+	if (!IsValid(PlayerController))
+	{
+		return false;
+	}
+
+	switch (Origin)
+	{
+	case EDieg_TraceOrigin::ViewportCenter:
+		{
+			if (!IsValid(GEngine) || !IsValid(GEngine->GameViewport))
+			{
+				return false;
+			}
+
+			FVector2D ViewportSize;
+			GEngine->GameViewport->GetViewportSize(ViewportSize);
+			return UGameplayStatics::DeprojectScreenToWorld(PlayerController, ViewportSize / 2.f, OutStart, OutDirection);
+		}
+	case EDieg_TraceOrigin::Mouse:
+		{
+			FVector MouseWorldLocation;
+			if (!PlayerController->PlayerCameraManager || !PlayerController->DeprojectMousePositionToWorld(MouseWorldLocation, OutDirection))
+			{
+				return false;
+			}
+
+			OutStart = PlayerController->PlayerCameraManager->GetCameraLocation();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UDieg_TraceSubsystem::Tick(const float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_TraceServiceTick);
+
+	DeliverResults();
+
+	TimeSinceLastBatch += DeltaTime;
+	if (TimeSinceLastBatch >= TraceInterval)
+	{
+		TimeSinceLastBatch = 0.0f;
+		IssueTraces();
+	}
+}
+
+TStatId UDieg_TraceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDieg_TraceSubsystem, STATGROUP_Tickables);
+}
+
+bool UDieg_TraceSubsystem::IsTickable() const
+{
+	return !Groups.IsEmpty();
+}
+
+void UDieg_TraceSubsystem::DeliverResults()
+{
+	UWorld* World = GetWorld();
+
+	// By index and by copy, callbacks may register or unregister traces
+	for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+	{
+		FDieg_TraceGroup& Group = Groups[GroupIndex];
+		if (!Group.PendingTrace.IsValid())
+		{
+			continue;
+		}
+
+		FTraceDatum TraceDatum;
+		const bool bHasData = World->QueryTraceData(Group.PendingTrace, TraceDatum);
+		Group.PendingTrace = FTraceHandle();
+		if (!bHasData)
+		{
+			continue;
+		}
+
+		const FHitResult* BlockingHit = TraceDatum.OutHits.FindByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		const FHitResult HitResult = BlockingHit ? *BlockingHit : FHitResult(TraceDatum.Start, TraceDatum.End);
+		const TArray<FDieg_TraceListener> Listeners = Group.Listeners;
+		for (const FDieg_TraceListener& Listener : Listeners)
+		{
+			INC_DWORD_STAT(STAT_Dieg_TraceResultsDelivered);
+			Listener.Callback.ExecuteIfBound(HitResult, BlockingHit != nullptr);
+		}
+	}
+}
+
+void UDieg_TraceSubsystem::IssueTraces()
+{
+	Groups.RemoveAll([](const FDieg_TraceGroup& Group)
+	{
+		return Group.Listeners.IsEmpty() || !Group.PlayerController.IsValid();
+	});
+
+	UWorld* World = GetWorld();
+	const double Now = World->GetRealTimeSeconds();
+	for (FDieg_TraceGroup& Group : Groups)
+	{
+		FVector Start;
+		FVector Direction;
+		if (!ComputeTraceRay(Group.PlayerController.Get(), Group.Origin, Start, Direction))
+		{
+			continue;
+		}
+
+		// Nothing moved, the last result still holds
+		if (Group.bHasLastTrace && Now - Group.LastTraceTime < MaxStillTraceAge
+			&& Start.Equals(Group.LastStart, StillTolerance) && Direction.Equals(Group.LastDirection, StillTolerance))
+		{
+			INC_DWORD_STAT(STAT_Dieg_TracesSkipped);
+			continue;
+		}
+
+		INC_DWORD_STAT(STAT_Dieg_TracesIssued);
+		Group.PendingTrace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Start + Direction * Group.Length, Group.Channel);
+		Group.LastStart = Start;
+		Group.LastDirection = Direction;
+		Group.LastTraceTime = Now;
+		Group.bHasLastTrace = true;
+	}
+}
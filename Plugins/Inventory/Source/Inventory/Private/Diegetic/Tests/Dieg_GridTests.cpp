@@ -0,0 +1,302 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Blueprint/UserWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/GridPanel.h"
+#include "Components/Image.h"
+#include "Debugging/SlateDebugging.h"
+#include "Diegetic/Components/Dieg_InventoryComponent.h"
+#include "Diegetic/UStructs/Dieg_RotatedShape.h"
+#include "Diegetic/Widgets/Dieg_Grid.h"
+#include "Diegetic/Widgets/Dieg_Slot.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Dieg_GridTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	// Native grid with the panel a widget blueprint would bind, and plain native slots
+	UDieg_Grid* CreateGrid(UWorld* World, const int32 TotalSlots, const int32 MaxColumns, const bool bBatchSlotStatus = true)
+	{
+		UDieg_Grid* Grid = CreateWidget<UDieg_Grid>(World, UDieg_Grid::StaticClass());
+		Grid->GridPanel = Grid->WidgetTree->ConstructWidget<UGridPanel>();
+		Grid->WidgetTree->RootWidget = Grid->GridPanel;
+		Grid->SlotClass = UDieg_Slot::StaticClass();
+		Grid->bBatchSlotStatus = bBatchSlotStatus;
+		Grid->CreateEmptyGrid(TotalSlots, MaxColumns);
+		return Grid;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_GridFindSlotTest, "Inventory.Diegetic.Grid.FindSlot", Dieg_GridTests::TestFlags)
+
+bool FDieg_GridFindSlotTest::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_GridTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// Two grids open at once, with different shapes
+	UDieg_Grid* GridA = CreateGrid(World, 6, 3);
+	UDieg_Grid* GridB = CreateGrid(World, 8, 4);
+	TestEqual(TEXT("Grid A has a slot per cell"), GridA->GetSlots().Num(), 6);
+	TestEqual(TEXT("Grid B has a slot per cell"), GridB->GetSlots().Num(), 8);
+
+	for (int32 Y = 0; Y < 2; ++Y)
+	{
+		for (int32 X = 0; X < 3; ++X)
+		{
+			const FIntPoint Coordinates(X, Y);
+			UDieg_Slot* SlotA = GridA->FindSlot(Coordinates);
+			UDieg_Slot* SlotB = GridB->FindSlot(Coordinates);
+			if (!TestNotNull(TEXT("Grid A finds its slot"), SlotA) || !TestNotNull(TEXT("Grid B finds its slot"), SlotB))
+			{
+				return false;
+			}
+			TestTrue(FString::Printf(TEXT("Slots at %s are not shared"), *Coordinates.ToString()), SlotA != SlotB);
+			TestTrue(TEXT("Grid A slot is at the requested cell"), SlotA->LastUpdatedCoordinate == Coordinates);
+			TestTrue(TEXT("Grid B slot is at the requested cell"), SlotB->LastUpdatedCoordinate == Coordinates);
+			TestTrue(TEXT("Grid A slot map holds its own slot"), GridA->GetSlotMapBP().FindRef(Coordinates) == SlotA);
+			TestTrue(TEXT("Grid B slot map holds its own slot"), GridB->GetSlotMapBP().FindRef(Coordinates) == SlotB);
+		}
+	}
+
+	// Cells only one grid has
+	TestNull(TEXT("Grid A has no fourth column"), GridA->FindSlot(FIntPoint(3, 0)));
+	TestNotNull(TEXT("Grid B has a fourth column"), GridB->FindSlot(FIntPoint(3, 1)));
+	TestNull(TEXT("Out of bounds coordinates find nothing"), GridB->FindSlot(FIntPoint(-1, 0)));
+
+	// Rebuilding one grid leaves the other untouched
+	UDieg_Slot* SlotBBefore = GridB->FindSlot(FIntPoint(2, 1));
+	GridA->CreateEmptyGrid(4, 2);
+	TestEqual(TEXT("Rebuilt grid A has its new slot count"), GridA->GetSlots().Num(), 4);
+	TestNull(TEXT("Rebuilt grid A lost its third column"), GridA->FindSlot(FIntPoint(2, 0)));
+	TestTrue(TEXT("Grid B keeps its slots"), GridB->FindSlot(FIntPoint(2, 1)) == SlotBBefore);
+	TestEqual(TEXT("Grid B keeps its slot count"), GridB->GetSlots().Num(), 8);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_GridVirtualizedSlotsTest, "Inventory.Diegetic.Grid.VirtualizedSlots", Dieg_GridTests::TestFlags)
+
+bool FDieg_GridVirtualizedSlotsTest::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_GridTests;
+
+	constexpr int32 Size = 100;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// No overlay image or material bound, the grid batches statuses itself
+	UDieg_Grid* Grid = CreateWidget<UDieg_Grid>(World, UDieg_Grid::StaticClass());
+	Grid->GridPanel = Grid->WidgetTree->ConstructWidget<UGridPanel>();
+	Grid->WidgetTree->RootWidget = Grid->GridPanel;
+	Grid->SlotClass = UDieg_Slot::StaticClass();
+	Grid->bVirtualizeSlots = true;
+	Grid->CreateEmptyGrid(Size * Size, Size);
+	TestTrue(TEXT("Statuses are batched without an overlay"), Grid->IsStatusBatched());
+	TestTrue(TEXT("Slots are virtualized without an overlay"), Grid->IsSlotsVirtualized());
+
+	auto CountSlotWidgets = [Grid]()
+	{
+		int32 NumWidgets = 0;
+		for (const UDieg_Slot* GridSlot : Grid->GetSlots())
+		{
+			NumWidgets += GridSlot != nullptr;
+		}
+		return NumWidgets;
+	};
+	TestEqual(TEXT("No slot widget before the grid is in view"), CountSlotWidgets(), 0);
+
+	// Cells without a widget still take a status
+	const TArray<FIntPoint> Hovered = { FIntPoint(1, 1), FIntPoint(2, 1), FIntPoint(90, 90) };
+	Grid->UpdateHoveringSlots(Hovered, EDieg_SlotStatus::Occupied, EDieg_SlotStatus::None);
+
+	// Five cells in view each way, plus the margin of two
+	const FVector2D CellSize(100.0f, 100.0f);
+	Grid->NativeTick(FGeometry::MakeRoot(CellSize * 5.0f, FSlateLayoutTransform()), 1.0f / 60.0f);
+	TestEqual(TEXT("Only the cells in view get a widget"), CountSlotWidgets(), 7 * 7);
+	UDieg_Slot* HoveredSlot = Grid->FindSlot(FIntPoint(2, 1));
+	if (TestNotNull(TEXT("A cell in view has a slot"), HoveredSlot))
+	{
+		TestTrue(TEXT("The realized slot shows the status set before it existed"), HoveredSlot->SlotStatus == EDieg_SlotStatus::Occupied);
+	}
+	TestNull(TEXT("A cell out of view has no slot"), Grid->FindSlot(FIntPoint(90, 90)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_GridHoverBenchmark, "Inventory.Diegetic.Grid.HoverBenchmark", Dieg_GridTests::TestFlags)
+
+bool FDieg_GridHoverBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_GridTests;
+
+	constexpr int32 Size = 40;
+	constexpr double BudgetMicroseconds = 50.0;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UDieg_Grid* Grid = CreateGrid(World, Size * Size, Size);
+	AActor* Owner = World->SpawnActor<AActor>();
+	UDieg_InventoryComponent* Inventory = NewObject<UDieg_InventoryComponent>(Owner);
+	Inventory->Initialize(Size * Size, Size, FGameplayTagContainer());
+
+	// L shaped item, baked the way the definition asset bakes it for the drag preview
+	const TArray<FIntPoint> Shape = { FIntPoint(0, 0), FIntPoint(0, 1), FIntPoint(0, 2), FIntPoint(1, 2) };
+	TArray<FDieg_RotatedShape> RotatedShapes;
+	for (const int32 Rotation : { 0, 90, 180, -90 })
+	{
+		RotatedShapes.Add(FDieg_RotatedShape::Build(Shape, FIntPoint(0, 0), Rotation));
+	}
+
+	// What the input handler does per hovered slot: preview cells, grid statuses, fit test
+	TArray<FIntPoint, TInlineAllocator<16>> PreviewCoordinates;
+	int32 NumHovers = 0;
+	int32 NumFits = 0;
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	for (const FDieg_RotatedShape& RotatedShape : RotatedShapes)
+	{
+		for (int32 Index = 0; Index < Size * Size; ++Index)
+		{
+			const FIntPoint PlacementCoordinates(Index % Size, Index / Size);
+			PreviewCoordinates.Reset();
+			for (const FIntPoint& Cell : RotatedShape.Cells)
+			{
+				PreviewCoordinates.Add(Cell + PlacementCoordinates);
+			}
+			Grid->UpdateHoveringCoordinates(PreviewCoordinates, EDieg_SlotStatus::Occupied, EDieg_SlotStatus::None);
+			NumFits += Inventory->DoesShapeFit(RotatedShape.Mask, PlacementCoordinates);
+			++NumHovers;
+		}
+	}
+	const double HoverMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumHovers;
+	Grid->UpdateHoveringCoordinates({}, EDieg_SlotStatus::None, EDieg_SlotStatus::None);
+
+	TestTrue(TEXT("The shape fits somewhere on the empty grid"), NumFits > 0);
+	TestTrue(TEXT("The shape doesn't fit past the grid edges"), NumFits < NumHovers);
+	TestTrue(FString::Printf(TEXT("A hover takes under %.0f us"), BudgetMicroseconds), HoverMicroseconds < BudgetMicroseconds);
+	AddInfo(FString::Printf(TEXT("%dx%d grid: %d hovers at %.2f us each"), Size, Size, NumHovers, HoverMicroseconds));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_GridStatusBatchingBenchmark, "Inventory.Diegetic.Grid.StatusBatchingBenchmark", Dieg_GridTests::TestFlags)
+
+bool FDieg_GridStatusBatchingBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_GridTests;
+
+	constexpr int32 Size = 40;
+	constexpr int32 ShapeSize = 3;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// Slot colors are class defaults, as a slot blueprint would set them
+	UDieg_Slot* SlotDefaults = GetMutableDefault<UDieg_Slot>();
+	const TMap<EDieg_SlotStatus, FLinearColor> PreviousColors = SlotDefaults->SlotFillColor;
+	SlotDefaults->SlotFillColor = { { EDieg_SlotStatus::None, FLinearColor::Gray }, { EDieg_SlotStatus::Occupied, FLinearColor::Green } };
+	ON_SCOPE_EXIT
+	{
+		SlotDefaults->SlotFillColor = PreviousColors;
+	};
+
+	// No overlay image and no material, only the native grid
+	UDieg_Grid* BatchedGrid = CreateGrid(World, Size * Size, Size);
+	UDieg_Grid* PerSlotGrid = CreateGrid(World, Size * Size, Size, false);
+	TestTrue(TEXT("Status batching is on without any editor assets"), BatchedGrid->IsStatusBatched());
+	TestFalse(TEXT("Status batching can be turned off"), PerSlotGrid->IsStatusBatched());
+
+	// Per-slot colors need the fill image the slot blueprints have
+	for (UDieg_Slot* GridSlot : PerSlotGrid->GetSlots())
+	{
+		GridSlot->Image_Fill = GridSlot->WidgetTree->ConstructWidget<UImage>();
+		GridSlot->WidgetTree->RootWidget = GridSlot->Image_Fill;
+	}
+
+	// Real Slate widgets, so color changes invalidate like they do on screen
+	BatchedGrid->TakeWidget();
+	PerSlotGrid->TakeWidget();
+
+	int32 NumInvalidations = 0;
+#if WITH_SLATE_DEBUGGING
+	const FDelegateHandle InvalidateHandle = FSlateDebugging::WidgetInvalidateEvent.AddLambda(
+		[&NumInvalidations](const FSlateDebuggingInvalidateArgs&)
+		{
+			++NumInvalidations;
+		});
+	ON_SCOPE_EXIT
+	{
+		FSlateDebugging::WidgetInvalidateEvent.Remove(InvalidateHandle);
+	};
+#endif
+
+	// A 3x3 item dragged over every cell, one frame per hovered cell
+	auto Sweep = [&NumInvalidations](UDieg_Grid* Grid, double& OutMicroseconds, int32& OutInvalidations)
+	{
+		TArray<FIntPoint, TInlineAllocator<16>> PreviewCoordinates;
+		int32 NumHovers = 0;
+		NumInvalidations = 0;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		for (int32 Y = 0; Y <= Size - ShapeSize; ++Y)
+		{
+			for (int32 X = 0; X <= Size - ShapeSize; ++X)
+			{
+				PreviewCoordinates.Reset();
+				for (int32 CellY = 0; CellY < ShapeSize; ++CellY)
+				{
+					for (int32 CellX = 0; CellX < ShapeSize; ++CellX)
+					{
+						PreviewCoordinates.Emplace(X + CellX, Y + CellY);
+					}
+				}
+				Grid->UpdateHoveringCoordinates(PreviewCoordinates, EDieg_SlotStatus::Occupied, EDieg_SlotStatus::None);
+				Grid->NativeTick(FGeometry(), 1.0f / 60.0f);
+				++NumHovers;
+			}
+		}
+		OutMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumHovers;
+		OutInvalidations = NumInvalidations;
+		return NumHovers;
+	};
+
+	double BatchedMicroseconds = 0.0;
+	double PerSlotMicroseconds = 0.0;
+	int32 BatchedInvalidations = 0;
+	int32 PerSlotInvalidations = 0;
+	const int32 NumFrames = Sweep(BatchedGrid, BatchedMicroseconds, BatchedInvalidations);
+	Sweep(PerSlotGrid, PerSlotMicroseconds, PerSlotInvalidations);
+
+	TestTrue(TEXT("Both grids show the last hover"), BatchedGrid->FindSlot(FIntPoint(Size - 1, Size - 1))->SlotStatus == EDieg_SlotStatus::Occupied
+		&& PerSlotGrid->FindSlot(FIntPoint(Size - 1, Size - 1))->SlotStatus == EDieg_SlotStatus::Occupied);
+#if WITH_SLATE_DEBUGGING
+	TestTrue(TEXT("The batched grid invalidates at most once per frame"), BatchedInvalidations <= NumFrames);
+	TestTrue(TEXT("The batched grid invalidates less than per-slot colors"), BatchedInvalidations < PerSlotInvalidations);
+#endif
+	AddInfo(FString::Printf(TEXT("%dx%d grid, %d frames: batched %.2f us and %d invalidations, per-slot %.2f us and %d invalidations"),
+		Size, Size, NumFrames, BatchedMicroseconds, BatchedInvalidations, PerSlotMicroseconds, PerSlotInvalidations));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,452 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Diegetic/Components/Dieg_InventoryComponent.h"
+#include "Diegetic/UObjects/Dieg_ItemDefinitionDataAsset.h"
+#include "Diegetic/UObjects/Dieg_ItemInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Dieg_InventoryComponentTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	// Definition with its rotated shapes baked, as the asset does on load
+	UDieg_ItemDefinitionDataAsset* CreateDefinition(const TArray<FIntPoint>& Shape, const int32 StackSizeMax)
+	{
+		UDieg_ItemDefinitionDataAsset* Definition = NewObject<UDieg_ItemDefinitionDataAsset>(GetTransientPackage());
+		Definition->ItemDefinition.StackSizeMax = StackSizeMax;
+		Definition->ItemDefinition.DefaultShape = Shape;
+		UDieg_ItemDefinitionDataAsset::SetItemDefinitionShapeRoot(Definition->ItemDefinition);
+		Definition->BuildRotatedShapes();
+		return Definition;
+	}
+
+	// Single cell stackable definition
+	UDieg_ItemDefinitionDataAsset* CreateStackableDefinition(const int32 StackSizeMax)
+	{
+		return CreateDefinition({ FIntPoint(0, 0) }, StackSizeMax);
+	}
+
+	// Rectangle of Size.X by Size.Y cells
+	TArray<FIntPoint> MakeRectShape(const FIntPoint& Size)
+	{
+		TArray<FIntPoint> Cells;
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			for (int32 X = 0; X < Size.X; ++X)
+			{
+				Cells.Emplace(X, Y);
+			}
+		}
+		return Cells;
+	}
+
+	UDieg_ItemInstance* CreateItem(UObject* Outer, UDieg_ItemDefinitionDataAsset* Definition, const int32 Quantity)
+	{
+		UDieg_ItemInstance* Item = NewObject<UDieg_ItemInstance>(Outer);
+		Item->Initialize(Definition, Quantity);
+		return Item;
+	}
+
+	// Component owned by a fresh actor of the test world
+	UDieg_InventoryComponent* CreateInventory(UWorld* World, const int32 NumSlots, const int32 NumColumns)
+	{
+		AActor* Owner = World->SpawnActor<AActor>();
+		UDieg_InventoryComponent* Inventory = NewObject<UDieg_InventoryComponent>(Owner);
+		Inventory->Initialize(NumSlots, NumColumns, FGameplayTagContainer());
+		return Inventory;
+	}
+
+	// Quantity held by every placed item
+	int32 GetTotalQuantity(const UDieg_InventoryComponent* Inventory)
+	{
+		int32 Total = 0;
+		for (const FDieg_InventorySlot& RootSlot : Inventory->GetRootSlots())
+		{
+			Total += RootSlot.ItemInstance->GetQuantity();
+		}
+		return Total;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_InventoryMergeIntoItemsTest, "Inventory.Diegetic.InventoryComponent.MergeIntoItems",
+	Dieg_InventoryComponentTests::TestFlags)
+
+bool FDieg_InventoryMergeIntoItemsTest::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_InventoryComponentTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UDieg_InventoryComponent* Inventory = CreateInventory(World, 6, 3);
+
+	// Fill the grid with stacks of the same definition, one of another definition in the middle
+	UDieg_ItemDefinitionDataAsset* Ammo = CreateStackableDefinition(10);
+	UDieg_ItemDefinitionDataAsset* Coins = CreateStackableDefinition(10);
+	const int32 Quantities[] = { 10, 4, 7, 5, 2, 10 };
+	TArray<UDieg_ItemInstance*> Placed;
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Quantities); ++Index)
+	{
+		UDieg_ItemInstance* Item = CreateItem(Inventory, Index == 3 ? Coins : Ammo, Quantities[Index]);
+		if (!TestTrue(TEXT("Stack is placed"), Inventory->AddItemToInventory(Item, FIntPoint(Index % 3, Index / 3), 0.0f)))
+		{
+			return false;
+		}
+		Placed.Add(Item);
+	}
+
+	// Dropped over the top row and the other definition: the full stack and the coins are skipped
+	UDieg_ItemInstance* Dropped = CreateItem(Inventory, Ammo, 9);
+	const TArray<FIntPoint> Roots = { FIntPoint(0, 0), FIntPoint(0, 1), FIntPoint(1, 0), FIntPoint(2, 0), FIntPoint(1, 1) };
+	const int32 VersionBefore = Inventory->GetChangeVersion();
+	TArray<UDieg_ItemInstance*> Merged;
+	const int32 Remaining = Inventory->MergeIntoItems(Dropped, Roots, Merged);
+
+	TestEqual(TEXT("The dropped stack fits"), Remaining, 0);
+	TestEqual(TEXT("The dropped item keeps what did not fit"), Dropped->GetQuantity(), 0);
+	TestEqual(TEXT("Full stack is unchanged"), Placed[0]->GetQuantity(), 10);
+	TestEqual(TEXT("First open stack is filled"), Placed[1]->GetQuantity(), 10);
+	TestEqual(TEXT("Second open stack gets the rest"), Placed[2]->GetQuantity(), 10);
+	TestEqual(TEXT("Other definition is unchanged"), Placed[3]->GetQuantity(), 5);
+	TestEqual(TEXT("Stacks past the merged quantity are unchanged"), Placed[4]->GetQuantity(), 2);
+	TestTrue(TEXT("Merged items are the filled stacks, in root order"),
+		Merged.Num() == 2 && Merged[0] == Placed[1] && Merged[1] == Placed[2]);
+
+	// One transaction: a quantity change per target, back to back, nothing else
+	TArray<FDieg_InventoryChange> Changes;
+	TestTrue(TEXT("The journal reaches back before the merge"), Inventory->GetChangesSince(VersionBefore, Changes));
+	if (TestEqual(TEXT("One journal entry per merged target"), Changes.Num(), 2))
+	{
+		for (int32 Index = 0; Index < Changes.Num(); ++Index)
+		{
+			const FDieg_InventoryChange& Change = Changes[Index];
+			TestTrue(TEXT("Merge entries are quantity changes"), Change.Type == EDieg_InventoryChangeType::QuantityChange);
+			TestEqual(TEXT("Merge entries are consecutive"), Change.Version, VersionBefore + Index + 1);
+			TestTrue(TEXT("Merge entries name the target"), Change.ItemInstance == Merged[Index]);
+			TestEqual(TEXT("Merge entries hold the quantity after the merge"), Change.Quantity, 10);
+		}
+	}
+
+	// A larger drop fills every open stack and keeps the leftover
+	UDieg_ItemInstance* Overflow = CreateItem(Inventory, Ammo, 10);
+	const int32 VersionBeforeOverflow = Inventory->GetChangeVersion();
+	const int32 Leftover = Inventory->MergeIntoItems(Overflow, Roots, Merged);
+	TestEqual(TEXT("Only the last open stack had room"), Leftover, 2);
+	TestEqual(TEXT("The dropped item keeps the leftover"), Overflow->GetQuantity(), 2);
+	TestEqual(TEXT("Last open stack is filled"), Placed[4]->GetQuantity(), 10);
+	TestTrue(TEXT("The journal reaches back before the overflow merge"), Inventory->GetChangesSince(VersionBeforeOverflow, Changes));
+	TestEqual(TEXT("One journal entry for the single target"), Changes.Num(), 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_InventoryTryAddItemPartialStackTest, "Inventory.Diegetic.InventoryComponent.TryAddItemPartialStack",
+	Dieg_InventoryComponentTests::TestFlags)
+
+bool FDieg_InventoryTryAddItemPartialStackTest::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_InventoryComponentTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UDieg_ItemDefinitionDataAsset* Ammo = CreateStackableDefinition(10);
+
+	// Single adds and the batch, from the same open stack and the same item
+	UDieg_InventoryComponent* Single = CreateInventory(World, 6, 3);
+	UDieg_InventoryComponent* Batch = CreateInventory(World, 6, 3);
+	UDieg_ItemInstance* SingleStack = CreateItem(Single, Ammo, 8);
+	UDieg_ItemInstance* BatchStack = CreateItem(Batch, Ammo, 8);
+	if (!TestTrue(TEXT("Open stack is placed"), Single->AddItemToInventory(SingleStack, FIntPoint(0, 0), 0.0f))
+		|| !TestTrue(TEXT("Open stack is placed in the batch inventory"), Batch->AddItemToInventory(BatchStack, FIntPoint(0, 0), 0.0f)))
+	{
+		return false;
+	}
+
+	// Two stacks go into the open stack, the other three need a slot of their own
+	UDieg_ItemInstance* SingleItem = CreateItem(Single, Ammo, 5);
+	int32 Remaining = INDEX_NONE;
+	TestTrue(TEXT("The item is added"), Single->TryAddItem(SingleItem, Remaining));
+	TestEqual(TEXT("Nothing remains"), Remaining, 0);
+	TestEqual(TEXT("The open stack is filled"), SingleStack->GetQuantity(), 10);
+	TestEqual(TEXT("The placed item keeps what the stack didn't take"), SingleItem->GetQuantity(), 3);
+	TestEqual(TEXT("No quantity is duplicated"), GetTotalQuantity(Single), 13);
+	TestEqual(TEXT("The item has a slot of its own"), Single->GetRootSlots().Num(), 2);
+
+	UDieg_ItemInstance* BatchItem = CreateItem(Batch, Ammo, 5);
+	TArray<int32> RemainingOut;
+	TestTrue(TEXT("The batch is added"), Batch->TryAddItemsBatch({ BatchItem }, RemainingOut));
+	TestTrue(TEXT("Nothing remains from the batch"), RemainingOut.Num() == 1 && RemainingOut[0] == 0);
+	TestEqual(TEXT("The batch fills the open stack"), BatchStack->GetQuantity(), 10);
+	TestEqual(TEXT("The batch places the same leftover"), BatchItem->GetQuantity(), SingleItem->GetQuantity());
+	TestEqual(TEXT("Both add paths hold the same quantity"), GetTotalQuantity(Batch), GetTotalQuantity(Single));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_InventoryPlacementBenchmark, "Inventory.Diegetic.InventoryComponent.PlacementBenchmark",
+	Dieg_InventoryComponentTests::TestFlags)
+
+bool FDieg_InventoryPlacementBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_InventoryComponentTests;
+
+	constexpr int32 Columns = 16;
+	constexpr int32 NumSlots = Columns * 24;
+	constexpr int32 NumRuns = 20;
+	constexpr int32 ItemsPerRun = 128;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// Rectangles up to 4x4 and a few irregular shapes, none of them stackable
+	TArray<UDieg_ItemDefinitionDataAsset*> Definitions;
+	for (int32 Y = 1; Y <= 4; ++Y)
+	{
+		for (int32 X = 1; X <= 4; ++X)
+		{
+			Definitions.Add(CreateDefinition(MakeRectShape(FIntPoint(X, Y)), 1));
+		}
+	}
+	Definitions.Add(CreateDefinition({ FIntPoint(0, 0), FIntPoint(0, 1), FIntPoint(0, 2), FIntPoint(1, 2) }, 1));
+	Definitions.Add(CreateDefinition({ FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(2, 0), FIntPoint(1, 1) }, 1));
+	Definitions.Add(CreateDefinition({ FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(1, 1), FIntPoint(2, 1) }, 1));
+
+	// The same shape streams for every strategy
+	FRandomStream Random(42);
+	TArray<UDieg_ItemDefinitionDataAsset*> Stream;
+	for (int32 Index = 0; Index < NumRuns * ItemsPerRun; ++Index)
+	{
+		Stream.Add(Definitions[Random.RandHelper(Definitions.Num())]);
+	}
+
+	const UEnum* StrategyEnum = StaticEnum<EDieg_PlacementStrategy>();
+	for (const EDieg_PlacementStrategy Strategy : { EDieg_PlacementStrategy::FirstFit, EDieg_PlacementStrategy::BottomLeftSkyline,
+		EDieg_PlacementStrategy::MinFragmentation, EDieg_PlacementStrategy::MaxRects })
+	{
+		const FString Name = StrategyEnum->GetNameStringByValue(static_cast<int64>(Strategy));
+		int32 Placed = 0;
+		int32 Insertions = 0;
+		uint64 InsertionCycles = 0;
+		double Fragmentation = 0.0;
+
+		for (int32 Run = 0; Run < NumRuns; ++Run)
+		{
+			UDieg_InventoryComponent* Inventory = CreateInventory(World, NumSlots, Columns);
+			Inventory->SetPlacementStrategy(Strategy);
+
+			// Items are created up front, only the insertion is timed
+			TArray<UDieg_ItemInstance*> Items;
+			for (int32 Index = Run * ItemsPerRun; Index < (Run + 1) * ItemsPerRun; ++Index)
+			{
+				Items.Add(CreateItem(Inventory, Stream[Index], 1));
+			}
+
+			int32 RunPlaced = 0;
+			for (UDieg_ItemInstance* Item : Items)
+			{
+				int32 Remaining = 0;
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				const bool bAdded = Inventory->TryAddItem(Item, Remaining);
+				InsertionCycles += FPlatformTime::Cycles64() - StartCycles;
+				RunPlaced += bAdded;
+			}
+			Placed += RunPlaced;
+			Insertions += Items.Num();
+			TestEqual(FString::Printf(TEXT("%s: every added item is in the grid"), *Name), Inventory->GetRootSlots().Num(), RunPlaced);
+
+			// Share of the free cells outside the largest free rectangle, 0 when all free space is one rectangle
+			FIntPoint Origin;
+			FIntPoint Size;
+			const int32 LargestFreeArea = Inventory->GetLargestFreeRect(Origin, Size);
+			const int32 FreeCells = Inventory->GetFreeCellCount();
+			Fragmentation += FreeCells > 0 ? 1.0 - static_cast<double>(LargestFreeArea) / FreeCells : 0.0;
+		}
+
+		TestTrue(FString::Printf(TEXT("%s places items"), *Name), Placed > 0);
+		AddInfo(FString::Printf(TEXT("%s: %d of %d items placed, fragmentation %.3f, %.2f us per insertion"),
+			*Name, Placed, Insertions, Fragmentation / NumRuns, FPlatformTime::ToMilliseconds64(InsertionCycles) * 1000.0 / Insertions));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_InventoryBatchBenchmark, "Inventory.Diegetic.InventoryComponent.BatchBenchmark",
+	Dieg_InventoryComponentTests::TestFlags)
+
+bool FDieg_InventoryBatchBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_InventoryComponentTests;
+
+	constexpr int32 NumItems = 50;
+	constexpr int32 NumIterations = 200;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// A loot crate: ammo, coins and herbs that stack, gear that doesn't
+	TArray<UDieg_ItemDefinitionDataAsset*> Stackables = { CreateStackableDefinition(10), CreateStackableDefinition(20), CreateStackableDefinition(5) };
+	TArray<UDieg_ItemDefinitionDataAsset*> Gear;
+	for (const FIntPoint& Size : { FIntPoint(1, 1), FIntPoint(1, 2), FIntPoint(2, 1), FIntPoint(2, 2), FIntPoint(1, 3) })
+	{
+		Gear.Add(CreateDefinition(MakeRectShape(Size), 1));
+	}
+
+	FRandomStream Random(11);
+	TArray<TPair<UDieg_ItemDefinitionDataAsset*, int32>> Crate;
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		if (Index % 5 < 3)
+		{
+			UDieg_ItemDefinitionDataAsset* Definition = Stackables[Random.RandHelper(Stackables.Num())];
+			Crate.Emplace(Definition, Random.RandRange(1, Definition->ItemDefinition.StackSizeMax));
+		}
+		else
+		{
+			Crate.Emplace(Gear[Random.RandHelper(Gear.Num())], 1);
+		}
+	}
+
+	uint64 SequentialCycles = 0;
+	uint64 BatchCycles = 0;
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		// Large enough for the whole crate, so both paths have to place everything
+		UDieg_InventoryComponent* Sequential = CreateInventory(World, 12 * 10, 12);
+		UDieg_InventoryComponent* Batch = CreateInventory(World, 12 * 10, 12);
+		TArray<UDieg_ItemInstance*> SequentialItems;
+		TArray<UDieg_ItemInstance*> BatchItems;
+		for (const TPair<UDieg_ItemDefinitionDataAsset*, int32>& Loot : Crate)
+		{
+			SequentialItems.Add(CreateItem(Sequential, Loot.Key, Loot.Value));
+			BatchItems.Add(CreateItem(Batch, Loot.Key, Loot.Value));
+		}
+
+		int32 SequentialRemaining = 0;
+		uint64 StartCycles = FPlatformTime::Cycles64();
+		for (UDieg_ItemInstance* Item : SequentialItems)
+		{
+			int32 Remaining = 0;
+			Sequential->TryAddItem(Item, Remaining);
+			SequentialRemaining += Remaining;
+		}
+		SequentialCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		TArray<int32> RemainingOut;
+		StartCycles = FPlatformTime::Cycles64();
+		const bool bAllAdded = Batch->TryAddItemsBatch(BatchItems, RemainingOut);
+		BatchCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		if (Iteration == 0)
+		{
+			int32 CrateQuantity = 0;
+			for (const TPair<UDieg_ItemDefinitionDataAsset*, int32>& Loot : Crate)
+			{
+				CrateQuantity += Loot.Value;
+			}
+			TestEqual(TEXT("The sequential path places the whole crate"), SequentialRemaining, 0);
+			TestTrue(TEXT("The batch places the whole crate"), bAllAdded);
+			TestEqual(TEXT("The sequential path holds the crate's quantity"), GetTotalQuantity(Sequential), CrateQuantity);
+			TestEqual(TEXT("Both paths hold the same quantity"), GetTotalQuantity(Batch), GetTotalQuantity(Sequential));
+		}
+	}
+
+	const double SequentialMicroseconds = FPlatformTime::ToMilliseconds64(SequentialCycles) * 1000.0 / NumIterations;
+	const double BatchMicroseconds = FPlatformTime::ToMilliseconds64(BatchCycles) * 1000.0 / NumIterations;
+	TestTrue(TEXT("The batch is not slower than adding the items one by one"), BatchCycles <= SequentialCycles);
+	AddInfo(FString::Printf(TEXT("%d item crate: %d TryAddItem calls %.1f us, TryAddItemsBatch %.1f us, %.2fx"),
+		NumItems, NumItems, SequentialMicroseconds, BatchMicroseconds, SequentialMicroseconds / FMath::Max(BatchMicroseconds, UE_DOUBLE_SMALL_NUMBER)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_InventoryRejectionBenchmark, "Inventory.Diegetic.InventoryComponent.RejectionBenchmark",
+	Dieg_InventoryComponentTests::TestFlags)
+
+bool FDieg_InventoryRejectionBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_InventoryComponentTests;
+
+	constexpr int32 Size = 40;
+	constexpr int32 NumQueries = 2000;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// 95% of the cells taken by single cell items, the free ones scattered
+	UDieg_InventoryComponent* Inventory = CreateInventory(World, Size * Size, Size);
+	UDieg_ItemDefinitionDataAsset* Pebble = CreateDefinition({ FIntPoint(0, 0) }, 1);
+	TArray<int32> Cells;
+	for (int32 Index = 0; Index < Size * Size; ++Index)
+	{
+		Cells.Add(Index);
+	}
+	FRandomStream Random(95);
+	for (int32 Index = Cells.Num() - 1; Index > 0; --Index)
+	{
+		Cells.Swap(Index, Random.RandRange(0, Index));
+	}
+	const int32 NumTaken = Size * Size * 95 / 100;
+	for (int32 Index = 0; Index < NumTaken; ++Index)
+	{
+		Inventory->AddItemToInventory(CreateItem(Inventory, Pebble, 1), FIntPoint(Cells[Index] % Size, Cells[Index] / Size), 0.0f);
+	}
+	TestEqual(TEXT("The grid is 95% full"), Inventory->GetFreeCellCount(), Size * Size - NumTaken);
+
+	// An item that needs a 3x3 block the scattered free cells can't give
+	UDieg_ItemDefinitionDataAsset* Crate = CreateDefinition(MakeRectShape(FIntPoint(3, 3)), 1);
+	UDieg_ItemInstance* Item = CreateItem(Inventory, Crate, 1);
+
+	// Every cell and rotation, what CanAddItem had to try before saying no
+	int32 ExhaustiveFits = 0;
+	uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Query = 0; Query < NumQueries / 100; ++Query)
+	{
+		for (int32 Index = 0; Index < Size * Size; ++Index)
+		{
+			for (const int32 Rotation : { 0, 90, 180, -90 })
+			{
+				ExhaustiveFits += Inventory->CanAddItemInstanceToSlot(FIntPoint(Index % Size, Index / Size), Item, Rotation);
+			}
+		}
+	}
+	const double ExhaustiveMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / (NumQueries / 100);
+
+	int32 Accepted = 0;
+	StartCycles = FPlatformTime::Cycles64();
+	for (int32 Query = 0; Query < NumQueries; ++Query)
+	{
+		Accepted += Inventory->CanAddItem(Item);
+	}
+	const double RejectionMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumQueries;
+
+	TestEqual(TEXT("No cell takes the item"), ExhaustiveFits, 0);
+	TestEqual(TEXT("CanAddItem rejects the item"), Accepted, 0);
+	TestFalse(TEXT("The free-space summary rejects the item"), Inventory->CouldEverFit(Crate));
+	TestTrue(TEXT("Early rejection is faster than the full search"), RejectionMicroseconds < ExhaustiveMicroseconds);
+	AddInfo(FString::Printf(TEXT("%dx%d grid at 95%%: CanAddItem rejects in %.3f us, the full cell and rotation search takes %.1f us"),
+		Size, Size, RejectionMicroseconds, ExhaustiveMicroseconds));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Diegetic/Actors/Dieg_WorldItemActor.h"
+#include "Diegetic/Components/Dieg_InventoryInputHandler.h"
+#include "Diegetic/UObjects/Dieg_ItemDefinitionDataAsset.h"
+#include "Diegetic/UObjects/Dieg_ItemInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Dieg_InventoryInputHandlerTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	// Item actor lying in the world, showing a fresh instance of a 2x2 definition
+	ADieg_WorldItemActor* CreateWorldItem(UWorld* World)
+	{
+		UDieg_ItemDefinitionDataAsset* Definition = NewObject<UDieg_ItemDefinitionDataAsset>(GetTransientPackage());
+		Definition->ItemDefinition.StackSizeMax = 1;
+		Definition->ItemDefinition.DefaultShape = { FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(0, 1), FIntPoint(1, 1) };
+		UDieg_ItemDefinitionDataAsset::SetItemDefinitionShapeRoot(Definition->ItemDefinition);
+		Definition->BuildRotatedShapes();
+
+		ADieg_WorldItemActor* ItemActor = World->SpawnActor<ADieg_WorldItemActor>();
+		UDieg_ItemInstance* Item = NewObject<UDieg_ItemInstance>(ItemActor);
+		Item->Initialize(Definition, 1);
+		ItemActor->SetFromItemInstance(Item);
+		return ItemActor;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_InputHandlerDragBenchmark, "Inventory.Diegetic.InputHandler.DragBenchmark",
+	Dieg_InventoryInputHandlerTests::TestFlags)
+
+bool FDieg_InputHandlerDragBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_InventoryInputHandlerTests;
+
+	constexpr int32 NumCycles = 10000;
+	constexpr double BudgetMicroseconds = 50.0;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	// No controller, the grab trace finds nothing and every drag starts and ends in the world
+	AActor* Owner = World->SpawnActor<AActor>();
+	UDieg_InventoryInputHandler* Handler = NewObject<UDieg_InventoryInputHandler>(Owner);
+	ADieg_WorldItemActor* ItemActor = CreateWorldItem(World);
+	Handler->HoveringItem = ItemActor;
+
+	// One cycle checked on its own, the drag reaches the actor without binding anything to it
+	Handler->TryDragItem();
+	TestTrue(TEXT("The hovered actor is being dragged"), Handler->DraggingItem.Get() == ItemActor);
+	TestFalse(TEXT("The dragged actor doesn't collide"), ItemActor->GetActorEnableCollision());
+	Handler->TryDropItem();
+	TestFalse(TEXT("Nothing is dragged after the drop"), Handler->DraggingItem.IsValid());
+	TestTrue(TEXT("The dropped actor collides again"), ItemActor->GetActorEnableCollision());
+	TestTrue(TEXT("Dropping in the world clears the coordinates"), ItemActor->GetCoordinates() == FIntPoint(-1, -1));
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+	{
+		Handler->TryDragItem();
+		Handler->TryDropItem();
+	}
+	const double CycleMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumCycles;
+
+	TestFalse(TEXT("Nothing is dragged after the last drop"), Handler->DraggingItem.IsValid());
+	TestTrue(FString::Printf(TEXT("A start/stop drag takes under %.0f us"), BudgetMicroseconds), CycleMicroseconds < BudgetMicroseconds);
+	AddInfo(FString::Printf(TEXT("%d start/stop drags at %.2f us each"), NumCycles, CycleMicroseconds));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
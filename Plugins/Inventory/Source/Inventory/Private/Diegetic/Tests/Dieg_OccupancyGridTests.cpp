@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Diegetic/UStructs/Dieg_OccupancyGrid.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace Dieg_OccupancyGridTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	bool IsRectFree(const FDieg_OccupancyGrid& Grid, const FIntRect& Rect)
+	{
+		for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+		{
+			for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+			{
+				if (!Grid.IsAvailable(FIntPoint(X, Y)))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// Per cell lookups against an occupation map, as the component tested shapes before the bitboard
+	bool DoesShapeFitMap(const TMap<FIntPoint, bool>& Occupation, const TArray<FIntPoint>& Shape, const FIntPoint& Coordinates)
+	{
+		for (const FIntPoint& Cell : Shape)
+		{
+			const bool* bOccupied = Occupation.Find(Cell + Coordinates);
+			if (!bOccupied || *bOccupied)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_OccupancyGridMaximalFreeRectsTest, "Inventory.Diegetic.OccupancyGrid.MaximalFreeRects",
+	Dieg_OccupancyGridTests::TestFlags)
+
+bool FDieg_OccupancyGridMaximalFreeRectsTest::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_OccupancyGridTests;
+
+	FDieg_OccupancyGrid Grid;
+	Grid.Initialize(6 * 5, 6);
+	TestEqual(TEXT("An empty grid is one maximal rectangle"), Grid.GetMaximalFreeRects().Num(), 1);
+	TestTrue(TEXT("The maximal rectangle of an empty grid is the grid"), Grid.GetMaximalFreeRects()[0] == FIntRect(0, 0, 6, 5));
+
+	// A single blocked cell in the middle leaves the four bands around it
+	Grid.SetOccupied(FIntPoint(2, 2), true);
+	TArray<FIntRect> Expected = { FIntRect(0, 0, 6, 2), FIntRect(0, 0, 2, 5), FIntRect(3, 0, 6, 5), FIntRect(0, 3, 6, 5) };
+	TestEqual(TEXT("Blocking one cell leaves four maximal rectangles"), Grid.GetMaximalFreeRects().Num(), Expected.Num());
+	for (const FIntRect& Rect : Expected)
+	{
+		TestTrue(FString::Printf(TEXT("Maximal rectangles contain %s"), *Rect.ToString()), Grid.GetMaximalFreeRects().Contains(Rect));
+	}
+
+	// Random grids against the definition: free, not growable in any direction, and no duplicates
+	FRandomStream Random(1337);
+	for (int32 Iteration = 0; Iteration < 50; ++Iteration)
+	{
+		const int32 Columns = Random.RandRange(1, 12);
+		const int32 NumSlots = Random.RandRange(1, 96);
+		Grid.Initialize(NumSlots, Columns);
+		for (int32 Index = 0; Index < NumSlots; ++Index)
+		{
+			Grid.SetOccupied(FIntPoint(Index % Columns, Index / Columns), Random.FRand() < 0.3f);
+		}
+
+		const TArray<FIntRect>& Rects = Grid.GetMaximalFreeRects();
+		for (int32 RectIndex = 0; RectIndex < Rects.Num(); ++RectIndex)
+		{
+			const FIntRect& Rect = Rects[RectIndex];
+			const bool bMaximal = IsRectFree(Grid, Rect)
+				&& !IsRectFree(Grid, FIntRect(Rect.Min - FIntPoint(1, 0), Rect.Max))
+				&& !IsRectFree(Grid, FIntRect(Rect.Min - FIntPoint(0, 1), Rect.Max))
+				&& !IsRectFree(Grid, FIntRect(Rect.Min, Rect.Max + FIntPoint(1, 0)))
+				&& !IsRectFree(Grid, FIntRect(Rect.Min, Rect.Max + FIntPoint(0, 1)));
+			if (!TestTrue(FString::Printf(TEXT("Rectangle %s is free and maximal"), *Rect.ToString()), bMaximal)
+				|| !TestEqual(TEXT("Rectangles are listed once"), Rects.IndexOfByKey(Rect), RectIndex))
+			{
+				return false;
+			}
+		}
+
+		// Every free cell is covered by some maximal rectangle
+		for (int32 Index = 0; Index < NumSlots; ++Index)
+		{
+			const FIntPoint Point(Index % Columns, Index / Columns);
+			if (Grid.IsAvailable(Point) && !Rects.ContainsByPredicate([&Point](const FIntRect& Rect) { return Rect.Contains(Point); }))
+			{
+				AddError(FString::Printf(TEXT("Free cell %s is not covered by a maximal rectangle"), *Point.ToString()));
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDieg_OccupancyGridFitTestBenchmark, "Inventory.Diegetic.OccupancyGrid.FitTestBenchmark",
+	Dieg_OccupancyGridTests::TestFlags)
+
+bool FDieg_OccupancyGridFitTestBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace Dieg_OccupancyGridTests;
+
+	// Single cell, bars, squares and an L, the shapes a stash is mostly made of
+	const TArray<TArray<FIntPoint>> Shapes = {
+		{ FIntPoint(0, 0) },
+		{ FIntPoint(0, 0), FIntPoint(1, 0) },
+		{ FIntPoint(0, 0), FIntPoint(0, 1), FIntPoint(0, 2) },
+		{ FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(0, 1), FIntPoint(1, 1) },
+		{ FIntPoint(0, 0), FIntPoint(0, 1), FIntPoint(0, 2), FIntPoint(1, 2) },
+		{ FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(2, 0), FIntPoint(0, 1), FIntPoint(1, 1), FIntPoint(2, 1) },
+	};
+	TArray<FDieg_ShapeMask> Masks;
+	for (const TArray<FIntPoint>& Shape : Shapes)
+	{
+		Masks.Add(FDieg_ShapeMask::Build(Shape));
+	}
+
+	FRandomStream Random(7);
+	for (const int32 Size : { 10, 40, 100 })
+	{
+		// A third of the cells taken, the same in both representations
+		FDieg_OccupancyGrid Grid;
+		Grid.Initialize(Size * Size, Size);
+		TMap<FIntPoint, bool> Occupation;
+		Occupation.Reserve(Size * Size);
+		for (int32 Index = 0; Index < Size * Size; ++Index)
+		{
+			const FIntPoint Point(Index % Size, Index / Size);
+			const bool bOccupied = Random.FRand() < 0.33f;
+			Grid.SetOccupied(Point, bOccupied);
+			Occupation.Add(Point, bOccupied);
+		}
+
+		// Every shape at every cell, repeated to about a million fit tests per size
+		const int32 NumPasses = FMath::Max(1, 1000000 / (Size * Size * Masks.Num()));
+		const int64 NumTests = static_cast<int64>(NumPasses) * Size * Size * Masks.Num();
+
+		int64 MaskFits = 0;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (int32 Index = 0; Index < Size * Size; ++Index)
+			{
+				const FIntPoint Coordinates(Index % Size, Index / Size);
+				for (const FDieg_ShapeMask& Mask : Masks)
+				{
+					MaskFits += Grid.DoesMaskFit(Mask, Coordinates);
+				}
+			}
+		}
+		const double MaskSeconds = FPlatformTime::Seconds() - StartTime;
+
+		int64 MapFits = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < NumPasses; ++Pass)
+		{
+			for (int32 Index = 0; Index < Size * Size; ++Index)
+			{
+				const FIntPoint Coordinates(Index % Size, Index / Size);
+				for (const TArray<FIntPoint>& Shape : Shapes)
+				{
+					MapFits += DoesShapeFitMap(Occupation, Shape, Coordinates);
+				}
+			}
+		}
+		const double MapSeconds = FPlatformTime::Seconds() - StartTime;
+
+		TestEqual(FString::Printf(TEXT("%dx%d: both fit tests agree"), Size, Size), MaskFits, MapFits);
+		TestTrue(FString::Printf(TEXT("%dx%d: the bitboard is faster than the map"), Size, Size), MaskSeconds < MapSeconds);
+		AddInfo(FString::Printf(TEXT("%dx%d: DoesMaskFit %.1f M tests/s, map lookup %.1f M tests/s, %.1fx"),
+			Size, Size, NumTests / MaskSeconds / 1.0e6, NumTests / MapSeconds / 1.0e6, MapSeconds / MaskSeconds));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -5,11 +5,19 @@
 
 #include "UObject/ObjectSaveContext.h"
 
+void UDieg_ItemDefinitionDataAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	BuildRotatedShapes();
+}
+
 void UDieg_ItemDefinitionDataAsset::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
 	SetItemDefinitionShapeRoot(ItemDefinition);
+	BuildRotatedShapes();
 }
 
 void UDieg_ItemDefinitionDataAsset::PostSaveRoot(FObjectPostSaveRootContext ObjectSaveContext)
@@ -17,6 +25,7 @@ void UDieg_ItemDefinitionDataAsset::PostSaveRoot(FObjectPostSaveRootContext Obje
 	Super::PostSaveRoot(ObjectSaveContext);
 
 	SetItemDefinitionShapeRoot(ItemDefinition);
+	BuildRotatedShapes();
 }
 
 void UDieg_ItemDefinitionDataAsset::SetItemDefinitionShapeRoot(FDieg_ItemDefinition& ItemDef)
@@ -38,3 +47,27 @@ void UDieg_ItemDefinitionDataAsset::SetItemDefinitionShapeRoot(FDieg_ItemDefinit
 		ItemDef.DefaultShapeRoot = TopLeftMost;
 	}
 }
+
+void UDieg_ItemDefinitionDataAsset::BuildRotatedShapes()
+{
+	RotatedShapes.Reset(4);
+	for (const int32 Rotation : { 0, 90, 180, -90 })
+	{
+		RotatedShapes.Add(FDieg_RotatedShape::Build(ItemDefinition.DefaultShape, ItemDefinition.DefaultShapeRoot, Rotation));
+	}
+}
+
+const FDieg_RotatedShape& UDieg_ItemDefinitionDataAsset::GetRotatedShape(const float Rotation) const
+{
+	return GetRotatedShapes()[FDieg_RotatedShape::GetRotationIndex(Rotation)];
+}
+
+const TArray<FDieg_RotatedShape>& UDieg_ItemDefinitionDataAsset::GetRotatedShapes() const
+{
+	// Assets created in memory never went through PostLoad, bake on first use
+	if (RotatedShapes.Num() != 4)
+	{
+		const_cast<UDieg_ItemDefinitionDataAsset*>(this)->BuildRotatedShapes();
+	}
+	return RotatedShapes;
+}
@@ -27,6 +27,8 @@ void UDieg_ItemInstance::Initialize(UDieg_ItemDefinitionDataAsset* Def, int32 In
 			ItemFragments.Add(InstancedFragment);
 		}
 	}
+
+	UpdateStackKey();
 }
 
 bool UDieg_ItemInstance::IsEqual(const UDieg_ItemInstance* ToCheck) const
@@ -38,6 +40,10 @@ bool UDieg_ItemInstance::IsEqual(const UDieg_ItemInstance* ToCheck) const
 	if (ItemDefinitionDataAsset != ToCheck->ItemDefinitionDataAsset)
 		return false;
 
+	// Different definition, tags or fragment layout, no need to compare fragment states
+	if (GetStackKey() != ToCheck->GetStackKey())
+		return false;
+
 	// Compare Item Tags
 	if (ItemTags != ToCheck->ItemTags)
 		return false;
@@ -76,3 +82,50 @@ const FDieg_ItemDefinition& UDieg_ItemInstance::GetItemDefinition() const
 {
 	return ItemDefinitionDataAsset->ItemDefinition;
 }
+
+uint32 UDieg_ItemInstance::GetStackKey() const
+{
+	if (StackKey == 0)
+	{
+		const_cast<UDieg_ItemInstance*>(this)->UpdateStackKey();
+	}
+	return StackKey;
+}
+
+void UDieg_ItemInstance::UpdateStackKey()
+{
+	uint32 Key = GetTypeHash(ItemDefinitionDataAsset.Get());
+
+	// Tag containers compare regardless of order, so combine tag hashes order-independently
+	uint32 TagsKey = 0;
+	for (const FGameplayTag& Tag : ItemTags)
+	{
+		TagsKey ^= GetTypeHash(Tag);
+	}
+	Key = HashCombineFast(Key, HashCombineFast(TagsKey, ItemTags.Num()));
+
+	// Fragments are compared in order
+	for (const UDieg_ItemFragment* Fragment : ItemFragments)
+	{
+		Key = HashCombineFast(Key, GetTypeHash(Fragment ? Fragment->GetClass() : nullptr));
+	}
+
+	// 0 is reserved for "not computed yet"
+	StackKey = Key != 0 ? Key : 1;
+}
+
+void UDieg_ItemInstance::PostLoad()
+{
+	Super::PostLoad();
+
+	UpdateStackKey();
+}
+
+#if WITH_EDITOR
+void UDieg_ItemInstance::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	UpdateStackKey();
+}
+#endif
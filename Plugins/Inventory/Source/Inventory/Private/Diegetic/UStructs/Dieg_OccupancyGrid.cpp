@@ -0,0 +1,377 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/UStructs/Dieg_OccupancyGrid.h"
+
+FDieg_ShapeMask FDieg_ShapeMask::Build(const TArray<FIntPoint>& Cells)
+{
+	FDieg_ShapeMask Mask;
+	if (Cells.IsEmpty())
+	{
+		return Mask;
+	}
+
+	// Bounding box of the shape
+	FIntPoint MinBounds(INT32_MAX, INT32_MAX);
+	FIntPoint MaxBounds(INT32_MIN, INT32_MIN);
+	for (const FIntPoint& Cell : Cells)
+	{
+		MinBounds.X = FMath::Min(MinBounds.X, Cell.X);
+		MinBounds.Y = FMath::Min(MinBounds.Y, Cell.Y);
+		MaxBounds.X = FMath::Max(MaxBounds.X, Cell.X);
+		MaxBounds.Y = FMath::Max(MaxBounds.Y, Cell.Y);
+	}
+
+	const FIntPoint Span = MaxBounds - MinBounds + FIntPoint(1, 1);
+	if (!ensureMsgf(Span.X <= 64, TEXT("FDieg_ShapeMask::Build, shapes wider than 64 cells are not supported")))
+	{
+		return Mask;
+	}
+
+	Mask.Min = MinBounds;
+	Mask.Span = Span;
+	Mask.RowBits.SetNumZeroed(Span.Y);
+	for (const FIntPoint& Cell : Cells)
+	{
+		const FIntPoint Local = Cell - MinBounds;
+		uint64& Row = Mask.RowBits[Local.Y];
+		const uint64 Bit = 1ull << Local.X;
+		if (!(Row & Bit))
+		{
+			Row |= Bit;
+			Mask.NumCells++;
+		}
+		if (Cell == FIntPoint::ZeroValue)
+		{
+			Mask.bContainsOrigin = true;
+		}
+	}
+
+	for (uint64 Row : Mask.RowBits)
+	{
+		// Each step shortens every run by one, the step count is the longest run
+		int32 Run = 0;
+		for (; Row; Row &= Row >> 1)
+		{
+			++Run;
+		}
+		Mask.LongestRowRun = FMath::Max(Mask.LongestRowRun, Run);
+	}
+	Mask.bIsRectangle = Mask.NumCells == Span.X * Span.Y;
+
+	return Mask;
+}
+
+void FDieg_OccupancyGrid::Initialize(const int32 NumSlots, const int32 NumColumns)
+{
+	Columns = FMath::Max(NumColumns, 0);
+	NumCells = Columns > 0 ? FMath::Max(NumSlots, 0) : 0;
+	Rows = Columns > 0 ? FMath::DivideAndRoundUp(NumCells, Columns) : 0;
+	WordsPerRow = FMath::DivideAndRoundUp(Columns, 64);
+
+	// Start fully blocked, then free every cell that exists so only padding stays set
+	Words.Init(~0ull, Rows * WordsPerRow);
+	for (int32 Index = 0; Index < NumCells; ++Index)
+	{
+		const int32 X = Index % Columns;
+		const int32 Y = Index / Columns;
+		Words[Y * WordsPerRow + (X >> 6)] &= ~(1ull << (X & 63));
+	}
+
+	FreeCells = NumCells;
+	RowFreeRuns.SetNumZeroed(Rows);
+	for (int32 Row = 0; Row < Rows; ++Row)
+	{
+		UpdateRowFreeRun(Row);
+	}
+	bLargestFreeRectDirty = true;
+	bMaximalFreeRectsDirty = true;
+}
+
+void FDieg_OccupancyGrid::SetOccupied(const FIntPoint& Point, const bool bOccupied)
+{
+	if (!IsInBounds(Point))
+	{
+		return;
+	}
+
+	uint64& Word = Words[Point.Y * WordsPerRow + (Point.X >> 6)];
+	const uint64 Bit = 1ull << (Point.X & 63);
+	if (((Word & Bit) != 0) == bOccupied)
+	{
+		return;
+	}
+
+	if (bOccupied)
+	{
+		Word |= Bit;
+		--FreeCells;
+	}
+	else
+	{
+		Word &= ~Bit;
+		++FreeCells;
+	}
+
+	UpdateRowFreeRun(Point.Y);
+	bLargestFreeRectDirty = true;
+	bMaximalFreeRectsDirty = true;
+}
+
+bool FDieg_OccupancyGrid::DoesMaskFit(const FDieg_ShapeMask& Mask, const FIntPoint& Coordinates) const
+{
+	if (Mask.IsEmpty())
+	{
+		return false;
+	}
+
+	// Bounding box test, anything left inside the box is handled by the padding bits
+	const FIntPoint Origin = Coordinates + Mask.Min;
+	if (Origin.X < 0 || Origin.Y < 0 || Origin.X + Mask.Span.X > Columns || Origin.Y + Mask.Span.Y > Rows)
+	{
+		return false;
+	}
+
+	const int32 WordIndex = Origin.X >> 6;
+	const int32 Shift = Origin.X & 63;
+	const bool bSpillsOver = Shift != 0 && WordIndex + 1 < WordsPerRow;
+	for (int32 RowIndex = 0; RowIndex < Mask.RowBits.Num(); ++RowIndex)
+	{
+		const uint64 RowBits = Mask.RowBits[RowIndex];
+		const uint64* RowWords = &Words[(Origin.Y + RowIndex) * WordsPerRow + WordIndex];
+
+		if (RowWords[0] & (RowBits << Shift))
+		{
+			return false;
+		}
+		if (bSpillsOver && (RowWords[1] & (RowBits >> (64 - Shift))))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 FDieg_OccupancyGrid::GetFreeRunRight(const FIntPoint& Point) const
+{
+	if (!IsInBounds(Point))
+	{
+		return 0;
+	}
+
+	// Padding bits stop the run at the last column
+	int32 Run = 0;
+	int32 X = Point.X;
+	for (int32 WordIndex = X >> 6; WordIndex < WordsPerRow; ++WordIndex)
+	{
+		const int32 Shift = X & 63;
+		const uint64 Blocked = Words[Point.Y * WordsPerRow + WordIndex] >> Shift;
+		const int32 FreeInWord = Blocked ? static_cast<int32>(FMath::CountTrailingZeros64(Blocked)) : 64 - Shift;
+		Run += FreeInWord;
+		if (FreeInWord < 64 - Shift)
+		{
+			break;
+		}
+		X += FreeInWord;
+	}
+	return Run;
+}
+
+int32 FDieg_OccupancyGrid::GetFreeRunDown(const FIntPoint& Point) const
+{
+	int32 Run = 0;
+	for (FIntPoint Cell = Point; IsAvailable(Cell); ++Cell.Y)
+	{
+		++Run;
+	}
+	return Run;
+}
+
+int32 FDieg_OccupancyGrid::CountContactEdges(const FDieg_ShapeMask& Mask, const FIntPoint& Coordinates) const
+{
+	const FIntPoint Origin = Coordinates + Mask.Min;
+	const int32 NumRows = Mask.RowBits.Num();
+
+	int32 Contacts = 0;
+	for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+	{
+		const uint64 Row = Mask.RowBits[RowIndex];
+		const uint64 RowAbove = RowIndex > 0 ? Mask.RowBits[RowIndex - 1] : 0;
+		const uint64 RowBelow = RowIndex + 1 < NumRows ? Mask.RowBits[RowIndex + 1] : 0;
+
+		for (uint64 Remaining = Row; Remaining; Remaining &= Remaining - 1)
+		{
+			const int32 X = static_cast<int32>(FMath::CountTrailingZeros64(Remaining));
+			const uint64 Bit = 1ull << X;
+			const FIntPoint Cell(Origin.X + X, Origin.Y + RowIndex);
+
+			// Only edges leaving the shape count, and anything that is not free is a contact
+			if (!(Row & (Bit >> 1)))
+			{
+				Contacts += !IsAvailable(Cell - FIntPoint(1, 0));
+			}
+			if (!(Row & (Bit << 1)))
+			{
+				Contacts += !IsAvailable(Cell + FIntPoint(1, 0));
+			}
+			if (!(RowAbove & Bit))
+			{
+				Contacts += !IsAvailable(Cell - FIntPoint(0, 1));
+			}
+			if (!(RowBelow & Bit))
+			{
+				Contacts += !IsAvailable(Cell + FIntPoint(0, 1));
+			}
+		}
+	}
+	return Contacts;
+}
+
+int32 FDieg_OccupancyGrid::GetLongestFreeRun() const
+{
+	int32 LongestRun = 0;
+	for (const int32 Run : RowFreeRuns)
+	{
+		LongestRun = FMath::Max(LongestRun, Run);
+	}
+	return LongestRun;
+}
+
+FIntRect FDieg_OccupancyGrid::GetLargestFreeRect() const
+{
+	if (!bLargestFreeRectDirty)
+	{
+		return LargestFreeRect;
+	}
+
+	// Largest rectangle in a histogram, one histogram per row of free column heights
+	LargestFreeRect = FIntRect();
+	int32 BestArea = 0;
+	TArray<int32, TInlineAllocator<64>> Heights;
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Heights.SetNumZeroed(Columns);
+	for (int32 Y = 0; Y < Rows; ++Y)
+	{
+		for (int32 X = 0; X < Columns; ++X)
+		{
+			Heights[X] = IsBitSet(FIntPoint(X, Y)) ? 0 : Heights[X] + 1;
+		}
+
+		Stack.Reset();
+		for (int32 X = 0; X <= Columns; ++X)
+		{
+			const int32 Height = X < Columns ? Heights[X] : 0;
+			while (!Stack.IsEmpty() && Heights[Stack.Last()] >= Height)
+			{
+				const int32 Top = Stack.Pop(EAllowShrinking::No);
+				const int32 Left = Stack.IsEmpty() ? 0 : Stack.Last() + 1;
+				const int32 Area = Heights[Top] * (X - Left);
+				if (Area > BestArea)
+				{
+					BestArea = Area;
+					LargestFreeRect = FIntRect(Left, Y - Heights[Top] + 1, X, Y + 1);
+				}
+			}
+			Stack.Add(X);
+		}
+	}
+
+	bLargestFreeRectDirty = false;
+	return LargestFreeRect;
+}
+
+const TArray<FIntRect>& FDieg_OccupancyGrid::GetMaximalFreeRects() const
+{
+	if (!bMaximalFreeRectsDirty)
+	{
+		return MaximalFreeRects;
+	}
+
+	// Each maximal rectangle has its bottom edge on some row Y and is as tall as the shortest free column
+	// it spans, so it shows up as a histogram bar of row Y widened left and right over taller columns.
+	MaximalFreeRects.Reset();
+	TArray<int32, TInlineAllocator<64>> Heights;
+	Heights.SetNumZeroed(Columns);
+	for (int32 Y = 0; Y < Rows; ++Y)
+	{
+		for (int32 X = 0; X < Columns; ++X)
+		{
+			Heights[X] = IsBitSet(FIntPoint(X, Y)) ? 0 : Heights[X] + 1;
+		}
+
+		for (int32 X = 0; X < Columns; ++X)
+		{
+			const int32 Height = Heights[X];
+			if (Height == 0)
+			{
+				continue;
+			}
+
+			int32 Left = X;
+			while (Left > 0 && Heights[Left - 1] >= Height)
+			{
+				--Left;
+			}
+
+			// The same rectangle is found from every column of its span with the minimum height, keep the leftmost
+			bool bDuplicate = false;
+			for (int32 Column = Left; Column < X && !bDuplicate; ++Column)
+			{
+				bDuplicate = Heights[Column] == Height;
+			}
+			if (bDuplicate)
+			{
+				continue;
+			}
+
+			int32 Right = X + 1;
+			while (Right < Columns && Heights[Right] >= Height)
+			{
+				++Right;
+			}
+
+			// Maximal downwards only if the next row blocks at least one cell below it
+			bool bBlockedBelow = Y + 1 == Rows;
+			for (int32 Column = Left; Column < Right && !bBlockedBelow; ++Column)
+			{
+				bBlockedBelow = IsBitSet(FIntPoint(Column, Y + 1));
+			}
+			if (bBlockedBelow)
+			{
+				MaximalFreeRects.Emplace(Left, Y - Height + 1, Right, Y + 1);
+			}
+		}
+	}
+
+	bMaximalFreeRectsDirty = false;
+	return MaximalFreeRects;
+}
+
+bool FDieg_OccupancyGrid::CouldEverFit(const FDieg_ShapeMask& Mask) const
+{
+	if (Mask.IsEmpty() || Mask.NumCells > FreeCells)
+	{
+		return false;
+	}
+
+	if (Mask.Span.X > Columns || Mask.Span.Y > Rows || Mask.LongestRowRun > GetLongestFreeRun())
+	{
+		return false;
+	}
+
+	// A rectangle needs a free rectangle at least as large
+	return !Mask.bIsRectangle || Mask.NumCells <= GetLargestFreeRect().Area();
+}
+
+void FDieg_OccupancyGrid::UpdateRowFreeRun(const int32 Row)
+{
+	int32 LongestRun = 0;
+	for (int32 X = 0; X < Columns;)
+	{
+		const int32 Run = GetFreeRunRight(FIntPoint(X, Row));
+		LongestRun = FMath::Max(LongestRun, Run);
+		X += FMath::Max(Run, 1);
+	}
+	RowFreeRuns[Row] = LongestRun;
+}
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/UStructs/Dieg_RotatedShape.h"
+
+#include "Diegetic/Dieg_UtilityLibrary.h"
+
+FDieg_RotatedShape FDieg_RotatedShape::Build(const TArray<FIntPoint>& Shape, const FIntPoint& ShapeRoot, const int32 InRotation)
+{
+	FDieg_RotatedShape RotatedShape;
+	RotatedShape.Rotation = InRotation;
+	RotatedShape.Cells = UDieg_UtilityLibrary::Rotate2DArrayWithRoot(Shape, InRotation, ShapeRoot, RotatedShape.Root);
+	RotatedShape.Span = RotatedShape.Cells.IsEmpty() ? FIntPoint::ZeroValue : UDieg_UtilityLibrary::GetShapeSpan(RotatedShape.Cells);
+	RotatedShape.Mask = FDieg_ShapeMask::Build(RotatedShape.Cells);
+	return RotatedShape;
+}
+
+int32 FDieg_RotatedShape::GetRotationIndex(const float InRotation)
+{
+	// 0 -> 0, 90 -> 1, 180 -> 2, -90/270 -> 3
+	const int32 QuarterTurns = FMath::RoundToInt(InRotation / 90.0f);
+	return ((QuarterTurns % 4) + 4) % 4;
+}
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/UStructs/Dieg_SlotStorage.h"
+
+#include "Diegetic/UObjects/Dieg_ItemInstance.h"
+#include "Diegetic/UStructs/Dieg_RotatedShape.h"
+
+float FDieg_StoredItem::GetRotation() const
+{
+	// Inverse of FDieg_RotatedShape::GetRotationIndex
+	static constexpr float RotationAngles[4] = { 0.0f, 90.0f, 180.0f, -90.0f };
+	return RotationAngles[RotationIndex & 3];
+}
+
+void FDieg_SlotStorage::Initialize(const int32 NumSlots, const int32 NumColumns, const FGameplayTagContainer& Tags)
+{
+	Columns = FMath::Max(NumColumns, 1);
+	CellHandles.Init(INDEX_NONE, FMath::Max(NumSlots, 0));
+	Items.Reset();
+	FreeHandles.Reset();
+	DefaultTags = Tags;
+	TagSets.Reset();
+	CellTagSets.Reset();
+}
+
+UDieg_ItemInstance* FDieg_SlotStorage::GetItem(const int32 Index) const
+{
+	const int32 Handle = CellHandles[Index];
+	return Handle != INDEX_NONE ? Items[Handle].ItemInstance.Get() : nullptr;
+}
+
+int32 FDieg_SlotStorage::FindHandle(const UDieg_ItemInstance* ItemInstance) const
+{
+	if (!ItemInstance)
+	{
+		return INDEX_NONE;
+	}
+	return Items.IndexOfByPredicate([ItemInstance](const FDieg_StoredItem& Item)
+	{
+		return Item.ItemInstance == ItemInstance;
+	});
+}
+
+int32 FDieg_SlotStorage::AddItem(UDieg_ItemInstance* ItemInstance, const int32 RootIndex, const float Rotation)
+{
+	const int32 Handle = FreeHandles.IsEmpty() ? Items.AddDefaulted() : FreeHandles.Pop(EAllowShrinking::No);
+	FDieg_StoredItem& Item = Items[Handle];
+	Item.ItemInstance = ItemInstance;
+	Item.RootIndex = RootIndex;
+	Item.RotationIndex = static_cast<uint8>(FDieg_RotatedShape::GetRotationIndex(Rotation));
+	return Handle;
+}
+
+void FDieg_SlotStorage::RemoveItem(const int32 Handle)
+{
+	if (!Items.IsValidIndex(Handle) || !Items[Handle].ItemInstance)
+	{
+		return;
+	}
+
+	Items[Handle] = FDieg_StoredItem();
+	FreeHandles.Add(Handle);
+}
+
+const FGameplayTagContainer& FDieg_SlotStorage::GetTags(const int32 Index) const
+{
+	const int32* TagSetIndex = CellTagSets.Find(Index);
+	return TagSetIndex ? TagSets[*TagSetIndex] : DefaultTags;
+}
+
+void FDieg_SlotStorage::SetTags(const int32 Index, const FGameplayTagContainer& Tags)
+{
+	if (Tags == DefaultTags)
+	{
+		CellTagSets.Remove(Index);
+		return;
+	}
+
+	// Tag sets are never removed, cells referencing them may be reassigned but the set stays shared
+	int32 TagSetIndex = TagSets.IndexOfByKey(Tags);
+	if (TagSetIndex == INDEX_NONE)
+	{
+		TagSetIndex = TagSets.Add(Tags);
+	}
+	CellTagSets.Add(Index, TagSetIndex);
+}
+
+FDieg_InventorySlot FDieg_SlotStorage::MakeSlot(const int32 Index) const
+{
+	FDieg_InventorySlot Slot;
+	if (!IsValidIndex(Index))
+	{
+		return Slot;
+	}
+
+	Slot.Initialize(GetCoordinates(Index), GetTags(Index));
+
+	const int32 Handle = CellHandles[Index];
+	if (Handle != INDEX_NONE)
+	{
+		const FDieg_StoredItem& Item = Items[Handle];
+		Slot.ItemInstance = Item.ItemInstance;
+		Slot.RootSlot = GetCoordinates(Item.RootIndex);
+		Slot.Rotation = Item.GetRotation();
+	}
+	return Slot;
+}
+
+SIZE_T FDieg_SlotStorage::GetAllocatedSize() const
+{
+	SIZE_T Size = CellHandles.GetAllocatedSize()
+		+ Items.GetAllocatedSize()
+		+ FreeHandles.GetAllocatedSize()
+		+ TagSets.GetAllocatedSize()
+		+ CellTagSets.GetAllocatedSize()
+		+ DefaultTags.GetGameplayTagArray().GetAllocatedSize();
+
+	for (const FGameplayTagContainer& TagSet : TagSets)
+	{
+		Size += TagSet.GetGameplayTagArray().GetAllocatedSize();
+	}
+	return Size;
+}
@@ -4,10 +4,25 @@
 #include "Diegetic/Widgets/Dieg_Grid.h"
 
 #include "BPF_PlugInv_DoubleLogger.h"
+#include "Inventory.h"
 #include "Components/GridPanel.h"
+#include "Components/GridSlot.h"
+#include "Components/Image.h"
 #include "Diegetic/Dieg_UtilityLibrary.h"
 #include "BPF_PlugInv_DoubleLogger.h"
 #include "Diegetic/Widgets/Dieg_Slot.h"
+#include "Diegetic/Widgets/SDieg_GridStatusLayer.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Widgets/SOverlay.h"
+
+DECLARE_CYCLE_STAT(TEXT("Create Grid"), STAT_Dieg_CreateGrid, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Update Realized Grid Cells"), STAT_Dieg_UpdateRealizedCells, STATGROUP_DiegInventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Grid Slot Widgets"), STAT_Dieg_GridSlotWidgets, STATGROUP_DiegInventory);
+DECLARE_CYCLE_STAT(TEXT("Flush Grid Status Texture"), STAT_Dieg_FlushGridStatus, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grid Status Uploads"), STAT_Dieg_GridStatusUploads, STATGROUP_DiegInventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grid Status Texels Uploaded"), STAT_Dieg_GridStatusTexelsUploaded, STATGROUP_DiegInventory);
 
 void UDieg_Grid::NativePreConstruct()
 {
@@ -21,42 +36,59 @@ void UDieg_Grid::NativePreConstruct()
 	CreateEmptyGrid(TotalSlots, MaxColumns);
 }
 
-TMap<FIntPoint, UDieg_Slot*>& UDieg_Grid::GetSlotMap()
+UDieg_Slot* UDieg_Grid::FindSlot(const FIntPoint& Coordinates) const
 {
-	// Convert TObjectPtr to raw pointer for C++ efficiency
-	static TMap<FIntPoint, UDieg_Slot*> ConvertedMap;
-	ConvertedMap.Empty();
-	for (const TPair<FIntPoint, TObjectPtr<UDieg_Slot>>& Pair : SlotMap)
+	if (Coordinates.X < 0 || Coordinates.Y < 0 || Coordinates.X >= MaxColumns)
 	{
-		ConvertedMap.Add(Pair.Key, Pair.Value.Get());
+		return nullptr;
 	}
-	return ConvertedMap;
-}
 
-TMap<FIntPoint, UDieg_Slot*> UDieg_Grid::GetSlotMapBP()
-{
-	TMap<FIntPoint, UDieg_Slot*> BlueprintMap;
-	for (const TPair<FIntPoint, TObjectPtr<UDieg_Slot>>& Pair : SlotMap)
-	{
-		BlueprintMap.Add(Pair.Key, Pair.Value.Get());
-	}
-	return BlueprintMap;
+	const int32 Index = UDieg_UtilityLibrary::GetIndexFromPosition(Coordinates, MaxColumns);
+	return Slots.IsValidIndex(Index) ? Slots[Index].Get() : nullptr;
 }
 
 void UDieg_Grid::CreateEmptyGrid_Implementation(int32 TotalSlots_, int32 MaxColumns_)
 {
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_CreateGrid);
+
 	TotalSlots = TotalSlots_;
 	MaxColumns = MaxColumns_;
 
 	GridPanel->ClearChildren();
+	GridPanel->SetRenderTranslation(FVector2D::ZeroVector);
+	Slots.Empty();
 	SlotMap.Empty();
+	SlotPool.Empty();
+	HoveredCoordinates.Empty();
+	RealizedCells = FIntRect();
+	PointerCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	DEC_DWORD_STAT_BY(STAT_Dieg_GridSlotWidgets, NumSlotWidgets);
+	NumSlotWidgets = 0;
 	
-	TArray<FIntPoint> Slots = UDieg_UtilityLibrary::GetSlotPoints(TotalSlots, MaxColumns);
-	if (Slots.IsEmpty())
+	TArray<FIntPoint> SlotPoints = UDieg_UtilityLibrary::GetSlotPoints(TotalSlots, MaxColumns);
+	if (SlotPoints.IsEmpty())
+	{
+		return;
+	}
+
+	// Before the slots, they hide their own fill when the grid draws it
+	CreateStatusTexture();
+	Slots.SetNum(SlotPoints.Num());
+
+	// The grid draws every cell and finds the cell under the pointer itself, widgets come with the view
+	bSlotsVirtualized = bVirtualizeSlots && IsStatusBatched() && !IsDesignTime();
+	if (bVirtualizeSlots && !bSlotsVirtualized && !IsDesignTime())
 	{
+		UPlugInv_DoubleLogger::LogWarning(TEXT("UDieg_Grid: slot virtualization needs bBatchSlotStatus, creating every slot"));
+	}
+	if (bSlotsVirtualized)
+	{
+		SetVisibility(ESlateVisibility::Visible);
 		return;
 	}
-	for (const FIntPoint& SlotValue : Slots)
+
+	SlotMap.Reserve(SlotPoints.Num());
+	for (const FIntPoint& SlotValue : SlotPoints)
 	{
 		// LOG_DOUBLE_S(5.0f, FColor::Green, "Slot {0}", SlotValue);
 		CreateSlot(SlotValue);
@@ -66,17 +98,28 @@ void UDieg_Grid::CreateEmptyGrid_Implementation(int32 TotalSlots_, int32 MaxColu
 
 UDieg_Slot* UDieg_Grid::CreateSlot(const FIntPoint& Point)
 {
-	UDieg_Slot* CreatedSlot = CreateWidget<UDieg_Slot>(this, SlotClass);
+	UDieg_Slot* CreatedSlot = CreateSlotWidget();
 	
-	CreatedSlot->SetParentGrid(this);
+	CreatedSlot->LastUpdatedCoordinate = Point;
 	GridPanel->AddChildToGrid(CreatedSlot, Point.Y, Point.X);
+	Slots[UDieg_UtilityLibrary::GetIndexFromPosition(Point, MaxColumns)] = CreatedSlot;
 	SlotMap.Add(Point, CreatedSlot);
+	
+	return CreatedSlot;
+}
 
+UDieg_Slot* UDieg_Grid::CreateSlotWidget()
+{
+	UDieg_Slot* CreatedSlot = CreateWidget<UDieg_Slot>(this, SlotClass);
+	
+	CreatedSlot->SetParentGrid(this);
 	CreatedSlot->OnHoverSlot.AddDynamic(this, &ThisClass::ChildSlotHover);
 	CreatedSlot->OnUnHoverSlot.AddDynamic(this, &ThisClass::ChildSlotUnHovered);
 	CreatedSlot->OnPressedSlot.AddDynamic(this, &ThisClass::ChildSlotPressed);
 	CreatedSlot->OnReleasedSlot.AddDynamic(this, &ThisClass::ChildSlotReleased);
-	
+
+	++NumSlotWidgets;
+	INC_DWORD_STAT(STAT_Dieg_GridSlotWidgets);
 	return CreatedSlot;
 }
 
@@ -107,50 +150,457 @@ void UDieg_Grid::ChildSlotReleased(const FGeometry& InGeometry, const FPointerEv
 void UDieg_Grid::UpdateHoveringSlots(const TArray<FIntPoint>& NewCoordinates, EDieg_SlotStatus NewStatus,
 	EDieg_SlotStatus ResetStatus)
 {
+	UpdateHoveringCoordinates(NewCoordinates, NewStatus, ResetStatus);
+}
+
+void UDieg_Grid::UpdateHoveringCoordinates(const TConstArrayView<FIntPoint> NewCoordinates, const EDieg_SlotStatus NewStatus,
+	const EDieg_SlotStatus ResetStatus)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UDieg_Grid::UpdateHoveringSlots);
+
 	// UPlugInv_DoubleLogger::Log(5.0f, TEXT("UpdateHoveringSlots. NewStatus: {1}, ResetStatus: {2}"),
 	// 			FColor::Yellow, NewStatus, ResetStatus);
-	TSet<FIntPoint> LocalNewCoordinates;
-	LocalNewCoordinates.Append(NewCoordinates);
 
-	// Difference: Result will contain all elements that are in Set A but are not found in Set B.
-	// So in this case: Anything in LocalNewCoordinates that is NOT in SlotsHoveredSet will be cached.
-	TArray<FIntPoint> DiffSlotsNew = LocalNewCoordinates.Difference(SlotsHoveredSet).Array();
-	for (const FIntPoint& DiffSlotNew : DiffSlotsNew)
+	// Slots that we want to hide: hovered before but not anymore. Item shapes are small, a linear search is cheapest.
+	for (int32 Index = HoveredCoordinates.Num() - 1; Index >= 0; --Index)
 	{
-		// Update state in the new ones
-		if (bool Contains = SlotMap.Contains(DiffSlotNew); TObjectPtr<UDieg_Slot> FoundSlot = SlotMap.FindRef(DiffSlotNew))
+		if (!NewCoordinates.Contains(HoveredCoordinates[Index]))
 		{
-			FoundSlot->SetStatusAndColor(NewStatus);
+			ApplySlotStatus(HoveredCoordinates[Index], ResetStatus);
+			HoveredCoordinates.RemoveAtSwap(Index, EAllowShrinking::No);
 		}
 	}
 
-	// Slots that we want to hide
-	TArray<FIntPoint> DiffSlotsOld = SlotsHoveredSet.Difference(LocalNewCoordinates).Array();
-	for (const FIntPoint& DiffSlotOld : DiffSlotsOld)
+	// Update state only in the new ones, slots hovered before keep theirs
+	for (const FIntPoint& NewCoordinate : NewCoordinates)
 	{
-		// Update state in the new ones
-		if (TObjectPtr<UDieg_Slot>* FoundSlot = SlotMap.Find(DiffSlotOld))
+		if (!HoveredCoordinates.Contains(NewCoordinate))
 		{
-			FoundSlot->Get()->SetStatusAndColor(ResetStatus);
+			HoveredCoordinates.Add(NewCoordinate);
+			ApplySlotStatus(NewCoordinate, NewStatus);
 		}
 	}
-	
-	SlotsHoveredSet = LocalNewCoordinates;
 }
 
 void UDieg_Grid::ModifyAllSlotsAppearance(bool IsAppearanceLocked, bool Override, EDieg_SlotStatus OverrideStatus)
 {
 	// UPlugInv_DoubleLogger::Log(5.0f, TEXT("ModifyAllSlotsAppearance. IsAppearanceLocked: {1}, Override: {2}, OverrideStatus: {3}"),
 	// 			FColor::Yellow, Override, OverrideStatus);
-	for (const TPair<FIntPoint, TObjectPtr<UDieg_Slot>>& Pair : SlotMap)
+	bAllSlotsAppearanceLocked = IsAppearanceLocked;
+	for (int32 Index = 0; Index < Slots.Num(); ++Index)
 	{
-		Pair.Value->SetAppearanceLocked(IsAppearanceLocked);
+		// Cells without a widget when virtualized still get the status
+		if (UDieg_Slot* GridSlot = Slots[Index])
+		{
+			GridSlot->SetAppearanceLocked(IsAppearanceLocked);
+		}
 
 		if (Override)
 		{
-			Pair.Value->SetStatusAndColor(OverrideStatus);
+			ApplySlotStatus(UDieg_UtilityLibrary::GetPositionFromIndex(Index, MaxColumns), OverrideStatus);
+		}
+	}
+}
+
+void UDieg_Grid::SetCellStatus(const FIntPoint& Coordinates, const EDieg_SlotStatus Status)
+{
+	if (!IsStatusBatched()
+		|| Coordinates.X < 0 || Coordinates.Y < 0 || Coordinates.X >= StatusTextureSize.X || Coordinates.Y >= StatusTextureSize.Y)
+	{
+		return;
+	}
+
+	const int32 CellIndex = Coordinates.Y * StatusTextureSize.X + Coordinates.X;
+	CellStatuses[CellIndex] = Status;
+
+	const uint8 StatusIndex = static_cast<uint8>(Status);
+	const FColor Color = StatusColors.IsValidIndex(StatusIndex) ? StatusColors[StatusIndex] : FColor::Transparent;
+	FColor& Texel = StatusTexels[CellIndex];
+	if (Texel == Color)
+	{
+		return;
+	}
+	Texel = Color;
+
+	if (DirtyStatusRect.IsEmpty())
+	{
+		DirtyStatusRect = FIntRect(Coordinates, Coordinates + FIntPoint(1, 1));
+	}
+	else
+	{
+		DirtyStatusRect.Min = DirtyStatusRect.Min.ComponentMin(Coordinates);
+		DirtyStatusRect.Max = DirtyStatusRect.Max.ComponentMax(Coordinates + FIntPoint(1, 1));
+	}
+}
+
+void UDieg_Grid::NativeTick(const FGeometry& MyGeometry, const float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (bSlotsVirtualized)
+	{
+		UpdateRealizedCells(ComputeVisibleCells(MyGeometry));
+	}
+
+	// Every status change of the frame goes up in one region
+	FlushStatusTexture();
+}
+
+FReply UDieg_Grid::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (bSlotsVirtualized)
+	{
+		RoutePointerToCell(GetCellAtPosition(InGeometry, InMouseEvent.GetScreenSpacePosition()), InMouseEvent);
+	}
+
+	return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
+}
+
+void UDieg_Grid::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+	Super::NativeOnMouseLeave(InMouseEvent);
+
+	if (bSlotsVirtualized)
+	{
+		RoutePointerToCell(FIntPoint(INDEX_NONE, INDEX_NONE), InMouseEvent);
+	}
+}
+
+FReply UDieg_Grid::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (bSlotsVirtualized)
+	{
+		RoutePointerToCell(GetCellAtPosition(InGeometry, InMouseEvent.GetScreenSpacePosition()), InMouseEvent);
+		if (UDieg_Slot* PressedSlot = FindSlot(PointerCell))
+		{
+			return PressedSlot->NativeOnMouseButtonDown(PressedSlot->GetCachedGeometry(), InMouseEvent);
+		}
+	}
+
+	return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
+}
+
+FReply UDieg_Grid::NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (bSlotsVirtualized)
+	{
+		RoutePointerToCell(GetCellAtPosition(InGeometry, InMouseEvent.GetScreenSpacePosition()), InMouseEvent);
+		if (UDieg_Slot* ReleasedSlot = FindSlot(PointerCell))
+		{
+			return ReleasedSlot->NativeOnMouseButtonUp(ReleasedSlot->GetCachedGeometry(), InMouseEvent);
+		}
+	}
+
+	return Super::NativeOnMouseButtonUp(InGeometry, InMouseEvent);
+}
+
+void UDieg_Grid::BeginDestroy()
+{
+	DEC_DWORD_STAT_BY(STAT_Dieg_GridSlotWidgets, NumSlotWidgets);
+	NumSlotWidgets = 0;
+
+	Super::BeginDestroy();
+}
+
+void UDieg_Grid::ReleaseSlateResources(const bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	StatusLayer.Reset();
+}
+
+TSharedRef<SWidget> UDieg_Grid::RebuildWidget()
+{
+	const TSharedRef<SWidget> Content = Super::RebuildWidget();
+
+	// The status texture goes under the slots, top left like GridPanel
+	StatusLayer = SNew(SDieg_GridStatusLayer);
+	if (IsStatusBatched() && !IsValid(StatusMaterialInstance))
+	{
+		StatusLayer->SetStatusTexture(StatusTexture, FVector2D(StatusTextureSize) * CellSize);
+	}
+
+	return SNew(SOverlay)
+		+ SOverlay::Slot()
+		.HAlign(HAlign_Left)
+		.VAlign(VAlign_Top)
+		[
+			StatusLayer.ToSharedRef()
+		]
+		+ SOverlay::Slot()
+		[
+			Content
+		];
+}
+
+FIntRect UDieg_Grid::ComputeVisibleCells(const FGeometry& MyGeometry) const
+{
+	// Scroll boxes and other clipping parents decide what is in view
+	FSlateRect VisibleRect = MyGeometry.GetLayoutBoundingRect();
+	for (const UPanelWidget* Parent = GetParent(); IsValid(Parent); Parent = Parent->GetParent())
+	{
+		if (Parent->GetClipping() == EWidgetClipping::Inherit)
+		{
+			continue;
+		}
+
+		bool bOverlapping = false;
+		VisibleRect = VisibleRect.IntersectionWith(Parent->GetCachedGeometry().GetLayoutBoundingRect(), bOverlapping);
+		if (!bOverlapping)
+		{
+			return FIntRect();
 		}
 	}
+
+	const FVector2D CornerA = MyGeometry.AbsoluteToLocal(VisibleRect.GetTopLeft());
+	const FVector2D CornerB = MyGeometry.AbsoluteToLocal(VisibleRect.GetBottomRight());
+	const FVector2D LocalMin = FVector2D::Min(CornerA, CornerB) / CellSize;
+	const FVector2D LocalMax = FVector2D::Max(CornerA, CornerB) / CellSize;
+
+	const FIntPoint Margin(VirtualizationMargin, VirtualizationMargin);
+	const FIntPoint Min = (FIntPoint(FMath::FloorToInt(LocalMin.X), FMath::FloorToInt(LocalMin.Y)) - Margin).ComponentMax(FIntPoint::ZeroValue);
+	const FIntPoint Max = (FIntPoint(FMath::CeilToInt(LocalMax.X), FMath::CeilToInt(LocalMax.Y)) + Margin).ComponentMin(StatusTextureSize);
+	if (Min.X >= Max.X || Min.Y >= Max.Y)
+	{
+		return FIntRect();
+	}
+	return FIntRect(Min, Max);
+}
+
+void UDieg_Grid::UpdateRealizedCells(const FIntRect& NewRealizedCells)
+{
+	if (NewRealizedCells == RealizedCells)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_UpdateRealizedCells);
+
+	for (int32 Y = RealizedCells.Min.Y; Y < RealizedCells.Max.Y; ++Y)
+	{
+		for (int32 X = RealizedCells.Min.X; X < RealizedCells.Max.X; ++X)
+		{
+			if (!NewRealizedCells.Contains(FIntPoint(X, Y)))
+			{
+				ReleaseSlot(FIntPoint(X, Y));
+			}
+		}
+	}
+
+	RealizedCells = NewRealizedCells;
+
+	// The panel only holds the realized cells, offset to the first one
+	GridPanel->SetRenderTranslation(FVector2D(RealizedCells.Min) * CellSize);
+	for (int32 Y = RealizedCells.Min.Y; Y < RealizedCells.Max.Y; ++Y)
+	{
+		for (int32 X = RealizedCells.Min.X; X < RealizedCells.Max.X; ++X)
+		{
+			const FIntPoint Coordinates(X, Y);
+			if (const UDieg_Slot* KeptSlot = FindSlot(Coordinates))
+			{
+				if (UGridSlot* PanelSlot = Cast<UGridSlot>(KeptSlot->Slot))
+				{
+					PanelSlot->SetRow(Y - RealizedCells.Min.Y);
+					PanelSlot->SetColumn(X - RealizedCells.Min.X);
+				}
+			}
+			else if (UDieg_UtilityLibrary::GetIndexFromPosition(Coordinates, MaxColumns) < TotalSlots)
+			{
+				RealizeSlot(Coordinates);
+			}
+		}
+	}
+}
+
+void UDieg_Grid::RealizeSlot(const FIntPoint& Coordinates)
+{
+	UDieg_Slot* GridSlot = SlotPool.IsEmpty() ? CreateSlotWidget() : SlotPool.Pop().Get();
+
+	GridSlot->LastUpdatedCoordinate = Coordinates;
+	GridSlot->SlotStatus = CellStatuses[Coordinates.Y * StatusTextureSize.X + Coordinates.X];
+	GridSlot->SetAppearanceLocked(bAllSlotsAppearanceLocked);
+
+	// The grid routes the pointer, the slots only draw
+	GridSlot->SetVisibility(ESlateVisibility::HitTestInvisible);
+	GridPanel->AddChildToGrid(GridSlot, Coordinates.Y - RealizedCells.Min.Y, Coordinates.X - RealizedCells.Min.X);
+
+	Slots[UDieg_UtilityLibrary::GetIndexFromPosition(Coordinates, MaxColumns)] = GridSlot;
+	SlotMap.Add(Coordinates, GridSlot);
+}
+
+void UDieg_Grid::ReleaseSlot(const FIntPoint& Coordinates)
+{
+	const int32 Index = UDieg_UtilityLibrary::GetIndexFromPosition(Coordinates, MaxColumns);
+	if (!Slots.IsValidIndex(Index) || !Slots[Index])
+	{
+		return;
+	}
+
+	UDieg_Slot* GridSlot = Slots[Index];
+	GridSlot->RemoveFromParent();
+	Slots[Index] = nullptr;
+	SlotMap.Remove(Coordinates);
+	SlotPool.Push(GridSlot);
+}
+
+FIntPoint UDieg_Grid::GetCellAtPosition(const FGeometry& InGeometry, const FVector2D& ScreenPosition) const
+{
+	const FVector2D LocalPosition = InGeometry.AbsoluteToLocal(ScreenPosition) / CellSize;
+	const FIntPoint Cell(FMath::FloorToInt(LocalPosition.X), FMath::FloorToInt(LocalPosition.Y));
+	if (Cell.X < 0 || Cell.Y < 0 || Cell.X >= MaxColumns
+		|| UDieg_UtilityLibrary::GetIndexFromPosition(Cell, MaxColumns) >= TotalSlots)
+	{
+		return FIntPoint(INDEX_NONE, INDEX_NONE);
+	}
+	return Cell;
+}
+
+void UDieg_Grid::RoutePointerToCell(const FIntPoint& Cell, const FPointerEvent& InMouseEvent)
+{
+	if (Cell == PointerCell)
+	{
+		return;
+	}
+
+	if (UDieg_Slot* PreviousSlot = FindSlot(PointerCell))
+	{
+		PreviousSlot->NativeOnMouseLeave(InMouseEvent);
+	}
+
+	PointerCell = Cell;
+	if (UDieg_Slot* CurrentSlot = FindSlot(PointerCell))
+	{
+		CurrentSlot->NativeOnMouseEnter(CurrentSlot->GetCachedGeometry(), InMouseEvent);
+	}
+}
+
+void UDieg_Grid::CreateStatusTexture()
+{
+	StatusTexture = nullptr;
+	StatusMaterialInstance = nullptr;
+	StatusTexels.Empty();
+	CellStatuses.Empty();
+	DirtyStatusRect = FIntRect();
+
+	if (StatusLayer.IsValid())
+	{
+		StatusLayer->SetStatusTexture(nullptr, FVector2D::ZeroVector);
+	}
+
+	if (!bBatchSlotStatus || !IsValid(SlotClass) || MaxColumns <= 0)
+	{
+		return;
+	}
+
+	StatusTextureSize = FIntPoint(MaxColumns, FMath::DivideAndRoundUp(TotalSlots, MaxColumns));
+	StatusTexture = UTexture2D::CreateTransient(StatusTextureSize.X, StatusTextureSize.Y, PF_B8G8R8A8, TEXT("DiegGridStatus"));
+	if (!IsValid(StatusTexture))
+	{
+		UPlugInv_DoubleLogger::LogError(TEXT("UDieg_Grid: could not create the status texture, falling back to per-slot colors"));
+		return;
+	}
+	StatusTexture->Filter = TF_Nearest;
+	StatusTexture->SRGB = true;
+	StatusTexture->UpdateResource();
+
+	// Slot colors are class defaults, read them once instead of from every slot
+	const UDieg_Slot* SlotDefaults = SlotClass->GetDefaultObject<UDieg_Slot>();
+	StatusColors.Reset();
+	for (const TPair<EDieg_SlotStatus, FLinearColor>& Pair : SlotDefaults->SlotFillColor)
+	{
+		const int32 StatusIndex = static_cast<int32>(Pair.Key);
+		if (!StatusColors.IsValidIndex(StatusIndex))
+		{
+			StatusColors.SetNumZeroed(StatusIndex + 1);
+		}
+		StatusColors[StatusIndex] = Pair.Value.ToFColor(true);
+	}
+
+	// Cells past TotalSlots in the last row stay transparent
+	StatusTexels.Init(FColor::Transparent, StatusTextureSize.X * StatusTextureSize.Y);
+	CellStatuses.Init(EDieg_SlotStatus::None, StatusTexels.Num());
+	const uint8 NoneIndex = static_cast<uint8>(EDieg_SlotStatus::None);
+	const FColor NoneColor = StatusColors.IsValidIndex(NoneIndex) ? StatusColors[NoneIndex] : FColor::Transparent;
+	for (int32 Index = 0; Index < TotalSlots; ++Index)
+	{
+		StatusTexels[Index] = NoneColor;
+	}
+	DirtyStatusRect = FIntRect(FIntPoint::ZeroValue, StatusTextureSize);
+
+	CellSize = SlotDefaults->SlotSize;
+	const FVector2D GridSize = FVector2D(StatusTextureSize) * CellSize;
+
+	// A bound overlay with a material gives the texture a custom look, otherwise the grid draws it itself
+	if (IsValid(Image_StatusOverlay) && IsValid(StatusMaterial))
+	{
+		StatusMaterialInstance = UMaterialInstanceDynamic::Create(StatusMaterial, this);
+		StatusMaterialInstance->SetTextureParameterValue(StatusTextureParameterName, StatusTexture);
+		Image_StatusOverlay->SetBrushFromMaterial(StatusMaterialInstance);
+		Image_StatusOverlay->SetDesiredSizeOverride(GridSize);
+	}
+	else if (StatusLayer.IsValid())
+	{
+		StatusLayer->SetStatusTexture(StatusTexture, GridSize);
+	}
+}
+
+void UDieg_Grid::ApplySlotStatus(const FIntPoint& Coordinates, const EDieg_SlotStatus Status)
+{
+	UDieg_Slot* GridSlot = FindSlot(Coordinates);
+	if (!IsStatusBatched())
+	{
+		if (GridSlot)
+		{
+			GridSlot->SetStatusAndColor(Status);
+		}
+		return;
+	}
+
+	// Plain write, skips the Blueprint event and the slot widget entirely
+	if (GridSlot)
+	{
+		GridSlot->SlotStatus = Status;
+	}
+	SetCellStatus(Coordinates, Status);
+}
+
+void UDieg_Grid::FlushStatusTexture()
+{
+	if (!IsStatusBatched() || DirtyStatusRect.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_Dieg_FlushGridStatus);
+
+	const FIntRect Rect = DirtyStatusRect;
+	DirtyStatusRect = FIntRect();
+
+	// Copied out, the render thread reads the region after this returns and StatusTexels keeps changing
+	const int32 RectWidth = Rect.Width();
+	const int32 RowBytes = RectWidth * sizeof(FColor);
+	uint8* RegionData = new uint8[Rect.Area() * sizeof(FColor)];
+	for (int32 Row = Rect.Min.Y; Row < Rect.Max.Y; ++Row)
+	{
+		FMemory::Memcpy(RegionData + (Row - Rect.Min.Y) * RowBytes, &StatusTexels[Row * StatusTextureSize.X + Rect.Min.X], RowBytes);
+	}
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(Rect.Min.X, Rect.Min.Y, 0, 0, RectWidth, Rect.Height());
+	StatusTexture->UpdateTextureRegions(0, 1, Region, RowBytes, sizeof(FColor), RegionData,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			delete[] SrcData;
+			delete Regions;
+		});
+
+	// The texture changed under the same brush, cached paint has to be redone
+	if (StatusLayer.IsValid())
+	{
+		StatusLayer->Invalidate(EInvalidateWidgetReason::Paint);
+	}
+
+	INC_DWORD_STAT(STAT_Dieg_GridStatusUploads);
+	INC_DWORD_STAT_BY(STAT_Dieg_GridStatusTexelsUploaded, Rect.Area());
 }
 
 
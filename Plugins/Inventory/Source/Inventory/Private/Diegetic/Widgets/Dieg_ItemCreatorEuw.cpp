@@ -10,6 +10,7 @@
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "Components/CanvasPanel.h"
 #include "Diegetic/Dieg_UtilityLibrary.h"
+#include "Diegetic/Subsystems/Dieg_AssetStreamingSubsystem.h"
 #include "Diegetic/UObjects/Dieg_ItemDefinitionDataAsset.h"
 #include "Diegetic/UStructs/Dieg_ItemDefinition.h"
 #include "Diegetic/Widgets/Dieg_Slot.h"
@@ -24,6 +25,17 @@ void UDieg_ItemCreatorEuw::NativePreConstruct()
 	
 }
 
+void UDieg_ItemCreatorEuw::NativeDestruct()
+{
+	if (UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get())
+	{
+		Streamer->ReleaseHolderAssets(this);
+	}
+	PendingStaticMesh.Reset();
+
+	Super::NativeDestruct();
+}
+
 void UDieg_ItemCreatorEuw::NativeConstruct()
 {
 	Super::NativeConstruct();
@@ -95,12 +107,13 @@ void UDieg_ItemCreatorEuw::ModifyDataAsset()
 	FDieg_ItemDefinition& ItemDefinition = SelectedItemDataAsset->ItemDefinition;
 	// Set properties
 	ItemDefinition.Name = Property_Name;
-	ItemDefinition.WorldMesh = Property_StaticMesh;
+	ItemDefinition.WorldMesh = GetStaticMeshToSave();
 	ItemDefinition.DefaultShape = SelectedSlots.Array();
 	ItemDefinition.StackSizeMax = Property_MaxQuantity;
 	
 	// Update the shape root after setting the shape
 	UDieg_ItemDefinitionDataAsset::SetItemDefinitionShapeRoot(ItemDefinition);
+	SelectedItemDataAsset->BuildRotatedShapes();
 		
 	// Mark dirty so it can be saved
 	SelectedItemDataAsset->MarkPackageDirty();
@@ -162,12 +175,13 @@ void UDieg_ItemCreatorEuw::CreateDataAsset()
 
 		// Set properties
 		ItemDefinition.Name = Property_Name;
-		ItemDefinition.WorldMesh = Property_StaticMesh;
+		ItemDefinition.WorldMesh = GetStaticMeshToSave();
 		ItemDefinition.DefaultShape = SelectedSlots.Array();
 		ItemDefinition.StackSizeMax = Property_MaxQuantity;
 		
 		// Update the shape root after setting the shape
 		UDieg_ItemDefinitionDataAsset::SetItemDefinitionShapeRoot(ItemDefinition);
+		ItemDataAsset->BuildRotatedShapes();
 		
 		// Mark dirty so it can be saved
 		ItemDataAsset->MarkPackageDirty();
@@ -202,6 +216,14 @@ void UDieg_ItemCreatorEuw::SelectDataAsset(const FString& Option)
 	float ItemSize = 3.0f;
 	int32 MaxQuantity = 1;
 	TArray<FIntPoint> Shape;
+	PendingStaticMesh.Reset();
+
+	// Only the selected item's assets are kept loaded for the editor
+	UDieg_AssetStreamingSubsystem* Streamer = UDieg_AssetStreamingSubsystem::Get();
+	if (Streamer)
+	{
+		Streamer->ReleaseHolderAssets(this);
+	}
 	
 	if (Option != EmptySelectionOption)
 	{
@@ -211,13 +233,18 @@ void UDieg_ItemCreatorEuw::SelectDataAsset(const FString& Option)
 
 		SelectedDataAssetName = ItemDefinition.Name;
 
-		if (ItemDefinition.WorldMesh.IsValid())
-		{
-			SelectedDataAssetMesh = ItemDefinition.WorldMesh.Get();
-		}
-		else
+		// Don't stall the editor on big meshes, the property view fills in once it streamed in
+		SelectedDataAssetMesh = ItemDefinition.WorldMesh.Get();
+		if (!SelectedDataAssetMesh && !ItemDefinition.WorldMesh.IsNull())
 		{
-			SelectedDataAssetMesh = ItemDefinition.WorldMesh.LoadSynchronous();
+			if (Streamer && !Streamer->RequestItemAssets(SelectedDataAsset, this, FSimpleDelegate::CreateUObject(this, &ThisClass::HandleStaticMeshStreamed, ItemDefinition.WorldMesh)))
+			{
+				PendingStaticMesh = ItemDefinition.WorldMesh;
+			}
+			else
+			{
+				SelectedDataAssetMesh = UDieg_AssetStreamingSubsystem::LoadBlocking(ItemDefinition.WorldMesh, TEXT("UDieg_ItemCreatorEuw::SelectDataAsset"));
+			}
 		}
 		
 		MaxQuantity = ItemDefinition.StackSizeMax;
@@ -237,11 +264,13 @@ void UDieg_ItemCreatorEuw::SelectDataAsset(const FString& Option)
 	SelectedSlots.Empty();
 	SetupGrid(ItemSize);
 
-	TMap<FIntPoint, UDieg_Slot*> SlotMap = GridWidget->GetSlotMap();
-	UDieg_UtilityLibrary::ForEachSlotInShape(SlotMap, Shape, [&](UDieg_Slot* GridSlot)
+	for (const FIntPoint& Coordinates : Shape)
 	{
-		HandleSlotPressed(GridSlot);
-	});
+		if (UDieg_Slot* GridSlot = GridWidget->FindSlot(Coordinates))
+		{
+			HandleSlotPressed(GridSlot);
+		}
+	}
 }
 
 void UDieg_ItemCreatorEuw::AddDataAssetToMap(FString Name, UDieg_ItemDefinitionDataAsset* DataAsset)
@@ -406,3 +435,28 @@ void UDieg_ItemCreatorEuw::HandleSpinBoxGridSizeChange(float InValue)
 {
 	SetupGrid(floor(InValue));
 }
+
+void UDieg_ItemCreatorEuw::HandleStaticMeshStreamed(const TSoftObjectPtr<UStaticMesh> StaticMesh)
+{
+	// Another data asset may have been selected, or a mesh picked by hand, in the meantime
+	if (PendingStaticMesh != StaticMesh || IsValid(Property_StaticMesh))
+	{
+		return;
+	}
+
+	Property_StaticMesh = StaticMesh.Get();
+	PendingStaticMesh.Reset();
+	if (IsValid(SinglePropertyView_StaticMesh))
+	{
+		SinglePropertyView_StaticMesh->SetObject(this);
+	}
+}
+
+TSoftObjectPtr<UStaticMesh> UDieg_ItemCreatorEuw::GetStaticMeshToSave() const
+{
+	if (IsValid(Property_StaticMesh))
+	{
+		return Property_StaticMesh;
+	}
+	return PendingStaticMesh;
+}
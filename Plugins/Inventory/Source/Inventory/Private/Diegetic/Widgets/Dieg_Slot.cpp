@@ -8,8 +8,10 @@
 #include "Components/GridSlot.h"
 #include "Components/Image.h"
 #include "Components/SizeBox.h"
+#include "Inventory.h"
 #include "Diegetic/Widgets/Dieg_Grid.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Slot Widget Color Updates"), STAT_Dieg_SlotWidgetColorUpdates, STATGROUP_DiegInventory);
 
 void UDieg_Slot::NativePreConstruct()
 {
@@ -69,12 +71,24 @@ void UDieg_Slot::InitializeDefaults_Implementation()
 		SizeBox_Root->SetHeightOverride(SlotSize.Y);
 	}
 
+	// The parent grid draws the fill of all its slots itself
+	if (IsValid(Image_Fill) && ParentGrid.IsValid() && ParentGrid->IsStatusBatched())
+	{
+		Image_Fill->SetVisibility(ESlateVisibility::Collapsed);
+	}
+
 	constexpr bool ChangeAppearance = true;
 	SetStatusAndColor(SlotStatus, ChangeAppearance);
 }
 
 FIntPoint UDieg_Slot::GetCoordinatesInGrid_Implementation()
 {
+	// Set by the grid, panel rows and columns are relative to the view when it virtualizes slots
+	if (ParentGrid.IsValid())
+	{
+		return LastUpdatedCoordinate;
+	}
+
 	const UGridSlot* GridSlot = UWidgetLayoutLibrary::SlotAsGridSlot(this);
 	if (!IsValid(GridSlot))
 		return FIntPoint();
@@ -89,6 +103,21 @@ void UDieg_Slot::SetStatusAndColor_Implementation(EDieg_SlotStatus Status, bool
 	// 	FColor::Emerald, GetCoordinatesInGrid(), Status);
 
 	this->SlotStatus = Status;
-	const FLinearColor ColorToSet = SlotFillColor.FindChecked(Status);
-	Image_Fill->SetColorAndOpacity(ColorToSet);
+
+	// The grid draws every slot's fill in one texture, don't invalidate this widget
+	if (ParentGrid.IsValid() && ParentGrid->IsStatusBatched())
+	{
+		ParentGrid->SetCellStatus(LastUpdatedCoordinate, Status);
+		return;
+	}
+
+	// Slot classes without a fill image or a color for this status only track the status
+	const FLinearColor* ColorToSet = SlotFillColor.Find(Status);
+	if (!ColorToSet || !IsValid(Image_Fill))
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_Dieg_SlotWidgetColorUpdates);
+	Image_Fill->SetColorAndOpacity(*ColorToSet);
 }
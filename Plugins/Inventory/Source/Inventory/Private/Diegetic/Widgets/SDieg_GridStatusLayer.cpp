@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Diegetic/Widgets/SDieg_GridStatusLayer.h"
+
+#include "Engine/Texture2D.h"
+#include "Rendering/DrawElements.h"
+
+void SDieg_GridStatusLayer::Construct(const FArguments& InArgs)
+{
+	SetCanTick(false);
+	StatusBrush.DrawAs = ESlateBrushDrawType::Image;
+	StatusBrush.Tiling = ESlateBrushTileType::NoTile;
+}
+
+void SDieg_GridStatusLayer::SetStatusTexture(UTexture2D* Texture, const FVector2D& InDrawSize)
+{
+	StatusBrush.SetResourceObject(Texture);
+	StatusBrush.ImageSize = InDrawSize;
+	DrawSize = Texture ? InDrawSize : FVector2D::ZeroVector;
+	Invalidate(EInvalidateWidgetReason::Layout);
+}
+
+int32 SDieg_GridStatusLayer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+	FSlateWindowElementList& OutDrawElements, const int32 LayerId, const FWidgetStyle& InWidgetStyle, const bool bParentEnabled) const
+{
+	if (!StatusBrush.GetResourceObject() || DrawSize.IsZero())
+	{
+		return LayerId;
+	}
+
+	// Drawn from the top left at the grid's size, whatever space the parent gives
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId,
+		AllottedGeometry.ToPaintGeometry(FVector2f(DrawSize), FSlateLayoutTransform()),
+		&StatusBrush, ESlateDrawEffect::None, InWidgetStyle.GetColorAndOpacityTint());
+	return LayerId;
+}
+
+FVector2D SDieg_GridStatusLayer::ComputeDesiredSize(const float LayoutScaleMultiplier) const
+{
+	return DrawSize;
+}
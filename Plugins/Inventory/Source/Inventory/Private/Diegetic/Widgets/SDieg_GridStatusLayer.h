@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Styling/SlateBrush.h"
+#include "Widgets/SLeafWidget.h"
+
+class UTexture2D;
+
+/**
+ * @brief Draws the status of every cell of a UDieg_Grid as one textured box.
+ * 
+ * The grid keeps one texel per cell in a transient texture; this layer draws that
+ * texture stretched over the cells with nearest filtering, so the whole grid costs
+ * one draw element no matter how many slots it has. Created by UDieg_Grid under
+ * its content, it needs no material or widget blueprint setup.
+ * 
+ * @see UDieg_Grid::IsStatusBatched
+ */
+class SDieg_GridStatusLayer : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SDieg_GridStatusLayer) {}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/**
+	 * @brief Sets the texture to draw and the size it covers, nullptr to draw nothing.
+	 * 
+	 * @param Texture One texel per cell, kept alive by the owning grid
+	 * @param InDrawSize Size of the whole grid in the grid's local space
+	 */
+	void SetStatusTexture(UTexture2D* Texture, const FVector2D& InDrawSize);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	FSlateBrush StatusBrush;
+
+	FVector2D DrawSize{FVector2D::ZeroVector};
+};
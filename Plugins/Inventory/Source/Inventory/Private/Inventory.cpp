@@ -6,6 +6,9 @@
 
 DEFINE_LOG_CATEGORY(LogInventory);	
 
+DEFINE_STAT(STAT_Dieg_SyncTraceTime);
+DEFINE_STAT(STAT_Dieg_SyncTraces);
+
 void FInventoryModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
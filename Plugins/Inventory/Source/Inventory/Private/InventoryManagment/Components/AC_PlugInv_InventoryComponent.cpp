@@ -23,6 +23,10 @@ UPlugInv_InventoryComponent::UPlugInv_InventoryComponent()
 	SetIsReplicatedByDefault(true);
 	bReplicateUsingRegisteredSubObjectList = true;
 	bInventoryMenuOpen = false;
+
+	GridDimensions.Add(EPlugInv_ItemCategory::Equippable, FIntPoint(8, 6));
+	GridDimensions.Add(EPlugInv_ItemCategory::Consumable, FIntPoint(8, 6));
+	GridDimensions.Add(EPlugInv_ItemCategory::Craftable, FIntPoint(8, 6));
 }
 
 void UPlugInv_InventoryComponent::PostInitProperties()
@@ -35,7 +39,7 @@ void UPlugInv_InventoryComponent::PostInitProperties()
 void UPlugInv_InventoryComponent::TryAddItem(UPlugInv_ItemComponent* ItemComponent)
 {
 	UPlugInv_DoubleLogger::Log("Try add item for InventoryComponent + OnNoRoomInInventory.Broadcast()");
-	FPlugInv_SlotAvailabilityResult Result = InventoryMenu->HasRoomForItem(ItemComponent);
+	FPlugInv_SlotAvailabilityResult Result = HasRoomForItem(ItemComponent->GetItemManifest());
 
 	UPlugInv_InventoryItem* FoundItem = InventoryList.FindFirstItemByType(ItemComponent->GetItemManifest().GetItemType());
 	Result.Item = FoundItem;
@@ -53,6 +57,10 @@ void UPlugInv_InventoryComponent::TryAddItem(UPlugInv_ItemComponent* ItemCompone
 	{
 		UPlugInv_DoubleLogger::Log("InventoryComponent::TryAddItem() : Scenario 1: Item already exists in inventory.");
 		// Add stacks to an item that already exists in the inventory. Update the stack count and not create a new item of this type.
+		if (FPlugInv_GridModel* GridModel = GridModels.Find(ItemComponent->GetItemManifest().GetItemCategory()))
+		{
+			GridModel->ApplyResult(Result, Result.Item.Get());
+		}
 		OnStackChange.Broadcast(Result);
 		Server_AddStacksToItem_Implementation(ItemComponent, Result.TotalRoomToFill, Result.Remainder);
 	}
@@ -70,6 +78,7 @@ void UPlugInv_InventoryComponent::Server_AddNewItem_Implementation(UPlugInv_Item
 {
 	UPlugInv_InventoryItem* NewInventoryItem = InventoryList.AddEntry(ItemComponent);
 	NewInventoryItem->SetTotalStackCount(StackCount);
+	AddItemToGridModel(NewInventoryItem, StackCount);
 	
 	// Maybe the current player is playing/acting on a listen server (local player who is a host or standalone)
 	if (GetOwner()->GetNetMode() == ENetMode::NM_ListenServer || GetOwner()->GetNetMode() == ENetMode::NM_Standalone)
@@ -102,13 +111,256 @@ void UPlugInv_InventoryComponent::Server_AddStacksToItem_Implementation(UPlugInv
 	{
 		ItemComponent->PickUp();
 	}
-	else if (FPlugInv_StackableFragment* StackableFragment = ItemComponent->GetItemManifest().GetFragmentOfTypeMutable<FPlugInv_StackableFragment>())
+	else if (FPlugInv_StackableFragment* StackableFragment = ItemComponent->GetItemManifestMutable().GetFragmentOfTypeMutable<FPlugInv_StackableFragment>())
 	{
 		// Otherwise, update the stack count for the item pickup
 		StackableFragment->SetStackCount(Remainder);
 	}
 }
 
+FPlugInv_SlotAvailabilityResult UPlugInv_InventoryComponent::HasRoomForItem(const FPlugInv_ItemManifest& ItemManifest, const int32 StackAmountOverride) const
+{
+	const FPlugInv_GridModel* GridModel = GetGridModel(ItemManifest.GetItemCategory());
+	if (!GridModel)
+	{
+		return FPlugInv_SlotAvailabilityResult();
+	}
+	return GridModel->HasRoomForItem(ItemManifest, StackAmountOverride);
+}
+
+void UPlugInv_InventoryComponent::RegisterGrid(const EPlugInv_ItemCategory Category, const int32 Rows, const int32 Columns)
+{
+	FPlugInv_GridModel& GridModel = GridModels.FindOrAdd(Category);
+	if (!GridModel.IsInitialized())
+	{
+		GridModel.Initialize(Category, Rows, Columns);
+		return;
+	}
+
+	if (GridModel.GetRows() != Rows || GridModel.GetColumns() != Columns)
+	{
+		UPlugInv_DoubleLogger::LogWarning(5.0f, TEXT("InventoryComponent::RegisterGrid : Grid widget is {0}x{1} but GridDimensions has {2}x{3}"),
+			Columns, Rows, GridModel.GetColumns(), GridModel.GetRows());
+	}
+}
+
+void UPlugInv_InventoryComponent::AddItemToGridModel(UPlugInv_InventoryItem* Item, const int32 StackCount)
+{
+	if (!IsValid(Item)) return;
+
+	FPlugInv_GridModel* GridModel = GridModels.Find(Item->GetItemManifest().GetItemCategory());
+	if (!GridModel) return;
+
+	// Already placed by a grid edit.
+	TArray<int32> Placements;
+	GridModel->GetItemPlacements(Item, Placements);
+	if (!Placements.IsEmpty()) return;
+
+	const FPlugInv_SlotAvailabilityResult Result = GridModel->HasRoomForItem(Item->GetItemManifest(), Item->IsStackable() ? StackCount : -1);
+	GridModel->ApplyResult(Result, Item);
+}
+
+void UPlugInv_InventoryComponent::PlaceGridItem(UPlugInv_InventoryItem* Item, const int32 Index, const int32 StackCount)
+{
+	if (!IsValid(Item)) return;
+
+	ApplyPlaceGridItem(Item, Index, StackCount);
+	if (!GetOwner()->HasAuthority())
+	{
+		Server_PlaceGridItem(Item, Index, StackCount);
+	}
+}
+
+void UPlugInv_InventoryComponent::RemoveGridItem(const EPlugInv_ItemCategory Category, const int32 Index)
+{
+	ApplyRemoveGridItem(Category, Index);
+	if (!GetOwner()->HasAuthority())
+	{
+		Server_RemoveGridItem(Category, Index);
+	}
+}
+
+void UPlugInv_InventoryComponent::SetGridStackCount(const EPlugInv_ItemCategory Category, const int32 Index, const int32 StackCount)
+{
+	ApplySetGridStackCount(Category, Index, StackCount);
+	if (!GetOwner()->HasAuthority())
+	{
+		Server_SetGridStackCount(Category, Index, StackCount);
+	}
+}
+
+void UPlugInv_InventoryComponent::DropItem(UPlugInv_InventoryItem* Item, const int32 StackCount, const int32 GridIndex)
+{
+	if (!IsValid(Item)) return;
+
+	if (!GetOwner()->HasAuthority())
+	{
+		TrimGridPlacements(Item, Item->GetTotalStackCount() - StackCount, GridIndex);
+	}
+	Server_DropItem(Item, StackCount, GridIndex);
+}
+
+void UPlugInv_InventoryComponent::ConsumeItem(UPlugInv_InventoryItem* Item, const int32 GridIndex)
+{
+	if (!IsValid(Item)) return;
+
+	if (!GetOwner()->HasAuthority())
+	{
+		TrimGridPlacements(Item, Item->GetTotalStackCount() - 1, GridIndex);
+	}
+	Server_ConsumeItem(Item, GridIndex);
+}
+
+void UPlugInv_InventoryComponent::Server_PlaceGridItem_Implementation(UPlugInv_InventoryItem* Item, int32 Index, int32 StackCount)
+{
+	// Only items this inventory holds can be placed in its grids.
+	if (!IsValid(Item) || !InventoryList.Contains(Item))
+	{
+		UPlugInv_DoubleLogger::LogWarning("InventoryComponent::Server_PlaceGridItem : Item is not in this inventory");
+		return;
+	}
+
+	if (const FPlugInv_GridModel* GridModel = GridModels.Find(Item->GetItemManifest().GetItemCategory()))
+	{
+		StackCount = ClampGridStackCount(*GridModel, Item, Index, StackCount);
+	}
+	ApplyPlaceGridItem(Item, Index, StackCount);
+}
+
+void UPlugInv_InventoryComponent::Server_RemoveGridItem_Implementation(EPlugInv_ItemCategory Category, int32 Index)
+{
+	ApplyRemoveGridItem(Category, Index);
+}
+
+void UPlugInv_InventoryComponent::Server_SetGridStackCount_Implementation(EPlugInv_ItemCategory Category, int32 Index, int32 StackCount)
+{
+	const FPlugInv_GridModel* GridModel = GridModels.Find(Category);
+	const UPlugInv_InventoryItem* Item = GridModel ? GridModel->GetItemAt(Index) : nullptr;
+	if (!IsValid(Item))
+	{
+		UPlugInv_DoubleLogger::LogWarning(5.0f, TEXT("InventoryComponent::Server_SetGridStackCount : No item at index {0}"), Index);
+		return;
+	}
+	ApplySetGridStackCount(Category, Index, ClampGridStackCount(*GridModel, Item, Index, StackCount));
+}
+
+void UPlugInv_InventoryComponent::ApplyPlaceGridItem(UPlugInv_InventoryItem* Item, const int32 Index, const int32 StackCount)
+{
+	const FPlugInv_ItemManifest& ItemManifest = Item->GetItemManifest();
+	const FPlugInv_GridFragment* GridFragment = ItemManifest.GetFragmentOfType<FPlugInv_GridFragment>();
+	const FIntPoint Dimensions = GridFragment ? GridFragment->GetGridSize() : FIntPoint(1, 1);
+
+	FPlugInv_GridModel* GridModel = GridModels.Find(ItemManifest.GetItemCategory());
+	if (!GridModel || !GridModel->PlaceItem(Item, Index, Dimensions, StackCount))
+	{
+		UPlugInv_DoubleLogger::LogWarning(5.0f, TEXT("InventoryComponent::ApplyPlaceGridItem : Rejected placement at index {0}"), Index);
+	}
+}
+
+void UPlugInv_InventoryComponent::ApplyRemoveGridItem(const EPlugInv_ItemCategory Category, const int32 Index)
+{
+	FPlugInv_GridModel* GridModel = GridModels.Find(Category);
+	if (!GridModel || !GridModel->RemoveItemAt(Index))
+	{
+		UPlugInv_DoubleLogger::LogWarning(5.0f, TEXT("InventoryComponent::ApplyRemoveGridItem : Nothing to remove at index {0}"), Index);
+	}
+}
+
+void UPlugInv_InventoryComponent::ApplySetGridStackCount(const EPlugInv_ItemCategory Category, const int32 Index, const int32 StackCount)
+{
+	FPlugInv_GridModel* GridModel = GridModels.Find(Category);
+	if (!GridModel || !GridModel->SetStackCount(Index, StackCount))
+	{
+		UPlugInv_DoubleLogger::LogWarning(5.0f, TEXT("InventoryComponent::ApplySetGridStackCount : No item at index {0}"), Index);
+	}
+}
+
+void UPlugInv_InventoryComponent::TrimGridPlacements(UPlugInv_InventoryItem* Item, const int32 TotalStackCount, const int32 PreferredIndex)
+{
+	FPlugInv_GridModel* GridModel = GridModels.Find(Item->GetItemManifest().GetItemCategory());
+	if (!GridModel) return;
+
+	TArray<int32> Placements;
+	GridModel->GetItemPlacements(Item, Placements);
+
+	if (TotalStackCount <= 0)
+	{
+		for (const int32 UpperLeftIndex : Placements)
+		{
+			GridModel->RemoveItemAt(UpperLeftIndex);
+		}
+		return;
+	}
+
+	// Non stackable placements hold no stacks.
+	if (!Item->IsStackable()) return;
+
+	int32 Excess = -TotalStackCount;
+	for (const int32 UpperLeftIndex : Placements)
+	{
+		Excess += GridModel->GetStackCount(UpperLeftIndex);
+	}
+
+	// Placements are taken from the back, move the preferred one there.
+	if (GridModel->GetItemAt(PreferredIndex) == Item && Placements.Remove(GridModel->GetUpperLeftIndex(PreferredIndex)) > 0)
+	{
+		Placements.Add(GridModel->GetUpperLeftIndex(PreferredIndex));
+	}
+
+	for (int32 PlacementIndex = Placements.Num() - 1; PlacementIndex >= 0 && Excess > 0; --PlacementIndex)
+	{
+		const int32 UpperLeftIndex = Placements[PlacementIndex];
+		const int32 StackCount = GridModel->GetStackCount(UpperLeftIndex);
+		const int32 Taken = FMath::Min(StackCount, Excess);
+		if (Taken == StackCount)
+		{
+			GridModel->RemoveItemAt(UpperLeftIndex);
+		}
+		else
+		{
+			GridModel->SetStackCount(UpperLeftIndex, StackCount - Taken);
+		}
+		Excess -= Taken;
+	}
+}
+
+int32 UPlugInv_InventoryComponent::ClampGridStackCount(const FPlugInv_GridModel& GridModel, const UPlugInv_InventoryItem* Item,
+	const int32 Index, const int32 StackCount) const
+{
+	const FPlugInv_StackableFragment* StackableFragment = Item->GetItemManifest().GetFragmentOfType<FPlugInv_StackableFragment>();
+	if (!Item->IsStackable() || !StackableFragment) return 0;
+
+	// Stacks the item holds outside of the placement at Index, e.g. in its other placements.
+	const int32 UpperLeftIndex = GridModel.GetItemAt(Index) == Item ? GridModel.GetUpperLeftIndex(Index) : INDEX_NONE;
+	TArray<int32> Placements;
+	GridModel.GetItemPlacements(Item, Placements);
+	int32 HeldElsewhere = 0;
+	for (const int32 PlacementIndex : Placements)
+	{
+		if (PlacementIndex != UpperLeftIndex)
+		{
+			HeldElsewhere += GridModel.GetStackCount(PlacementIndex);
+		}
+	}
+
+	const int32 MaxStackCount = FMath::Max(0, FMath::Min(StackableFragment->GetMaxStackSize(), Item->GetTotalStackCount() - HeldElsewhere));
+	const int32 ClampedStackCount = FMath::Clamp(StackCount, 0, MaxStackCount);
+	if (ClampedStackCount != StackCount)
+	{
+		UPlugInv_DoubleLogger::LogWarning(5.0f, TEXT("InventoryComponent::ClampGridStackCount : Clamped {0} stacks to {1} at index {2}"),
+			StackCount, ClampedStackCount, Index);
+	}
+	return ClampedStackCount;
+}
+
+void UPlugInv_InventoryComponent::ConstructGridModels()
+{
+	for (const TPair<EPlugInv_ItemCategory, FIntPoint>& Dimensions : GridDimensions)
+	{
+		GridModels.FindOrAdd(Dimensions.Key).Initialize(Dimensions.Key, Dimensions.Value.Y, Dimensions.Value.X);
+	}
+}
+
 // Called when the game starts
 void UPlugInv_InventoryComponent::BeginPlay()
 {
@@ -121,6 +373,19 @@ void UPlugInv_InventoryComponent::BeginPlay()
 	{
 		UPlugInv_DoubleLogger::LogWarning("InventoryList OwnerComponent is NOT null in BeginPlay!");
 	}
+	ConstructGridModels();
+	if (GetOwner()->HasAuthority())
+	{
+		// The server has no widget to register a missing category from.
+		for (const EPlugInv_ItemCategory Category : { EPlugInv_ItemCategory::Equippable, EPlugInv_ItemCategory::Consumable, EPlugInv_ItemCategory::Craftable })
+		{
+			if (!GridModels.Contains(Category))
+			{
+				UPlugInv_DoubleLogger::LogError(5.0f, TEXT("InventoryComponent::BeginPlay : GridDimensions has no size for category {0}"),
+					UEnum::GetValueAsString(Category));
+			}
+		}
+	}
 	ConstructInventory();	
 }
 
@@ -131,7 +396,7 @@ void UPlugInv_InventoryComponent::GetLifetimeReplicatedProps(TArray<class FLifet
 	DOREPLIFETIME(ThisClass, InventoryList);
 }
 
-void UPlugInv_InventoryComponent::Server_DropItem_Implementation(UPlugInv_InventoryItem* Item, int32 StackCount)
+void UPlugInv_InventoryComponent::Server_DropItem_Implementation(UPlugInv_InventoryItem* Item, int32 StackCount, int32 GridIndex)
 {
 	const int32 NewStackCount = Item->GetTotalStackCount() - StackCount;
 	if (NewStackCount <= 0)
@@ -142,11 +407,12 @@ void UPlugInv_InventoryComponent::Server_DropItem_Implementation(UPlugInv_Invent
 	{
 		Item->SetTotalStackCount(NewStackCount);
 	}
+	TrimGridPlacements(Item, NewStackCount, GridIndex);
 	
 	SpawnDroppedItem(Item, StackCount);
 }
 
-void UPlugInv_InventoryComponent::Server_ConsumeItem_Implementation(UPlugInv_InventoryItem* Item)
+void UPlugInv_InventoryComponent::Server_ConsumeItem_Implementation(UPlugInv_InventoryItem* Item, int32 GridIndex)
 {
 	const int32 NewStackCount = Item->GetTotalStackCount() - 1;
 	
@@ -158,6 +424,7 @@ void UPlugInv_InventoryComponent::Server_ConsumeItem_Implementation(UPlugInv_Inv
 	{
 		Item->SetTotalStackCount(NewStackCount);
 	}
+	TrimGridPlacements(Item, NewStackCount, GridIndex);
 	
 	if (FPlugInv_ConsumableFragment* ConsumableFragment = Item->GetItemManifestMutable().GetFragmentOfTypeMutable<FPlugInv_ConsumableFragment>())
 	{
@@ -23,6 +23,9 @@ TArray<TObjectPtr<UPlugInv_InventoryItem>> FPlugInv_InventoryFastArray::GetAllIt
 
 void FPlugInv_InventoryFastArray::PreReplicatedRemove(const TArrayView<int32> RemovedIndices, int32 FinalSize)
 {
+	// The serializer swaps entries around once they're removed.
+	bIndicesStale = true;
+
 	TObjectPtr<UPlugInv_InventoryComponent> ItemComponent = Cast<UPlugInv_InventoryComponent>(this->OwnerComponent);
 	if (!IsValid(ItemComponent)) return;
 
@@ -35,11 +38,21 @@ void FPlugInv_InventoryFastArray::PreReplicatedRemove(const TArrayView<int32> Re
 
 void FPlugInv_InventoryFastArray::PostReplicatedAdd(const TArrayView<int32> AddedIndices, int32 FinalSize)
 {
+	if (!bIndicesStale)
+	{
+		for (const int32 Index : AddedIndices)
+		{
+			IndexEntry(Index);
+		}
+	}
+
 	TObjectPtr<UPlugInv_InventoryComponent> ItemComponent = Cast<UPlugInv_InventoryComponent>(this->OwnerComponent);
 	if (!IsValid(ItemComponent)) return;
 
 	for (int32 Index : AddedIndices)
 	{
+		// Mirror the server's placement before the grid widgets draw the item.
+		ItemComponent->AddItemToGridModel(Entries[Index].Item, IsValid(Entries[Index].Item) ? Entries[Index].Item->GetTotalStackCount() : 0);
 		UPlugInv_DoubleLogger::Log("InventoryFastArray::PostReplicatedAdd : OnItemAdded.Broadcast()");
 		ItemComponent->OnItemAdded.Broadcast(Entries[Index].Item);
 	}
@@ -47,6 +60,9 @@ void FPlugInv_InventoryFastArray::PostReplicatedAdd(const TArrayView<int32> Adde
 
 void FPlugInv_InventoryFastArray::PostReplicatedChange(const TArrayView<int32> ChangedIndices, int32 FinalSize)
 {
+	// A changed entry may point to another item.
+	bIndicesStale = true;
+
 	TObjectPtr<UPlugInv_InventoryComponent> ItemComponent = Cast<UPlugInv_InventoryComponent>(this->OwnerComponent);
 	if (!IsValid(ItemComponent)) return;
 
@@ -69,12 +85,13 @@ TObjectPtr<UPlugInv_InventoryItem> FPlugInv_InventoryFastArray::AddEntry(TObject
 	FPlugInv_InventoryItemEntry& NewEntryRef = Entries.AddDefaulted_GetRef();
 
 	/**
-	* This line NewEntry.Item = ItemComponent->GetItemManifest().Manifest(OwningActor); creates a new Item so it needs to be registered.
+	* This line NewEntry.Item = ItemComponent->GetItemManifestMutable().Manifest(OwningActor); creates a new Item so it needs to be registered.
 	* The other overload doesnt create an Item but has an already made Item passed to it
 	* and its not this function's responsibility to register it for replication since its not creating it.
 	**/
-	NewEntryRef.Item = ItemComponent->GetItemManifest().Manifest(OwningActor);
+	NewEntryRef.Item = ItemComponent->GetItemManifestMutable().Manifest(OwningActor);
 	InventoryComponent->AddSubObjToReplication(NewEntryRef.Item);
+	IndexEntry(Entries.Num() - 1);
 	
 	MarkItemDirty(NewEntryRef);
 	return NewEntryRef.Item;
@@ -89,6 +106,7 @@ TObjectPtr<UPlugInv_InventoryItem> FPlugInv_InventoryFastArray::AddEntry(TObject
 
 	FPlugInv_InventoryItemEntry& NewEntryRef = Entries.AddDefaulted_GetRef();
 	NewEntryRef.Item = Item;
+	IndexEntry(Entries.Num() - 1);
 
 	this->MarkItemDirty(NewEntryRef);
 	return Item;
@@ -96,22 +114,88 @@ TObjectPtr<UPlugInv_InventoryItem> FPlugInv_InventoryFastArray::AddEntry(TObject
 
 void FPlugInv_InventoryFastArray::RemoveEntry(TObjectPtr<UPlugInv_InventoryItem> Item)
 {
-	for (auto EntryIt = Entries.CreateIterator(); EntryIt; ++EntryIt)
+	RebuildIndicesIfStale();
+
+	const int32* FoundIndex = EntryIndexByItem.Find(Item);
+	if (!FoundIndex) return;
+
+	// Swap the last entry into the hole instead of shifting every entry after it.
+	const int32 EntryIndex = *FoundIndex;
+	const int32 LastIndex = Entries.Num() - 1;
+	UnindexEntry(EntryIndex);
+	if (EntryIndex != LastIndex)
+	{
+		RemapEntry(LastIndex, EntryIndex);
+	}
+	Entries.RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	this->MarkArrayDirty();
+}
+
+TObjectPtr<UPlugInv_InventoryItem> FPlugInv_InventoryFastArray::FindFirstItemByType(const FGameplayTag& ItemType)
+{
+	RebuildIndicesIfStale();
+
+	const TArray<int32, TInlineAllocator<2>>* TypeIndices = EntryIndicesByType.Find(ItemType);
+	return TypeIndices && !TypeIndices->IsEmpty() ? Entries[(*TypeIndices)[0]].Item : nullptr;
+}
+
+bool FPlugInv_InventoryFastArray::Contains(const UPlugInv_InventoryItem* Item) const
+{
+	RebuildIndicesIfStale();
+	return IsValid(Item) && EntryIndexByItem.Contains(Item);
+}
+
+void FPlugInv_InventoryFastArray::IndexEntry(const int32 EntryIndex) const
+{
+	const UPlugInv_InventoryItem* Item = Entries[EntryIndex].Item;
+	if (!IsValid(Item)) return;
+
+	EntryIndexByItem.Add(Item, EntryIndex);
+	EntryIndicesByType.FindOrAdd(Item->GetItemManifest().GetItemType()).Add(EntryIndex);
+}
+
+void FPlugInv_InventoryFastArray::UnindexEntry(const int32 EntryIndex) const
+{
+	const UPlugInv_InventoryItem* Item = Entries[EntryIndex].Item;
+	if (!IsValid(Item)) return;
+
+	EntryIndexByItem.Remove(Item);
+	const FGameplayTag ItemType = Item->GetItemManifest().GetItemType();
+	if (TArray<int32, TInlineAllocator<2>>* TypeIndices = EntryIndicesByType.Find(ItemType))
 	{
-		FPlugInv_InventoryItemEntry& Entry = *EntryIt;
-		if (Entry.Item == Item)
+		TypeIndices->RemoveSingle(EntryIndex);
+		if (TypeIndices->IsEmpty())
 		{
-			EntryIt.RemoveCurrent();
-			this->MarkArrayDirty();
+			EntryIndicesByType.Remove(ItemType);
 		}
 	}
 }
 
-TObjectPtr<UPlugInv_InventoryItem> FPlugInv_InventoryFastArray::FindFirstItemByType(const FGameplayTag& ItemType)
+void FPlugInv_InventoryFastArray::RemapEntry(const int32 FromIndex, const int32 ToIndex) const
 {
-	FPlugInv_InventoryItemEntry* FoundItem = Entries.FindByPredicate([Type = ItemType](const FPlugInv_InventoryItemEntry& Entry)
+	const UPlugInv_InventoryItem* Item = Entries[FromIndex].Item;
+	if (!IsValid(Item)) return;
+
+	EntryIndexByItem.Add(Item, ToIndex);
+	if (TArray<int32, TInlineAllocator<2>>* TypeIndices = EntryIndicesByType.Find(Item->GetItemManifest().GetItemType()))
 	{
-		return IsValid(Entry.Item) && Entry.Item->GetItemManifestMutable().GetItemType().MatchesTagExact(Type);
-	});
-	return FoundItem ? FoundItem->Item : nullptr;
+		// Keep the position in the type list so the first item of a type stays the same.
+		if (int32* TypeIndex = TypeIndices->FindByKey(FromIndex))
+		{
+			*TypeIndex = ToIndex;
+		}
+	}
+}
+
+void FPlugInv_InventoryFastArray::RebuildIndicesIfStale() const
+{
+	if (!bIndicesStale) return;
+
+	EntryIndexByItem.Reset();
+	EntryIndicesByType.Reset();
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		IndexEntry(EntryIndex);
+	}
+	bIndicesStale = false;
 }
@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "InventoryManagment/Containers/F_PlugInv_GridModel.h"
+
+#include "Items/O_PlugInv_InventoryItem.h"
+#include "Items/Fragments/BPF_PlugInv_ItemFragmentLibrary.h"
+#include "Items/Manifest/F_PlugInv_ItemManifest.h"
+
+void FPlugInv_GridModel::Initialize(const EPlugInv_ItemCategory InCategory, const int32 InRows, const int32 InColumns)
+{
+	Category = InCategory;
+	Rows = FMath::Max(InRows, 0);
+	Columns = FMath::Max(InColumns, 0);
+
+	const int32 NumCells = Rows * Columns;
+	Occupied.Init(false, NumCells);
+	CellPlacements.Init(INDEX_NONE, NumCells);
+	Placements.Reset();
+	FreePlacements.Reset();
+}
+
+FPlugInv_SlotAvailabilityResult FPlugInv_GridModel::HasRoomForItem(const FPlugInv_ItemManifest& ItemManifest, const int32 StackAmountOverride) const
+{
+	FPlugInv_SlotAvailabilityResult Result;
+
+	// Determine if the item is stackable.
+	const FPlugInv_StackableFragment* StackableFragment = ItemManifest.GetFragmentOfType<FPlugInv_StackableFragment>();
+	Result.bStackable = StackableFragment != nullptr;
+
+	// Determine how many stacks to add.
+	const int32 MaxStackSize = Result.bStackable ? StackableFragment->GetMaxStackSize() : 1;
+	int32 AmountToFill = Result.bStackable ? StackableFragment->GetStackCount() : 1;
+	if (StackAmountOverride != -1 && Result.bStackable)
+	{
+		AmountToFill = StackAmountOverride;
+	}
+
+	const FPlugInv_GridFragment* GridFragment = ItemManifest.GetFragmentOfType<FPlugInv_GridFragment>();
+	const FIntPoint Dimensions = GridFragment ? GridFragment->GetGridSize() : FIntPoint(1, 1);
+	const FGameplayTag& ItemType = ItemManifest.GetItemType();
+
+	// Cells handed out to earlier availabilities of this query.
+	TBitArray<> Claimed(false, Num());
+
+	for (int32 Index = 0; Index < Num() && AmountToFill > 0; ++Index)
+	{
+		// Is this index claimed yet, or covered by a placement anchored somewhere else?
+		if (Claimed[Index] || (Occupied[Index] && Placements[CellPlacements[Index]].UpperLeftIndex != Index))
+		{
+			continue;
+		}
+
+		// Can the item fit here? (i.e. is it out of grid bounds?)
+		if (!IsInGridBounds(Index, Dimensions))
+		{
+			continue;
+		}
+
+		// Every cell must be free, or belong to a placement anchored here of the same stackable type with room left.
+		bool bHasRoomAtIndex = true;
+		ForEachCell(Index, Dimensions, [&](const int32 CellIndex)
+		{
+			if (!bHasRoomAtIndex || !Occupied[CellIndex])
+			{
+				bHasRoomAtIndex = bHasRoomAtIndex && !Claimed[CellIndex];
+				return;
+			}
+
+			const FPlugInv_GridPlacement& Placement = Placements[CellPlacements[CellIndex]];
+			const UPlugInv_InventoryItem* SubItem = Placement.Item.Get();
+			const FPlugInv_StackableFragment* SubStackableFragment = SubItem ? SubItem->GetItemManifest().GetFragmentOfType<FPlugInv_StackableFragment>() : nullptr;
+			bHasRoomAtIndex = !Claimed[CellIndex]
+				&& Placement.UpperLeftIndex == Index
+				&& SubStackableFragment != nullptr
+				&& SubItem->GetItemManifest().GetItemType().MatchesTagExact(ItemType)
+				&& Placement.StackCount < SubStackableFragment->GetMaxStackSize();
+		});
+
+		if (!bHasRoomAtIndex)
+		{
+			continue;
+		}
+
+		// How much to fill in slot?
+		const bool bItemAtIndex = Occupied[Index];
+		const int32 RoomInSlot = MaxStackSize - GetStackCount(Index);
+		const int32 AmountToFillInSlot = Result.bStackable ? FMath::Min(AmountToFill, RoomInSlot) : 1;
+		if (AmountToFillInSlot <= 0)
+		{
+			continue;
+		}
+
+		ForEachCell(Index, Dimensions, [&Claimed](const int32 CellIndex)
+		{
+			Claimed[CellIndex] = true;
+		});
+
+		Result.TotalRoomToFill += AmountToFillInSlot;
+		Result.SlotAvailabilities.Emplace(FPlugInv_SlotAvailability{Index, Result.bStackable ? AmountToFillInSlot : 0, bItemAtIndex});
+
+		AmountToFill -= AmountToFillInSlot;
+		Result.Remainder = AmountToFill;
+	}
+
+	return Result;
+}
+
+void FPlugInv_GridModel::ApplyResult(const FPlugInv_SlotAvailabilityResult& Result, UPlugInv_InventoryItem* Item)
+{
+	if (!IsValid(Item)) return;
+
+	const FPlugInv_GridFragment* GridFragment = Item->GetItemManifest().GetFragmentOfType<FPlugInv_GridFragment>();
+	const FIntPoint Dimensions = GridFragment ? GridFragment->GetGridSize() : FIntPoint(1, 1);
+
+	for (const FPlugInv_SlotAvailability& Availability : Result.SlotAvailabilities)
+	{
+		if (Availability.bItemAtIndex)
+		{
+			SetStackCount(Availability.Index, GetStackCount(Availability.Index) + Availability.AmountToFill);
+		}
+		else
+		{
+			PlaceItem(Item, Availability.Index, Dimensions, Availability.AmountToFill);
+		}
+	}
+}
+
+bool FPlugInv_GridModel::PlaceItem(UPlugInv_InventoryItem* Item, const int32 Index, const FIntPoint& Dimensions, const int32 StackCount)
+{
+	if (!IsValid(Item) || !IsInGridBounds(Index, Dimensions))
+	{
+		return false;
+	}
+
+	bool bCellsFree = true;
+	ForEachCell(Index, Dimensions, [&](const int32 CellIndex)
+	{
+		bCellsFree = bCellsFree && !Occupied[CellIndex];
+	});
+	if (!bCellsFree)
+	{
+		return false;
+	}
+
+	const int32 Handle = FreePlacements.IsEmpty() ? Placements.AddDefaulted() : FreePlacements.Pop(EAllowShrinking::No);
+	FPlugInv_GridPlacement& Placement = Placements[Handle];
+	Placement.Item = Item;
+	Placement.UpperLeftIndex = Index;
+	Placement.Dimensions = Dimensions;
+	Placement.StackCount = StackCount;
+
+	ForEachCell(Index, Dimensions, [&](const int32 CellIndex)
+	{
+		Occupied[CellIndex] = true;
+		CellPlacements[CellIndex] = Handle;
+	});
+	return true;
+}
+
+bool FPlugInv_GridModel::RemoveItemAt(const int32 Index)
+{
+	if (!IsOccupied(Index)) return false;
+
+	const int32 Handle = CellPlacements[Index];
+	FPlugInv_GridPlacement& Placement = Placements[Handle];
+	ForEachCell(Placement.UpperLeftIndex, Placement.Dimensions, [&](const int32 CellIndex)
+	{
+		Occupied[CellIndex] = false;
+		CellPlacements[CellIndex] = INDEX_NONE;
+	});
+
+	Placement = FPlugInv_GridPlacement();
+	FreePlacements.Add(Handle);
+	return true;
+}
+
+bool FPlugInv_GridModel::SetStackCount(const int32 Index, const int32 StackCount)
+{
+	if (!IsOccupied(Index)) return false;
+
+	Placements[CellPlacements[Index]].StackCount = StackCount;
+	return true;
+}
+
+bool FPlugInv_GridModel::IsInGridBounds(const int32 StartIndex, const FIntPoint& Dimensions) const
+{
+	if (StartIndex < 0 || StartIndex >= Num())
+	{
+		return false;
+	}
+
+	// The column where the rightmost square in this item is going to be.
+	const int32 EndColumn = (StartIndex % Columns) + Dimensions.X;
+	const int32 EndRow = (StartIndex / Columns) + Dimensions.Y;
+	return EndColumn <= Columns && EndRow <= Rows;
+}
+
+UPlugInv_InventoryItem* FPlugInv_GridModel::GetItemAt(const int32 Index) const
+{
+	const FPlugInv_GridPlacement* Placement = FindPlacement(Index);
+	return Placement ? Placement->Item.Get() : nullptr;
+}
+
+int32 FPlugInv_GridModel::GetUpperLeftIndex(const int32 Index) const
+{
+	const FPlugInv_GridPlacement* Placement = FindPlacement(Index);
+	return Placement ? Placement->UpperLeftIndex : INDEX_NONE;
+}
+
+int32 FPlugInv_GridModel::GetStackCount(const int32 Index) const
+{
+	const FPlugInv_GridPlacement* Placement = FindPlacement(Index);
+	return Placement ? Placement->StackCount : 0;
+}
+
+void FPlugInv_GridModel::GetItemPlacements(const UPlugInv_InventoryItem* Item, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (!IsValid(Item)) return;
+
+	for (const FPlugInv_GridPlacement& Placement : Placements)
+	{
+		if (Placement.UpperLeftIndex != INDEX_NONE && Placement.Item.Get() == Item)
+		{
+			OutIndices.Add(Placement.UpperLeftIndex);
+		}
+	}
+	OutIndices.Sort();
+}
+
+const FPlugInv_GridPlacement* FPlugInv_GridModel::FindPlacement(const int32 Index) const
+{
+	return IsOccupied(Index) ? &Placements[CellPlacements[Index]] : nullptr;
+}
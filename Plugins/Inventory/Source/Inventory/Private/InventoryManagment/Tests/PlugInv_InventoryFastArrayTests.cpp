@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "InventoryManagment/Components/AC_PlugInv_InventoryComponent.h"
+#include "InventoryManagment/Containers/BPF_FastArray.h"
+#include "Items/O_PlugInv_InventoryItem.h"
+#include "Items/PlugInv_ItemTags.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PlugInv_InventoryFastArrayTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	// Manifest of a given item type, the type tags are only settable from the editor otherwise
+	struct FTypedManifest : public FPlugInv_ItemManifest
+	{
+		explicit FTypedManifest(const FGameplayTag& ItemType)
+		{
+			ItemTypesTags.AddTag(ItemType);
+		}
+	};
+
+	TArray<FGameplayTag> GetItemTypes()
+	{
+		using namespace GameItems;
+		return {
+			Equipment::Weapons::Axe, Equipment::Weapons::Sword, Equipment::Cloaks::RedCloak, Equipment::Masks::SteelMask,
+			Consumables::Potions::Red::Small, Consumables::Potions::Red::Large, Consumables::Potions::Blue::Small, Consumables::Potions::Blue::Large,
+			Craftables::FireFernFruit, Craftables::LuminDaisy, Craftables::ScorchPetalBlossom
+		};
+	}
+
+	UPlugInv_InventoryItem* CreateItem(UObject* Outer, const FGameplayTag& ItemType)
+	{
+		UPlugInv_InventoryItem* Item = NewObject<UPlugInv_InventoryItem>(Outer);
+		Item->SetItemManifest(FTypedManifest(ItemType));
+		return Item;
+	}
+
+	// Component whose owner has authority, as AddEntry requires
+	UPlugInv_InventoryComponent* CreateOwnerComponent(UWorld* World)
+	{
+		AActor* Owner = World->SpawnActor<AActor>();
+		return NewObject<UPlugInv_InventoryComponent>(Owner);
+	}
+
+	// The lookup before entries were indexed: first entry in order whose item has the type
+	UPlugInv_InventoryItem* FindFirstItemByTypeLinear(const TArray<UPlugInv_InventoryItem*>& Items, const FGameplayTag& ItemType)
+	{
+		for (UPlugInv_InventoryItem* Item : Items)
+		{
+			if (IsValid(Item) && Item->GetItemManifest().GetItemType().MatchesTagExact(ItemType))
+			{
+				return Item;
+			}
+		}
+		return nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlugInv_FastArrayFirstItemByTypeTest, "Inventory.PlugInv.InventoryFastArray.FirstItemByTypeAfterRemove",
+	PlugInv_InventoryFastArrayTests::TestFlags)
+
+bool FPlugInv_FastArrayFirstItemByTypeTest::RunTest(const FString& Parameters)
+{
+	using namespace PlugInv_InventoryFastArrayTests;
+
+	constexpr int32 NumEntries = 200;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UPlugInv_InventoryComponent* OwnerComponent = CreateOwnerComponent(World);
+	FPlugInv_InventoryFastArray List(OwnerComponent);
+	const TArray<FGameplayTag> ItemTypes = GetItemTypes();
+
+	// Items in the order they were added, which is what the shifting removal used to keep
+	TArray<UPlugInv_InventoryItem*> AddedItems;
+	FRandomStream Random(7);
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		UPlugInv_InventoryItem* Item = CreateItem(OwnerComponent, ItemTypes[Random.RandHelper(ItemTypes.Num())]);
+		List.AddEntry(Item);
+		AddedItems.Add(Item);
+	}
+
+	// Every removal swaps the last entry into the hole, the first item per type must not change because of it
+	while (!AddedItems.IsEmpty())
+	{
+		UPlugInv_InventoryItem* Removed = AddedItems[Random.RandHelper(AddedItems.Num())];
+		List.RemoveEntry(Removed);
+		AddedItems.RemoveSingle(Removed);
+
+		TestFalse(TEXT("The removed item has no entry"), List.Contains(Removed));
+		for (const FGameplayTag& ItemType : ItemTypes)
+		{
+			if (List.FindFirstItemByType(ItemType) != FindFirstItemByTypeLinear(AddedItems, ItemType))
+			{
+				AddError(FString::Printf(TEXT("First %s differs from the earliest added one with %d entries left"), *ItemType.ToString(), AddedItems.Num()));
+				return false;
+			}
+		}
+	}
+
+	TestEqual(TEXT("Every entry is removed"), List.GetAllItems().Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlugInv_FastArrayLookupBenchmark, "Inventory.PlugInv.InventoryFastArray.LookupBenchmark",
+	PlugInv_InventoryFastArrayTests::TestFlags)
+
+bool FPlugInv_FastArrayLookupBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace PlugInv_InventoryFastArrayTests;
+
+	constexpr int32 NumEntries = 1000;
+	constexpr int32 NumFindRounds = 100;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UPlugInv_InventoryComponent* OwnerComponent = CreateOwnerComponent(World);
+	FPlugInv_InventoryFastArray List(OwnerComponent);
+	const TArray<FGameplayTag> ItemTypes = GetItemTypes();
+
+	// Types added in runs, so most types sit deep in the array as they would after a long session
+	TArray<UPlugInv_InventoryItem*> LinearItems;
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		UPlugInv_InventoryItem* Item = CreateItem(OwnerComponent, ItemTypes[Index * ItemTypes.Num() / NumEntries]);
+		List.AddEntry(Item);
+		LinearItems.Add(Item);
+	}
+
+	// Find, indexed and with the linear scan it replaced
+	int32 NumFound = 0;
+	uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Round = 0; Round < NumFindRounds; ++Round)
+	{
+		for (const FGameplayTag& ItemType : ItemTypes)
+		{
+			NumFound += List.FindFirstItemByType(ItemType) != nullptr;
+		}
+	}
+	const double IndexedFindMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / (NumFindRounds * ItemTypes.Num());
+
+	int32 NumLinearFound = 0;
+	StartCycles = FPlatformTime::Cycles64();
+	for (int32 Round = 0; Round < NumFindRounds; ++Round)
+	{
+		for (const FGameplayTag& ItemType : ItemTypes)
+		{
+			NumLinearFound += FindFirstItemByTypeLinear(LinearItems, ItemType) != nullptr;
+		}
+	}
+	const double LinearFindMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / (NumFindRounds * ItemTypes.Num());
+
+	TestEqual(TEXT("Both lookups find every type"), NumFound, NumLinearFound);
+
+	// Remove every entry in a shuffled order, indexed swap against find and shift
+	TArray<UPlugInv_InventoryItem*> RemovalOrder = LinearItems;
+	FRandomStream Random(11);
+	for (int32 Index = RemovalOrder.Num() - 1; Index > 0; --Index)
+	{
+		RemovalOrder.Swap(Index, Random.RandHelper(Index + 1));
+	}
+
+	StartCycles = FPlatformTime::Cycles64();
+	for (UPlugInv_InventoryItem* Item : RemovalOrder)
+	{
+		List.RemoveEntry(Item);
+	}
+	const double IndexedRemoveMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumEntries;
+
+	StartCycles = FPlatformTime::Cycles64();
+	for (UPlugInv_InventoryItem* Item : RemovalOrder)
+	{
+		LinearItems.RemoveAt(LinearItems.IndexOfByKey(Item));
+	}
+	const double LinearRemoveMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumEntries;
+
+	TestEqual(TEXT("Every indexed entry is removed"), List.GetAllItems().Num(), 0);
+	TestTrue(TEXT("The indexed find beats the linear scan"), IndexedFindMicroseconds < LinearFindMicroseconds);
+	AddInfo(FString::Printf(TEXT("%d entries, find: %.3f us indexed, %.3f us linear"), NumEntries, IndexedFindMicroseconds, LinearFindMicroseconds));
+	AddInfo(FString::Printf(TEXT("%d entries, remove: %.3f us indexed, %.3f us linear"), NumEntries, IndexedRemoveMicroseconds, LinearRemoveMicroseconds));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
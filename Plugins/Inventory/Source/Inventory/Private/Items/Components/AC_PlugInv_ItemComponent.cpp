@@ -3,6 +3,7 @@
 
 #include "Items/Components/AC_PlugInv_ItemComponent.h"
 
+#include "Items/Manifest/O_PlugInv_ItemDefinition.h"
 #include "Net/UnrealNetwork.h"
 
 
@@ -24,9 +25,20 @@ void UPlugInv_ItemComponent::GetLifetimeReplicatedProps(TArray<class FLifetimePr
 	DOREPLIFETIME(ThisClass, ItemManifest);
 }
 
+void UPlugInv_ItemComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Dropped items get their carried manifest through InitItemManifest right after spawning.
+	if (IsValid(ItemDefinition) && GetOwner()->HasAuthority())
+	{
+		ItemManifest = ItemDefinition->MakeItemManifest();
+	}
+}
+
 void UPlugInv_ItemComponent::InitItemManifest(FPlugInv_ItemManifest CopyOfManifest)
 {
-	ItemManifest = CopyOfManifest;
+	ItemManifest = MoveTemp(CopyOfManifest);
 }
 
 void UPlugInv_ItemComponent::PickUp()
@@ -41,6 +41,22 @@ void FPlugInv_ConsumableFragment::Manifest()
 	}
 }
 
+void FPlugInv_ConsumableFragment::CaptureRolledValues(TArray<float>& OutValues) const
+{
+	for (const TInstancedStruct<FPlugInv_ConsumeModifier>& Modifier : ConsumeModifiers)
+	{
+		Modifier.Get().CaptureRolledValues(OutValues);
+	}
+}
+
+void FPlugInv_ConsumableFragment::RestoreRolledValues(const TArray<float>& Values, int32& InOutIndex)
+{
+	for (TInstancedStruct<FPlugInv_ConsumeModifier>& Modifier : ConsumeModifiers)
+	{
+		Modifier.GetMutable().RestoreRolledValues(Values, InOutIndex);
+	}
+}
+
 void FPlugInv_HealthPotionFragment::OnConsume(APlayerController* PC)
 {
 	FPlugInv_ConsumeModifier::OnConsume(PC);
@@ -107,6 +123,22 @@ void FPlugInv_EquipmentFragment::Manifest()
     }
 }
 
+void FPlugInv_EquipmentFragment::CaptureRolledValues(TArray<float>& OutValues) const
+{
+	for (const TInstancedStruct<FPlugInv_EquipModifier>& Modifier : EquipModifiers)
+	{
+		Modifier.Get().CaptureRolledValues(OutValues);
+	}
+}
+
+void FPlugInv_EquipmentFragment::RestoreRolledValues(const TArray<float>& Values, int32& InOutIndex)
+{
+	for (TInstancedStruct<FPlugInv_EquipModifier>& Modifier : EquipModifiers)
+	{
+		Modifier.GetMutable().RestoreRolledValues(Values, InOutIndex);
+	}
+}
+
 APlugInv_EquipActor* FPlugInv_EquipmentFragment::SpawnAttachedActor(USkeletalMeshComponent* AttachMesh) const
 {
 	if (!IsValid(EquipActorClass) || !IsValid(AttachMesh)) return nullptr;
@@ -179,6 +211,20 @@ void FPlugInv_LabeledNumberFragment::Manifest()
 	bRandomizeOnManifest = false;
 }
 
+void FPlugInv_LabeledNumberFragment::CaptureRolledValues(TArray<float>& OutValues) const
+{
+	OutValues.Add(Value);
+}
+
+void FPlugInv_LabeledNumberFragment::RestoreRolledValues(const TArray<float>& Values, int32& InOutIndex)
+{
+	if (!Values.IsValidIndex(InOutIndex)) return;
+
+	// Already rolled on the server, keep it from rolling again.
+	Value = Values[InOutIndex++];
+	bRandomizeOnManifest = false;
+}
+
 void FPlugInv_ImageFragment::Assimilate(UPlugInv_CompositeBase* Composite) const
 {
 	FPlugInv_InventoryItemFragment::Assimilate(Composite);
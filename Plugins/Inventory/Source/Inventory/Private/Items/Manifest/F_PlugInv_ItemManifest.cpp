@@ -6,17 +6,23 @@
 #include "Items/O_PlugInv_InventoryItem.h"
 #include "Items/Components/AC_PlugInv_ItemComponent.h"
 #include "Items/Fragments/BPF_PlugInv_ItemFragmentLibrary.h"
+#include "Items/Manifest/O_PlugInv_ItemDefinition.h"
 #include "Widgets/Composite/UW_PlugInv_CompositeBase.h"
 
 UPlugInv_InventoryItem* FPlugInv_ItemManifest::Manifest(UObject* Outer)
 {
 	UPlugInv_InventoryItem* Item = NewObject<UPlugInv_InventoryItem>(Outer, UPlugInv_InventoryItem::StaticClass());
-	Item->SetItemManifest(*this);
+	Item->SetItemManifest(MoveTemp(*this));
 
-	for (TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Item->GetItemManifestMutable().GetFragmentsMutable())
+	// Only the item's own fragments roll, the ones shared with a definition have nothing to roll.
+	for (TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Item->GetItemManifestMutable().Fragments)
 	{
-		Fragment.GetMutable().Manifest();
+		if (FPlugInv_ItemFragment* FragmentPtr = Fragment.GetMutablePtr())
+		{
+			FragmentPtr->Manifest();
+		}
 	}
+	Item->GetItemManifest().BuildFragmentIndex();
 	
 	ClearFragments();
 	
@@ -39,9 +45,10 @@ void FPlugInv_ItemManifest::AssimilateInventoryFragments(UPlugInv_CompositeBase*
 void FPlugInv_ItemManifest::SpawnPickupActor(const UObject* WorldContextObject, const FVector& SpawnLocation,
                                              const FRotator& SpawnRotation)
 {
-	if (!IsValid(PickupActorClass) || !IsValid(WorldContextObject)) return;
+	const TSubclassOf<AActor> PickupClass = GetSharedManifest().PickupActorClass;
+	if (!IsValid(PickupClass) || !IsValid(WorldContextObject)) return;
 
-	const AActor* SpawnedActor = WorldContextObject->GetWorld()->SpawnActor<AActor>(PickupActorClass, SpawnLocation, SpawnRotation);
+	const AActor* SpawnedActor = WorldContextObject->GetWorld()->SpawnActor<AActor>(PickupClass, SpawnLocation, SpawnRotation);
 
 	if (!IsValid(SpawnedActor)) return;
 	
@@ -51,6 +58,157 @@ void FPlugInv_ItemManifest::SpawnPickupActor(const UObject* WorldContextObject,
 	ItemComp->InitItemManifest(*this);
 }
 
+void FPlugInv_ItemManifest::CaptureDynamicState(int32& OutStackCount, TArray<float>& OutRolledValues) const
+{
+	const FPlugInv_StackableFragment* StackableFragment = GetFragmentOfType<FPlugInv_StackableFragment>();
+	OutStackCount = StackableFragment ? StackableFragment->GetStackCount() : 0;
+
+	// Fragments that roll have instance state, so they are always among the manifest's own.
+	OutRolledValues.Reset();
+	for (const TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
+	{
+		if (const FPlugInv_ItemFragment* FragmentPtr = Fragment.GetPtr())
+		{
+			FragmentPtr->CaptureRolledValues(OutRolledValues);
+		}
+	}
+}
+
+void FPlugInv_ItemManifest::RestoreDynamicState(const int32 StackCount, const TArray<float>& RolledValues)
+{
+	if (FPlugInv_StackableFragment* StackableFragment = GetFragmentOfTypeMutable<FPlugInv_StackableFragment>())
+	{
+		StackableFragment->SetStackCount(StackCount);
+	}
+
+	int32 ValueIndex = 0;
+	for (TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
+	{
+		if (FPlugInv_ItemFragment* FragmentPtr = Fragment.GetMutablePtr())
+		{
+			FragmentPtr->RestoreRolledValues(RolledValues, ValueIndex);
+		}
+	}
+}
+
+FPlugInv_ItemManifest FPlugInv_ItemManifest::MakeInstanceManifest(UPlugInv_ItemDefinition* InDefinition) const
+{
+	FPlugInv_ItemManifest Instance;
+	Instance.Definition = InDefinition;
+
+	for (int32 Index = 0; Index < Fragments.Num(); ++Index)
+	{
+		const FPlugInv_ItemFragment* Fragment = Fragments[Index].GetPtr();
+		if (!Fragment || !Fragment->HasInstanceState()) continue;
+
+		// Keep the instance's fragments at the definition's indices, the ones in between stay empty.
+		if (Instance.Fragments.IsEmpty())
+		{
+			Instance.Fragments.SetNum(Fragments.Num());
+		}
+		Instance.Fragments[Index] = Fragments[Index];
+	}
+	return Instance;
+}
+
+void FPlugInv_ItemManifest::DetachFromDefinition()
+{
+	if (!Definition) return;
+
+	const FPlugInv_ItemManifest& Shared = Definition->GetItemManifest();
+	ItemCategory = Shared.ItemCategory;
+	ItemTypesTags = Shared.ItemTypesTags;
+	PickupActorClass = Shared.PickupActorClass;
+
+	Fragments.SetNum(Shared.Fragments.Num());
+	for (int32 Index = 0; Index < Fragments.Num(); ++Index)
+	{
+		if (!Fragments[Index].IsValid())
+		{
+			Fragments[Index] = Shared.Fragments[Index];
+		}
+	}
+
+	Definition = nullptr;
+	bFragmentIndexBuilt = false;
+}
+
+const FPlugInv_ItemManifest& FPlugInv_ItemManifest::GetSharedManifest() const
+{
+	return Definition ? Definition->GetItemManifest() : *this;
+}
+
+const TInstancedStruct<FPlugInv_ItemFragment>& FPlugInv_ItemManifest::GetFragmentAt(const int32 Index) const
+{
+	if (Definition && (!Fragments.IsValidIndex(Index) || !Fragments[Index].IsValid()))
+	{
+		return Definition->GetItemManifest().Fragments[Index];
+	}
+	return Fragments[Index];
+}
+
+TInstancedStruct<FPlugInv_ItemFragment>& FPlugInv_ItemManifest::GetFragmentAtMutable(const int32 Index)
+{
+	if (Definition && (!Fragments.IsValidIndex(Index) || !Fragments[Index].IsValid()))
+	{
+		// The definition's fragments are shared by every instance, changing one needs a copy of its own.
+		DetachFromDefinition();
+	}
+	return Fragments[Index];
+}
+
+void FPlugInv_ItemManifest::BuildFragmentIndex() const
+{
+	if (Definition)
+	{
+		const FPlugInv_ItemManifest& Shared = Definition->GetItemManifest();
+		if (!Shared.bFragmentIndexBuilt)
+		{
+			Shared.BuildFragmentIndex();
+		}
+		return;
+	}
+
+	FragmentIndicesByStruct.Reset();
+	FragmentIndicesByTag.Reset();
+
+	for (int32 Index = 0; Index < Fragments.Num(); ++Index)
+	{
+		const FPlugInv_ItemFragment* Fragment = Fragments[Index].GetPtr();
+		if (!Fragment) continue;
+
+		// List it under every parent struct too, so queries for a base fragment type find it.
+		for (const UStruct* Struct = Fragments[Index].GetScriptStruct(); Struct; Struct = Struct->GetSuperStruct())
+		{
+			FragmentIndicesByStruct.FindOrAdd(static_cast<const UScriptStruct*>(Struct)).Add(Index);
+		}
+		FragmentIndicesByTag.FindOrAdd(Fragment->GetFragmentTag()).Add(Index);
+	}
+	bFragmentIndexBuilt = true;
+}
+
+TConstArrayView<int32> FPlugInv_ItemManifest::FindFragmentIndicesByStruct(const UScriptStruct* FragmentStruct) const
+{
+	const FPlugInv_ItemManifest& Indexed = GetSharedManifest();
+	if (!Indexed.bFragmentIndexBuilt)
+	{
+		Indexed.BuildFragmentIndex();
+	}
+	const TArray<int32, TInlineAllocator<2>>* Indices = Indexed.FragmentIndicesByStruct.Find(FragmentStruct);
+	return Indices ? TConstArrayView<int32>(*Indices) : TConstArrayView<int32>();
+}
+
+TConstArrayView<int32> FPlugInv_ItemManifest::FindFragmentIndicesByTag(const FGameplayTag& FragmentTag) const
+{
+	const FPlugInv_ItemManifest& Indexed = GetSharedManifest();
+	if (!Indexed.bFragmentIndexBuilt)
+	{
+		Indexed.BuildFragmentIndex();
+	}
+	const TArray<int32, TInlineAllocator<1>>* Indices = Indexed.FragmentIndicesByTag.Find(FragmentTag);
+	return Indices ? TConstArrayView<int32>(*Indices) : TConstArrayView<int32>();
+}
+
 void FPlugInv_ItemManifest::ClearFragments()
 {
 	for (TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
@@ -59,4 +217,5 @@ void FPlugInv_ItemManifest::ClearFragments()
 	}
 	
 	Fragments.Empty();
+	bFragmentIndexBuilt = false;
 }
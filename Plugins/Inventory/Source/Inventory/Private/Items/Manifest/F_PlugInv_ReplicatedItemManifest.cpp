@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/Manifest/F_PlugInv_ReplicatedItemManifest.h"
+
+#include "Engine/NetSerialization.h"
+#include "Items/Manifest/F_PlugInv_ItemManifest.h"
+#include "Items/Manifest/O_PlugInv_ItemDefinition.h"
+
+FPlugInv_ReplicatedItemManifest::FPlugInv_ReplicatedItemManifest()
+{
+	Manifest.InitializeAs<FPlugInv_ItemManifest>();
+}
+
+bool FPlugInv_ReplicatedItemManifest::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	const FPlugInv_ItemManifest* ItemManifest = Manifest.GetPtr<FPlugInv_ItemManifest>();
+	UPlugInv_ItemDefinition* Definition = ItemManifest ? ItemManifest->GetDefinition() : nullptr;
+
+	uint8 bCompact = Ar.IsSaving() && IsValid(Definition) && Definition->ReplicatesCompact() ? 1 : 0;
+	Ar.SerializeBits(&bCompact, 1);
+	if (!bCompact)
+	{
+		// A manifest still reading from its definition goes out standalone, the receiver may not rebuild it from the asset.
+		if (Ar.IsSaving() && Definition)
+		{
+			FPlugInv_ItemManifest Standalone = *ItemManifest;
+			Standalone.DetachFromDefinition();
+			FInstancedStruct StandaloneManifest = FInstancedStruct::Make<FPlugInv_ItemManifest>(MoveTemp(Standalone));
+			return StandaloneManifest.NetSerialize(Ar, Map, bOutSuccess);
+		}
+
+		const bool bResult = Manifest.NetSerialize(Ar, Map, bOutSuccess);
+		if (Ar.IsLoading())
+		{
+			if (const FPlugInv_ItemManifest* ReceivedManifest = Manifest.GetPtr<FPlugInv_ItemManifest>())
+			{
+				ReceivedManifest->BuildFragmentIndex();
+			}
+			else
+			{
+				Manifest.InitializeAs<FPlugInv_ItemManifest>();
+			}
+		}
+		return bResult;
+	}
+
+	// Definition reference, then the instance state the definition doesn't hold.
+	UObject* DefinitionObject = Definition;
+	const bool bDefinitionMapped = Map->SerializeObject(Ar, UPlugInv_ItemDefinition::StaticClass(), DefinitionObject);
+
+	int32 StackCount = 0;
+	TArray<float> RolledValues;
+	if (Ar.IsSaving())
+	{
+		ItemManifest->CaptureDynamicState(StackCount, RolledValues);
+	}
+
+	uint32 PackedStackCount = static_cast<uint32>(FMath::Max(StackCount, 0));
+	Ar.SerializeIntPacked(PackedStackCount);
+	bOutSuccess = SafeNetSerializeTArray_Default<31>(Ar, RolledValues) && !Ar.IsError();
+
+	if (Ar.IsLoading() && bOutSuccess)
+	{
+		// Not mapped yet: keep the previous manifest, returning unmapped makes the property be received again once it resolves.
+		Definition = Cast<UPlugInv_ItemDefinition>(DefinitionObject);
+		if (!IsValid(Definition))
+		{
+			return false;
+		}
+
+		// Rebuild the static part from the local asset, then apply what the server rolled.
+		FPlugInv_ItemManifest NewManifest = Definition->MakeItemManifest();
+		NewManifest.RestoreDynamicState(static_cast<int32>(PackedStackCount), RolledValues);
+		NewManifest.BuildFragmentIndex();
+		Manifest.InitializeAs<FPlugInv_ItemManifest>(MoveTemp(NewManifest));
+	}
+	return bDefinitionMapped;
+}
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/Manifest/O_PlugInv_ItemDefinition.h"
+
+FPlugInv_ItemManifest UPlugInv_ItemDefinition::MakeItemManifest()
+{
+	return ItemManifest.MakeInstanceManifest(this);
+}
+
+void UPlugInv_ItemDefinition::SetItemManifest(const FPlugInv_ItemManifest& InManifest)
+{
+	// Items read their static fragments from here, so this manifest has to hold all of them itself.
+	ItemManifest = InManifest;
+	ItemManifest.DetachFromDefinition();
+	ItemManifest.BuildFragmentIndex();
+}
+
+#if WITH_EDITOR
+void UPlugInv_ItemDefinition::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// Fragments may have been added, removed or reordered, items share this index.
+	ItemManifest.BuildFragmentIndex();
+}
+#endif
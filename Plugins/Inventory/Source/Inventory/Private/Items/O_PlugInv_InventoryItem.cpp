@@ -17,7 +17,13 @@ void UPlugInv_InventoryItem::GetLifetimeReplicatedProps(TArray<class FLifetimePr
 
 void UPlugInv_InventoryItem::SetItemManifest(const FPlugInv_ItemManifest& Manifest)
 {
-	ItemManifest = FInstancedStruct::Make<FPlugInv_ItemManifest>(Manifest);
+	ItemManifest.Manifest = FInstancedStruct::Make<FPlugInv_ItemManifest>(Manifest);
+}
+
+void UPlugInv_InventoryItem::SetItemManifest(FPlugInv_ItemManifest&& Manifest)
+{
+	// Moves the fragments instead of deep copying them and their sub-fragment arrays.
+	ItemManifest.Manifest.InitializeAs<FPlugInv_ItemManifest>(MoveTemp(Manifest));
 }
 
 bool UPlugInv_InventoryItem::IsStackable() const
@@ -0,0 +1,490 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Blueprint/UserWidget.h"
+#include "Components/Image.h"
+#include "Components/SizeBox.h"
+#include "Components/TextBlock.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/MemoryBase.h"
+#include "Items/O_PlugInv_InventoryItem.h"
+#include "Items/Components/AC_PlugInv_ItemComponent.h"
+#include "Items/Fragments/BPF_PlugInv_ItemFragmentLibrary.h"
+#include "Items/Fragments/PlugInv_FragmentTags.h"
+#include "Items/Manifest/F_PlugInv_ItemManifest.h"
+#include "Items/Manifest/F_PlugInv_ReplicatedItemManifest.h"
+#include "Items/Manifest/O_PlugInv_ItemDefinition.h"
+#include "Items/Tests/PlugInv_TestPackageMap.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/CoreNet.h"
+#include "Widgets/Composite/UW_PlugInv_Composite.h"
+#include "Widgets/Composite/UW_PlugInv_Leaf_Image.h"
+#include "Widgets/Composite/UW_PlugInv_Leaf_LabeledValue.h"
+#include "Widgets/Composite/UW_PlugInv_Leaf_Text.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PlugInv_ItemManifestTests
+{
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	template<typename T>
+	void AddFragment(FPlugInv_ItemManifest& Manifest, T Fragment, const FGameplayTag& FragmentTag)
+	{
+		Fragment.SetFragmentTag(FragmentTag);
+		Manifest.GetFragmentsMutable().Add(TInstancedStruct<FPlugInv_ItemFragment>::Make<T>(MoveTemp(Fragment)));
+	}
+
+	FPlugInv_TextFragment MakeText(const TCHAR* Text)
+	{
+		FPlugInv_TextFragment Fragment;
+		Fragment.SetText(FText::FromString(Text));
+		return Fragment;
+	}
+
+	// The roll range is only editable from the editor
+	FPlugInv_LabeledNumberFragment MakeRolledNumber(const float Min, const float Max)
+	{
+		FPlugInv_LabeledNumberFragment Fragment;
+		const UScriptStruct* Struct = FPlugInv_LabeledNumberFragment::StaticStruct();
+		CastFieldChecked<FFloatProperty>(Struct->FindPropertyByName(TEXT("Min")))->SetPropertyValue_InContainer(&Fragment, Min);
+		CastFieldChecked<FFloatProperty>(Struct->FindPropertyByName(TEXT("Max")))->SetPropertyValue_InContainer(&Fragment, Max);
+		return Fragment;
+	}
+
+	// Stackable item with a description the way the hover pop-up shows it, 11 fragments
+	FPlugInv_ItemManifest MakeDescribedManifest()
+	{
+		FPlugInv_ItemManifest Manifest;
+
+		FPlugInv_GridFragment Grid;
+		Grid.SetGridSize(FIntPoint(1, 3));
+		AddFragment(Manifest, Grid, FragmentTags::GridFragment);
+		AddFragment(Manifest, FPlugInv_ImageFragment(), FragmentTags::IconFragment);
+		AddFragment(Manifest, MakeText(TEXT("Ember Edge")), FragmentTags::ItemNameFragment);
+		AddFragment(Manifest, MakeText(TEXT("Equipment")), FragmentTags::ItemTypeFragment);
+		AddFragment(Manifest, MakeText(TEXT("Forged in the fire fern groves, it never quite cools down.")), FragmentTags::FlavorTextFragment);
+		AddFragment(Manifest, MakeRolledNumber(10.f, 25.f), FragmentTags::PrimaryStatFragment);
+		AddFragment(Manifest, MakeRolledNumber(1.f, 5.f), FragmentTags::StatMod::StatMod_1);
+		AddFragment(Manifest, MakeRolledNumber(1.f, 5.f), FragmentTags::StatMod::StatMod_2);
+		AddFragment(Manifest, MakeRolledNumber(50.f, 80.f), FragmentTags::SellValueFragment);
+		AddFragment(Manifest, MakeRolledNumber(3.f, 7.f), FragmentTags::RequiredLevelFragment);
+
+		FPlugInv_StackableFragment Stackable;
+		Stackable.SetMaxStackSize(20);
+		AddFragment(Manifest, Stackable, FragmentTags::StackableFragment);
+		return Manifest;
+	}
+
+	// Item as the server manifests it from the definition, with its own stack count and rolls
+	UPlugInv_InventoryItem* ManifestItem(UPlugInv_ItemDefinition* Definition, const int32 StackCount)
+	{
+		FPlugInv_ItemManifest Manifest = Definition->MakeItemManifest();
+		Manifest.GetFragmentOfTypeMutable<FPlugInv_StackableFragment>()->SetStackCount(StackCount);
+		return Manifest.Manifest(GetTransientPackage());
+	}
+
+	// What the full path sends: the manifest's struct reference, then every property.
+	// FInstancedStruct::NetSerialize needs a net driver's rep layout, binary serialization writes the same properties.
+	int64 MeasureFullManifestBits(const FPlugInv_ItemManifest& ItemManifest, UPackageMap* Map)
+	{
+		FPlugInv_ItemManifest FullManifest = ItemManifest;
+		FullManifest.DetachFromDefinition();
+
+		FNetBitWriter Writer(Map, 8192);
+		Writer.WriteBit(0);
+		UObject* ManifestStruct = FPlugInv_ItemManifest::StaticStruct();
+		Writer << ManifestStruct;
+		FPlugInv_ItemManifest::StaticStruct()->SerializeBin(Writer, &FullManifest);
+		return Writer.GetNumBits();
+	}
+
+	// Fragments of a type the way the manifest found them before it was indexed, every fragment type-checked in order
+	template<typename T>
+	TArray<const T*> FindAllFragmentsLinear(FPlugInv_ItemManifest& Manifest)
+	{
+		TArray<const T*> Result;
+		for (const TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Manifest.GetFragmentsMutable())
+		{
+			if (const T* FragmentPtr = Fragment.template GetPtr<T>())
+			{
+				Result.Add(FragmentPtr);
+			}
+		}
+		return Result;
+	}
+
+	template<typename T>
+	void TestSameFragments(FAutomationTestBase& Test, FPlugInv_ItemManifest& Manifest, const TCHAR* TypeName)
+	{
+		const TArray<const T*> Indexed = Manifest.GetAllFragmentsOfType<T>();
+		const TArray<const T*> Linear = FindAllFragmentsLinear<T>(Manifest);
+		Test.TestTrue(FString::Printf(TEXT("%s fragments match the linear scan, in order"), TypeName), Indexed == Linear);
+	}
+
+	// Sets a widget the blueprint would bind, native widget classes have nothing to bind from
+	void BindWidget(UUserWidget* Widget, const TCHAR* PropertyName, UWidget* BoundWidget)
+	{
+		CastFieldChecked<FObjectProperty>(Widget->GetClass()->FindPropertyByName(PropertyName))->SetObjectPropertyValue_InContainer(Widget, BoundWidget);
+	}
+
+	template<typename T>
+	T* CreateLeaf(UPlugInv_Composite* Description, const FGameplayTag& FragmentTag)
+	{
+		T* Leaf = CreateWidget<T>(Description, T::StaticClass());
+		Leaf->SetFragmentTag(FragmentTag);
+		TArray<TObjectPtr<UPlugInv_CompositeBase>>* Children = CastFieldChecked<FArrayProperty>(UPlugInv_Composite::StaticClass()->FindPropertyByName(TEXT("Children")))
+			->ContainerPtrToValuePtr<TArray<TObjectPtr<UPlugInv_CompositeBase>>>(Description);
+		Children->Add(Leaf);
+		return Leaf;
+	}
+
+	// Item description pop-up with a leaf per described fragment, as the widget blueprint lays it out
+	UPlugInv_Composite* CreateDescription(UWorld* World)
+	{
+		UPlugInv_Composite* Description = CreateWidget<UPlugInv_Composite>(World, UPlugInv_Composite::StaticClass());
+
+		UPlugInv_Leaf_Image* Icon = CreateLeaf<UPlugInv_Leaf_Image>(Description, FragmentTags::IconFragment);
+		BindWidget(Icon, TEXT("Image_Icon"), NewObject<UImage>(Icon));
+		BindWidget(Icon, TEXT("SizeBox_Icon"), NewObject<USizeBox>(Icon));
+
+		for (const FGameplayTag& TextTag : TArray<FGameplayTag>{ FragmentTags::ItemNameFragment, FragmentTags::ItemTypeFragment, FragmentTags::FlavorTextFragment })
+		{
+			UPlugInv_Leaf_Text* Text = CreateLeaf<UPlugInv_Leaf_Text>(Description, TextTag);
+			BindWidget(Text, TEXT("Text_LeafText"), NewObject<UTextBlock>(Text));
+		}
+
+		for (const FGameplayTag& NumberTag : TArray<FGameplayTag>{ FragmentTags::PrimaryStatFragment, FragmentTags::StatMod::StatMod_1, FragmentTags::StatMod::StatMod_2,
+			FragmentTags::SellValueFragment, FragmentTags::RequiredLevelFragment })
+		{
+			UPlugInv_Leaf_LabeledValue* LabeledValue = CreateLeaf<UPlugInv_Leaf_LabeledValue>(Description, NumberTag);
+			BindWidget(LabeledValue, TEXT("Text_Label"), NewObject<UTextBlock>(LabeledValue));
+			BindWidget(LabeledValue, TEXT("Text_Value"), NewObject<UTextBlock>(LabeledValue));
+		}
+		return Description;
+	}
+
+	// Counts what the game thread allocates while installed as GMalloc, everything goes on to the allocator it wraps
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation(Count);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation(Count);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("PlugInv counting malloc"); }
+
+		FMalloc* GetInner() const { return Inner; }
+
+		int64 NumAllocations{0};
+		int64 NumBytes{0};
+
+	private:
+		void CountAllocation(const SIZE_T Count)
+		{
+			if (Count > 0 && IsInGameThread())
+			{
+				++NumAllocations;
+				NumBytes += Count;
+			}
+		}
+
+		FMalloc* Inner;
+	};
+
+	// Pickup and drop round trips: the pickup's manifest goes into a new item the way AddNewItem manifests it,
+	// then back onto the pickup the way SpawnDroppedItem hands it over
+	void RunPickupDropCycles(UPlugInv_ItemComponent* ItemComponent, UObject* Outer, const int32 NumCycles)
+	{
+		for (int32 Cycle = 0; Cycle < NumCycles; ++Cycle)
+		{
+			UPlugInv_InventoryItem* Item = ItemComponent->GetItemManifestMutable().Manifest(Outer);
+			FPlugInv_ItemManifest& ItemManifest = Item->GetItemManifestMutable();
+			ItemManifest.GetFragmentOfTypeMutable<FPlugInv_StackableFragment>()->SetStackCount(1 + Cycle % 20);
+			ItemComponent->InitItemManifest(ItemManifest);
+		}
+	}
+
+	// Allocations of the round trips, counted on their own
+	void CountPickupDropCycles(UPlugInv_ItemComponent* ItemComponent, UObject* Outer, const int32 NumCycles, int64& OutNumAllocations, int64& OutNumBytes)
+	{
+		FCountingMalloc CountingMalloc(GMalloc);
+		GMalloc = &CountingMalloc;
+		RunPickupDropCycles(ItemComponent, Outer, NumCycles);
+		GMalloc = CountingMalloc.GetInner();
+
+		OutNumAllocations = CountingMalloc.NumAllocations;
+		OutNumBytes = CountingMalloc.NumBytes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlugInv_ReplicatedItemManifestBandwidthTest, "Inventory.PlugInv.ItemManifest.ReplicationBandwidth",
+	PlugInv_ItemManifestTests::TestFlags)
+
+bool FPlugInv_ReplicatedItemManifestBandwidthTest::RunTest(const FString& Parameters)
+{
+	using namespace PlugInv_ItemManifestTests;
+
+	constexpr int32 NumItems = 60;
+
+	UPlugInv_TestPackageMap* Map = NewObject<UPlugInv_TestPackageMap>();
+	UPlugInv_ItemDefinition* Definition = NewObject<UPlugInv_ItemDefinition>(GetTransientPackage());
+	Definition->SetItemManifest(MakeDescribedManifest());
+
+	// Initial sync of a 60 item inventory, compact against the full manifest
+	int64 CompactBits = 0;
+	int64 FullBits = 0;
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		const UPlugInv_InventoryItem* Item = ManifestItem(Definition, 1 + Index % 20);
+		FPlugInv_ReplicatedItemManifest Sent;
+		Sent.Manifest = FInstancedStruct::Make(Item->GetItemManifest());
+
+		FNetBitWriter Writer(Map, 8192);
+		bool bWriteSuccess = true;
+		Sent.NetSerialize(Writer, Map, bWriteSuccess);
+		CompactBits += Writer.GetNumBits();
+		FullBits += MeasureFullManifestBits(Item->GetItemManifest(), Map);
+
+		// The client rebuilds the same instance state from its own copy of the definition
+		FNetBitReader Reader(Map, Writer.GetData(), Writer.GetNumBits());
+		FPlugInv_ReplicatedItemManifest Received;
+		bool bReadSuccess = true;
+		const bool bMapped = Received.NetSerialize(Reader, Map, bReadSuccess);
+		if (!TestTrue(TEXT("The compact manifest reads back mapped"), bMapped && bReadSuccess && bWriteSuccess))
+		{
+			return false;
+		}
+
+		int32 SentStackCount = 0;
+		int32 ReceivedStackCount = 0;
+		TArray<float> SentRolls;
+		TArray<float> ReceivedRolls;
+		Item->GetItemManifest().CaptureDynamicState(SentStackCount, SentRolls);
+		Received.Manifest.Get<FPlugInv_ItemManifest>().CaptureDynamicState(ReceivedStackCount, ReceivedRolls);
+		TestEqual(TEXT("The stack count survives the trip"), ReceivedStackCount, SentStackCount);
+		TestTrue(TEXT("The rolled values survive the trip"), ReceivedRolls == SentRolls);
+		TestTrue(TEXT("The received manifest points to the definition"), Received.Manifest.Get<FPlugInv_ItemManifest>().GetDefinition() == Definition);
+	}
+
+	TestTrue(TEXT("Compact manifests take less bandwidth than full ones"), CompactBits < FullBits);
+	AddInfo(FString::Printf(TEXT("%d item initial sync: compact %lld bytes (%.1f bits per item), full %lld bytes (%.1f bits per item)"),
+		NumItems, (CompactBits + 7) / 8, double(CompactBits) / NumItems, (FullBits + 7) / 8, double(FullBits) / NumItems));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlugInv_ReplicatedItemManifestUnmappedTest, "Inventory.PlugInv.ItemManifest.UnmappedDefinition",
+	PlugInv_ItemManifestTests::TestFlags)
+
+bool FPlugInv_ReplicatedItemManifestUnmappedTest::RunTest(const FString& Parameters)
+{
+	using namespace PlugInv_ItemManifestTests;
+
+	UPlugInv_TestPackageMap* Map = NewObject<UPlugInv_TestPackageMap>();
+	UPlugInv_ItemDefinition* Definition = NewObject<UPlugInv_ItemDefinition>(GetTransientPackage());
+	Definition->SetItemManifest(MakeDescribedManifest());
+
+	FPlugInv_ReplicatedItemManifest Sent;
+	Sent.Manifest = FInstancedStruct::Make(ManifestItem(Definition, 5)->GetItemManifest());
+	FNetBitWriter Writer(Map, 8192);
+	bool bWriteSuccess = true;
+	Sent.NetSerialize(Writer, Map, bWriteSuccess);
+
+	// The client hasn't loaded the definition yet
+	Map->bResolveObjects = false;
+	FNetBitReader Reader(Map, Writer.GetData(), Writer.GetNumBits());
+	FPlugInv_ReplicatedItemManifest Received;
+	bool bReadSuccess = true;
+	const bool bMapped = Received.NetSerialize(Reader, Map, bReadSuccess);
+
+	TestFalse(TEXT("An unresolved definition reports the manifest unmapped"), bMapped);
+	TestTrue(TEXT("An unresolved definition isn't a serialization failure"), bReadSuccess);
+	TestFalse(TEXT("The whole compact manifest was read"), Reader.IsError() || !Reader.AtEnd());
+	TestNull(TEXT("The previous manifest is kept"), Received.Manifest.Get<FPlugInv_ItemManifest>().GetDefinition());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlugInv_ItemManifestFragmentIndexTest, "Inventory.PlugInv.ItemManifest.FragmentIndexMatchesLinearScan",
+	PlugInv_ItemManifestTests::TestFlags)
+
+bool FPlugInv_ItemManifestFragmentIndexTest::RunTest(const FString& Parameters)
+{
+	using namespace PlugInv_ItemManifestTests;
+
+	// Widget fragments interleaved with grid and stack fragments, so base type queries have to skip some
+	FPlugInv_ItemManifest Manifest = MakeDescribedManifest();
+	TestSameFragments<FPlugInv_ItemFragment>(*this, Manifest, TEXT("Base"));
+	TestSameFragments<FPlugInv_InventoryItemFragment>(*this, Manifest, TEXT("Inventory item"));
+	TestSameFragments<FPlugInv_TextFragment>(*this, Manifest, TEXT("Text"));
+	TestSameFragments<FPlugInv_LabeledNumberFragment>(*this, Manifest, TEXT("Labeled number"));
+	TestSameFragments<FPlugInv_StackableFragment>(*this, Manifest, TEXT("Stackable"));
+	TestEqual(TEXT("Every widget fragment is found"), Manifest.GetAllFragmentsOfType<FPlugInv_InventoryItemFragment>().Num(), 9);
+
+	// Fragments added and removed later show up in the rebuilt index
+	TArray<TInstancedStruct<FPlugInv_ItemFragment>>& Fragments = Manifest.GetFragmentsMutable();
+	Fragments.RemoveAt(3);
+	FPlugInv_TextFragment Subtitle = MakeText(TEXT("Subtitle"));
+	Subtitle.SetFragmentTag(FragmentTags::ItemNameFragment);
+	Fragments.Insert(TInstancedStruct<FPlugInv_ItemFragment>::Make<FPlugInv_TextFragment>(Subtitle), 0);
+	TestSameFragments<FPlugInv_InventoryItemFragment>(*this, Manifest, TEXT("Edited inventory item"));
+	TestSameFragments<FPlugInv_TextFragment>(*this, Manifest, TEXT("Edited text"));
+
+	const FPlugInv_TextFragment* FirstName = Manifest.GetFragmentOfTypeByTag<FPlugInv_TextFragment>(FragmentTags::ItemNameFragment);
+	TestTrue(TEXT("The first fragment with a tag wins, as with the scan"), FirstName && FirstName->GetText().ToString() == TEXT("Subtitle"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlugInv_ItemManifestDescriptionBenchmark, "Inventory.PlugInv.ItemManifest.DescriptionBenchmark",
+	PlugInv_ItemManifestTests::TestFlags)
+
+bool FPlugInv_ItemManifestDescriptionBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace PlugInv_ItemManifestTests;
+
+	constexpr int32 NumHovers = 1000;
+	constexpr double BudgetMicroseconds = 100.0;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UPlugInv_ItemDefinition* Definition = NewObject<UPlugInv_ItemDefinition>(GetTransientPackage());
+	Definition->SetItemManifest(MakeDescribedManifest());
+	const UPlugInv_InventoryItem* Item = ManifestItem(Definition, 3);
+	UPlugInv_Composite* Description = CreateDescription(World);
+
+	// What the description timer runs once the item is hovered, plus the grid's own fragment reads
+	const FPlugInv_ItemManifest& Manifest = Item->GetItemManifest();
+	int32 NumFound = 0;
+	uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Hover = 0; Hover < NumHovers; ++Hover)
+	{
+		Manifest.AssimilateInventoryFragments(Description);
+		const TTuple<const FPlugInv_GridFragment*, const FPlugInv_StackableFragment*> GridAndStack = Manifest.GetFragmentsOfTypes<FPlugInv_GridFragment, FPlugInv_StackableFragment>();
+		NumFound += (GridAndStack.Get<0>() != nullptr) + (GridAndStack.Get<1>() != nullptr);
+	}
+	const double IndexedMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumHovers;
+
+	// The same hover with every lookup scanning the fragments
+	FPlugInv_ItemManifest LinearManifest = Manifest;
+	int32 NumLinearFound = 0;
+	StartCycles = FPlatformTime::Cycles64();
+	for (int32 Hover = 0; Hover < NumHovers; ++Hover)
+	{
+		for (const FPlugInv_InventoryItemFragment* Fragment : FindAllFragmentsLinear<FPlugInv_InventoryItemFragment>(LinearManifest))
+		{
+			Description->ApplyFunction([Fragment](UPlugInv_CompositeBase* Widget)
+			{
+				Fragment->Assimilate(Widget);
+			});
+		}
+		NumLinearFound += !FindAllFragmentsLinear<FPlugInv_GridFragment>(LinearManifest).IsEmpty();
+		NumLinearFound += !FindAllFragmentsLinear<FPlugInv_StackableFragment>(LinearManifest).IsEmpty();
+	}
+	const double LinearMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / NumHovers;
+
+	const UPlugInv_Leaf_Text* NameLeaf = nullptr;
+	Description->ApplyFunction([&NameLeaf](UPlugInv_CompositeBase* Widget)
+	{
+		if (Widget->GetFragmentTag().MatchesTagExact(FragmentTags::ItemNameFragment))
+		{
+			NameLeaf = Cast<UPlugInv_Leaf_Text>(Widget);
+		}
+	});
+	TestTrue(TEXT("The description shows the item"), NameLeaf && NameLeaf->GetVisibility() == ESlateVisibility::Visible);
+	TestEqual(TEXT("Both paths find the grid and stack fragments"), NumFound, NumLinearFound);
+	TestTrue(FString::Printf(TEXT("A hover description takes under %.0f us"), BudgetMicroseconds), IndexedMicroseconds < BudgetMicroseconds);
+	AddInfo(FString::Printf(TEXT("%d fragments: %.2f us per hover indexed, %.2f us with linear scans"),
+		Manifest.GetAllFragmentsOfType<FPlugInv_ItemFragment>().Num(), IndexedMicroseconds, LinearMicroseconds));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPlugInv_ItemManifestPickupDropAllocations, "Inventory.PlugInv.ItemManifest.PickupDropAllocations",
+	PlugInv_ItemManifestTests::TestFlags)
+
+bool FPlugInv_ItemManifestPickupDropAllocations::RunTest(const FString& Parameters)
+{
+	using namespace PlugInv_ItemManifestTests;
+
+	constexpr int32 NumCycles = 1000;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	ON_SCOPE_EXIT
+	{
+		World->DestroyWorld(false);
+	};
+
+	UPlugInv_ItemDefinition* Definition = NewObject<UPlugInv_ItemDefinition>(GetTransientPackage());
+	Definition->SetItemManifest(MakeDescribedManifest());
+
+	// A pickup made from the definition, and one holding a full copy of every fragment the way each item used to
+	AActor* SharedPickup = World->SpawnActor<AActor>();
+	UPlugInv_ItemComponent* SharedComponent = NewObject<UPlugInv_ItemComponent>(SharedPickup);
+	SharedComponent->InitItemManifest(Definition->MakeItemManifest());
+
+	AActor* FullPickup = World->SpawnActor<AActor>();
+	UPlugInv_ItemComponent* FullComponent = NewObject<UPlugInv_ItemComponent>(FullPickup);
+	FPlugInv_ItemManifest FullManifest = Definition->MakeItemManifest();
+	FullManifest.DetachFromDefinition();
+	FullComponent->InitItemManifest(MoveTemp(FullManifest));
+
+	// One trip first, so values are rolled and the indices built before counting
+	RunPickupDropCycles(SharedComponent, SharedPickup, 1);
+	RunPickupDropCycles(FullComponent, FullPickup, 1);
+
+	int32 RolledStackCount = 0;
+	TArray<float> RolledValues;
+	SharedComponent->GetItemManifest().CaptureDynamicState(RolledStackCount, RolledValues);
+
+	int64 SharedAllocations = 0;
+	int64 SharedBytes = 0;
+	CountPickupDropCycles(SharedComponent, SharedPickup, NumCycles, SharedAllocations, SharedBytes);
+	int64 FullAllocations = 0;
+	int64 FullBytes = 0;
+	CountPickupDropCycles(FullComponent, FullPickup, NumCycles, FullAllocations, FullBytes);
+
+	// Instance state rides along, static fragments stay the definition's
+	const FPlugInv_ItemManifest& SharedManifest = SharedComponent->GetItemManifest();
+	int32 StackCount = 0;
+	TArray<float> Values;
+	SharedManifest.CaptureDynamicState(StackCount, Values);
+	TestEqual(TEXT("The last drop's stack count is on the pickup"), StackCount, 1 + (NumCycles - 1) % 20);
+	TestTrue(TEXT("Rolled values survive every trip"), Values == RolledValues);
+	TestTrue(TEXT("The pickup still shares the definition"), SharedManifest.GetDefinition() == Definition);
+	TestTrue(TEXT("Static fragments are read from the definition"),
+		SharedManifest.GetFragmentOfType<FPlugInv_ImageFragment>() == Definition->GetItemManifest().GetFragmentOfType<FPlugInv_ImageFragment>());
+
+	TestTrue(TEXT("Sharing the static fragments allocates less often"), SharedAllocations < FullAllocations);
+	TestTrue(TEXT("Sharing the static fragments allocates fewer bytes"), SharedBytes < FullBytes);
+	AddInfo(FString::Printf(TEXT("%d pickup/drop cycles, shared: %lld allocations, %lld bytes (%.1f, %.0f per cycle)"),
+		NumCycles, SharedAllocations, SharedBytes, double(SharedAllocations) / NumCycles, double(SharedBytes) / NumCycles));
+	AddInfo(FString::Printf(TEXT("%d pickup/drop cycles, full copies: %lld allocations, %lld bytes (%.1f, %.0f per cycle)"),
+		NumCycles, FullAllocations, FullBytes, double(FullAllocations) / NumCycles, double(FullBytes) / NumCycles));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
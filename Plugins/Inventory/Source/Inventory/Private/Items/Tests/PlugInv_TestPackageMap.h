@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/CoreNet.h"
+
+#include "PlugInv_TestPackageMap.generated.h"
+
+/**
+ * Package map for serializing replicated properties in automation tests, without a net driver.
+ * Objects go over as a packed index, like a NetGUID the client already acknowledged.
+ */
+UCLASS(Transient)
+class UPlugInv_TestPackageMap : public UPackageMap
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool SerializeObject(FArchive& Ar, UClass* InClass, UObject*& Obj, FNetworkGUID* OutNetGUID = nullptr) override
+	{
+		uint32 Index = Ar.IsSaving() && Obj ? Objects.AddUnique(Obj) + 1 : 0;
+		Ar.SerializeIntPacked(Index);
+		if (Ar.IsSaving())
+		{
+			return true;
+		}
+
+		// Unresolved objects read back as null and unmapped, like a GUID the client hasn't loaded yet.
+		const int32 ObjectIndex = static_cast<int32>(Index) - 1;
+		Obj = bResolveObjects && Objects.IsValidIndex(ObjectIndex) ? Objects[ObjectIndex].Get() : nullptr;
+		return Index == 0 || Obj != nullptr;
+	}
+
+	// Whether objects written earlier resolve when read back.
+	bool bResolveObjects{true};
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UObject>> Objects;
+};
@@ -3,6 +3,7 @@
 #include "Player/A_PlugInv_PlayerController.h"
 
 #include "BPF_PlugInv_DoubleLogger.h"
+#include "Diegetic/Subsystems/Dieg_TraceSubsystem.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Inventory.h"
@@ -10,7 +11,6 @@
 #include "InventoryManagment/Components/AC_PlugInv_InventoryComponent.h"
 #include "Items/O_PlugInv_InventoryItem.h"
 #include "Items/Components/AC_PlugInv_ItemComponent.h"
-#include "Kismet/GameplayStatics.h"
 #include "Widgets/HUD/UW_PlugInv_HUDWidget.h"
 
 APlugInv_PlayerController::APlugInv_PlayerController()
@@ -24,7 +24,11 @@ void APlugInv_PlayerController::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	TraceForItem();
+	// The batched trace reports through HandleItemTraceResult
+	if (ItemTraceId == INDEX_NONE)
+	{
+		TraceForItem();
+	}
 }
 
 void APlugInv_PlayerController::ToggleInventory()
@@ -43,6 +47,23 @@ void APlugInv_PlayerController::BeginPlay()
 	InventoryComponent = FindComponentByClass<UPlugInv_InventoryComponent>();
 
 	CreateHUDWidget();
+
+	if (UDieg_TraceSubsystem* TraceSubsystem = UDieg_TraceSubsystem::Get(this))
+	{
+		ItemTraceId = TraceSubsystem->RegisterTrace(this, EDieg_TraceOrigin::ViewportCenter, ItemTraceChannel, TraceLength,
+			FDieg_OnTraceResult::CreateUObject(this, &ThisClass::HandleItemTraceResult));
+	}
+}
+
+void APlugInv_PlayerController::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDieg_TraceSubsystem* TraceSubsystem = UDieg_TraceSubsystem::Get(this))
+	{
+		TraceSubsystem->UnregisterTrace(ItemTraceId);
+	}
+	ItemTraceId = INDEX_NONE;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void APlugInv_PlayerController::InitIMCSubsystem()
@@ -99,20 +120,24 @@ void APlugInv_PlayerController::CreateHUDWidget()
 
 void APlugInv_PlayerController::TraceForItem()
 {
-	if (!IsValid(GEngine) || !IsValid(GEngine->GameViewport)) return;
-	
-	FVector2D ViewportSize;
-	GEngine->GameViewport->GetViewportSize(ViewportSize);
-	const FVector2D ViewportCenter = ViewportSize/2.f;
 	FVector TraceStart;
 	FVector TraceForward;
-
-	if (!UGameplayStatics::DeprojectScreenToWorld(this, ViewportCenter, TraceStart, TraceForward)) return;
+	if (!UDieg_TraceSubsystem::ComputeTraceRay(this, EDieg_TraceOrigin::ViewportCenter, TraceStart, TraceForward)) return;
 
 	const FVector TraceEnd = TraceStart + TraceForward * TraceLength;
 	FHitResult HitResult;
-	GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ItemTraceChannel);
+	bool bBlockingHit;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_Dieg_SyncTraceTime);
+		INC_DWORD_STAT(STAT_Dieg_SyncTraces);
+		bBlockingHit = GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ItemTraceChannel);
+	}
+
+	HandleItemTraceResult(HitResult, bBlockingHit);
+}
 
+void APlugInv_PlayerController::HandleItemTraceResult(const FHitResult& HitResult, bool bBlockingHit)
+{
 	PreviousTraceActor = CurrentTraceActor;
 	CurrentTraceActor = HitResult.GetActor();
 
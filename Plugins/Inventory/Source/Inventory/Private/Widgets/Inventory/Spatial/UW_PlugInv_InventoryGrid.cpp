@@ -18,6 +18,24 @@
 #include "Widgets/Utils/BPF_PlugInv_WidgetUtils.h"
 #include "Widgets/ItemPopUp/UW_PlugInv_ItemPopUp.h"
 
+template<typename FuncT>
+void UPlugInv_InventoryGrid::ForEachCell(const int32 Index, const FIntPoint& Dimensions, const FuncT& Function) const
+{
+	// Same cells as UPlugInv_InventoryStatics::ForEach2D over the slots
+	for (int32 j = 0; j < Dimensions.Y; ++j)
+	{
+		for (int32 i = 0; i < Dimensions.X; ++i)
+		{
+			const FIntPoint Coordinates = UPlugInv_WidgetUtils::GetPositionFromIndex(Index, Columns) + FIntPoint(i, j);
+			const int32 CellIndex = UPlugInv_WidgetUtils::GetIndexFromPosition(Coordinates, Columns);
+			if (CellStates.IsValidIndex(CellIndex))
+			{
+				Function(CellIndex);
+			}
+		}
+	}
+}
+
 void UPlugInv_InventoryGrid::NativeOnInitialized()
 {
 	Super::NativeOnInitialized();
@@ -25,6 +43,7 @@ void UPlugInv_InventoryGrid::NativeOnInitialized()
 	ConstructGrid();
 
 	InventoryComponent = UPlugInv_InventoryStatics::GetInventoryComponent(GetOwningPlayer());
+	InventoryComponent->RegisterGrid(ItemCategory, Rows, Columns);
 	InventoryComponent->OnItemAdded.AddDynamic(this, &ThisClass::AddItem);
 	InventoryComponent->OnStackChange.AddDynamic(this, &ThisClass::AddStacks);
 	InventoryComponent->OnInventoryMenuToggled.AddDynamic(this, &ThisClass::OnInventoryMenuToggled);
@@ -34,6 +53,11 @@ void UPlugInv_InventoryGrid::NativeTick(const FGeometry& MyGeometry, float InDel
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
+	if (bVirtualizeSlots)
+	{
+		UpdateRealizedCells(ComputeVisibleCells());
+	}
+
 	// Mouse pos relative to the canvas panel
 	const FVector2D CanvasPosition = UPlugInv_WidgetUtils::GetWidgetPosition(CanvasPanel);
 	const FVector2D MousePosition = UWidgetLayoutLibrary::GetMousePositionOnViewport(GetOwningPlayer());
@@ -50,7 +74,16 @@ void UPlugInv_InventoryGrid::ConstructGrid()
 {
 	UPlugInv_DoubleLogger::Log("InventoryGrid::ConstructGrid()");
 	
-	GridSlots.Reserve(Rows*Columns);
+	GridSlots.Init(nullptr, Rows*Columns);
+	CellStates.Init(EPlugInv_GridSlotState::Unoccupied, Rows*Columns);
+	SlotPool.Reset();
+	RealizedCells = FIntRect();
+
+	// Slots come with the view, NativeTick realizes the visible ones
+	if (bVirtualizeSlots)
+	{
+		return;
+	}
 
 	for (int j = 0; j < Rows; ++j)
 	{
@@ -58,28 +91,129 @@ void UPlugInv_InventoryGrid::ConstructGrid()
 		{
 			// Unique temp name
 			FString StrName = TEXT("Row ") + FString::FromInt(j) + TEXT(" Col ") + FString::FromInt(i);
+			const int32 Index = UPlugInv_WidgetUtils::GetIndexFromPosition(FIntPoint(i, j), Columns);
+			SlotPool.Add(CreateGridSlot(FName(*StrName)));
+			RealizeSlot(Index);
+		}
+	}
+}
+
+const FPlugInv_GridModel& UPlugInv_InventoryGrid::GetGridModel() const
+{
+	// Registered in NativeOnInitialized
+	const FPlugInv_GridModel* GridModel = InventoryComponent->GetGridModel(ItemCategory);
+	check(GridModel);
+	return *GridModel;
+}
+
+void UPlugInv_InventoryGrid::SetCellState(const int32 Index, const EPlugInv_GridSlotState State)
+{
+	CellStates[Index] = State;
+	if (UPlugInv_GridSlot* GridSlot = GridSlots[Index])
+	{
+		GridSlot->SetStateAndBrushTexture(State);
+	}
+}
+
+UPlugInv_GridSlot* UPlugInv_InventoryGrid::CreateGridSlot(const FName& Name)
+{
+	UPlugInv_GridSlot* GridSlot = CreateWidget<UPlugInv_GridSlot>(this, GridSlotClass, Name);
+	GridSlot->OnGridSlotHovered.AddDynamic(this, &ThisClass::UPlugInv_InventoryGrid::OnGridSlotHovered);
+	GridSlot->OnGridSlotUnhovered.AddDynamic(this, &ThisClass::UPlugInv_InventoryGrid::OnGridSlotUnhovered);
+	GridSlot->OnGridSlotClicked.AddDynamic(this, &ThisClass::UPlugInv_InventoryGrid::UPlugInv_InventoryGrid::OnGridSlotClicked);
+	return GridSlot;
+}
+
+void UPlugInv_InventoryGrid::RealizeSlot(const int32 Index)
+{
+	// Pooled slots are reused under any cell, new ones can't be named after theirs
+	UPlugInv_GridSlot* GridSlot = SlotPool.IsEmpty() ? CreateGridSlot(NAME_None) : SlotPool.Pop().Get();
+
+	// Creating and adding grid slot to the canvas
+	CanvasPanel->AddChild(GridSlot);
+	GridSlot->SetTileIndex(Index);
+
+	// Grid slot widget pos and size
+	UCanvasPanelSlot* GridCPS = UWidgetLayoutLibrary::SlotAsCanvasSlot(GridSlot);
+	GridCPS->SetSize(FVector2D(TileSize));
+	GridCPS->SetPosition(UPlugInv_WidgetUtils::GetPositionFromIndex(Index, Columns) * TileSize);
+
+	GridSlots[Index] = GridSlot;
+	GridSlot->SetStateAndBrushTexture(CellStates[Index]);
+}
+
+void UPlugInv_InventoryGrid::ReleaseSlot(const int32 Index)
+{
+	UPlugInv_GridSlot* GridSlot = GridSlots[Index];
+	if (!GridSlot) return;
+
+	GridSlot->RemoveFromParent();
+	GridSlots[Index] = nullptr;
+	SlotPool.Push(GridSlot);
+}
+
+FIntRect UPlugInv_InventoryGrid::ComputeVisibleCells() const
+{
+	// Scroll boxes and other clipping parents decide what is in view
+	const FGeometry& CanvasGeometry = CanvasPanel->GetCachedGeometry();
+	FSlateRect VisibleRect = CanvasGeometry.GetLayoutBoundingRect();
+	for (const UPanelWidget* Parent = CanvasPanel->GetParent(); IsValid(Parent); Parent = Parent->GetParent())
+	{
+		if (Parent->GetClipping() == EWidgetClipping::Inherit)
+		{
+			continue;
+		}
 
-			// Creating and adding grid slot to the canvas
-			UPlugInv_GridSlot* GridSlot = CreateWidget<UPlugInv_GridSlot>(this, GridSlotClass, FName(*StrName));
-			CanvasPanel->AddChild(GridSlot);
-			
-			const FIntPoint TilePos = FIntPoint(i, j);
-			
-			// Setting index
-			GridSlot->SetTileIndex(UPlugInv_WidgetUtils::GetIndexFromPosition(TilePos, Columns));
-
-			// Grid slot widget pos and size
-			UCanvasPanelSlot* GridCPS = UWidgetLayoutLibrary::SlotAsCanvasSlot(GridSlot);
-			GridCPS->SetSize(FVector2D(TileSize));
-			GridCPS->SetPosition(TilePos * TileSize);
-
-			// Adding grid slot to the container array
-			GridSlots.Add(GridSlot);
-			GridSlot->OnGridSlotHovered.AddDynamic(this, &ThisClass::UPlugInv_InventoryGrid::OnGridSlotHovered);
-			GridSlot->OnGridSlotUnhovered.AddDynamic(this, &ThisClass::UPlugInv_InventoryGrid::OnGridSlotUnhovered);
-			GridSlot->OnGridSlotClicked.AddDynamic(this, &ThisClass::UPlugInv_InventoryGrid::UPlugInv_InventoryGrid::OnGridSlotClicked);
+		bool bOverlapping = false;
+		VisibleRect = VisibleRect.IntersectionWith(Parent->GetCachedGeometry().GetLayoutBoundingRect(), bOverlapping);
+		if (!bOverlapping)
+		{
+			return FIntRect();
 		}
 	}
+
+	const FVector2D CornerA = CanvasGeometry.AbsoluteToLocal(VisibleRect.GetTopLeft());
+	const FVector2D CornerB = CanvasGeometry.AbsoluteToLocal(VisibleRect.GetBottomRight());
+	const FVector2D LocalMin = FVector2D::Min(CornerA, CornerB) / TileSize;
+	const FVector2D LocalMax = FVector2D::Max(CornerA, CornerB) / TileSize;
+
+	const FIntPoint Margin(VirtualizationMargin, VirtualizationMargin);
+	const FIntPoint Min = (FIntPoint(FMath::FloorToInt(LocalMin.X), FMath::FloorToInt(LocalMin.Y)) - Margin).ComponentMax(FIntPoint::ZeroValue);
+	const FIntPoint Max = (FIntPoint(FMath::CeilToInt(LocalMax.X), FMath::CeilToInt(LocalMax.Y)) + Margin).ComponentMin(FIntPoint(Columns, Rows));
+	if (Min.X >= Max.X || Min.Y >= Max.Y)
+	{
+		return FIntRect();
+	}
+	return FIntRect(Min, Max);
+}
+
+void UPlugInv_InventoryGrid::UpdateRealizedCells(const FIntRect& NewRealizedCells)
+{
+	if (NewRealizedCells == RealizedCells) return;
+
+	for (int32 Y = RealizedCells.Min.Y; Y < RealizedCells.Max.Y; ++Y)
+	{
+		for (int32 X = RealizedCells.Min.X; X < RealizedCells.Max.X; ++X)
+		{
+			if (!NewRealizedCells.Contains(FIntPoint(X, Y)))
+			{
+				ReleaseSlot(UPlugInv_WidgetUtils::GetIndexFromPosition(FIntPoint(X, Y), Columns));
+			}
+		}
+	}
+
+	for (int32 Y = NewRealizedCells.Min.Y; Y < NewRealizedCells.Max.Y; ++Y)
+	{
+		for (int32 X = NewRealizedCells.Min.X; X < NewRealizedCells.Max.X; ++X)
+		{
+			const int32 Index = UPlugInv_WidgetUtils::GetIndexFromPosition(FIntPoint(X, Y), Columns);
+			if (!GridSlots[Index])
+			{
+				RealizeSlot(Index);
+			}
+		}
+	}
+	RealizedCells = NewRealizedCells;
 }
 
 
@@ -94,22 +228,17 @@ void UPlugInv_InventoryGrid::AddItem(UPlugInv_InventoryItem* Item)
 
 	UPlugInv_DoubleLogger::Log("InventoryGrid::AddItem()");
 
-	// Slot availability result data + Check room
-	FPlugInv_SlotAvailabilityResult Result = HasRoomForItem(Item);
+	const FPlugInv_GridModel* GridModel = InventoryComponent->GetGridModel(ItemCategory);
+	if (!GridModel) return;
 
-	// Create a widget to show the item icon and add it to the correct spot on the grid.
-	AddItemToIndices(Result, Item);
-}
-
-void UPlugInv_InventoryGrid::AddItemToIndices(const FPlugInv_SlotAvailabilityResult& Result, UPlugInv_InventoryItem* NewItem)
-{
-	UPlugInv_DoubleLogger::Log("InventoryGrid::AddItemToIndices()");
-
-	// Check multiple slot availabilities
-	for (const auto& Availability : Result.SlotAvailabilities)
+	// The inventory component already placed the item, create a widget for each of its placements.
+	TArray<int32> Placements;
+	GridModel->GetItemPlacements(Item, Placements);
+	for (const int32 Index : Placements)
 	{
-		AddItemToIndex(NewItem, Availability.Index, Result.bStackable, Availability.AmountToFill);
-		UpdateGridSlots(NewItem, Availability.Index, Result.bStackable, Availability.AmountToFill);
+		const int32 StackAmount = GridModel->GetStackCount(Index);
+		AddItemToIndex(Item, Index, Item->IsStackable(), StackAmount);
+		UpdateGridSlots(Item, Index);
 	}
 }
 
@@ -173,25 +302,16 @@ void UPlugInv_InventoryGrid::AddSlottedItemToCanvas(const int32 Index, const FPl
 
 }
 
-void UPlugInv_InventoryGrid::UpdateGridSlots(UPlugInv_InventoryItem* NewItem, const int32 Index, const bool bStackableItem, const int32 StackAmount)
+void UPlugInv_InventoryGrid::UpdateGridSlots(const UPlugInv_InventoryItem* NewItem, const int32 Index)
 {
-	check(GridSlots.IsValidIndex(Index));
-
-	if (bStackableItem)
-	{
-		// Upper left index holds the stack amount
-		GridSlots[Index]->SetStackCount(StackAmount);
-	}
+	check(CellStates.IsValidIndex(Index));
 	
 	const FPlugInv_GridFragment* GridFragment = GetFragment<FPlugInv_GridFragment>(NewItem, FragmentTags::GridFragment);
 	const FIntPoint Dimensions = GridFragment ? GridFragment->GetGridSize() : FIntPoint(1, 1);
 
-	UPlugInv_InventoryStatics::ForEach2D(GridSlots, Index, Dimensions, Columns, [&](UPlugInv_GridSlot* GridSlot)
+	ForEachCell(Index, Dimensions, [this](const int32 CellIndex)
 	{
-		GridSlot->SetInventoryItem(NewItem);
-		GridSlot->SetUpperLeftIndex(Index);
-		GridSlot->SetStateAndBrushTexture(EPlugInv_GridSlotState::Occupied);
-		GridSlot->SetAvailable(false);
+		SetCellState(CellIndex, EPlugInv_GridSlotState::Occupied);
 	});
 }
 
@@ -245,137 +365,16 @@ FPlugInv_SlotAvailabilityResult UPlugInv_InventoryGrid::HasRoomForItem(const UPl
 	return HasRoomForItem(InventoryItem->GetItemManifest(), StackAmountOverride);
 }
 
-bool UPlugInv_InventoryGrid::IsIndexClaimed(const TSet<int32>& CheckedIndices, const TObjectPtr<UPlugInv_GridSlot>& GridSlot)
-{
-	return CheckedIndices.Contains(GridSlot->GetTileIndex());
-}
-
 FPlugInv_SlotAvailabilityResult UPlugInv_InventoryGrid::HasRoomForItem(const FPlugInv_ItemManifest& ItemManifest, const int32 StackAmountOverride)
 {
-	FPlugInv_SlotAvailabilityResult Result;
-
-	// Determine if the item is stackable.
-	// Determine how many stacks to add.
-	// For each Grid Slot:
-		// If we don't have anymore to fill, break out of the loop early.
-		// Is this index claimed yet?
-		// Can the item fit here? (i.e. is it out of grid bounds?)
-		// Is there room at this index? (i.e. are there other items in the way?)
-		// Check any other important conditions - ForEach2D over a 2D range
-			// Index claimed?
-			// Has valid item?
-			// Is this item the same type as the item we're trying to add?
-			// If so, is this a stackable item?
-			// If stackable, is this slot at the max stack size already?
-		// How much to fill?
-		// Update the amount left to fill
-	// How much is the remainder
-
-	// Determine if the item is stackable.
-	const FPlugInv_StackableFragment* StackableFragment = ItemManifest.GetFragmentOfType<FPlugInv_StackableFragment>();
-	Result.bStackable = StackableFragment != nullptr;
-	
-	// Determine how many stacks to add.
-	const int32 MaxStackSize = Result.bStackable ? StackableFragment->GetMaxStackSize() : 1;
-	int32 AmountToFill = Result.bStackable ? StackableFragment->GetStackCount() : 1;
-	if (StackAmountOverride != -1 && Result.bStackable)
-	{
-		AmountToFill = StackAmountOverride;
-	}
-	
-	// Container of unique values unlike arrays.
-	TSet<int32> CheckedIndices;
-	// For each Grid Slot:
-	for (const TObjectPtr<UPlugInv_GridSlot>& GridSlot : GridSlots)
-	{
-		// If we don't have anymore to fill, break out of the loop early.
-		if (AmountToFill == 0)
-		{
-			break;
-		}
-		
-		// Is this index claimed yet?
-		if (IsIndexClaimed(CheckedIndices, GridSlot))
-		{
-			continue;
-		}
-		
-		
-		// Can the item fit here? (i.e. is it out of grid bounds?)
-		const FPlugInv_GridFragment* GridFragment = ItemManifest.GetFragmentOfType<FPlugInv_GridFragment>();
-		const FIntPoint Dimensions = GridFragment ? GridFragment->GetGridSize() : FIntPoint(1, 1);
-		if (!IsInGridBounds(GridSlot->GetTileIndex(), Dimensions))
-		{
-			continue;
-		}
-		
-		TSet<int32> TentativelyClaimedIndices;
-		bool bHasRoomAtIndex = true;
-
-		// From the current upper left index check through its item grid size all potential indices
-		// Is there room at this index? (i.e. are there other items in the way?
-		UPlugInv_InventoryStatics::ForEach2D(GridSlots, GridSlot->GetTileIndex(), Dimensions, Columns,
-			[&](const UPlugInv_GridSlot* SubGridSlot)
-		{
-				if (CheckSlotConstraints(ItemManifest, GridSlot, SubGridSlot, CheckedIndices, TentativelyClaimedIndices))
-				{
-					TentativelyClaimedIndices.Add(SubGridSlot->GetTileIndex());
-				}
-				else
-				{
-					bHasRoomAtIndex = false;
-				}
-		});
-
-		// Single invalid index issues early continue, thus not appending to checked indices
-		if (bHasRoomAtIndex == false)
-		{
-			continue;
-		}
-		
-		// How much to fill in slot?
-		const int32 CurrentSlotStackCount = GetSlotStackAmount(GridSlot);
-		const int32 RoomInSlot = MaxStackSize - CurrentSlotStackCount;
-		const int32 AmountToFillInSlot = Result.bStackable ? FMath::Min(AmountToFill, RoomInSlot) : 1;
-
-		if (AmountToFillInSlot == 0)
-		{
-			continue;
-		}
-
-		// Only append to checked indices if all valid
-		CheckedIndices.Append(TentativelyClaimedIndices);
-		
-		// Update the amount left to fill
-		Result.TotalRoomToFill += AmountToFillInSlot;
-		Result.SlotAvailabilities.Emplace(
-			FPlugInv_SlotAvailability{
-				GridSlot->GetInventoryItem().IsValid() ? GridSlot->GetUpperLeftIndex() : GridSlot->GetTileIndex(),
-				Result.bStackable ? AmountToFillInSlot : 0,
-				GridSlot->GetInventoryItem().IsValid()
-			}
-		);
-
-		// Update the filling left
-		AmountToFill -= AmountToFillInSlot;
-
-		// How much is the remainder
-		Result.Remainder = AmountToFill;
-
-		// Exit if no more to fill left
-		if (AmountToFill == 0)
-		{
-			return Result;
-		}
-	}
-	
+	FPlugInv_SlotAvailabilityResult Result = InventoryComponent->HasRoomForItem(ItemManifest, StackAmountOverride);
 	UPlugInv_DoubleLogger::Log(5.0f, TEXT("InventoryGrid::HasRoomForItem: TotalRoomToFill: {0}, Remainder: {1}, bStackable: {2}"), FColor::Orange, Result.TotalRoomToFill, Result.Remainder, Result.bStackable);
-	return Result;	
+	return Result;
 }
 
 bool UPlugInv_InventoryGrid::IsInGridBounds(const int32 StartIndex, const FIntPoint& ItemDimensions) const
 {
-	if (StartIndex < 0 || StartIndex >= GridSlots.Num())
+	if (StartIndex < 0 || StartIndex >= CellStates.Num())
 	{
 		return false;
 	}
@@ -386,72 +385,6 @@ bool UPlugInv_InventoryGrid::IsInGridBounds(const int32 StartIndex, const FIntPo
 	return EndColumn <= Columns && EndRow <= Rows;
 }
 
-bool UPlugInv_InventoryGrid::CheckSlotConstraints(const FPlugInv_ItemManifest& ItemManifest, const UPlugInv_GridSlot* GridSlot, const UPlugInv_GridSlot* SubGridSlot, const TSet<int32>& CheckedIndices, TSet<int32>& OutTentativelyClaimedIndices) const
-{
-	// If valid index adds to potential index
-	// Check any other important conditions - ForEach2D over a 2D range
-	// Index claimed?
-	if (CheckedIndices.Contains(SubGridSlot->GetTileIndex()))
-	{
-		return false;
-	}
-					
-	// Has valid item?
-	if (SubGridSlot->GetInventoryItem().IsValid() == false)
-	{
-		OutTentativelyClaimedIndices.Add(SubGridSlot->GetTileIndex());
-		return true;
-	}
-
-	// Is this GridSlot the anchor (Upper Left Slot)
-	if (SubGridSlot->GetUpperLeftIndex() != GridSlot->GetTileIndex())
-	{
-		return false;
-	}
-
-	// Is this a stackable item?
-	const TWeakObjectPtr<UPlugInv_InventoryItem> SubItem = SubGridSlot->GetInventoryItem().Get();
-	const FPlugInv_StackableFragment* StackableFragment = SubItem->GetItemManifestMutable().GetFragmentOfType<FPlugInv_StackableFragment>();
-	if (StackableFragment == nullptr)
-	{
-		return false;
-	}
-	
-	// Is this item the same type as the item we're trying to add?
-	const FGameplayTag& ItemTypeTag = ItemManifest.GetItemType();
-	if (DoesItemTypeMatch(SubItem, ItemTypeTag) == false)
-	{
-		return false;
-	}
-	
-	// If stackable, is this slot at the max stack size already?
-	if (GridSlot->GetStackCount() >= StackableFragment->GetMaxStackSize())
-	{
-		return false;
-	}
-	
-	return true;
-}
-
-bool UPlugInv_InventoryGrid::DoesItemTypeMatch(const TWeakObjectPtr<UPlugInv_InventoryItem> SubItem,
-	const FGameplayTag& ItemTypeTag) const
-{
-	return SubItem->GetItemManifestMutable().GetItemType().MatchesTagExact(ItemTypeTag);
-}
-
-int32 UPlugInv_InventoryGrid::GetSlotStackAmount(const TObjectPtr<UPlugInv_GridSlot>& GridSlot)
-{
-	int32 CurrentSlotStackCount = GridSlot->GetStackCount();
-	// If it is a slot that doesn't hold stack count (i.e. not being the upper left, then get the upper left index)
-	const int32 UpperLeftIndex = GridSlot->GetUpperLeftIndex();
-	if (UpperLeftIndex != INDEX_NONE)
-	{
-		const UPlugInv_GridSlot* UpperLeftGridSlot = GridSlots[UpperLeftIndex];
-		CurrentSlotStackCount = UpperLeftGridSlot->GetStackCount();
-	}
-	return CurrentSlotStackCount;
-}
-
 void UPlugInv_InventoryGrid::AddStacks(const FPlugInv_SlotAvailabilityResult& Result)
 {
 	if (!MatchesCategory(Result.Item.Get()))
@@ -463,15 +396,14 @@ void UPlugInv_InventoryGrid::AddStacks(const FPlugInv_SlotAvailabilityResult& Re
 	{
 		if (SlotAvailability.bItemAtIndex)
 		{
-			UPlugInv_GridSlot* GridSlot = GridSlots[SlotAvailability.Index];
+			// The grid model already holds the new stack count
 			const UPlugInv_SlottedItem* SlottedItem = SlottedItemMap.FindChecked(SlotAvailability.Index);
-			SlottedItem->UpdateStackAmount(GridSlot->GetStackCount() + SlotAvailability.AmountToFill);
-			GridSlot->SetStackCount(GridSlot->GetStackCount() + SlotAvailability.AmountToFill);
+			SlottedItem->UpdateStackAmount(GetGridModel().GetStackCount(SlotAvailability.Index));
 		}
 		else
 		{
 			AddItemToIndex(Result.Item.Get(), SlotAvailability.Index, Result.bStackable, SlotAvailability.AmountToFill);
-			UpdateGridSlots(Result.Item.Get(), SlotAvailability.Index, Result.bStackable, SlotAvailability.AmountToFill);
+			UpdateGridSlots(Result.Item.Get(), SlotAvailability.Index);
 		}
 	}
 }
@@ -491,8 +423,8 @@ void UPlugInv_InventoryGrid::OnSlottedItemClicked(int32 GridIndex, const FPointe
 	UPlugInv_InventoryStatics::ItemUnhovered(GetOwningPlayer());
 	
 	UPlugInv_DoubleLogger::Log(5.0f, TEXT("InventoryGrid::OnSlottedItemClicked : Clicked on item at index {0}"), FColor::Orange, GridIndex);
-	check(GridSlots.IsValidIndex(GridIndex));
-	UPlugInv_InventoryItem* ClickedInventoryItem = GridSlots[GridIndex]->GetInventoryItem().Get();
+	check(CellStates.IsValidIndex(GridIndex));
+	UPlugInv_InventoryItem* ClickedInventoryItem = GetGridModel().GetItemAt(GridIndex);
 
 	if (IsValid(HoverItem) == false && IsLeftClick(MouseEvent))
 	{
@@ -510,7 +442,7 @@ void UPlugInv_InventoryGrid::OnSlottedItemClicked(int32 GridIndex, const FPointe
 	// Do the hovered item and the clicked inventory item share a type, and are they stackable?
 	if (IsHoverAndClickedSameTypeAndStackable(ClickedInventoryItem))
 	{
-		const int32 ClickedStackCount = GridSlots[GridIndex]->GetStackCount();
+		const int32 ClickedStackCount = GetGridModel().GetStackCount(GridIndex);
 		const FPlugInv_StackableFragment* StackableFragment = ClickedInventoryItem->GetItemManifest().GetFragmentOfType<FPlugInv_StackableFragment>();
 		const int32 MaxStackSize = StackableFragment->GetMaxStackSize();
 		const int32 RoomInClickedSlot = MaxStackSize - ClickedStackCount;
@@ -555,17 +487,16 @@ void UPlugInv_InventoryGrid::OnSlottedItemClicked(int32 GridIndex, const FPointe
 void UPlugInv_InventoryGrid::OnGridSlotClicked(int32 GridIndex, const FPointerEvent& MouseEvent)
 {
 	if (!IsValid(HoverItem)) return;
-	if (!GridSlots.IsValidIndex(ItemDropIndex)) return;
+	if (!CellStates.IsValidIndex(ItemDropIndex)) return;
 
-	if (CurrentQueryResult.ValidItem.IsValid() && GridSlots.IsValidIndex(CurrentQueryResult.UpperLeftIndex))
+	if (CurrentQueryResult.ValidItem.IsValid() && CellStates.IsValidIndex(CurrentQueryResult.UpperLeftIndex))
 	{
 		// Clicked on a location that has a slotted event.
 		OnSlottedItemClicked(CurrentQueryResult.UpperLeftIndex, MouseEvent);
 		return;
 	}
 
-	TObjectPtr<UPlugInv_GridSlot> GridSlot = GridSlots[GridIndex];
-	if (!GridSlot->GetInventoryItem().IsValid())
+	if (!GetGridModel().IsOccupied(GridIndex))
 	{
 		// Clicked on an empty location
 		PutDownOnIndex(ItemDropIndex);
@@ -577,10 +508,9 @@ void UPlugInv_InventoryGrid::OnGridSlotHovered(int32 GridIndex, const FPointerEv
 	// Already doing a 2d range hover with the hover item, no need of this.
 	if (IsValid(HoverItem)) return;
 
-	UPlugInv_GridSlot* GridSlot = GridSlots[GridIndex];
-	if (GridSlot->IsAvailable())
+	if (!GetGridModel().IsOccupied(GridIndex))
 	{
-		GridSlot->SetStateAndBrushTexture(EPlugInv_GridSlotState::Occupied);
+		SetCellState(GridIndex, EPlugInv_GridSlotState::Occupied);
 	}
 }
 
@@ -588,26 +518,24 @@ void UPlugInv_InventoryGrid::OnGridSlotUnhovered(int32 GridIndex, const FPointer
 {
 	// Already doing a 2d range hover with the hover item, no need of this.
 	if (IsValid(HoverItem)) return;
-	UPlugInv_GridSlot* GridSlot = GridSlots[GridIndex];
-	if (GridSlot->IsAvailable())
+	if (!GetGridModel().IsOccupied(GridIndex))
 	{
-		GridSlot->SetStateAndBrushTexture(EPlugInv_GridSlotState:: Unoccupied);
+		SetCellState(GridIndex, EPlugInv_GridSlotState::Unoccupied);
 	}
 }
 
 void UPlugInv_InventoryGrid::OnPopUpMenuSplit(int32 SplitAmount, int32 Index)
 {
-	UPlugInv_InventoryItem* RightClickedItem = GridSlots[Index]->GetInventoryItem().Get();
+	const FPlugInv_GridModel& GridModel = GetGridModel();
+	UPlugInv_InventoryItem* RightClickedItem = GridModel.GetItemAt(Index);
 	if (!IsValid(RightClickedItem)) return;
 	if (!RightClickedItem->IsStackable()) return;
 	
-	const int32 UpperLeftIndex = GridSlots[Index]->GetUpperLeftIndex();
-	UPlugInv_GridSlot* UpperLeftGridSlot = GridSlots[UpperLeftIndex];
-	
-	const int32 StackCount = UpperLeftGridSlot->GetStackCount();
+	const int32 UpperLeftIndex = GridModel.GetUpperLeftIndex(Index);
+	const int32 StackCount = GridModel.GetStackCount(UpperLeftIndex);
 	const int32 NewStackCount = StackCount - SplitAmount;
-	UpperLeftGridSlot->SetStackCount(NewStackCount);
 	SlottedItemMap.FindChecked(UpperLeftIndex)->UpdateStackAmount(NewStackCount);
+	InventoryComponent->SetGridStackCount(ItemCategory, UpperLeftIndex, NewStackCount);
 	
 	AssignHoverItem(RightClickedItem, UpperLeftIndex, UpperLeftIndex);
 	HoverItem->UpdateStackCount(SplitAmount);
@@ -615,26 +543,30 @@ void UPlugInv_InventoryGrid::OnPopUpMenuSplit(int32 SplitAmount, int32 Index)
 
 void UPlugInv_InventoryGrid::OnPopUpMenuDrop(int32 Index)
 {
-	UPlugInv_InventoryItem* RightClickedItem = GridSlots[Index]->GetInventoryItem().Get();
+	const FPlugInv_GridModel& GridModel = GetGridModel();
+	UPlugInv_InventoryItem* RightClickedItem = GridModel.GetItemAt(Index);
 	if (!IsValid(RightClickedItem)) return;
 	
-	PickUp(RightClickedItem, Index);
-	DropItem();
+	const int32 UpperLeftIndex = GridModel.GetUpperLeftIndex(Index);
+	const int32 StackCount = RightClickedItem->IsStackable() ? GridModel.GetStackCount(UpperLeftIndex) : 0;
+	RemoveItemFromGrid(RightClickedItem, UpperLeftIndex);
+
+	// The component takes the placement off the grid model.
+	InventoryComponent->DropItem(RightClickedItem, StackCount, UpperLeftIndex);
 }
 
 void UPlugInv_InventoryGrid::OnPopUpMenuConsume(int32 Index)
 {
-	UPlugInv_InventoryItem* RightClickedItem = GridSlots[Index]->GetInventoryItem().Get();
+	const FPlugInv_GridModel& GridModel = GetGridModel();
+	UPlugInv_InventoryItem* RightClickedItem = GridModel.GetItemAt(Index);
 	if (!IsValid(RightClickedItem)) return;
 	
-	const int32 UpperLeftIndex = GridSlots[Index]->GetUpperLeftIndex();
-	UPlugInv_GridSlot* UpperLeftGridSlot = GridSlots[UpperLeftIndex];
-	
-	const int32 NewStackCount = UpperLeftGridSlot->GetStackCount() - 1;
-	UpperLeftGridSlot->SetStackCount(NewStackCount);
+	const int32 UpperLeftIndex = GridModel.GetUpperLeftIndex(Index);
+	const int32 NewStackCount = GridModel.GetStackCount(UpperLeftIndex) - 1;
 	SlottedItemMap.FindChecked(UpperLeftIndex)->UpdateStackAmount(NewStackCount);
 
-	InventoryComponent->Server_ConsumeItem(RightClickedItem);
+	// The component takes the stack off the grid model.
+	InventoryComponent->ConsumeItem(RightClickedItem, UpperLeftIndex);
 
 	if (NewStackCount <= 0)
 	{
@@ -655,6 +587,7 @@ void UPlugInv_InventoryGrid::PickUp(UPlugInv_InventoryItem* ClickedInventoryItem
 	AssignHoverItem(ClickedInventoryItem, GridIndex, GridIndex);
 	// Remove clicked item from the grid
 	RemoveItemFromGrid(ClickedInventoryItem, GridIndex);
+	InventoryComponent->RemoveGridItem(ItemCategory, GridIndex);
 }
 
 void UPlugInv_InventoryGrid::AssignHoverItem(UPlugInv_InventoryItem* InventoryItem)
@@ -695,7 +628,7 @@ void UPlugInv_InventoryGrid::AssignHoverItem(UPlugInv_InventoryItem* InventoryIt
 	AssignHoverItem(InventoryItem);
 
 	HoverItem->SetPreviousGridIndex(PreviousGridIndex);
-	HoverItem->UpdateStackCount(InventoryItem->IsStackable() ? GridSlots[GridIndex]->GetStackCount() : 0);
+	HoverItem->UpdateStackCount(InventoryItem->IsStackable() ? GetGridModel().GetStackCount(GridIndex) : 0);
 }
 
 void UPlugInv_InventoryGrid::RemoveItemFromGrid(UPlugInv_InventoryItem* InventoryItem, const int32 GridIndex)
@@ -705,13 +638,9 @@ void UPlugInv_InventoryGrid::RemoveItemFromGrid(UPlugInv_InventoryItem* Inventor
 	const FPlugInv_GridFragment* GridFragment = GetFragment<FPlugInv_GridFragment>(InventoryItem, FragmentTags::GridFragment);
 	if (!GridFragment) return;
 
-	UPlugInv_InventoryStatics::ForEach2D(GridSlots, GridIndex, GridFragment->GetGridSize(), Columns, [&](UPlugInv_GridSlot* GridSlot)
+	ForEachCell(GridIndex, GridFragment->GetGridSize(), [this](const int32 CellIndex)
 	{
-		GridSlot->SetInventoryItem(nullptr);
-		GridSlot->SetUpperLeftIndex(INDEX_NONE);
-		GridSlot->SetStateAndBrushTexture(EPlugInv_GridSlotState::Unoccupied);
-		GridSlot->SetAvailable(true);
-		GridSlot->SetStackCount(0);
+		SetCellState(CellIndex, EPlugInv_GridSlotState::Unoccupied);
 	});
 
 	if (SlottedItemMap.Contains(GridIndex))
@@ -807,7 +736,7 @@ void UPlugInv_InventoryGrid::OnTileParametersUpdated(const FPlugInv_TileParamete
 	
 	UnHighlightSlots(LastHighlightedIndex, LastHighlightedDimensions);
 
-	if (CurrentQueryResult.ValidItem.IsValid() && GridSlots.IsValidIndex(CurrentQueryResult.UpperLeftIndex))
+	if (CurrentQueryResult.ValidItem.IsValid() && CellStates.IsValidIndex(CurrentQueryResult.UpperLeftIndex))
 	{
 		// TODO: There's a single item in this space. We can swap or add stacks.
 		const FPlugInv_GridFragment* GridFragment = GetFragment<FPlugInv_GridFragment>(CurrentQueryResult.ValidItem.Get(), FragmentTags::GridFragment);
@@ -872,11 +801,12 @@ FInv_SpaceQueryResult UPlugInv_InventoryGrid::CheckHoverPosition(const FIntPoint
 	// Container of unique values unlike arrays.
 	TSet<int32> OccupiedUpperLeftIndices;
 
-	UPlugInv_InventoryStatics::ForEach2D(GridSlots, UPlugInv_WidgetUtils::GetIndexFromPosition(Position, Columns), Dimensions, Columns, [&](const UPlugInv_GridSlot* GridSlot)
+	const FPlugInv_GridModel& GridModel = GetGridModel();
+	ForEachCell(StartingIndex, Dimensions, [&](const int32 CellIndex)
 	{
-		if (GridSlot->GetInventoryItem().IsValid())
+		if (GridModel.IsOccupied(CellIndex))
 		{
-			OccupiedUpperLeftIndices.Add(GridSlot->GetUpperLeftIndex());
+			OccupiedUpperLeftIndices.Add(GridModel.GetUpperLeftIndex(CellIndex));
 			Result.bHasSpace = false;
 		}
 	});
@@ -891,8 +821,8 @@ FInv_SpaceQueryResult UPlugInv_InventoryGrid::CheckHoverPosition(const FIntPoint
 	if (OccupiedUpperLeftIndices.Num() == 1) // single item at position - it's valid for swapping/combining
 	{
 		const int32 Index = *OccupiedUpperLeftIndices.CreateConstIterator();
-		Result.ValidItem = GridSlots[Index]->GetInventoryItem();
-		Result.UpperLeftIndex = GridSlots[Index]->GetUpperLeftIndex();
+		Result.ValidItem = GridModel.GetItemAt(Index);
+		Result.UpperLeftIndex = Index;
 	}
 	return Result;
 }
@@ -916,9 +846,9 @@ void UPlugInv_InventoryGrid::HighlightSlots(const int32 Index, const FIntPoint&
 	if (!bCurrentMouseWithinCanvas) return;
 	
 	UnHighlightSlots(LastHighlightedIndex, LastHighlightedDimensions);
-	UPlugInv_InventoryStatics::ForEach2D(GridSlots, Index, Dimensions, Columns, [&](UPlugInv_GridSlot* GridSlot)
+	ForEachCell(Index, Dimensions, [this](const int32 CellIndex)
 	{
-		GridSlot->SetStateAndBrushTexture(EPlugInv_GridSlotState::Occupied);
+		SetCellState(CellIndex, EPlugInv_GridSlotState::Occupied);
 	});
 	
 	LastHighlightedDimensions = Dimensions;
@@ -927,16 +857,10 @@ void UPlugInv_InventoryGrid::HighlightSlots(const int32 Index, const FIntPoint&
 
 void UPlugInv_InventoryGrid::UnHighlightSlots(const int32 Index, const FIntPoint& Dimensions)
 {
-	UPlugInv_InventoryStatics::ForEach2D(GridSlots, Index, Dimensions, Columns, [&](UPlugInv_GridSlot* GridSlot)
+	const FPlugInv_GridModel& GridModel = GetGridModel();
+	ForEachCell(Index, Dimensions, [this, &GridModel](const int32 CellIndex)
 	{
-		if (GridSlot->IsAvailable())
-		{
-			GridSlot->SetStateAndBrushTexture(EPlugInv_GridSlotState::Unoccupied);
-		}
-		else
-		{
-			GridSlot->SetStateAndBrushTexture(EPlugInv_GridSlotState::Occupied);
-		}
+		SetCellState(CellIndex, GridModel.IsOccupied(CellIndex) ? EPlugInv_GridSlotState::Occupied : EPlugInv_GridSlotState::Unoccupied);
 	});
 }
 
@@ -944,9 +868,9 @@ void UPlugInv_InventoryGrid::ChangeHoverType(const int32 Index, const FIntPoint&
 	EPlugInv_GridSlotState GridSlotState)
 {
 	UnHighlightSlots(LastHighlightedIndex, LastHighlightedDimensions);
-	UPlugInv_InventoryStatics::ForEach2D(GridSlots, Index, Dimensions, Columns, [State = GridSlotState](UPlugInv_GridSlot* GridSlot)
+	ForEachCell(Index, Dimensions, [this, State = GridSlotState](const int32 CellIndex)
 	{
-		GridSlot->SetStateAndBrushTexture(State);
+		SetCellState(CellIndex, State);
 	});
 	
 	LastHighlightedIndex = Index;
@@ -958,7 +882,8 @@ void UPlugInv_InventoryGrid::PutDownOnIndex(const int32 Index)
 	check(HoverItem);
 	
 	AddItemToIndex(HoverItem->GetInventoryItem(), Index, HoverItem->IsStackable(), HoverItem->GetStackCount());
-	UpdateGridSlots(HoverItem->GetInventoryItem(), Index, HoverItem->IsStackable(), HoverItem->GetStackCount());
+	UpdateGridSlots(HoverItem->GetInventoryItem(), Index);
+	InventoryComponent->PlaceGridItem(HoverItem->GetInventoryItem(), Index, HoverItem->GetStackCount());
 	ClearHoverItem();
 }
 
@@ -1017,8 +942,10 @@ void UPlugInv_InventoryGrid::SwapClickedWithHoverItem(UPlugInv_InventoryItem* Cl
 	// Keep the same previous grid index
 	AssignHoverItem(ClickedInventoryItem, GridIndex, HoverItem->GetPreviousGridIndex());
 	RemoveItemFromGrid(ClickedInventoryItem, GridIndex);
+	InventoryComponent->RemoveGridItem(ItemCategory, GridIndex);
 	AddItemToIndex(TempInventoryItem, ItemDropIndex, bTempIsStackable, TempStackCount);
-	UpdateGridSlots(TempInventoryItem, ItemDropIndex, bTempIsStackable, TempStackCount);
+	UpdateGridSlots(TempInventoryItem, ItemDropIndex);
+	InventoryComponent->PlaceGridItem(TempInventoryItem, ItemDropIndex, TempStackCount);
 }
 
 bool UPlugInv_InventoryGrid::ShouldSwapStackCounts(const int32 RoomInClickedSlot, const int32 HoveredStackCount,
@@ -1030,10 +957,9 @@ bool UPlugInv_InventoryGrid::ShouldSwapStackCounts(const int32 RoomInClickedSlot
 void UPlugInv_InventoryGrid::SwapStackCounts(const int32 ClickedStackCount, const int32 HoveredStackCount,
 	const int32 Index)
 {
-	UPlugInv_GridSlot* GridSlot = GridSlots[Index];
-	GridSlot->SetStackCount(HoveredStackCount);
 	const UPlugInv_SlottedItem* ClickedSlottedItem = SlottedItemMap.FindChecked(Index);
 	ClickedSlottedItem->UpdateStackAmount(HoveredStackCount);
+	InventoryComponent->SetGridStackCount(ItemCategory, Index, HoveredStackCount);
 	HoverItem->UpdateStackCount(ClickedStackCount);
 }
 
@@ -1049,13 +975,13 @@ void UPlugInv_InventoryGrid::ConsumeHoverItemStacks(const int32 ClickedStackCoun
 	const int32 AmountToTransfer = HoveredStackCount;
 	const int32 NewClickedStackCount = ClickedStackCount + AmountToTransfer;
 	
-	GridSlots[Index]->SetStackCount(NewClickedStackCount);
 	SlottedItemMap.FindChecked(Index)->UpdateStackAmount(NewClickedStackCount);
+	InventoryComponent->SetGridStackCount(ItemCategory, Index, NewClickedStackCount);
 	
 	ClearHoverItem();
 	ShowCursor();
 	
-	const FPlugInv_GridFragment* GridFragment = GridSlots[Index]->GetInventoryItem()->GetItemManifest().GetFragmentOfType<FPlugInv_GridFragment>();
+	const FPlugInv_GridFragment* GridFragment = GetGridModel().GetItemAt(Index)->GetItemManifest().GetFragmentOfType<FPlugInv_GridFragment>();
 	const FIntPoint Dimensions = GridFragment ? GridFragment->GetGridSize() : FIntPoint(1, 1);
 	HighlightSlots(Index, Dimensions);
 }
@@ -1067,23 +993,33 @@ bool UPlugInv_InventoryGrid::ShouldFillInStack(const int32 RoomInClickedSlot, co
 
 void UPlugInv_InventoryGrid::FillInStack(const int32 FillAmount, const int32 Remainder, const int32 Index)
 {
-	UPlugInv_GridSlot* GridSlot = GridSlots[Index];
-	const int32 NewStackCount = GridSlot->GetStackCount() + FillAmount;
-	GridSlot->SetStackCount(NewStackCount);
+	const int32 NewStackCount = GetGridModel().GetStackCount(Index) + FillAmount;
 	UPlugInv_SlottedItem* ClickedSlottedItem = SlottedItemMap.FindChecked(Index);
 	ClickedSlottedItem->UpdateStackAmount(NewStackCount);
+	InventoryComponent->SetGridStackCount(ItemCategory, Index, NewStackCount);
 	HoverItem->UpdateStackCount(Remainder);
 }
 
 void UPlugInv_InventoryGrid::CreateItemPopUp(const int32 GridIndex)
 {
-	UPlugInv_InventoryItem* RightClickedItem = GridSlots[GridIndex]->GetInventoryItem().Get();
+	const FPlugInv_GridModel& GridModel = GetGridModel();
+	UPlugInv_InventoryItem* RightClickedItem = GridModel.GetItemAt(GridIndex);
 	
 	if (!IsValid(RightClickedItem)) return;
-	if (GridSlots[GridIndex]->GetItemPopUp().IsValid()) return;
+
+	// The slot tracks its pop up, a virtualized cell out of view has no slot to ask
+	UPlugInv_GridSlot* GridSlot = GridSlots[GridIndex];
+	if (GridSlot && GridSlot->GetItemPopUp().IsValid()) return;
 	
 	ItemPopUp = CreateWidget<UPlugInv_ItemPopUp>(this, ItemPopUpClass);
-	GridSlots[GridIndex]->SetItemPopUp(ItemPopUp);
+	if (GridSlot)
+	{
+		GridSlot->SetItemPopUp(ItemPopUp);
+	}
+	else
+	{
+		ItemPopUp->SetGridIndex(GridIndex);
+	}
 	OwningCanvasPanel->AddChild(ItemPopUp);
 	// Same alternative UCanvasPanelSlot* CanvasSlot = OwningCanvasPanel->AddChildToCanvas(ItemPopUp);
 	UCanvasPanelSlot* CanvasSlot = UWidgetLayoutLibrary::SlotAsCanvasSlot(ItemPopUp);
@@ -1091,11 +1027,11 @@ void UPlugInv_InventoryGrid::CreateItemPopUp(const int32 GridIndex)
 	CanvasSlot->SetPosition(MousePosition - ItemPopUpOffset);
 	CanvasSlot->SetSize(ItemPopUp->GetBoxSize());
 
-	const int32 SliderMax = GridSlots[GridIndex]->GetStackCount() - 1;
+	const int32 SliderMax = GridModel.GetStackCount(GridIndex) - 1;
 	if (RightClickedItem->IsStackable() && SliderMax > 0)
 	{
 		ItemPopUp->OnSplit.BindDynamic(this, &ThisClass::OnPopUpMenuSplit);
-		ItemPopUp->SetSliderParams(SliderMax, FMath::Max(1, GridSlots[GridIndex]->GetStackCount() / 2));
+		ItemPopUp->SetSliderParams(SliderMax, FMath::Max(1, GridModel.GetStackCount(GridIndex) / 2));
 	}
 	else
 	{
@@ -1120,6 +1056,20 @@ void UPlugInv_InventoryGrid::PutHoverItemBack()
 	
 	FPlugInv_SlotAvailabilityResult Result = HasRoomForItem(HoverItem->GetInventoryItem(), HoverItem->GetStackCount());
 	Result.Item = HoverItem->GetInventoryItem();
+
+	// Claim the room in the grid model first, the widgets then draw it.
+	const FPlugInv_GridModel* GridModel = InventoryComponent->GetGridModel(ItemCategory);
+	for (const FPlugInv_SlotAvailability& SlotAvailability : Result.SlotAvailabilities)
+	{
+		if (SlotAvailability.bItemAtIndex)
+		{
+			InventoryComponent->SetGridStackCount(ItemCategory, SlotAvailability.Index, GridModel->GetStackCount(SlotAvailability.Index) + SlotAvailability.AmountToFill);
+		}
+		else
+		{
+			InventoryComponent->PlaceGridItem(HoverItem->GetInventoryItem(), SlotAvailability.Index, SlotAvailability.AmountToFill);
+		}
+	}
 	AddStacks(Result);
 	ClearHoverItem();
 }
@@ -1129,7 +1079,7 @@ void UPlugInv_InventoryGrid::DropItem()
 	if (!IsValid(HoverItem)) return;
 	if (!IsValid(HoverItem->GetInventoryItem())) return;
 
-	InventoryComponent->Server_DropItem(HoverItem->GetInventoryItem(), HoverItem->GetStackCount());
+	InventoryComponent->DropItem(HoverItem->GetInventoryItem(), HoverItem->GetStackCount());
 	
 	ClearHoverItem();
 	ShowCursor();
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Diegetic/Dieg_DataLibrary.h"
 #include "Diegetic/Components/Dieg_3DInventoryComponent.h"
+#include "Diegetic/Interfaces/Dieg_DragEventListener.h"
 #include "Diegetic/Interfaces/Dieg_Interactable.h"
 #include "Diegetic/UStructs/Dieg_InventorySlot.h"
 #include "Diegetic/UStructs/Dieg_PrePopulate.h"
@@ -16,6 +17,63 @@ class UTextRenderComponent;
 class UDieg_ItemInstance;
 class UDieg_ItemDefinitionDataAsset;
 
+/**
+ * @brief How an item actor's root is transformed by a transform request.
+ * 
+ * @see FDieg_ItemTransformRequest
+ */
+enum class EDieg_ItemRootMode : uint8
+{
+	/** @brief Leave the root rotation and scale as they are */
+	Keep,
+	
+	/** @brief Lay the item on an inventory grid: rotated onto the grid plane, inventory scale, quantity shown */
+	Grid,
+	
+	/** @brief Free item in the world: unit scale, quantity hidden */
+	World,
+};
+
+/**
+ * @brief What ADieg_WorldItemActor::SolveTransforms recomputes.
+ * 
+ * The mesh rotation and location always follow CurrentRotation. Requests made in the same
+ * frame are merged, the latest root mode and grab point win.
+ * 
+ * @since 1.0
+ */
+struct FDieg_ItemTransformRequest
+{
+	EDieg_ItemRootMode RootMode{EDieg_ItemRootMode::Keep};
+
+	/**
+	 * @brief Cell of the item held by the cursor, the mesh is offset so it sits under it. Unset for no offset.
+	 */
+	TOptional<FVector2D> GrabPoint;
+
+	/**
+	 * @brief Move the root to the item's grid coordinates.
+	 */
+	bool bPlaceAtCoordinates{false};
+
+	/**
+	 * @brief Place the quantity text on the rotated shape's root.
+	 */
+	bool bUpdateText{false};
+
+	void Merge(const FDieg_ItemTransformRequest& Other)
+	{
+		if (Other.RootMode != EDieg_ItemRootMode::Keep)
+		{
+			RootMode = Other.RootMode;
+		}
+		// Every request recomputes the mesh location, so a later one without grab point drops the offset
+		GrabPoint = Other.GrabPoint;
+		bPlaceAtCoordinates |= Other.bPlaceAtCoordinates;
+		bUpdateText |= Other.bUpdateText;
+	}
+};
+
 /**
  * @brief World actor that represents an item in the 3D world for the diegetic inventory system.
  * 
@@ -31,6 +89,7 @@ class UDieg_ItemDefinitionDataAsset;
  * its current state and the item data it represents.
  * 
  * @note This actor implements IDieg_Interactable for player interaction.
+ * @note This actor implements IDieg_DragEventListener, the input handler calls it directly while dragging it.
  * @note This actor is designed to work with the diegetic inventory system and requires
  * proper setup with item instances and input handlers.
  * 
@@ -38,11 +97,12 @@ class UDieg_ItemDefinitionDataAsset;
  * @see UDieg_3DInventoryComponent
  * @see UDieg_InventoryInputHandler
  * @see IDieg_Interactable
+ * @see IDieg_DragEventListener
  * 
  * @since 1.0
  */
 UCLASS()
-class INVENTORY_API ADieg_WorldItemActor : public AActor, public IDieg_Interactable
+class INVENTORY_API ADieg_WorldItemActor : public AActor, public IDieg_Interactable, public IDieg_DragEventListener
 {
 	GENERATED_BODY()
 	
@@ -78,12 +138,32 @@ public:
 	 * such as quantity or item name. Can be used for debugging or UI purposes.
 	 * 
 	 * @see UTextRenderComponent
-	 * @see AdjustText
+	 * @see SolveTransforms
 	 * @see ModifyTextQuantity
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Game|Dieg|WorldItemActor|Components", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<UTextRenderComponent> TextRendererComponent;
-	
+
+	/**
+	 * @brief Mesh shown while the item's own mesh is still streaming in.
+	 *
+	 * At runtime item meshes are loaded asynchronously; until the load finishes the
+	 * actor, or the instanced copy drawn by UDieg_3DInventoryComponent, uses this mesh.
+	 * Leave empty to show nothing until the mesh is loaded.
+	 *
+	 * @see SetMesh
+	 * @see UDieg_AssetStreamingSubsystem
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game|Dieg|World Item Actor|Streaming", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UStaticMesh> PlaceholderMesh;
+
+	/**
+	 * @brief Item definition whose assets the actor holds in UDieg_AssetStreamingSubsystem.
+	 *
+	 * Released when the actor shows another item or ends play.
+	 */
+	mutable TObjectKey<UDieg_ItemDefinitionDataAsset> StreamedItemDataAsset;
+
 	/**
 	 * @brief Prepopulate data for initializing the item.
 	 * 
@@ -118,7 +198,7 @@ public:
 	 * This can be used to adjust the item's height relative to the ground
 	 * or other reference points.
 	 * 
-	 * @see AdjustActorLocation
+	 * @see SolveTransforms
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Game|Dieg|World Item Actor|Item", meta = (AllowPrivateAccess = "true")) 
 	float OffsetZ{0.0f};
@@ -146,7 +226,7 @@ public:
 	 * 
 	 * @see SetCurrentRotation
 	 * @see GetCurrentRotation
-	 * @see AdjustMeshRelativeRotation
+	 * @see SolveTransforms
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Game|Dieg|World Item Actor|Item", meta = (AllowPrivateAccess = "true")) 
 	float CurrentRotation{0.0f};
@@ -177,67 +257,78 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Text
 	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void AdjustText() const;
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
 	void ModifyTextQuantity();
 	UFUNCTION(Category = "Game|Dieg|World Item Actor")
 	FIntPoint GetTextCoordinates(const TArray<FIntPoint>& Shape, EDieg_TextLocation TextLocation) const;
 
 	// Transform
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void AdjustActorLocation();
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void AdjustMeshRelativeRotation() const; // Previously named adjust rotation
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void AdjustForGrabPoint(const FVector2D& GrabPoint) const;
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void AdjustRootTransformForGrid() const;
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void AdjustRootTransformForWorld();
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	float GetUnitScaled() const;
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	FVector GetLocationMultiplier() const;
+	/**
+	 * @brief Queues a transform update, applied with every other request of the frame once actors have ticked.
+	 * 
+	 * Drag handlers used to set the root, mesh and text transforms piece by piece, each call
+	 * propagating to the attached children. Requests are now merged and solved once per frame.
+	 * 
+	 * @param Request What to recompute
+	 * 
+	 * @see SolveTransforms
+	 */
+	void RequestTransformUpdate(const FDieg_ItemTransformRequest& Request);
 
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleDragHoverEnterInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor*
-	                              DraggedItem, FIntPoint GrabPoint);
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleDragHoverLeaveInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor*
-	                              DraggedItem, FIntPoint GrabPoint);
+	/**
+	 * @brief Applies the queued transform request right away, for callers that need the result now.
+	 */
+	void FlushTransformUpdate();
 
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleStartDragInventory(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DraggedItem, FIntPoint GrabPoint, FIntPoint Coordinates);
-	
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleStartDragWorld(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DraggedItem, FIntPoint GrabPoint, FVector WorldLocation);
+	/**
+	 * @brief Computes the final root, mesh and text transforms in one pass and applies them.
+	 * 
+	 * Each component gets at most one relative transform, skipped when unchanged, and the
+	 * children of the root are updated once at the end of a deferred movement scope.
+	 * 
+	 * @param Request What to recompute
+	 */
+	void SolveTransforms(const FDieg_ItemTransformRequest& Request);
 
 	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleStopDragInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor*
-	                             DroppedItem, FIntPoint DroppedCoordinates, float DroppedRotation);
-
+	float GetUnitScaled() const;
 	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleStopDragWorld(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DroppedItem, FVector DroppedLocation);
+	FVector GetLocationMultiplier() const;
 
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleResetDragInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor* RestItem, FIntPoint
-	                              ResetCoordinates, float ResetRotation);
-	
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleResetDragWorld(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* ResetItem, FVector ResetLocation);
+	/**
+	 * @brief Relative location of the root when the item sits at the given grid coordinates.
+	 * 
+	 * @see SolveTransforms
+	 */
+	FVector GetInventoryRootLocation(const FIntPoint& Coordinates) const;
 
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleRotateItemInventory(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* RotatedItem, float NewRotation, FIntPoint GripPoint);
+	/**
+	 * @brief Relative location of the mesh component for a shape and rotation.
+	 * 
+	 * @see SolveTransforms
+	 */
+	FVector GetMeshRelativeLocation(const UDieg_ItemDefinitionDataAsset* InItemDataAsset, float Rotation) const;
 
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleMergeItemInventory(UDieg_InventoryInputHandler* InventoryInputHandler, AActor* DroppedItem, TArray<AActor*> MergedActors, int32
-	                              OldQuantity, int32 NewQuantity);
+	/**
+	 * @brief Relative location of the mesh component for a shape and rotation, for a given world size of one cell.
+	 */
+	static FVector GetMeshRelativeLocation(const UDieg_ItemDefinitionDataAsset* InItemDataAsset, float Rotation, float UnitScaled);
 
-	UFUNCTION(Category = "Game|Dieg|World Item Actor")
-	void HandleConsumedItemInventory(UDieg_InventoryInputHandler* InventoryInputHandler, UDieg_3DInventoryComponent* InventoryComponent3D, AActor*
-	                                 ConsumedActor);
+	//~ Begin IDieg_DragEventListener Interface
+	virtual void OnDragHoverEnterInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint GrabPoint) override;
+	virtual void OnDragHoverLeaveInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint GrabPoint) override;
+	virtual void OnStartDragInventory(UDieg_InventoryInputHandler* Handler, FIntPoint GrabPoint, FIntPoint Coordinates) override;
+	virtual void OnStartDragWorld(UDieg_InventoryInputHandler* Handler, FIntPoint GrabPoint, FVector WorldLocation) override;
+	virtual void OnDropInInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint DroppedCoordinates, float DroppedRotation) override;
+	virtual void OnDropWorld(UDieg_InventoryInputHandler* Handler, FVector DroppedLocation) override;
+	virtual void OnResetDragInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint ResetCoordinates, float ResetRotation) override;
+	virtual void OnResetDragWorld(UDieg_InventoryInputHandler* Handler, FVector ResetLocation) override;
+	virtual void OnRotateDragged(UDieg_InventoryInputHandler* Handler, float NewRotation, FIntPoint GripPoint) override;
+	virtual void OnConsumedInMerge(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D) override;
+	//~ End IDieg_DragEventListener Interface
 
 public:
 	/**
@@ -259,35 +350,6 @@ public:
 	 */
 	virtual void OnInteract_Implementation(UObject* Interactor) override;
 	
-	/**
-	 * @brief Binds this actor to an inventory input handler.
-	 * 
-	 * This Blueprint-native event connects the actor to the input handler
-	 * for drag-and-drop operations. Override this in Blueprint to customize
-	 * the binding process.
-	 * 
-	 * @param Handler The input handler to bind to
-	 * 
-	 * @see UDieg_InventoryInputHandler
-	 * @see UnBindEventsFromHandler
-	 */
-	UFUNCTION(BlueprintNativeEvent, Category = "Game|Dieg|World Item Actor")
-	void BindEventsToHandler(UDieg_InventoryInputHandler* Handler);
-
-	/**
-	 * @brief Unbinds this actor from an inventory input handler.
-	 * 
-	 * This Blueprint-native event disconnects the actor from the input handler.
-	 * Override this in Blueprint to customize the unbinding process.
-	 * 
-	 * @param Handler The input handler to unbind from
-	 * 
-	 * @see UDieg_InventoryInputHandler
-	 * @see BindEventsToHandler
-	 */
-	UFUNCTION(BlueprintNativeEvent, Category = "Game|Dieg|World Item Actor")
-	void UnBindEventsFromHandler(UDieg_InventoryInputHandler* Handler);
-	
 	/**
 	 * @brief Checks if this actor is owned by an inventory component.
 	 * 
@@ -474,7 +536,31 @@ public:
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category="Game|Dieg|World Item Actor")
 	void SetFromInventorySlot(const FDieg_InventorySlot& InventorySlot);
 
+	/**
+	 * @brief Transform the mesh component ends up with, relative to the inventory it is attached to.
+	 * 
+	 * Matches what SetFromInventorySlot produces without touching any component, so it can be
+	 * called on the class default object to place instanced copies of the mesh.
+	 * 
+	 * @param InItemDataAsset The item's definition, for the rotated shape
+	 * @param Coordinates Grid coordinates of the item
+	 * @param Rotation Rotation of the item in degrees
+	 * @return The mesh transform relative to the inventory's widget component
+	 * 
+	 * @see UDieg_3DInventoryComponent::RenderMode
+	 */
+	FTransform GetInventoryMeshTransform(const UDieg_ItemDefinitionDataAsset* InItemDataAsset, const FIntPoint& Coordinates, float Rotation) const;
+
 private:
 	UFUNCTION(Category = "Game|Dieg|World Item Actor")
 	bool SetMesh(const UDieg_ItemDefinitionDataAsset* InItemDataAsset) const;
+
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/**
+	 * @brief Requests of this frame not yet solved.
+	 */
+	TOptional<FDieg_ItemTransformRequest> PendingTransformRequest;
+
+	FDelegateHandle PostActorTickHandle;
 };
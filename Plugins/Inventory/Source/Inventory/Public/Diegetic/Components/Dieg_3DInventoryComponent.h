@@ -4,11 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Diegetic/Dieg_DataLibrary.h"
+#include "Diegetic/UStructs/Dieg_InventoryChange.h"
+#include "Diegetic/UStructs/Dieg_ItemInstancer.h"
+#include "UObject/ObjectKey.h"
 #include "Dieg_3DInventoryComponent.generated.h"
 
 
 class ADieg_WorldItemActor;
+class UDieg_ItemDefinitionDataAsset;
+class UDieg_ItemInstance;
 class UDieg_Slot;
+class UPrimitiveComponent;
+class UStaticMesh;
 class UWidgetComponent;
 class UDieg_Grid;
 class UDieg_InventoryComponent;
@@ -155,6 +163,27 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
 	TArray<ADieg_WorldItemActor*> Items;
 
+	/**
+	 * @brief The actors of Items, by the item instance they display.
+	 * 
+	 * Together with the slot storage, which leads from any cell to its item, this finds
+	 * the actor under a coordinate without scanning Items.
+	 * 
+	 * @see FindItemActor
+	 */
+	TMap<const UDieg_ItemInstance*, ADieg_WorldItemActor*> ItemActorsByInstance;
+
+	/**
+	 * @brief Change version of the inventory component that Items reflects.
+	 * 
+	 * INDEX_NONE when the item actors have never been synced or were released,
+	 * which forces the next SyncItemActors to rebuild from the slots.
+	 * 
+	 * @see SyncItemActors
+	 * @see UDieg_InventoryComponent::GetChangesSince
+	 */
+	int32 SyncedChangeVersion{INDEX_NONE};
+
 	/**
 	 * @brief Class for creating new world item actors.
 	 * 
@@ -164,6 +193,38 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
 	TSubclassOf<ADieg_WorldItemActor> ItemClass;
 
+	/**
+	 * @brief How the placed items are drawn.
+	 * 
+	 * In Instanced mode resting items are instances of one instanced static mesh component
+	 * per mesh, placed where ItemClass would put its mesh. An item is promoted to a full
+	 * ItemClass actor while it is hovered or dragged, and demoted back afterwards.
+	 * The item's quantity is passed to the material as per-instance custom data 0,
+	 * since the quantity text is only drawn by actors.
+	 * 
+	 * @see PromoteInstancedItem
+	 * @see DemoteItemActor
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory", meta = (AllowPrivateAccess = "true"))
+	EDieg_ItemRenderMode RenderMode{EDieg_ItemRenderMode::Actors};
+
+	/**
+	 * @brief Instancers drawing resting items in Instanced mode, by mesh.
+	 */
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UStaticMesh>, FDieg_ItemInstancer> ItemInstancers;
+
+	/**
+	 * @brief Instance drawing each resting item in Instanced mode.
+	 */
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UDieg_ItemInstance>, FDieg_ItemMeshInstance> ItemMeshInstances;
+
+	/**
+	 * @brief Item definitions whose mesh is streaming in for Instanced mode.
+	 */
+	TSet<TObjectKey<UDieg_ItemDefinitionDataAsset>> PendingItemMeshes;
+
 	/**
 	 * @brief The grid widget for displaying the inventory.
 	 * 
@@ -189,6 +250,15 @@ protected:
 	 * component and prepares it for use.
 	 */
 	virtual void BeginPlay() override;
+
+	/**
+	 * @brief End play for the component.
+	 * 
+	 * Releases the item assets the component requested from UDieg_AssetStreamingSubsystem.
+	 * 
+	 * @param EndPlayReason Why play ended
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 	/**
 	 * @brief Tick the component.
@@ -221,8 +291,124 @@ protected:
 	UFUNCTION(Category = "Constructor", BlueprintCallable)
 	void Populate3D();
 
+	/**
+	 * @brief Hands every item actor back to the actor pool and forgets the synced version.
+	 * 
+	 * Also releases the item assets held for the inventory, Populate3D requests them again.
+	 * 
+	 * @see UDieg_ActorPoolSubsystem
+	 */
 	UFUNCTION(Category = "Constructor", BlueprintCallable)
 	void DeInitializeInventory();
+
+	/**
+	 * @brief Finds the index in Items of the item actor displaying an item instance.
+	 * 
+	 * @param ItemInstance The item instance
+	 * @return Index in Items, or INDEX_NONE
+	 */
+	int32 FindItemActorIndex(const UDieg_ItemInstance* ItemInstance) const;
+
+	/**
+	 * @brief Adds an actor to Items and indexes it by its item instance.
+	 */
+	void AddItemActor(ADieg_WorldItemActor* ItemActor);
+
+	/**
+	 * @brief Drops an actor from the index by item instance, Items is left to the caller.
+	 */
+	void UnindexItemActor(const ADieg_WorldItemActor* ItemActor);
+
+	/**
+	 * @brief Makes a placed item show up to date, through its actor or, in Instanced mode, its mesh instance.
+	 * 
+	 * @param ItemInstance The placed item instance
+	 * @param RootIndex Grid index of the item's root cell
+	 */
+	void SyncItem(UDieg_ItemInstance* ItemInstance, int32 RootIndex);
+
+	/**
+	 * @brief Stops showing an item that left the inventory, releasing its actor or mesh instance.
+	 * 
+	 * @param ItemInstance The item instance
+	 */
+	void ReleaseItem(const UDieg_ItemInstance* ItemInstance);
+
+	/**
+	 * @brief Takes an item actor from the pool and sets it up for a placed item.
+	 * 
+	 * @param InventorySlot Root slot view of the item
+	 * @return The actor, already added to Items, or nullptr if spawning failed
+	 */
+	ADieg_WorldItemActor* AcquireItemActor(const FDieg_InventorySlot& InventorySlot);
+
+	/**
+	 * @brief Detaches an item actor from this inventory and hands it back to the actor pool.
+	 * 
+	 * @param Index Index in Items
+	 */
+	void ReleaseItemActor(int32 Index);
+
+	/**
+	 * @brief Places or moves the mesh instance of a resting item.
+	 * 
+	 * While the item's mesh is still streaming in, the ItemClass placeholder mesh is
+	 * instanced instead, or nothing if there is none, and HandleItemMeshStreamed swaps
+	 * the real mesh in later.
+	 * 
+	 * @param InventorySlot Root slot view of the item
+	 * @return false if the item has no mesh to instance
+	 */
+	bool UpdateItemMeshInstance(const FDieg_InventorySlot& InventorySlot);
+
+	/**
+	 * @brief Re-instances the resting items of a definition once its mesh finished streaming in.
+	 * 
+	 * @param ItemDataAsset The item definition that was loaded
+	 * 
+	 * @see UDieg_AssetStreamingSubsystem
+	 */
+	void HandleItemMeshStreamed(const UDieg_ItemDefinitionDataAsset* ItemDataAsset);
+
+	/**
+	 * @brief Frees the mesh instance of an item, if it has one.
+	 * 
+	 * @param ItemInstance The item instance
+	 */
+	void ReleaseItemMeshInstance(const UDieg_ItemInstance* ItemInstance);
+
+	/**
+	 * @brief Clears every instancer, for full rebuilds.
+	 */
+	void ResetItemMeshInstances();
+
+	/**
+	 * @brief Gets the instancer of a mesh, creating and attaching its component on first use.
+	 * 
+	 * @param Mesh The mesh to instance
+	 * @return The instancer
+	 */
+	FDieg_ItemInstancer& GetOrCreateItemInstancer(UStaticMesh* Mesh);
+
+	/**
+	 * @brief Spawns, releases or updates the item actors of the items touched by a list of changes.
+	 * 
+	 * @param Changes Changes from UDieg_InventoryComponent::GetChangesSince
+	 * @param IgnoredItem Item whose actor is left alone, may be nullptr
+	 */
+	void SyncChangedItems(const TArray<FDieg_InventoryChange>& Changes, const UDieg_ItemInstance* IgnoredItem);
+
+	/**
+	 * @brief Advances SyncedChangeVersion past a change this component made itself.
+	 * 
+	 * Only done when Items was already up to date before the change, so changes made
+	 * elsewhere in between are still picked up by the next SyncItemActors. Other items
+	 * the change stacked into are updated right away.
+	 * 
+	 * @param VersionBefore Change version of the inventory right before the change
+	 * @param OwnItem Item of the actor the caller added or removed itself
+	 */
+	void AcknowledgeOwnChange(int32 VersionBefore, const UDieg_ItemInstance* OwnItem);
 	
 	UFUNCTION(Category = "Event Handler", BlueprintCallable)
 	void WidgetSlotHover(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDieg_Slot* GridSlot);
@@ -231,6 +417,48 @@ protected:
 	void WidgetSlotUnHovered(const FPointerEvent& InMouseEvent, UDieg_Slot* GridSlot);
 
 public:
+	/**
+	 * @brief Brings the item actors in line with the inventory component.
+	 * 
+	 * When the actors were synced before and the inventory's change journal still reaches
+	 * back to that point, only the items that changed since are spawned, released, moved or
+	 * updated. Otherwise every placed item is matched against the existing actors, reusing
+	 * the ones that already show it and taking the rest from the actor pool.
+	 * 
+	 * @see UDieg_InventoryComponent::GetChangesSince
+	 * @see UDieg_ActorPoolSubsystem
+	 */
+	UFUNCTION(Category = "Constructor", BlueprintCallable)
+	void SyncItemActors();
+
+	/**
+	 * @brief Turns the mesh instance hit by a trace into a full item actor.
+	 * 
+	 * Only does something in Instanced mode when the component is one of this inventory's
+	 * instancers. The actor replaces the instance until DemoteItemActor.
+	 * 
+	 * @param HitComponent The component that was hit
+	 * @param InstanceIndex The hit instance, FHitResult::Item
+	 * @return The promoted actor, or nullptr if nothing was promoted
+	 */
+	ADieg_WorldItemActor* PromoteInstancedItem(const UPrimitiveComponent* HitComponent, int32 InstanceIndex);
+
+	/**
+	 * @brief Turns an item actor back into a mesh instance once it is no longer hovered or dragged.
+	 * 
+	 * Does nothing outside Instanced mode or when the actor's item is not placed here.
+	 * 
+	 * @param ItemActor The actor to demote
+	 */
+	void DemoteItemActor(ADieg_WorldItemActor* ItemActor);
+
+	/**
+	 * @brief Enables or disables collision of every placed item, actors and mesh instances alike.
+	 * 
+	 * @param bEnabled Whether the items should be traceable
+	 */
+	void SetItemCollisionEnabled(bool bEnabled);
+
 	UFUNCTION(Category = "Direct", BlueprintCallable)
 	void AddItemToInventory(ADieg_WorldItemActor* ItemActor);
 
@@ -247,5 +475,13 @@ public:
 	TWeakObjectPtr<UWidgetComponent> GetWidgetComponent() {return WidgetComponentRef;}
 	TObjectPtr<UDieg_InventoryComponent> GetInventoryComponent() {return InventoryComponentRef;}
 
-	TArray<ADieg_WorldItemActor*>& GetItems() {return Items;}
+	const TArray<ADieg_WorldItemActor*>& GetItems() const {return Items;}
+
+	/**
+	 * @brief Finds the actor displaying an item instance, in constant time.
+	 * 
+	 * @param ItemInstance The item instance
+	 * @return The actor, or nullptr if the item has none, e.g. while drawn as a mesh instance
+	 */
+	ADieg_WorldItemActor* FindItemActor(const UDieg_ItemInstance* ItemInstance) const;
 };
@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "Components/ActorComponent.h"
+#include "Diegetic/Dieg_DataLibrary.h"
+#include "Diegetic/UStructs/Dieg_InventoryChange.h"
 #include "Diegetic/UStructs/Dieg_InventorySlot.h"
+#include "Diegetic/UStructs/Dieg_OccupancyGrid.h"
 #include "Diegetic/UStructs/Dieg_PrePopulate.h"
+#include "Diegetic/UStructs/Dieg_RotatedShape.h"
+#include "Diegetic/UStructs/Dieg_SlotStorage.h"
 #include "Dieg_InventoryComponent.generated.h"
 
 /**
@@ -77,26 +82,123 @@ protected:
 	virtual void BeginPlay() override;
 
 	/**
-	 * @brief Array of all inventory slots containing metadata and item references.
+	 * @brief Per-cell item handles, placed items and slot tags of the inventory.
 	 * 
-	 * This is the core storage for the inventory system. Each slot contains information
-	 * about its position, whether it's occupied, and what item (if any) is placed there.
+	 * This is the core storage for the inventory system. Cells only hold a handle to the
+	 * item covering them; the item, its root and rotation are stored once per item, and
+	 * slot tags are shared. FDieg_InventorySlot values are generated from it on request.
 	 * 
+	 * @see FDieg_SlotStorage
 	 * @see FDieg_InventorySlot
 	 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|InventoryComponent|Storage", meta = (AllowPrivateAccess = "true"))
-	TArray<FDieg_InventorySlot> InventorySlots;
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|InventoryComponent|Storage", meta = (AllowPrivateAccess = "true"))
+	FDieg_SlotStorage SlotStorage;
 
 	/**
-	 * @brief Quick lookup map to check if a slot exists and whether it's occupied.
+	 * @brief Bitboard tracking which slots exist and whether they're occupied.
 	 * 
-	 * Maps grid coordinates to boolean values indicating occupation status.
-	 * Used for fast collision detection during item placement.
+	 * Row-major, one bit per slot, with O(1) coordinate lookup. Whole item shapes are
+	 * tested against it as bitmasks, which is what keeps fit tests cheap on stash-sized grids.
 	 * 
 	 * @note This is automatically maintained by the inventory system.
+	 * 
+	 * @see FDieg_OccupancyGrid
+	 * @see GetSlotsOccupation
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|InventoryComponent|Storage", meta = (AllowPrivateAccess = "true"))
+	FDieg_OccupancyGrid Occupancy;
+
+	/**
+	 * @brief Root slot coordinates of every placed item, grouped by item definition.
+	 * 
+	 * Kept in sync by AddItemToInventory and RemoveItemFromInventory so stacking
+	 * lookups only visit items of the same definition instead of the whole grid.
+	 * 
+	 * @note This is automatically maintained by the inventory system.
+	 * 
+	 * @see FindRootSlotByItemType
+	 * @see AddQuantityToSlot
+	 */
+	TMap<const UDieg_ItemDefinitionDataAsset*, TArray<FIntPoint>> StackIndex;
+
+	/**
+	 * @brief Incremented whenever slot contents or slot tags change.
+	 * 
+	 * @see GetSlotsVersion
+	 */
+	uint32 SlotsVersion{0};
+
+	/**
+	 * @brief Root slots handed out to Blueprint, rebuilt when SlotsVersion moves past CachedRootSlotsVersion.
+	 * 
+	 * @see GetRootSlotsMutableBP
+	 */
+	UPROPERTY(Transient)
+	TArray<FDieg_InventorySlot> CachedRootSlots;
+	uint32 CachedRootSlotsVersion{MAX_uint32};
+
+	/**
+	 * @brief All slots handed out to Blueprint, rebuilt when SlotsVersion moves past CachedSlotsVersion.
+	 * 
+	 * @see GetSlotsMutableBP
+	 * @see GetInventorySlots
+	 */
+	UPROPERTY(Transient)
+	mutable TArray<FDieg_InventorySlot> CachedSlots;
+	mutable uint32 CachedSlotsVersion{MAX_uint32};
+
+	/**
+	 * @brief Most recent changes to the placed items, oldest first.
+	 * 
+	 * Holds the changes with versions JournalBaseVersion + 1 up to ChangeVersion.
+	 * Older entries are dropped once the journal grows past MaxChangeJournalEntries.
+	 * 
+	 * @see GetChangesSince
+	 * @see RecordChange
+	 */
+	UPROPERTY(Transient)
+	TArray<FDieg_InventoryChange> ChangeJournal;
+
+	/**
+	 * @brief Version of the latest recorded change.
+	 * 
+	 * @see GetChangeVersion
+	 */
+	int32 ChangeVersion{0};
+
+	/**
+	 * @brief Version right before the oldest change still in ChangeJournal.
+	 */
+	int32 JournalBaseVersion{0};
+
+	/**
+	 * @brief Appends a change to the journal, reading the quantity from the item.
+	 * 
+	 * @param Type The kind of change
+	 * @param ItemInstance The item that changed
+	 * @param RootSlot Root slot of the item after the change, or the one it left for Remove
+	 * @param Rotation Rotation of the item after the change
+	 * @param PreviousRootSlot Root slot before the change, for Move and Rotate
+	 */
+	void RecordChange(EDieg_InventoryChangeType Type, UDieg_ItemInstance* ItemInstance, const FIntPoint& RootSlot,
+		float Rotation, const FIntPoint& PreviousRootSlot = FIntPoint(-1, -1));
+
+	/**
+	 * @brief Writes an item into the slot storage, occupancy and stack index without any checks or journaling.
+	 * 
+	 * @param ItemToAdd The item to place
+	 * @param SlotCoordinates The placement coordinates
+	 * @param Rotation The rotation to place it with
+	 * @return Root slot coordinates of the placed item
 	 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|InventoryComponent|Storage", meta = (AllowPrivateAccess = "true"))
-	TMap<FIntPoint, bool> SlotsOccupation;
+	FIntPoint PlaceItem(UDieg_ItemInstance* ItemToAdd, const FIntPoint& SlotCoordinates, float Rotation);
+
+	/**
+	 * @brief Clears a placed item from the slot storage, occupancy and stack index without journaling.
+	 * 
+	 * @param Handle The slot storage handle of the item
+	 */
+	void UnplaceItem(int32 Handle);
 
 	/**
 	 * @brief Default tags applied to all slots for filtering or item restrictions.
@@ -122,6 +224,19 @@ protected:
 		meta=(ClampMin="-90.0", ClampMax="180.0", UIMin="-90.0", UIMax="180.0", AllowPrivateAccess = "true"))
 	float ItemRotationPriority{90.0};
 
+	/**
+	 * @brief How TryAddItem picks a slot when more than one placement fits.
+	 * 
+	 * FirstFit keeps the original grid-order behaviour. The other strategies score
+	 * valid placements to keep free space in larger contiguous areas, MaxRects only
+	 * considers the corners of the grid's maximal free rectangles.
+	 * 
+	 * @see EDieg_PlacementStrategy
+	 * @see FindPlacement
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category="Game|Dieg|InventoryComponent|Storage", meta = (AllowPrivateAccess = "true"))
+	EDieg_PlacementStrategy PlacementStrategy{EDieg_PlacementStrategy::FirstFit};
+
 	/**
 	 * @brief Total number of slots in the inventory grid.
 	 * 
@@ -155,6 +270,16 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game|Dieg|InventoryComponent|Setup", meta = (AllowPrivateAccess = "true"))
 	TArray<FDieg_PrePopulate> PrePopulateData;
 
+	/**
+	 * @brief Number of changes kept for GetChangesSince.
+	 * 
+	 * Consumers that fall further behind than this get a full rebuild instead of deltas.
+	 * 
+	 * @see GetChangesSince
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game|Dieg|InventoryComponent|Setup", meta = (ClampMin="1", UIMin="1", AllowPrivateAccess = "true"))
+	int32 MaxChangeJournalEntries{256};
+
 	/**
 	 * @brief Enable debug logging for inventory operations.
 	 * 
@@ -173,6 +298,86 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Game|Dieg|InventoryComponent")
 	bool bIsInitialized{false};
 
+	/**
+	 * @brief Gets the baked shape of every rotation, in the order placement should try them.
+	 * 
+	 * ItemRotationPriority comes first, followed by the remaining rotations in 0, 90, 180, -90 order.
+	 * 
+	 * @param ItemDataAsset The data asset whose rotated shape cache is read
+	 * @param ShapesOut [Out] The rotated shapes, pointing into the data asset cache
+	 * 
+	 * @see UDieg_ItemDefinitionDataAsset::GetRotatedShape
+	 */
+	void GetPlacementShapes(const UDieg_ItemDefinitionDataAsset* ItemDataAsset, TArray<const FDieg_RotatedShape*, TInlineAllocator<4>>& ShapesOut) const;
+
+	/**
+	 * @brief Checks if any of the rotated shapes fits starting from the given slot.
+	 * 
+	 * @param Shapes The rotated shapes to test, in priority order
+	 * @param SlotCoordinates The slot the item would start from
+	 * @param RotationUsedOut [Out] The rotation of the first shape that fits
+	 * @return true if a shape fits, false otherwise
+	 * 
+	 * @see CanAddItemToSlot
+	 */
+	bool DoesAnyShapeFit(TConstArrayView<const FDieg_RotatedShape*> Shapes, const FIntPoint& SlotCoordinates, int32& RotationUsedOut) const;
+
+	/**
+	 * @brief Finds the first slot, in slot order, where any rotated shape fits.
+	 * 
+	 * @param Shapes The rotated shapes to test, in priority order
+	 * @param SlotCoordinatesOut [Out] The slot the item would be placed at
+	 * @param RotationUsedOut [Out] The rotation the item would be placed with
+	 * @return true if a placement was found, false otherwise
+	 * 
+	 * @see TryAddItem
+	 * @see CanAddItem
+	 */
+	bool FindFirstFit(TConstArrayView<const FDieg_RotatedShape*> Shapes, FIntPoint& SlotCoordinatesOut, int32& RotationUsedOut) const;
+
+	/**
+	 * @brief Finds the best placement for the rotated shapes according to PlacementStrategy.
+	 * 
+	 * All strategies score placements on the occupancy bitboard. Ties keep the
+	 * placement found first in grid order and rotation priority order.
+	 * 
+	 * @param Shapes The rotated shapes to test, in priority order
+	 * @param SlotCoordinatesOut [Out] The slot the item would be placed at
+	 * @param RotationUsedOut [Out] The rotation the item would be placed with
+	 * @return true if a placement was found, false otherwise
+	 * 
+	 * @see PlacementStrategy
+	 * @see TryAddItem
+	 */
+	bool FindPlacement(TConstArrayView<const FDieg_RotatedShape*> Shapes, FIntPoint& SlotCoordinatesOut, int32& RotationUsedOut) const;
+
+	/**
+	 * @brief Finds the MaxRects placement for the rotated shapes.
+	 * 
+	 * Places a shape's bounding box in the top left corner of one of the occupancy grid's
+	 * maximal free rectangles, picking the rectangle with the smallest leftover short side,
+	 * then long side. Falls back to FindFirstFit for shapes whose bounding box fits no free
+	 * rectangle but that still interlock with the items in the grid.
+	 * 
+	 * @param Shapes The rotated shapes to test, in priority order
+	 * @param SlotCoordinatesOut [Out] The slot the item would be placed at
+	 * @param RotationUsedOut [Out] The rotation the item would be placed with
+	 * @return true if a placement was found, false otherwise
+	 * 
+	 * @see FDieg_OccupancyGrid::GetMaximalFreeRects
+	 */
+	bool FindMaxRectsFit(TConstArrayView<const FDieg_RotatedShape*> Shapes, FIntPoint& SlotCoordinatesOut, int32& RotationUsedOut) const;
+
+	/**
+	 * @brief Scores a valid placement for the given strategy, higher is better.
+	 * 
+	 * @param Strategy The strategy to score for
+	 * @param Shape The rotated shape being placed
+	 * @param SlotCoordinates The slot the shape would start from
+	 * @return The placement score
+	 */
+	int64 ScorePlacement(EDieg_PlacementStrategy Strategy, const FDieg_RotatedShape& Shape, const FIntPoint& SlotCoordinates) const;
+
 public:
 	/**
 	 * @brief Called every frame.
@@ -212,13 +417,35 @@ public:
 	 * @param Remaining [Out] The quantity that could not be added (0 if fully added)
 	 * @return true if any quantity was successfully added, false otherwise
 	 * 
-	 * @note The item instance is not consumed - the caller retains ownership.
+	 * @note The item instance is not consumed - the caller retains ownership. Its quantity is
+	 * reduced to what was not stacked, the same as TryAddItemsBatch does.
 	 * @see CanAddItem
 	 * @see AddQuantityToSlot
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	bool TryAddItem(UDieg_ItemInstance* ItemToAdd, int32& Remaining);
 
+	/**
+	 * @brief Attempts to add many items at once, packing them together.
+	 * 
+	 * Equivalent to calling TryAddItem for every item, but bounded: items are grouped by
+	 * definition and the groups handled largest shape first. Each item is stacked once
+	 * against the stacks of its definition (see StackIndex), skipping stacks already known
+	 * to be full, and whatever is left is placed using PlacementStrategy. Items placed
+	 * earlier in a group are stack targets for later ones. Stacking uses
+	 * UDieg_ItemInstance::CanStackWith, like TryAddItem.
+	 * 
+	 * @param ItemsToAdd The item instances to add to the inventory
+	 * @param RemainingOut [Out] Per item, the quantity that could not be added (0 if fully added), same order as ItemsToAdd
+	 * @return true if every item was fully added, false otherwise
+	 * 
+	 * @note Use this for loot dumps and prepopulation instead of looping TryAddItem.
+	 * @see TryAddItem
+	 * @see PlacementStrategy
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	bool TryAddItemsBatch(const TArray<UDieg_ItemInstance*>& ItemsToAdd, TArray<int32>& RemainingOut);
+
 	/**
 	 * @brief Attempts to remove an item from the inventory.
 	 * 
@@ -249,6 +476,61 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Inventory omponent")
 	bool CanAddItem(const UDieg_ItemInstance* ItemToAdd);
 
+	/**
+	 * @brief Gets the number of free slots in the inventory.
+	 * 
+	 * @return Number of free slots, maintained incrementally
+	 * 
+	 * @see GetLargestFreeRect
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	int32 GetFreeCellCount() const { return Occupancy.GetFreeCellCount(); }
+
+	/**
+	 * @brief Gets the largest empty rectangle of slots in the inventory.
+	 * 
+	 * @param OriginOut [Out] Top-left slot coordinates of the rectangle
+	 * @param SizeOut [Out] Width and height of the rectangle, zero if the inventory is full
+	 * @return The area of the rectangle in slots
+	 * 
+	 * @see GetFreeCellCount
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	int32 GetLargestFreeRect(FIntPoint& OriginOut, FIntPoint& SizeOut) const;
+
+	/**
+	 * @brief Cheap early-out test for whether an item shape could fit at all.
+	 * 
+	 * Uses the free-space summary (free slot count, longest free row run and largest
+	 * free rectangle) against every rotation of the shape. A false result means no
+	 * placement exists; a true result still needs a full search to find one.
+	 * 
+	 * @param ItemDataAsset The definition of the item to test
+	 * @return false if the item can never fit in the current free space, true if it might
+	 * 
+	 * @see CanAddItem
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	bool CouldEverFit(const UDieg_ItemDefinitionDataAsset* ItemDataAsset) const;
+
+	/**
+	 * @brief Sets how TryAddItem picks a slot for items placed from now on.
+	 * 
+	 * @param Strategy The placement strategy to use
+	 * 
+	 * @see PlacementStrategy
+	 */
+	void SetPlacementStrategy(const EDieg_PlacementStrategy Strategy) { PlacementStrategy = Strategy; }
+
+	/**
+	 * @brief Gets how TryAddItem picks a slot.
+	 * 
+	 * @return The current placement strategy
+	 * 
+	 * @see PlacementStrategy
+	 */
+	EDieg_PlacementStrategy GetPlacementStrategy() const { return PlacementStrategy; }
+
 	/**
 	 * @brief Checks if an item can be removed from the inventory.
 	 * 
@@ -266,7 +548,7 @@ public:
 	 * @brief Returns true if inventory contains at least one instance of the item.
 	 * 
 	 * Performs a quick check to see if any slots contain items of the same type
-	 * as the provided item instance.
+	 * as the provided item instance. Only items of the same definition are visited.
 	 * 
 	 * @param ItemToCheck The item instance to search for
 	 * @return true if at least one matching item is found, false otherwise
@@ -274,25 +556,25 @@ public:
 	 * @see FindRootSlotByItemType
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
-	bool DoesInventoryContainItem(const UDieg_ItemInstance* ItemToCheck) { return FindRootSlotByItemType(ItemToCheck).Num() > 0; }
+	bool DoesInventoryContainItem(const UDieg_ItemInstance* ItemToCheck);
 
 	/**
 	 * @brief Returns all root slots containing items equal to the provided instance (C++ only).
 	 * 
-	 * Searches through all inventory slots to find root slots that contain items
-	 * of the same type as the provided item instance. Returns pointers for efficiency.
+	 * Searches the root slots of items sharing the provided instance's definition
+	 * for items of the same type.
 	 * 
 	 * @param ItemToCheck The item instance to search for
-	 * @return Array of pointers to root slots containing matching items
+	 * @return Array of root slots containing matching items
 	 * 
 	 * @see FindRootSlotByItemTypeBP
 	 */
-	TArray<FDieg_InventorySlot*> FindRootSlotByItemType(const UDieg_ItemInstance* ItemToCheck);
+	TArray<FDieg_InventorySlot> FindRootSlotByItemType(const UDieg_ItemInstance* ItemToCheck) const;
 	
 	/**
 	 * @brief Returns all root slots containing items equal to the provided instance (Blueprint compatible).
 	 * 
-	 * Blueprint-compatible version that returns structs by value instead of pointers.
+	 * Blueprint-compatible version of FindRootSlotByItemType.
 	 * 
 	 * @param ItemToCheck The item instance to search for
 	 * @return Array of root slots containing matching items
@@ -306,19 +588,18 @@ public:
 	 * @brief Returns all root slots containing exactly the provided instance (C++ only).
 	 * 
 	 * Searches for slots containing the exact same item instance (not just same type).
-	 * Returns pointers for efficiency.
 	 * 
 	 * @param ItemToCheck The exact item instance to search for
-	 * @return Array of pointers to root slots containing the exact item
+	 * @return Array of root slots containing the exact item
 	 * 
 	 * @see FindRootSlotByInstanceBP
 	 */
-	TArray<FDieg_InventorySlot*> FindRootSlotByInstance(const UDieg_ItemInstance* ItemToCheck);
+	TArray<FDieg_InventorySlot> FindRootSlotByInstance(const UDieg_ItemInstance* ItemToCheck) const;
 	
 	/**
 	 * @brief Returns all root slots containing exactly the provided instance (Blueprint compatible).
 	 * 
-	 * Blueprint-compatible version that returns structs by value instead of pointers.
+	 * Blueprint-compatible version of FindRootSlotByInstance.
 	 * 
 	 * @param ItemToCheck The exact item instance to search for
 	 * @return Array of root slots containing the exact item
@@ -331,14 +612,15 @@ public:
 	/**
 	 * @brief Gets a root slot at the specified coordinates (C++ only).
 	 * 
-	 * Returns a pointer to the root slot at the given coordinates for efficient access.
+	 * Builds the root slot at the given coordinates from the slot storage.
 	 * 
 	 * @param SlotCoordinates The grid coordinates to query
-	 * @return Pointer to the root slot, or nullptr if not found
+	 * @param SlotOut [Out] The root slot, left untouched if not found
+	 * @return true if an item has its root at the coordinates, false otherwise
 	 * 
 	 * @see GetRootSlotBP
 	 */
-	FDieg_InventorySlot* GetRootSlot(const FIntPoint& SlotCoordinates);
+	bool GetRootSlot(const FIntPoint& SlotCoordinates, FDieg_InventorySlot& SlotOut) const;
 	
 	/**
 	 * @brief Gets a root slot at the specified coordinates (Blueprint compatible).
@@ -356,15 +638,16 @@ public:
 	/**
 	 * @brief Gets any slot at the specified coordinates (C++ only).
 	 * 
-	 * Returns a pointer to any slot at the given coordinates, regardless of whether
-	 * it's a root slot or part of a multi-slot item.
+	 * Builds the slot at the given coordinates from the slot storage, regardless of
+	 * whether it's a root slot or part of a multi-slot item.
 	 * 
 	 * @param SlotCoordinates The grid coordinates to query
-	 * @return Pointer to the slot, or nullptr if not found
+	 * @param SlotOut [Out] The slot, left untouched if out of bounds
+	 * @return true if the coordinates are inside the inventory, false otherwise
 	 * 
 	 * @see GetSlotBP
 	 */
-	FDieg_InventorySlot* GetSlot(const FIntPoint& SlotCoordinates);
+	bool GetSlot(const FIntPoint& SlotCoordinates, FDieg_InventorySlot& SlotOut) const;
 	
 	/**
 	 * @brief Gets any slot at the specified coordinates (Blueprint compatible).
@@ -379,25 +662,39 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	FDieg_InventorySlot GetSlotBP(const FIntPoint& SlotCoordinates);
 	
+	/**
+	 * @brief Returns the item whose root is at the given coordinates (C++ only).
+	 * 
+	 * Cheaper than GetRootSlot when only the item is needed, no slot is built.
+	 * 
+	 * @param SlotCoordinates The grid coordinates to query
+	 * @return The item instance, or nullptr if no item has its root there
+	 * 
+	 * @see GetRootSlot
+	 */
+	UDieg_ItemInstance* GetRootItem(const FIntPoint& SlotCoordinates) const;
+
 	/**
 	 * @brief Gets all root slots in the inventory (C++ only).
 	 * 
-	 * Returns pointers to all root slots for efficient iteration and modification.
+	 * Builds one slot per placed item, at the item's root. Walks the placed items, not
+	 * the grid; iterate GetSlotStorage().CreateItemIterator() directly to avoid the array.
 	 * 
-	 * @return Array of pointers to all root slots
+	 * @return Array of all root slots
 	 * 
 	 * @see GetRootSlotsMutableBP
 	 */
-	TArray<FDieg_InventorySlot*> GetRootSlotsMutable();
+	TArray<FDieg_InventorySlot> GetRootSlots() const;
 	
 	/**
 	 * @brief Gets all root slots in the inventory (Blueprint compatible).
 	 * 
-	 * Blueprint-compatible version that returns structs by value.
+	 * Blueprint-compatible version of GetRootSlots. The array is cached and only rebuilt
+	 * after the inventory changed.
 	 * 
 	 * @return Array of all root slots
 	 * 
-	 * @see GetRootSlotsMutable
+	 * @see GetRootSlots
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	TArray<FDieg_InventorySlot> GetRootSlotsMutableBP();
@@ -405,25 +702,42 @@ public:
 	/**
 	 * @brief Gets all slots in the inventory (C++ only).
 	 * 
-	 * Returns pointers to all slots, including both root and non-root slots.
+	 * Builds every slot, including both root and non-root slots. This generates one
+	 * FDieg_InventorySlot per cell, so prefer the per-coordinate queries on large grids.
 	 * 
-	 * @return Array of pointers to all slots
+	 * @return Array of all slots
 	 * 
 	 * @see GetSlotsMutableBP
 	 */
-	TArray<FDieg_InventorySlot*> GetSlotsMutable();
+	TArray<FDieg_InventorySlot> GetSlots() const;
 	
 	/**
 	 * @brief Gets all slots in the inventory (Blueprint compatible).
 	 * 
-	 * Blueprint-compatible version that returns structs by value.
+	 * Blueprint-compatible version of GetSlots. The array is cached and only rebuilt
+	 * after the inventory changed.
 	 * 
 	 * @return Array of all slots
 	 * 
-	 * @see GetSlotsMutable
+	 * @see GetSlots
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	TArray<FDieg_InventorySlot> GetSlotsMutableBP();
+
+	/**
+	 * @brief Gets all slots in the inventory, replacing the former InventorySlots property.
+	 * 
+	 * Pure Blueprint access to the same cached array as GetSlotsMutableBP, for graphs that
+	 * used to read InventorySlots directly. Slots are generated from SlotStorage, so changing
+	 * the returned array does not change the inventory.
+	 * 
+	 * @return Array of all slots, in slot index order
+	 * 
+	 * @see GetSlotsMutableBP
+	 * @see SlotStorage
+	 */
+	UFUNCTION(BlueprintPure, Category = "Game|Dieg|InventoryComponent", meta = (DisplayName = "Get Inventory Slots"))
+	const TArray<FDieg_InventorySlot>& GetInventorySlots() const;
 	
 	/**
 	 * @brief Gets the total number of slots in the inventory.
@@ -465,16 +779,18 @@ public:
 	static TArray<FIntPoint> GetRelevantCoordinates(const FIntPoint& SlotCoordinates, const TArray<FIntPoint>& Shape, const FIntPoint& ShapeRoot, float Rotation, FIntPoint& RootSlotOut);
 	
 	/**
-	 * @brief Returns all inventory root slot coordinates containing items overlapping the given shape.
+	 * @brief Returns the root slot coordinates of the items under a shape that the given item could stack into.
 	 * 
-	 * Searches for existing items that would overlap with the specified shape coordinates
-	 * and returns the root coordinates of those items.
+	 * Each shape cell is looked up in the slot storage, which leads straight to the item covering it,
+	 * so the cost grows with the shape, not with the grid. Items are reported once, in the order
+	 * their first cell appears in ShapeCoordinates, and only when their stack still has room.
 	 * 
 	 * @param ShapeCoordinates The coordinates to check for overlaps
 	 * @param Object The item instance to check against (for type matching)
 	 * @return Array of root slot coordinates that overlap with the shape
 	 * 
 	 * @see GetRelevantCoordinates
+	 * @see MergeIntoItems
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	TArray<FIntPoint> GetRelevantItems(const TArray<FIntPoint>& ShapeCoordinates, const UDieg_ItemInstance* Object);
@@ -510,6 +826,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	bool AreSlotsAvailableSimple(const TArray<FIntPoint>& InputShape);
 
+	/**
+	 * @brief Checks if all slots covered by a shape mask are free, in a handful of bit operations.
+	 * 
+	 * Same result as AreSlotsAvailableSimple for the mask's cells, without building the coordinate array.
+	 * 
+	 * @param Mask The shape to test, usually from FDieg_RotatedShape::Mask
+	 * @param Coordinates The placement coordinates the mask is relative to
+	 * @return true if all slots are available, false otherwise
+	 * 
+	 * @see AreSlotsAvailableSimple
+	 */
+	bool DoesShapeFit(const FDieg_ShapeMask& Mask, const FIntPoint& Coordinates) const { return Occupancy.DoesMaskFit(Mask, Coordinates); }
+
 	/**
 	 * @brief Adds quantity to an existing stackable slot; returns amount added.
 	 * 
@@ -525,21 +854,37 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	int32 AddQuantityToSlot(const UDieg_ItemInstance* ItemToAdd, int32 QuantityIn);
 
+	/**
+	 * @brief Moves as much quantity as fits from an item into the items rooted at the given slots.
+	 * 
+	 * All transfers are worked out before any quantity changes, then applied together: each
+	 * target gets one QuantityChange in the change journal and the merged item is left with
+	 * what did not fit. The merged item itself is expected not to be placed in this inventory.
+	 * 
+	 * @param ItemToMerge The item giving away its quantity, usually a dragged item
+	 * @param RootSlotCoordinates Root slots of the targets, in merge order, e.g. from GetRelevantItems
+	 * @param MergedItemsOut [Out] The targets that received quantity
+	 * @return The quantity left in ItemToMerge, 0 when it was merged away entirely
+	 * 
+	 * @see GetRelevantItems
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	int32 MergeIntoItems(UDieg_ItemInstance* ItemToMerge, const TArray<FIntPoint>& RootSlotCoordinates, TArray<UDieg_ItemInstance*>& MergedItemsOut);
+
 	/**
 	 * @brief Places an item in inventory starting at given slot with rotation (C++ only).
 	 * 
 	 * Directly places an item at the specified coordinates with the given rotation.
-	 * Returns a pointer to the root slot for efficiency.
 	 * 
 	 * @param ItemToAdd The item instance to place
 	 * @param SlotCoordinates The root coordinates where to place the item
 	 * @param RotationUsed The rotation angle to use
-	 * @return Pointer to the root slot where the item was placed, or nullptr if failed
+	 * @return true if the item was placed, false otherwise
 	 * 
 	 * @see AddItemToInventoryBP
 	 * @see CanAddItemToSlot
 	 */
-	FDieg_InventorySlot* AddItemToInventory(UDieg_ItemInstance* ItemToAdd, const FIntPoint& SlotCoordinates, float RotationUsed);
+	bool AddItemToInventory(UDieg_ItemInstance* ItemToAdd, const FIntPoint& SlotCoordinates, float RotationUsed);
 	
 	/**
 	 * @brief Places an item in inventory starting at given slot with rotation (Blueprint compatible).
@@ -560,15 +905,14 @@ public:
 	 * @brief Removes an item from inventory, clearing all occupied slots (C++ only).
 	 * 
 	 * Searches for and removes the specified item instance, clearing all slots it occupies.
-	 * Returns a pointer to the root slot for efficiency.
 	 * 
 	 * @param ItemToRemove The item instance to remove
-	 * @return Pointer to the root slot that was cleared, or nullptr if not found
+	 * @return true if the item was found and removed, false otherwise
 	 * 
 	 * @see RemoveItemFromInventoryBP
 	 * @see TryRemoveItem
 	 */
-	FDieg_InventorySlot* RemoveItemFromInventory(UDieg_ItemInstance* ItemToRemove);
+	bool RemoveItemFromInventory(UDieg_ItemInstance* ItemToRemove);
 	
 	/**
 	 * @brief Removes an item from inventory, clearing all occupied slots (Blueprint compatible).
@@ -635,11 +979,124 @@ public:
 	 * @return true if the slot is occupied, false otherwise
 	 * 
 	 * @see IsSlotPointOutOfBounds
-	 * @see SlotsOccupation
+	 * @see Occupancy
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
 	bool IsSlotPointOccupied(const FIntPoint& SlotPoint);
 
+	/**
+	 * @brief Builds a coordinate to occupation map of the whole inventory (Blueprint compatible).
+	 * 
+	 * Blueprint view of the occupancy bitboard. Allocates a new map on every call,
+	 * so prefer IsSlotPointOccupied for single lookups.
+	 * 
+	 * @return Map of every slot coordinate to whether it is occupied
+	 * 
+	 * @see Occupancy
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	TMap<FIntPoint, bool> GetSlotsOccupation() const;
+
+	/**
+	 * @brief Gets the occupancy bitboard of the inventory (C++ only).
+	 * 
+	 * @return The occupancy grid
+	 * 
+	 * @see Occupancy
+	 */
+	const FDieg_OccupancyGrid& GetOccupancy() const { return Occupancy; }
+
+	/**
+	 * @brief Gets the compact slot storage of the inventory (C++ only).
+	 * 
+	 * @return The slot storage
+	 * 
+	 * @see SlotStorage
+	 */
+	const FDieg_SlotStorage& GetSlotStorage() const { return SlotStorage; }
+
+	/**
+	 * @brief Version of the slot contents, changes whenever an item is placed or removed or slot tags change.
+	 * 
+	 * Lets callers keep data derived from the slots and only rebuild it when this changes.
+	 * 
+	 * @return The current slots version
+	 */
+	uint32 GetSlotsVersion() const { return SlotsVersion; }
+
+	/**
+	 * @brief Version of the latest change to the placed items.
+	 * 
+	 * Store it after syncing a view of the inventory and pass it to GetChangesSince later.
+	 * 
+	 * @return The current change version
+	 * 
+	 * @see GetChangesSince
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	int32 GetChangeVersion() const { return ChangeVersion; }
+
+	/**
+	 * @brief Gets every change recorded after the given version.
+	 * 
+	 * Applying the returned changes in order brings a view synced at Version up to date.
+	 * When the journal no longer reaches back that far, or the inventory was initialized
+	 * since, nothing is returned and the view has to be rebuilt from the slots.
+	 * 
+	 * @param Version The change version the caller is synced to
+	 * @param ChangesOut [Out] The changes after Version, oldest first
+	 * @return true if ChangesOut holds every change since Version, false if a full rebuild is needed
+	 * 
+	 * @see GetChangeVersion
+	 * @see FDieg_InventoryChange
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	bool GetChangesSince(int32 Version, TArray<FDieg_InventoryChange>& ChangesOut) const;
+
+	/**
+	 * @brief Moves and/or rotates an item that is already in the inventory.
+	 * 
+	 * The item's own slots are ignored while testing the new placement. Recorded as a
+	 * single Move or Rotate change rather than a Remove and an Add.
+	 * 
+	 * @param ItemToMove The placed item
+	 * @param SlotCoordinates The new placement coordinates
+	 * @param Rotation The new rotation
+	 * @return true if the item was moved, false if it is not placed or does not fit there
+	 * 
+	 * @see GetChangesSince
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	bool MoveItem(UDieg_ItemInstance* ItemToMove, const FIntPoint& SlotCoordinates, float Rotation);
+
+	/**
+	 * @brief Gives a single slot its own gameplay tags.
+	 * 
+	 * Slots share the component's SlotTags by default; only slots set here store a
+	 * reference to their own tag set, and identical sets are shared between slots.
+	 * 
+	 * @param SlotCoordinates The slot to change
+	 * @param Tags The tags for this slot, passing SlotTags restores the default
+	 * @return true if the coordinates are inside the inventory, false otherwise
+	 * 
+	 * @see SlotTags
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	bool SetSlotTags(const FIntPoint& SlotCoordinates, const FGameplayTagContainer& Tags);
+
+	/**
+	 * @brief Memory report of the slot storage.
+	 * 
+	 * Heap bytes of the slot storage, the item table and tag sets included, divided by
+	 * the number of slots. Also logged on initialization when debug logs are on.
+	 * 
+	 * @return Average storage bytes per slot, 0 for an empty inventory
+	 * 
+	 * @see SlotStorage
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|InventoryComponent")
+	float GetStorageBytesPerSlot() const;
+
 	/**
 	 * @brief Creates a new item instance from prepopulate data.
 	 * 
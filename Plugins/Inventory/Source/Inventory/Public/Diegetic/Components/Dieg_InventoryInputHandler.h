@@ -16,6 +16,8 @@ class UCameraComponent;
 class UInputAction;
 class UInputMappingContext;
 class ADieg_PlayerController;
+class IDieg_DragEventListener;
+struct FDieg_RotatedShape;
 
 /**
  * @brief Delegate fired when an inventory is opened.
@@ -284,6 +286,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Input Handler|Strong References", meta = (AllowPrivateAccess = "true"))
 	TObjectPtr<ADieg_Briefcase> BriefcaseActor;
 
+	/**
+	 * @brief Whether closing the inventory hands the briefcase to the actor pool.
+	 * 
+	 * A pooled briefcase keeps its item actors while hidden, so the next open reuses it
+	 * and only syncs the items that changed instead of spawning everything again.
+	 * Has no effect when CloseBriefcase destroys the briefcase.
+	 * 
+	 * @see UDieg_ActorPoolSubsystem
+	 * @see UDieg_3DInventoryComponent::SyncItemActors
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Input Handler|Diegetic Inventory", meta = (AllowPrivateAccess = "true"))
+	bool bPoolBriefcase{true};
+
 	/**
 	 * @brief Relative spawn location for the briefcase.
 	 * 
@@ -413,6 +428,15 @@ public:
 	// Only for visuals
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Input Handler|Dieg Inventory", meta = (AllowPrivateAccess = "true"))
 	TWeakObjectPtr<UDieg_Slot> CurrentMouseSlot;
+
+	// Drag preview: baked shape of the dragging item at CurrentRotation, refreshed on StartDraggingItem and RotateItem
+	const FDieg_RotatedShape* DraggingShape{nullptr};
+
+	// Drag preview: GetRotatedGrabCoordinates(false) for DraggingShape
+	FIntPoint DraggingRotatedGrab{0, 0};
+
+	// Drag preview: coordinates covered by the dragging item, inline so typical shapes never touch the heap
+	TArray<FIntPoint, TInlineAllocator<16>> PreviewCoordinates;
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Input Handler|Weak References", meta = (AllowPrivateAccess = "true"))
 	TWeakObjectPtr<UDieg_3DInventoryComponent> ValidInventory3D;
@@ -732,6 +756,21 @@ protected:
 	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
 	void HandleTraceHit(const FHitResult& HitResult, bool bIsBlockingHit);
 
+	/**
+	 * @brief Receives the batched mouse trace while the inventory is open.
+	 * 
+	 * @param HitResult The hit result from the trace
+	 * @param bIsBlockingHit Whether the trace hit something
+	 * 
+	 * @see UDieg_TraceSubsystem
+	 */
+	void HandleMouseTraceResult(const FHitResult& HitResult, bool bIsBlockingHit);
+
+	/**
+	 * @brief Id of the mouse trace batched by UDieg_TraceSubsystem while open, INDEX_NONE when tracing on tick.
+	 */
+	int32 MouseTraceId{INDEX_NONE};
+
 	/**
 	 * @brief Check if currently dragging an item.
 	 * 
@@ -764,24 +803,6 @@ protected:
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Inventory Input Handler")
 	bool IsItemInInventory(const ADieg_WorldItemActor* ItemIn, UDieg_3DInventoryComponent*& Inventory3DOut);
 	
-	/**
-	 * @brief Attempt to start dragging an item.
-	 * 
-	 * Initiates a drag operation with the currently hovered item.
-	 * Called when the drag input action is triggered.
-	 */
-	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
-	void TryDragItem();
-	
-	/**
-	 * @brief Attempt to drop the currently dragged item.
-	 * 
-	 * Completes a drag operation by dropping the item at the current location.
-	 * Called when the drag input action is released.
-	 */
-	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
-	void TryDropItem();
-
 	/**
 	 * @brief Handle input for item rotation.
 	 * 
@@ -811,6 +832,7 @@ protected:
 	void StartDraggingItem();
 	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
 	void StopDraggingItem();
+	// Merges the dragged item into the items rooted at the given slots, returns whether quantity is left
 	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
 	bool MergeItems(const TArray<FIntPoint>& RootSlotCoordinates);
 	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
@@ -831,7 +853,36 @@ protected:
 	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
 	bool GetCurrentSlot(UDieg_Slot*& SlotOut) const;
 
+	// Caches the dragging item's baked shape and rotated grab point for the current rotation
+	void RefreshDragPreviewCache();
+	// Fills PreviewCoordinates for the current mouse coordinates, returns where the item would be placed
+	FIntPoint UpdatePreviewCoordinates();
+
+	// Broadcasts OnMergeItem if bound, then tells the dragged actor
+	void BroadcastMergeItem(const TArray<AActor*>& MergedActors, int32 OldQuantity, int32 NewQuantity);
+	// The dragged actor as a native drag listener, nullptr when nothing is dragged
+	IDieg_DragEventListener* GetDragEventListener() const;
+
 public:
+	/**
+	 * @brief Attempt to start dragging an item.
+	 * 
+	 * Initiates a drag operation with the currently hovered item.
+	 * Called when the drag input action is triggered, or directly by
+	 * code driving a drag without input.
+	 */
+	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
+	void TryDragItem();
+	
+	/**
+	 * @brief Attempt to drop the currently dragged item.
+	 * 
+	 * Completes a drag operation by dropping the item at the current location.
+	 * Called when the drag input action is released.
+	 */
+	UFUNCTION(Category = "Game|Dieg|Inventory Input Handler")
+	void TryDropItem();
+
 	/**
 	 * @brief Tick the component.
 	 * 
@@ -4,9 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "UObject/ObjectKey.h"
 #include "Dieg_TracerComponent.generated.h"
 
 class ADieg_PlayerController;
+class UDieg_ItemDefinitionDataAsset;
 
 /**
  * @brief Delegate fired when a new actor enters the trace.
@@ -119,6 +121,18 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Game|Dieg|Tracer Component|Properties", meta = (AllowPrivateAccess = "true"))
 	TArray<TEnumAsByte<ECollisionChannel>> TraceChannels;
 
+	/**
+	 * @brief Whether to start streaming in item assets of actors as soon as they enter the trace.
+	 * 
+	 * Hovering a world item prefetches its mesh and icon, hovering an actor with an
+	 * inventory prefetches those of every item inside, so they are usually resident
+	 * by the time the item is picked up or the inventory is opened.
+	 * 
+	 * @see UDieg_AssetStreamingSubsystem
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Game|Dieg|Tracer Component|Properties", meta = (AllowPrivateAccess = "true"))
+	bool bPrefetchOnHover{true};
+
 	// // The Actor currently in trace line.
 	// UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Weak References", meta = (AllowPrivateAccess = "true"))
 	// TMap<TEnumAsByte<ECollisionChannel>, TWeakObjectPtr<AActor>> CurrentTraceActor;
@@ -196,6 +210,29 @@ protected:
 	FHitResult DoSingleTrace(const FVector& TraceStart, const FVector& TraceEnd,
 	                         TEnumAsByte<ECollisionChannel> Channel);
 
+	/**
+	 * @brief Ends play for the component, stopping its batched traces.
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * @brief Registers one batched trace per entry in TraceChannels with the trace service.
+	 * 
+	 * Called on BeginPlay; call again after changing TraceChannels or TraceLength at runtime.
+	 * While registered the component does not trace on tick, results come from
+	 * UDieg_TraceSubsystem one frame after the ray was cast.
+	 * 
+	 * @see UDieg_TraceSubsystem
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Tracer Component")
+	void RegisterTraces();
+
+	/**
+	 * @brief Stops the batched traces, falling back to tracing on tick.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Tracer Component")
+	void UnregisterTraces();
+
 private:
 	/**
 	 * @brief Perform multiple trace operations for all configured channels.
@@ -217,6 +254,33 @@ private:
 	UFUNCTION(Category = "Game|Dieg|Tracer Component")
 	ADieg_PlayerController* CacheOwningPlayerController();
 
+	/**
+	 * @brief Updates the traced actors of a channel from a trace result and fires the in/out delegates.
+	 * 
+	 * @param HitResult Result of the trace, TraceStart and TraceEnd included
+	 * @param bHit Whether the trace hit something
+	 * @param Channel Collision channel that was traced
+	 */
+	void HandleTraceResult(const FHitResult& HitResult, bool bHit, TEnumAsByte<ECollisionChannel> Channel);
+
+	/**
+	 * @brief Ids of the traces registered with UDieg_TraceSubsystem, empty when tracing on tick.
+	 */
+	TArray<int32> RegisteredTraceIds;
+
+	/**
+	 * @brief Requests the item assets the traced actors may soon need.
+	 * 
+	 * The tracer holds the assets of the actors currently in its traces only, what it
+	 * prefetched for actors that left the trace is released.
+	 */
+	void PrefetchItemAssets();
+
+	/**
+	 * @brief Item definitions the tracer currently holds the assets of.
+	 */
+	TSet<TObjectKey<UDieg_ItemDefinitionDataAsset>> PrefetchedDefinitions;
+
 	/**
 	 * @brief Get the currently traced actor for a specific channel.
 	 * 
@@ -96,3 +96,109 @@ enum class EDieg_TextLocation : uint8
 	BottomLeft UMETA(DisplayName = "Bottom Left"),
 };
 
+
+/**
+ * @brief Enumeration defining how automatic placement picks a slot for a new item.
+ * 
+ * EDieg_PlacementStrategy selects the scoring used by UDieg_InventoryComponent when
+ * TryAddItem has to find room for an item. Every strategy only considers placements
+ * that fit, they differ in which valid placement is preferred.
+ * 
+ * @note This enum is Blueprint-compatible and can be used in Blueprint graphs.
+ * 
+ * @see UDieg_InventoryComponent
+ * 
+ * @since 1.0
+ */
+UENUM(BlueprintType)
+enum class EDieg_PlacementStrategy : uint8
+{
+	/** @brief First slot in grid order where any rotation fits */
+	FirstFit UMETA(DisplayName = "First Fit"),
+	
+	/** @brief Placement whose bottom edge is highest in the grid, then left-most, packing items against the top rows */
+	BottomLeftSkyline UMETA(DisplayName = "Bottom Left Skyline"),
+	
+	/** @brief Placement touching the most occupied slots and grid edges, leaving the fewest isolated gaps */
+	MinFragmentation UMETA(DisplayName = "Min Fragmentation"),
+	
+	/** @brief Placement in the maximal free rectangle leaving the smallest leftover short side, then long side */
+	MaxRects UMETA(DisplayName = "Max Rects"),
+};
+
+/**
+ * @brief Enumeration defining the kinds of changes recorded in the inventory change journal.
+ * 
+ * EDieg_InventoryChangeType tags every FDieg_InventoryChange so consumers can apply
+ * the change to their own view of the inventory instead of rebuilding it.
+ * 
+ * @note This enum is Blueprint-compatible and can be used in Blueprint graphs.
+ * 
+ * @see FDieg_InventoryChange
+ * @see UDieg_InventoryComponent::GetChangesSince
+ * 
+ * @since 1.0
+ */
+UENUM(BlueprintType)
+enum class EDieg_InventoryChangeType : uint8
+{
+	/** @brief An item was placed in the inventory */
+	Add UMETA(DisplayName = "Add"),
+	
+	/** @brief An item was taken out of the inventory */
+	Remove UMETA(DisplayName = "Remove"),
+	
+	/** @brief A placed item moved to another root slot, keeping its rotation */
+	Move UMETA(DisplayName = "Move"),
+	
+	/** @brief A placed item changed rotation, its root slot may have moved too */
+	Rotate UMETA(DisplayName = "Rotate"),
+	
+	/** @brief The quantity of a placed item changed */
+	QuantityChange UMETA(DisplayName = "Quantity Change"),
+};
+
+/**
+ * @brief Enumeration defining how a 3D inventory draws the items it contains.
+ * 
+ * EDieg_ItemRenderMode selects whether UDieg_3DInventoryComponent keeps one
+ * ADieg_WorldItemActor per placed item or draws resting items as instances of
+ * one instanced static mesh component per mesh.
+ * 
+ * @note This enum is Blueprint-compatible and can be used in Blueprint graphs.
+ * 
+ * @see UDieg_3DInventoryComponent
+ * 
+ * @since 1.0
+ */
+UENUM(BlueprintType)
+enum class EDieg_ItemRenderMode : uint8
+{
+	/** @brief Every placed item is a full world item actor */
+	Actors UMETA(DisplayName = "Actors"),
+	
+	/** @brief Resting items are mesh instances, an item becomes a full actor only while hovered or dragged */
+	Instanced UMETA(DisplayName = "Instanced"),
+};
+
+/**
+ * @brief Enumeration defining where a player's trace starts and points to.
+ * 
+ * EDieg_TraceOrigin tells UDieg_TraceSubsystem how to build the ray of a
+ * registered trace from its player controller each time it is issued.
+ * 
+ * @note This enum is Blueprint-compatible and can be used in Blueprint graphs.
+ * 
+ * @see UDieg_TraceSubsystem
+ * 
+ * @since 1.0
+ */
+UENUM(BlueprintType)
+enum class EDieg_TraceOrigin : uint8
+{
+	/** @brief From the camera through the center of the viewport */
+	ViewportCenter UMETA(DisplayName = "Viewport Center"),
+	
+	/** @brief From the camera through the mouse cursor */
+	Mouse UMETA(DisplayName = "Mouse"),
+};
@@ -0,0 +1,146 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Dieg_DragEventListener.generated.h"
+
+class UDieg_3DInventoryComponent;
+class UDieg_InventoryInputHandler;
+
+/**
+ * @brief UInterface implementation for the drag event listener interface.
+ * 
+ * This class does not need to be modified. It provides the UInterface
+ * implementation for the IDieg_DragEventListener interface.
+ */
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UDieg_DragEventListener : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * @brief Native interface for actors told about their own drag by the input handler.
+ * 
+ * The inventory input handler calls these functions directly on the actor it is dragging,
+ * right after broadcasting the matching Blueprint delegate (only when something is bound).
+ * Dragged actors used to bind eleven dynamic delegates on every drag start and remove them
+ * on every drop; calling the dragged actor instead needs no binding at all.
+ * 
+ * Every function has an empty default implementation, listeners only override what they need.
+ * The dragged actor is the listener itself, so it is not passed again.
+ * 
+ * @note This interface is native only and cannot be implemented in Blueprint. Blueprint
+ * code keeps listening through the delegates of UDieg_InventoryInputHandler.
+ * 
+ * @see UDieg_InventoryInputHandler
+ * @see ADieg_WorldItemActor
+ * 
+ * @since 1.0
+ */
+class INVENTORY_API IDieg_DragEventListener
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Called when the dragged actor enters an inventory.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param InventoryComponent3D The inventory being hovered
+	 * @param GrabPoint Grab point, in item coordinates
+	 */
+	virtual void OnDragHoverEnterInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint GrabPoint) {}
+
+	/**
+	 * @brief Called when the dragged actor leaves an inventory.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param InventoryComponent3D The inventory that was hovered
+	 * @param GrabPoint Grab point, in item coordinates
+	 */
+	virtual void OnDragHoverLeaveInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint GrabPoint) {}
+
+	/**
+	 * @brief Called when a drag starts from an inventory.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param GrabPoint Rotated grab point, in item coordinates
+	 * @param Coordinates Coordinates the actor was lifted from
+	 */
+	virtual void OnStartDragInventory(UDieg_InventoryInputHandler* Handler, FIntPoint GrabPoint, FIntPoint Coordinates) {}
+
+	/**
+	 * @brief Called when a drag starts from the world.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param GrabPoint Rotated grab point, in item coordinates
+	 * @param WorldLocation Location the actor was lifted from
+	 */
+	virtual void OnStartDragWorld(UDieg_InventoryInputHandler* Handler, FIntPoint GrabPoint, FVector WorldLocation) {}
+
+	/**
+	 * @brief Called when the actor is dropped at a new place in an inventory.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param InventoryComponent3D The inventory the actor was dropped in
+	 * @param DroppedCoordinates Root coordinates of the drop
+	 * @param DroppedRotation Rotation of the drop
+	 */
+	virtual void OnDropInInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint DroppedCoordinates, float DroppedRotation) {}
+
+	/**
+	 * @brief Called when the actor is dropped in the world.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param DroppedLocation Location of the drop
+	 */
+	virtual void OnDropWorld(UDieg_InventoryInputHandler* Handler, FVector DroppedLocation) {}
+
+	/**
+	 * @brief Called when the actor is dropped where it was lifted from in an inventory.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param InventoryComponent3D The inventory the actor returns to
+	 * @param ResetCoordinates Root coordinates it returns to
+	 * @param ResetRotation Rotation it returns to
+	 */
+	virtual void OnResetDragInventory(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D, FIntPoint ResetCoordinates, float ResetRotation) {}
+
+	/**
+	 * @brief Called when no valid place was found and the actor returns to the world.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param ResetLocation Location it returns to
+	 */
+	virtual void OnResetDragWorld(UDieg_InventoryInputHandler* Handler, FVector ResetLocation) {}
+
+	/**
+	 * @brief Called when the dragged actor is rotated.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param NewRotation The new rotation
+	 * @param GripPoint Grab point rotated to the new rotation
+	 */
+	virtual void OnRotateDragged(UDieg_InventoryInputHandler* Handler, float NewRotation, FIntPoint GripPoint) {}
+
+	/**
+	 * @brief Called when the dragged actor merged quantities into items of an inventory.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param MergedActors Actors of the items that received quantity
+	 * @param OldQuantity Quantity before merging
+	 * @param NewQuantity Quantity left after merging
+	 */
+	virtual void OnMergeDragged(UDieg_InventoryInputHandler* Handler, const TArray<AActor*>& MergedActors, int32 OldQuantity, int32 NewQuantity) {}
+
+	/**
+	 * @brief Called when the whole quantity of the dragged actor was merged away.
+	 * 
+	 * @param Handler The input handler dragging this actor
+	 * @param InventoryComponent3D The inventory it merged into
+	 */
+	virtual void OnConsumedInMerge(UDieg_InventoryInputHandler* Handler, UDieg_3DInventoryComponent* InventoryComponent3D) {}
+};
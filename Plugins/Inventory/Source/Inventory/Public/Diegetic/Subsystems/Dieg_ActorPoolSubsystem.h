@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Dieg_ActorPoolSubsystem.generated.h"
+
+/**
+ * @brief Idle actors of one class kept by UDieg_ActorPoolSubsystem.
+ *
+ * @see UDieg_ActorPoolSubsystem
+ *
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_ActorPoolBucket
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Hidden actors waiting to be acquired, most recently released last.
+	 */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AActor>> Actors;
+};
+
+/**
+ * @brief World subsystem that recycles actors instead of destroying and respawning them.
+ *
+ * UDieg_ActorPoolSubsystem keeps released actors hidden, without collision and without
+ * tick, grouped by their exact class. Acquiring an actor of a class first reuses an idle
+ * one and only spawns when the pool for that class is empty.
+ *
+ * Used for the world item actors of UDieg_3DInventoryComponent and for the briefcase of
+ * UDieg_InventoryInputHandler, so opening and closing an inventory does not cause a
+ * spawn and garbage collection storm.
+ *
+ * The spawned, reused and released counts are reported in the Diegetic Inventory stat group.
+ *
+ * @note Released actors keep their state; callers reinitialize whatever they need after acquiring.
+ *
+ * @see UDieg_3DInventoryComponent
+ * @see UDieg_InventoryInputHandler
+ *
+ * @since 1.0
+ */
+UCLASS()
+class INVENTORY_API UDieg_ActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Gets the pool of the world an object lives in.
+	 *
+	 * @param WorldContextObject Any object in the world
+	 * @return The pool, or nullptr if the object has no world
+	 */
+	static UDieg_ActorPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * @brief Takes an idle actor of exactly the given class out of the pool, without spawning.
+	 *
+	 * The actor is shown again and gets its collision and tick back. Its transform, owner
+	 * and attachment are left as they were when it was released.
+	 *
+	 * @param ActorClass The class to look for
+	 * @return A pooled actor, or nullptr if none is idle
+	 */
+	AActor* TryAcquireActor(UClass* ActorClass);
+
+	/**
+	 * @brief Takes an idle actor of the given class out of the pool, spawning one if none is idle.
+	 *
+	 * @param ActorClass The class to acquire
+	 * @param Transform World transform to place the actor at
+	 * @param SpawnParameters Parameters used when a new actor has to be spawned; the owner is also applied to reused actors
+	 * @return The actor, or nullptr if spawning failed
+	 */
+	AActor* AcquireActor(UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParameters);
+
+	template <typename T>
+	T* AcquireActor(const TSubclassOf<T>& ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParameters)
+	{
+		return Cast<T>(AcquireActor(ActorClass.Get(), Transform, SpawnParameters));
+	}
+
+	/**
+	 * @brief Hands an actor back to the pool.
+	 *
+	 * The actor is detached, hidden together with the actors attached to it, loses
+	 * collision and tick, and waits for the next acquire of its class. Actors beyond
+	 * MaxPooledPerClass are destroyed instead.
+	 *
+	 * @param Actor The actor to release
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Actor Pool")
+	void ReleaseActor(AActor* Actor);
+
+	/**
+	 * @brief Spawns idle actors up front so later acquires don't spawn.
+	 *
+	 * @param ActorClass The class to spawn
+	 * @param Count Number of idle actors the pool should hold for that class
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Actor Pool")
+	void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+	/**
+	 * @brief Number of idle actors held for a class.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Actor Pool")
+	int32 GetNumPooled(TSubclassOf<AActor> ActorClass) const;
+
+	virtual void Deinitialize() override;
+
+protected:
+	/**
+	 * @brief Idle actors, by exact class.
+	 */
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UClass>, FDieg_ActorPoolBucket> Pools;
+
+	/**
+	 * @brief Upper bound of idle actors per class; releases past it destroy the actor.
+	 */
+	int32 MaxPooledPerClass{256};
+
+	/**
+	 * @brief Shows or hides an actor and every actor attached to it, toggling collision and tick with it.
+	 */
+	static void SetActorPooled(AActor* Actor, bool bPooled);
+};
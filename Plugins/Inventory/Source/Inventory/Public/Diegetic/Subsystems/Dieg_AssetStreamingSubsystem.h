@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Dieg_AssetStreamingSubsystem.generated.h"
+
+class UDieg_InventoryComponent;
+class UDieg_ItemDefinitionDataAsset;
+struct FStreamableHandle;
+
+/**
+ * @brief Async load of the assets of one item definition, tracked by UDieg_AssetStreamingSubsystem.
+ *
+ * @see UDieg_AssetStreamingSubsystem
+ *
+ * @since 1.0
+ */
+struct FDieg_ItemAssetRequest
+{
+	/**
+	 * @brief Streaming handle, keeps the loaded assets resident while held.
+	 */
+	TSharedPtr<FStreamableHandle> Handle;
+
+	/**
+	 * @brief Time the load was requested, in seconds, for the latency stat.
+	 */
+	double RequestTime{0.0};
+
+	/**
+	 * @brief Callbacks waiting for the load to finish.
+	 */
+	TArray<FSimpleDelegate> Callbacks;
+
+	/**
+	 * @brief Objects keeping the assets resident, the handle is released when the last one lets go.
+	 */
+	TSet<TObjectKey<UObject>> Holders;
+};
+
+/**
+ * @brief Engine subsystem that streams the meshes and icons of items in asynchronously.
+ *
+ * Item definitions only hold soft references to their world mesh and 2D icon. Loading
+ * them synchronously the first time an item is shown hitches the game thread, so
+ * UDieg_AssetStreamingSubsystem requests them through the asset manager's streamable
+ * manager instead and notifies the caller once they are resident.
+ *
+ * Loads are keyed by item definition: requesting the same definition twice shares one
+ * load. Every request names a holder (the inventory, actor or widget showing the item)
+ * and the streaming handle is kept until the last holder released it with
+ * ReleaseItemAssets or ReleaseHolderAssets, after which the assets can be garbage collected.
+ *
+ * Inventories are prefetched when they are about to be shown (hovered by the tracer,
+ * opened, populated), so by the time items are drawn their assets are usually loaded.
+ * Load latency, in-flight loads and remaining blocking loads are reported in the
+ * Diegetic Inventory stat group.
+ *
+ * @note Lives on the engine, so it is also available to editor utility widgets.
+ *
+ * @see ADieg_WorldItemActor
+ * @see UDieg_3DInventoryComponent
+ * @see UDieg_TracerComponent
+ *
+ * @since 1.0
+ */
+UCLASS()
+class INVENTORY_API UDieg_AssetStreamingSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Gets the subsystem.
+	 *
+	 * @return The subsystem, or nullptr if the engine is not up
+	 */
+	static UDieg_AssetStreamingSubsystem* Get();
+
+	/**
+	 * @brief Requests the world mesh and icon of an item definition.
+	 *
+	 * @param ItemDataAsset The item definition to load the assets of
+	 * @param Holder Keeps the assets resident until it releases them
+	 * @param OnLoaded Called once the assets are loaded, only when this returns false
+	 * @return True if the assets are already resident, in which case OnLoaded is not called
+	 *
+	 * @see ReleaseHolderAssets
+	 */
+	bool RequestItemAssets(const UDieg_ItemDefinitionDataAsset* ItemDataAsset, const UObject* Holder, FSimpleDelegate OnLoaded = FSimpleDelegate());
+
+	/**
+	 * @brief Requests the assets of every item placed in an inventory.
+	 *
+	 * @param InventoryComponent The inventory to prefetch
+	 * @param Holder Keeps the assets resident until it releases them
+	 */
+	void RequestInventoryAssets(const UDieg_InventoryComponent* InventoryComponent, const UObject* Holder);
+
+	/**
+	 * @brief Lets go of the assets of an item definition for one holder.
+	 *
+	 * Once no holder is left the handle is dropped so the assets can be garbage collected,
+	 * a load still in flight is canceled and its callbacks are not called.
+	 *
+	 * @param ItemDataAsset The item definition to release the assets of
+	 * @param Holder The holder that requested them
+	 */
+	void ReleaseItemAssets(const UDieg_ItemDefinitionDataAsset* ItemDataAsset, const UObject* Holder);
+
+	/**
+	 * @brief Lets go of every item definition requested by a holder.
+	 *
+	 * Call it when the holder stops showing items: the 3D inventory deinitializes, the
+	 * tracer's target leaves, an item actor ends play or shows another item.
+	 *
+	 * @param Holder The holder that requested the assets
+	 */
+	void ReleaseHolderAssets(const UObject* Holder);
+
+	/**
+	 * @brief Loads a soft reference synchronously, reporting it as a blocking load.
+	 *
+	 * Fallback for code that cannot wait for an async load. Every load that actually
+	 * blocks is logged and counted, so the remaining hitches can be found and prefetched.
+	 *
+	 * @param SoftRef The asset to load
+	 * @param Context Who is loading, for the log
+	 * @return The asset, or nullptr if the reference is null or failed to load
+	 */
+	template <typename T>
+	static T* LoadBlocking(const TSoftObjectPtr<T>& SoftRef, const TCHAR* Context)
+	{
+		if (T* Resident = SoftRef.Get())
+		{
+			return Resident;
+		}
+		if (SoftRef.IsNull())
+		{
+			return nullptr;
+		}
+
+		NoteBlockingLoad(SoftRef.ToSoftObjectPath(), Context);
+		return SoftRef.LoadSynchronous();
+	}
+
+	virtual void Deinitialize() override;
+
+protected:
+	/**
+	 * @brief Loads in flight or completed, by item definition.
+	 */
+	TMap<TObjectKey<UDieg_ItemDefinitionDataAsset>, FDieg_ItemAssetRequest> Requests;
+
+	/**
+	 * @brief Completion of the load of an item definition, updates the stats and runs its callbacks.
+	 */
+	void HandleItemAssetsLoaded(TObjectKey<UDieg_ItemDefinitionDataAsset> Key);
+
+	/**
+	 * @brief Drops the handle of a request, canceling it if still loading.
+	 */
+	static void ReleaseRequest(FDieg_ItemAssetRequest& Request);
+
+	static void NoteBlockingLoad(const FSoftObjectPath& Path, const TCHAR* Context);
+};
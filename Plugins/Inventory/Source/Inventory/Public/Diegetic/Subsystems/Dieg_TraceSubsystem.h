@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+#include "Diegetic/Dieg_DataLibrary.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Dieg_TraceSubsystem.generated.h"
+
+class APlayerController;
+
+/**
+ * @brief Callback receiving the result of a registered trace.
+ *
+ * @param HitResult The first blocking hit, or an empty hit spanning the ray if nothing was hit
+ * @param bBlockingHit Whether something was hit
+ */
+DECLARE_DELEGATE_TwoParams(FDieg_OnTraceResult, const FHitResult& /*HitResult*/, bool /*bBlockingHit*/);
+
+/**
+ * @brief Listener of a trace group of UDieg_TraceSubsystem.
+ *
+ * @since 1.0
+ */
+struct FDieg_TraceListener
+{
+	/**
+	 * @brief Id returned by UDieg_TraceSubsystem::RegisterTrace.
+	 */
+	int32 TraceId{INDEX_NONE};
+
+	/**
+	 * @brief Called with every fresh result of the group.
+	 */
+	FDieg_OnTraceResult Callback;
+};
+
+/**
+ * @brief One async line trace per frame, shared by every listener asking for the same ray and channel.
+ *
+ * @see UDieg_TraceSubsystem
+ *
+ * @since 1.0
+ */
+struct FDieg_TraceGroup
+{
+	TWeakObjectPtr<APlayerController> PlayerController;
+	EDieg_TraceOrigin Origin{EDieg_TraceOrigin::ViewportCenter};
+	TEnumAsByte<ECollisionChannel> Channel{ECC_Visibility};
+	double Length{0.0};
+
+	/**
+	 * @brief Listeners the result is fanned out to.
+	 */
+	TArray<FDieg_TraceListener> Listeners;
+
+	/**
+	 * @brief Trace issued last frame, its result is read this frame.
+	 */
+	FTraceHandle PendingTrace;
+
+	/**
+	 * @brief Ray of the last issued trace, to skip tracing again while the camera is still.
+	 */
+	FVector LastStart{FVector::ZeroVector};
+	FVector LastDirection{FVector::ZeroVector};
+	double LastTraceTime{0.0};
+	bool bHasLastTrace{false};
+};
+
+/**
+ * @brief World subsystem batching the per-frame line traces of the player's components.
+ *
+ * The tracer component, the inventory input handler and the player controller each used
+ * to fire their own synchronous line traces every tick. They now register the ray they are
+ * interested in (player, origin, channel and length) and get the result through a callback.
+ *
+ * Once per frame the subsystem:
+ * - reads the results of the async traces issued the frame before and fans each result
+ *   out to all listeners of that ray, so identical requests cost a single trace;
+ * - issues the next batch with AsyncLineTraceByChannel, at most every TraceInterval
+ *   seconds, skipping rays that did not move since the last trace unless the last
+ *   result is older than MaxStillTraceAge.
+ *
+ * Results arrive one frame after the trace was issued. Traces that must reflect the
+ * input of the current frame, like picking the grab point of a drag, stay synchronous.
+ *
+ * Traces issued, traces skipped and the game thread time of the service are reported in
+ * the Diegetic Inventory stat group; setting bBatchTraces to false makes every consumer
+ * fall back to its own synchronous traces for comparison.
+ *
+ * @see UDieg_TracerComponent
+ * @see UDieg_InventoryInputHandler
+ *
+ * @since 1.0
+ */
+UCLASS(Config = Game)
+class INVENTORY_API UDieg_TraceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Gets the trace service of the world an object lives in.
+	 *
+	 * @param WorldContextObject Any object in the world
+	 * @return The subsystem, or nullptr if the object has no world
+	 */
+	static UDieg_TraceSubsystem* Get(const UObject* WorldContextObject);
+
+	/**
+	 * @brief Starts tracing a ray every frame for a listener.
+	 *
+	 * @param PlayerController Player whose camera, viewport and mouse build the ray
+	 * @param Origin How the ray is built
+	 * @param Channel Collision channel to trace
+	 * @param Length Length of the ray
+	 * @param Callback Called with each fresh result
+	 * @return Id to unregister with, or INDEX_NONE if batching is disabled and the caller should trace itself
+	 */
+	int32 RegisterTrace(APlayerController* PlayerController, EDieg_TraceOrigin Origin, ECollisionChannel Channel, double Length, FDieg_OnTraceResult Callback);
+
+	/**
+	 * @brief Stops tracing for a listener. Safe to call from a result callback.
+	 *
+	 * @param TraceId Id returned by RegisterTrace
+	 */
+	void UnregisterTrace(int32 TraceId);
+
+	/**
+	 * @brief Builds the ray of a player for an origin, as the service does before tracing.
+	 *
+	 * @param PlayerController The player
+	 * @param Origin How the ray is built
+	 * @param OutStart Start of the ray
+	 * @param OutDirection Normalized direction of the ray
+	 * @return false if the ray could not be built, e.g. without a viewport
+	 */
+	static bool ComputeTraceRay(const APlayerController* PlayerController, EDieg_TraceOrigin Origin, FVector& OutStart, FVector& OutDirection);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override;
+
+	/**
+	 * @brief Whether traces are batched at all; when false, RegisterTrace refuses and consumers trace themselves.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Game|Dieg|Trace Subsystem")
+	bool bBatchTraces{true};
+
+	/**
+	 * @brief Minimum time between two batches of traces, in seconds. 0 traces every frame.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Game|Dieg|Trace Subsystem", meta = (ClampMin = "0.0"))
+	float TraceInterval{0.0f};
+
+	/**
+	 * @brief Distance a ray start may move, and direction change, still considered still.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Game|Dieg|Trace Subsystem", meta = (ClampMin = "0.0"))
+	float StillTolerance{0.01f};
+
+	/**
+	 * @brief Longest time a still ray goes without being traced again, in seconds, so moving objects are still noticed.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Game|Dieg|Trace Subsystem", meta = (ClampMin = "0.0"))
+	float MaxStillTraceAge{0.25f};
+
+protected:
+	/**
+	 * @brief Reads last frame's traces and hands their results to the listeners.
+	 */
+	void DeliverResults();
+
+	/**
+	 * @brief Issues this frame's traces.
+	 */
+	void IssueTraces();
+
+	/**
+	 * @brief Registered rays, each traced once per batch.
+	 */
+	TArray<FDieg_TraceGroup> Groups;
+
+	int32 NextTraceId{0};
+
+	/**
+	 * @brief Time since the last batch was issued.
+	 */
+	float TimeSinceLastBatch{0.0f};
+};
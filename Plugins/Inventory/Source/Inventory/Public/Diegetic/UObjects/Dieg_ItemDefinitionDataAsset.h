@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Diegetic/UStructs/Dieg_ItemDefinition.h"
+#include "Diegetic/UStructs/Dieg_RotatedShape.h"
 #include "Engine/DataAsset.h"
 #include "Dieg_ItemDefinitionDataAsset.generated.h"
 
@@ -21,6 +22,7 @@ class UDieg_ItemFragment;
  * - Item definition data storage
  * - Editor integration for item configuration
  * - Automatic shape root calculation
+ * - A read-only cache of the shape baked at every rotation
  * - Data validation and cleanup
  * 
  * @note This is a primary data asset and can be referenced by other systems.
@@ -49,6 +51,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Item Definition Data Asset|Definition", meta = (AllowPrivateAccess = "true"))
 	FDieg_ItemDefinition ItemDefinition;
 
+	/**
+	 * @brief Called after the asset is loaded, bakes the rotated shape cache.
+	 */
+	virtual void PostLoad() override;
+
 	/**
 	 * @brief Called when a property is changed in the editor.
 	 * 
@@ -80,4 +87,41 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Item Definition Data Asset")
 	static void SetItemDefinitionShapeRoot(FDieg_ItemDefinition& ItemDef);
+
+	/**
+	 * @brief Bakes the item shape at every rotation.
+	 * 
+	 * Called automatically on load, on property change and on save. Only needs to be
+	 * called manually if DefaultShape or DefaultShapeRoot are modified at runtime.
+	 * 
+	 * @see GetRotatedShape
+	 */
+	void BuildRotatedShapes();
+
+	/**
+	 * @brief Gets the baked shape for a rotation.
+	 * 
+	 * Placement and presentation code reads from here instead of rotating
+	 * DefaultShape on every call.
+	 * 
+	 * @param Rotation The rotation angle in degrees, any multiple of 90
+	 * @return The baked shape for that rotation
+	 * 
+	 * @see FDieg_RotatedShape
+	 */
+	const FDieg_RotatedShape& GetRotatedShape(float Rotation) const;
+
+	/**
+	 * @brief Gets the baked shapes for all rotations, in 0, 90, 180, -90 order.
+	 * 
+	 * @return The rotated shape cache
+	 */
+	const TArray<FDieg_RotatedShape>& GetRotatedShapes() const;
+
+private:
+	/**
+	 * @brief The shape baked at 0, 90, 180 and -90 degrees, derived from ItemDefinition.
+	 */
+	UPROPERTY(Transient, VisibleAnywhere, Category = "Game|Dieg|Item Definition Data Asset|Cache")
+	TArray<FDieg_RotatedShape> RotatedShapes;
 };
@@ -214,6 +214,54 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Item Instance")
 	bool CanStackWith(const UDieg_ItemInstance* ToCheck) const;
+
+	/**
+	 * @brief Gets the hashed stack key of this instance.
+	 * 
+	 * The key combines the item definition, the item tags and the fragment classes.
+	 * Instances with different keys can never be equal, so IsEqual compares keys
+	 * before comparing fragment states.
+	 * 
+	 * @return The stack key
+	 * 
+	 * @see UpdateStackKey
+	 * @see IsEqual
+	 */
+	uint32 GetStackKey() const;
+
+	/**
+	 * @brief Recomputes the stack key.
+	 * 
+	 * Done automatically on Initialize, load and editor changes. Call it after
+	 * modifying ItemTags or ItemFragments directly at runtime.
+	 * 
+	 * @see GetStackKey
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Item Instance")
+	void UpdateStackKey();
+
+	/**
+	 * @brief Called after the instance is loaded, refreshes the stack key.
+	 */
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	/**
+	 * @brief Called when a property is changed in the editor, refreshes the stack key.
+	 * 
+	 * @param PropertyChangedEvent Information about the property change
+	 */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	/**
+	 * @brief Cached stack key, 0 until computed.
+	 * 
+	 * @see GetStackKey
+	 */
+	UPROPERTY(Transient)
+	uint32 StackKey{0};
 };
 
 template <typename T>
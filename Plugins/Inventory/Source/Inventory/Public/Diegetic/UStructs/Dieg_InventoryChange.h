@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Diegetic/Dieg_DataLibrary.h"
+#include "Dieg_InventoryChange.generated.h"
+
+class UDieg_ItemInstance;
+
+/**
+ * @brief One entry of the inventory change journal.
+ * 
+ * Every change to the placed items of a UDieg_InventoryComponent is recorded as one
+ * FDieg_InventoryChange carrying the item's state after the change, so a consumer that
+ * applies the records in order ends up with the same view as the component.
+ * 
+ * @note This struct is Blueprint-compatible and can be used in Blueprint graphs.
+ * 
+ * @see UDieg_InventoryComponent::GetChangesSince
+ * @see EDieg_InventoryChangeType
+ * 
+ * @since 1.0
+ */
+USTRUCT(BlueprintType)
+struct INVENTORY_API FDieg_InventoryChange
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Inventory version this change produced. Versions increase by one per change.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Change")
+	int32 Version{0};
+
+	/**
+	 * @brief What happened to the item.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Change")
+	EDieg_InventoryChangeType Type{EDieg_InventoryChangeType::Add};
+
+	/**
+	 * @brief The item the change applies to.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Change")
+	TObjectPtr<UDieg_ItemInstance> ItemInstance;
+
+	/**
+	 * @brief Root slot of the item after the change. For Remove, the root slot it was removed from.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Change")
+	FIntPoint RootSlot{-1, -1};
+
+	/**
+	 * @brief Root slot of the item before the change, only set for Move and Rotate.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Change")
+	FIntPoint PreviousRootSlot{-1, -1};
+
+	/**
+	 * @brief Rotation of the item after the change, in degrees.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Change")
+	float Rotation{0.0f};
+
+	/**
+	 * @brief Quantity of the item after the change.
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Inventory Change")
+	int32 Quantity{0};
+};
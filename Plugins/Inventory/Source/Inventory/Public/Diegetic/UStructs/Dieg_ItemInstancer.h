@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dieg_ItemInstancer.generated.h"
+
+class UDieg_ItemInstance;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/**
+ * @brief Instanced static mesh component drawing every resting item that shares one mesh.
+ * 
+ * Instances are never removed from the component, since removing reorders the indices
+ * of the other instances. A freed instance is collapsed to zero scale and its index is
+ * reused by the next item.
+ * 
+ * The single per-instance custom data float holds the item's quantity, for materials
+ * that want to display it.
+ * 
+ * @see UDieg_3DInventoryComponent
+ * @see EDieg_ItemRenderMode
+ * 
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_ItemInstancer
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief The component drawing the instances.
+	 */
+	UPROPERTY(Transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Component;
+
+	/**
+	 * @brief Item drawn by each instance index, nullptr for freed instances.
+	 */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UDieg_ItemInstance>> InstanceItems;
+
+	/**
+	 * @brief Freed instance indices, reused before new instances are added.
+	 */
+	TArray<int32> FreeInstances;
+
+	/**
+	 * @brief Number of instances currently drawing an item.
+	 */
+	int32 NumUsed() const { return InstanceItems.Num() - FreeInstances.Num(); }
+};
+
+/**
+ * @brief Where a resting item is drawn by an FDieg_ItemInstancer.
+ * 
+ * @see FDieg_ItemInstancer
+ * 
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_ItemMeshInstance
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Mesh of the instancer, the key it is stored under.
+	 */
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMesh> Mesh;
+
+	/**
+	 * @brief Instance index in the instancer's component.
+	 */
+	UPROPERTY(Transient)
+	int32 InstanceIndex{INDEX_NONE};
+};
@@ -0,0 +1,330 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "Dieg_OccupancyGrid.generated.h"
+
+/**
+ * @brief Bitmask form of an item shape, laid out one 64-bit word per shape row.
+ *
+ * FDieg_ShapeMask is the packed representation of a (possibly rotated) item shape
+ * used by FDieg_OccupancyGrid for fit tests. Bit X of RowBits[Y] is set when the
+ * shape occupies cell (Min.X + X, Min.Y + Y) relative to the placement coordinates.
+ *
+ * Testing whether a shape fits therefore costs one AND per shape row instead of
+ * one lookup per shape cell.
+ *
+ * @note Shapes wider than 64 cells are not supported and produce an empty mask.
+ *
+ * @see FDieg_OccupancyGrid
+ *
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_ShapeMask
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Occupied cells of each shape row, bit 0 being the left-most column (Min.X).
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Shape Mask")
+	TArray<uint64> RowBits;
+
+	/**
+	 * @brief Top-left corner of the shape's bounding box, relative to the placement coordinates.
+	 *
+	 * Usually (0,0), but kept explicit so that unnormalized shapes are still tested
+	 * at the same cells GetRelevantCoordinates would produce.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Shape Mask")
+	FIntPoint Min{0, 0};
+
+	/**
+	 * @brief Width and height of the shape's bounding box.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Shape Mask")
+	FIntPoint Span{0, 0};
+
+	/**
+	 * @brief Number of cells set in the mask.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Shape Mask")
+	int32 NumCells{0};
+
+	/**
+	 * @brief Longest horizontal run of consecutive cells in any shape row.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Shape Mask")
+	int32 LongestRowRun{0};
+
+	/**
+	 * @brief Whether the shape fills its whole bounding box.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Shape Mask")
+	bool bIsRectangle{false};
+
+	/**
+	 * @brief Whether the shape covers its own placement coordinates (offset 0,0).
+	 *
+	 * Automatic placement only accepts rotations whose shape includes the slot it
+	 * starts from, this caches that check per mask.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Shape Mask")
+	bool bContainsOrigin{false};
+
+	/**
+	 * @brief Builds the mask from shape cell offsets.
+	 *
+	 * @param Cells Offsets of every cell in the shape, relative to the placement coordinates
+	 * @return The packed mask, empty if the shape is empty or wider than 64 cells
+	 */
+	static FDieg_ShapeMask Build(const TArray<FIntPoint>& Cells);
+
+	/**
+	 * @brief Checks if the mask contains any cell.
+	 *
+	 * @return true if the mask is empty, false otherwise
+	 */
+	bool IsEmpty() const { return NumCells == 0; }
+};
+
+/**
+ * @brief Dense occupancy bitboard for a diegetic inventory grid.
+ *
+ * FDieg_OccupancyGrid stores one bit per grid cell in row-major order, each row padded to
+ * a whole number of 64-bit words. Coordinates map to bits in O(1), with the same cell order
+ * as UDieg_UtilityLibrary::GetIndexFromPosition, and whole shapes are tested with
+ * FDieg_ShapeMask using a handful of AND/shift operations per row.
+ *
+ * Padding bits (past the last column and past TotalSlots on a partial last row) are
+ * permanently set, so fit tests never need to special-case the grid edges beyond
+ * a bounding-box check.
+ *
+ * A free-space summary (free cell count, longest free run per row, largest free
+ * rectangle) is kept alongside the bits so that shapes that cannot fit anywhere are
+ * rejected without scanning the grid, see CouldEverFit.
+ *
+ * @note This is the source of truth for slot occupation in UDieg_InventoryComponent.
+ *
+ * @see FDieg_ShapeMask
+ * @see UDieg_InventoryComponent
+ *
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_OccupancyGrid
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Resets the grid to the given dimensions with every cell free.
+	 *
+	 * @param NumSlots Total number of cells in the grid
+	 * @param NumColumns Number of columns in the grid
+	 */
+	void Initialize(int32 NumSlots, int32 NumColumns);
+
+	/**
+	 * @brief Returns true if the coordinates belong to the grid.
+	 *
+	 * @param Point The coordinates to check
+	 * @return true if the coordinates map to one of the NumSlots cells, false otherwise
+	 */
+	bool IsInBounds(const FIntPoint& Point) const
+	{
+		return Point.X >= 0 && Point.X < Columns && Point.Y >= 0 && Point.Y < Rows
+			&& Point.X + Point.Y * Columns < NumCells;
+	}
+
+	/**
+	 * @brief Returns true if the cell is in bounds and occupied.
+	 *
+	 * @param Point The coordinates to check
+	 * @return true if an item occupies the cell, false if free or out of bounds
+	 */
+	bool IsOccupied(const FIntPoint& Point) const
+	{
+		return IsInBounds(Point) && IsBitSet(Point);
+	}
+
+	/**
+	 * @brief Returns true if the cell is in bounds and free.
+	 *
+	 * @param Point The coordinates to check
+	 * @return true if an item could be placed in the cell, false otherwise
+	 */
+	bool IsAvailable(const FIntPoint& Point) const
+	{
+		return IsInBounds(Point) && !IsBitSet(Point);
+	}
+
+	/**
+	 * @brief Marks a single cell as occupied or free.
+	 *
+	 * @param Point The coordinates of the cell, ignored if out of bounds
+	 * @param bOccupied The new occupation state
+	 */
+	void SetOccupied(const FIntPoint& Point, bool bOccupied);
+
+	/**
+	 * @brief Tests whether every cell of a shape mask is in bounds and free.
+	 *
+	 * @param Mask The shape to test
+	 * @param Coordinates The placement coordinates the mask is relative to
+	 * @return true if the shape fits, false otherwise
+	 */
+	bool DoesMaskFit(const FDieg_ShapeMask& Mask, const FIntPoint& Coordinates) const;
+
+	/**
+	 * @brief Counts the free cells to the right of a cell, the cell included.
+	 * 
+	 * @param Point The coordinates to start from
+	 * @return Number of consecutive free cells on the row, 0 if the cell is blocked or out of bounds
+	 */
+	int32 GetFreeRunRight(const FIntPoint& Point) const;
+
+	/**
+	 * @brief Counts the free cells below a cell, the cell included.
+	 * 
+	 * @param Point The coordinates to start from
+	 * @return Number of consecutive free cells on the column, 0 if the cell is blocked or out of bounds
+	 */
+	int32 GetFreeRunDown(const FIntPoint& Point) const;
+
+	/**
+	 * @brief Counts the edges of a placed shape that touch an occupied cell or the grid border.
+	 * 
+	 * Used to score placements by how tightly they pack against what is already there.
+	 * 
+	 * @param Mask The shape to score
+	 * @param Coordinates The placement coordinates the mask is relative to
+	 * @return Number of shape cell edges facing a blocked cell, 0 to 4 per shape cell
+	 */
+	int32 CountContactEdges(const FDieg_ShapeMask& Mask, const FIntPoint& Coordinates) const;
+
+	/**
+	 * @brief Gets the number of free cells in the grid.
+	 * 
+	 * @return Number of free cells, maintained incrementally
+	 */
+	int32 GetFreeCellCount() const { return FreeCells; }
+
+	/**
+	 * @brief Gets the longest run of free cells on any single row.
+	 * 
+	 * @return Length of the longest free run, maintained incrementally
+	 */
+	int32 GetLongestFreeRun() const;
+
+	/**
+	 * @brief Gets the largest free rectangle (by area) in the grid.
+	 * 
+	 * Recomputed lazily after the occupancy changed, in O(cells).
+	 * 
+	 * @return The largest free rectangle, empty if the grid is full
+	 */
+	FIntRect GetLargestFreeRect() const;
+
+	/**
+	 * @brief Gets every maximal free rectangle in the grid.
+	 * 
+	 * A free rectangle is maximal when it can't grow in any direction without covering
+	 * a blocked cell or leaving the grid. Every free rectangle is contained in at least
+	 * one of them, so a rectangular shape fits somewhere iff it fits in one of these.
+	 * Recomputed lazily after the occupancy changed.
+	 * 
+	 * @return The maximal free rectangles, empty if the grid is full
+	 */
+	const TArray<FIntRect>& GetMaximalFreeRects() const;
+
+	/**
+	 * @brief Cheap necessary test for whether a shape could fit somewhere in the grid.
+	 * 
+	 * Rejects masks that need more free cells, a longer free row run or, for
+	 * rectangular shapes, a larger free rectangle than the grid has. A true result
+	 * does not guarantee a placement exists.
+	 * 
+	 * @param Mask The shape to test
+	 * @return false if the shape can't fit anywhere, true if it might
+	 */
+	bool CouldEverFit(const FDieg_ShapeMask& Mask) const;
+
+	/**
+	 * @brief Gets the number of columns in the grid.
+	 *
+	 * @return Number of columns
+	 */
+	int32 GetColumns() const { return Columns; }
+
+	/**
+	 * @brief Gets the number of rows in the grid, including a partial last row.
+	 *
+	 * @return Number of rows
+	 */
+	int32 GetRows() const { return Rows; }
+
+	/**
+	 * @brief Gets the number of cells in the grid.
+	 *
+	 * @return Number of cells
+	 */
+	int32 GetNumCells() const { return NumCells; }
+
+private:
+	bool IsBitSet(const FIntPoint& Point) const
+	{
+		return (Words[Point.Y * WordsPerRow + (Point.X >> 6)] >> (Point.X & 63)) & 1ull;
+	}
+
+	/**
+	 * @brief Recomputes the longest free run of a row.
+	 */
+	void UpdateRowFreeRun(int32 Row);
+
+	/**
+	 * @brief Row-major blocked bits, WordsPerRow words per row. Padding bits are always set.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Occupancy Grid")
+	TArray<uint64> Words;
+
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Occupancy Grid")
+	int32 Columns{0};
+
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Occupancy Grid")
+	int32 Rows{0};
+
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Occupancy Grid")
+	int32 NumCells{0};
+
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Occupancy Grid")
+	int32 WordsPerRow{0};
+
+	/**
+	 * @brief Number of free cells.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Occupancy Grid")
+	int32 FreeCells{0};
+
+	/**
+	 * @brief Longest run of free cells on each row.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Occupancy Grid")
+	TArray<int32> RowFreeRuns;
+
+	/**
+	 * @brief Cached result of GetLargestFreeRect, valid while bLargestFreeRectDirty is false.
+	 */
+	mutable FIntRect LargestFreeRect;
+
+	mutable bool bLargestFreeRectDirty{true};
+
+	/**
+	 * @brief Cached result of GetMaximalFreeRects, valid while bMaximalFreeRectsDirty is false.
+	 */
+	mutable TArray<FIntRect> MaximalFreeRects;
+
+	mutable bool bMaximalFreeRectsDirty{true};
+};
@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Diegetic/UStructs/Dieg_OccupancyGrid.h"
+#include "Dieg_RotatedShape.generated.h"
+
+/**
+ * @brief One baked rotation of an item shape.
+ *
+ * FDieg_RotatedShape holds everything placement and presentation code needs
+ * about an item shape at a given rotation: the rotated cell offsets, the
+ * rotated root, the span and the packed bitmask used for fit tests.
+ *
+ * The cell offsets are exactly what UDieg_UtilityLibrary::Rotate2DArrayWithRoot
+ * produces for the shape, in the same order as the source shape, so a cell index
+ * in FDieg_ItemDefinition::DefaultShape is also valid in Cells.
+ *
+ * @note Instances are normally read from UDieg_ItemDefinitionDataAsset::GetRotatedShape
+ * rather than built on demand.
+ *
+ * @see UDieg_ItemDefinitionDataAsset
+ * @see FDieg_ShapeMask
+ *
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_RotatedShape
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief The rotation angle in degrees, one of 0, 90, 180 or -90.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Rotated Shape")
+	int32 Rotation{0};
+
+	/**
+	 * @brief Rotated cell offsets relative to the placement coordinates, in source shape order.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Rotated Shape")
+	TArray<FIntPoint> Cells;
+
+	/**
+	 * @brief Rotated shape root, relative to the placement coordinates.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Rotated Shape")
+	FIntPoint Root{0, 0};
+
+	/**
+	 * @brief Span of the rotated shape, as returned by UDieg_UtilityLibrary::GetShapeSpan.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Rotated Shape")
+	FIntPoint Span{0, 0};
+
+	/**
+	 * @brief Packed form of Cells used for fit tests against FDieg_OccupancyGrid.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Rotated Shape")
+	FDieg_ShapeMask Mask;
+
+	/**
+	 * @brief Bakes one rotation of a shape.
+	 *
+	 * @param Shape The unrotated shape cells
+	 * @param ShapeRoot The root point of the unrotated shape
+	 * @param InRotation The rotation angle in degrees
+	 * @return The baked rotation
+	 */
+	static FDieg_RotatedShape Build(const TArray<FIntPoint>& Shape, const FIntPoint& ShapeRoot, int32 InRotation);
+
+	/**
+	 * @brief Maps a rotation angle to its index in the 0, 90, 180, -90 rotation order.
+	 *
+	 * @param InRotation The rotation angle in degrees, any multiple of 90
+	 * @return Index in [0, 3]
+	 */
+	static int32 GetRotationIndex(float InRotation);
+};
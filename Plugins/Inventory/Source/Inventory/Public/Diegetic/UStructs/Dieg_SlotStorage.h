@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Diegetic/UStructs/Dieg_InventorySlot.h"
+#include "Dieg_SlotStorage.generated.h"
+
+class UDieg_ItemInstance;
+
+/**
+ * @brief One item placed in an FDieg_SlotStorage.
+ *
+ * Everything that is the same for every cell an item covers lives here once,
+ * instead of being repeated in each cell.
+ *
+ * @see FDieg_SlotStorage
+ *
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_StoredItem
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief The placed item instance, nullptr while the entry is on the free list.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	TObjectPtr<UDieg_ItemInstance> ItemInstance;
+
+	/**
+	 * @brief Grid index of the item's root cell.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	int32 RootIndex{INDEX_NONE};
+
+	/**
+	 * @brief Rotation as quarter turns in the 0, 90, 180, -90 order, see FDieg_RotatedShape::GetRotationIndex.
+	 */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	uint8 RotationIndex{0};
+
+	/**
+	 * @brief Rotation angle in degrees, one of 0, 90, 180 or -90.
+	 */
+	float GetRotation() const;
+};
+
+/**
+ * @brief Compact per-cell storage backing UDieg_InventoryComponent.
+ *
+ * Instead of one FDieg_InventorySlot per cell, the grid is kept as separate arrays:
+ * - a 4-byte item handle per cell, INDEX_NONE for empty cells
+ * - one FDieg_StoredItem per placed item, holding the instance, root index and rotation
+ * - one shared default tag container, plus tag sets referenced by index only for the
+ *   few cells whose tags differ from the default
+ *
+ * Scans over the grid only touch the handle array. FDieg_InventorySlot values are
+ * generated on demand by MakeSlot for Blueprint and for callers that want the old view.
+ *
+ * Cells are addressed by grid index, X + Y * Columns, the same order as
+ * UDieg_UtilityLibrary::GetSlotPoints.
+ *
+ * @see UDieg_InventoryComponent
+ * @see FDieg_InventorySlot
+ *
+ * @since 1.0
+ */
+USTRUCT()
+struct INVENTORY_API FDieg_SlotStorage
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Walks the placed items in handle order without allocating.
+	 *
+	 * Handles are stable while their item is placed, so the iterator can be kept in a
+	 * loop that only reads the storage. Adding or removing items invalidates it.
+	 *
+	 * @code
+	 * for (FDieg_SlotStorage::FItemIterator It = Storage.CreateItemIterator(); It; ++It)
+	 * {
+	 *     UseItem(It->ItemInstance, It.GetRootCoordinates(), It->GetRotation());
+	 * }
+	 * @endcode
+	 */
+	class FItemIterator
+	{
+	public:
+		explicit FItemIterator(const FDieg_SlotStorage& InStorage) : Storage(InStorage) { ++(*this); }
+
+		FItemIterator& operator++()
+		{
+			do
+			{
+				++Handle;
+			}
+			while (Handle < Storage.Items.Num() && !Storage.Items[Handle].ItemInstance);
+			return *this;
+		}
+
+		explicit operator bool() const { return Handle < Storage.Items.Num(); }
+		const FDieg_StoredItem& operator*() const { return Storage.Items[Handle]; }
+		const FDieg_StoredItem* operator->() const { return &Storage.Items[Handle]; }
+
+		int32 GetHandle() const { return Handle; }
+		FIntPoint GetRootCoordinates() const { return Storage.GetCoordinates(Storage.Items[Handle].RootIndex); }
+
+	private:
+		const FDieg_SlotStorage& Storage;
+		int32 Handle{INDEX_NONE};
+	};
+
+	/**
+	 * @brief Resets the storage to NumSlots empty cells sharing the given tags.
+	 *
+	 * @param NumSlots Total number of cells
+	 * @param NumColumns Number of columns in the grid
+	 * @param Tags Tags every cell starts with
+	 */
+	void Initialize(int32 NumSlots, int32 NumColumns, const FGameplayTagContainer& Tags);
+
+	int32 Num() const { return CellHandles.Num(); }
+	bool IsValidIndex(const int32 Index) const { return CellHandles.IsValidIndex(Index); }
+
+	/**
+	 * @brief Grid index of the given coordinates. Does not check bounds.
+	 */
+	int32 GetIndex(const FIntPoint& Coordinates) const { return Coordinates.X + Coordinates.Y * Columns; }
+
+	/**
+	 * @brief Coordinates of the given grid index.
+	 */
+	FIntPoint GetCoordinates(const int32 Index) const { return FIntPoint(Index % Columns, Index / Columns); }
+
+	/**
+	 * @brief Item handle stored in a cell, INDEX_NONE when the cell is empty.
+	 */
+	int32 GetHandle(const int32 Index) const { return CellHandles[Index]; }
+
+	bool IsOccupied(const int32 Index) const { return CellHandles[Index] != INDEX_NONE; }
+	bool IsRoot(const int32 Index) const { return IsOccupied(Index) && Items[CellHandles[Index]].RootIndex == Index; }
+
+	/**
+	 * @brief Item covering a cell, nullptr when the cell is empty.
+	 */
+	UDieg_ItemInstance* GetItem(const int32 Index) const;
+
+	/**
+	 * @brief Rotation of the item covering a cell, 0 when the cell is empty.
+	 */
+	float GetRotation(const int32 Index) const { return IsOccupied(Index) ? Items[CellHandles[Index]].GetRotation() : 0.0f; }
+
+	/**
+	 * @brief Placed item behind a handle.
+	 */
+	const FDieg_StoredItem& GetStoredItem(const int32 Handle) const { return Items[Handle]; }
+
+	/**
+	 * @brief Creates an iterator over the placed items.
+	 */
+	FItemIterator CreateItemIterator() const { return FItemIterator(*this); }
+
+	/**
+	 * @brief Number of placed items.
+	 */
+	int32 NumItems() const { return Items.Num() - FreeHandles.Num(); }
+
+	/**
+	 * @brief Handle of a placed item instance, INDEX_NONE if it is not placed. Linear in the number of items.
+	 */
+	int32 FindHandle(const UDieg_ItemInstance* ItemInstance) const;
+
+	/**
+	 * @brief Registers a placed item and returns its handle. Cells are assigned separately with SetCell.
+	 *
+	 * Handles of removed items are reused, so a handle stays valid exactly as long as its item is placed.
+	 */
+	int32 AddItem(UDieg_ItemInstance* ItemInstance, int32 RootIndex, float Rotation);
+
+	/**
+	 * @brief Releases a handle. Its cells should already have been cleared with SetCell.
+	 */
+	void RemoveItem(int32 Handle);
+
+	/**
+	 * @brief Points a cell at an item handle, or clears it with INDEX_NONE.
+	 */
+	void SetCell(const int32 Index, const int32 Handle) { CellHandles[Index] = Handle; }
+
+	/**
+	 * @brief Tags of a cell, the shared default unless the cell has its own set.
+	 */
+	const FGameplayTagContainer& GetTags(int32 Index) const;
+
+	/**
+	 * @brief Gives a cell its own tags. Identical tag sets are shared, and setting the default drops the override.
+	 */
+	void SetTags(int32 Index, const FGameplayTagContainer& Tags);
+
+	/**
+	 * @brief Builds the FDieg_InventorySlot view of a cell.
+	 *
+	 * @param Index Grid index of the cell
+	 * @return The slot as it would have been stored per cell
+	 */
+	FDieg_InventorySlot MakeSlot(int32 Index) const;
+
+	/**
+	 * @brief Heap memory owned by the storage, in bytes.
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	/** Item handle per cell, INDEX_NONE when empty. */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	TArray<int32> CellHandles;
+
+	/** Placed items, indexed by handle. Entries listed in FreeHandles are unused. */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	TArray<FDieg_StoredItem> Items;
+
+	/** Handles of removed items, reused before Items grows. */
+	UPROPERTY()
+	TArray<int32> FreeHandles;
+
+	/** Tags shared by every cell without an override. */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	FGameplayTagContainer DefaultTags;
+
+	/** Distinct non-default tag sets. */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	TArray<FGameplayTagContainer> TagSets;
+
+	/** Grid index to TagSets index, only for cells that differ from DefaultTags. */
+	UPROPERTY(VisibleAnywhere, Category = "Game|Dieg|Slot Storage")
+	TMap<int32, int32> CellTagSets;
+
+	UPROPERTY()
+	int32 Columns{1};
+};
@@ -7,9 +7,14 @@
 #include "Dieg_Grid.generated.h"
 
 enum class EDieg_SlotStatus : uint8;
+class SDieg_GridStatusLayer;
 class UCanvasPanel;
 class UDieg_Slot;
 class UGridPanel;
+class UImage;
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+class UTexture2D;
 
 /**
  * @brief Delegate fired when a slot in the grid is hovered.
@@ -83,6 +88,53 @@ public:
 	UPROPERTY(meta = (BindWidget, AllowPrivateAccess = "true"))
 	TObjectPtr<UGridPanel> GridPanel;
 
+	/**
+	 * @brief Whether the grid draws the status of every slot in one pass.
+	 * 
+	 * When enabled, slot colors are no longer applied to each slot's Image_Fill. The
+	 * grid keeps one texel per slot in StatusTexture instead and only uploads the
+	 * rectangle that changed, once per tick, so hovering or dragging over a large grid
+	 * costs one texture update rather than one widget invalidation per slot. The
+	 * texture is drawn natively under GridPanel, or through Image_StatusOverlay when
+	 * a widget blueprint binds it with a StatusMaterial.
+	 * 
+	 * @see IsStatusBatched
+	 * @see Image_StatusOverlay
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game|Dieg|Grid|Status Rendering", meta = (AllowPrivateAccess = "true"))
+	bool bBatchSlotStatus{true};
+
+	/**
+	 * @brief Optional image drawing the status texture through StatusMaterial.
+	 * 
+	 * Only needed for a custom look, batching works without it. When bound and
+	 * StatusMaterial is set, the texture is drawn by this image instead of natively.
+	 * Place it over or under GridPanel, it is sized to match the slots.
+	 * 
+	 * @see StatusMaterial
+	 * @see bBatchSlotStatus
+	 */
+	UPROPERTY(meta = (BindWidgetOptional, AllowPrivateAccess = "true"))
+	TObjectPtr<UImage> Image_StatusOverlay;
+
+	/**
+	 * @brief Material drawn by Image_StatusOverlay.
+	 * 
+	 * Must sample the texture parameter named StatusTextureParameterName at the
+	 * widget's UVs; each texel holds the fill color of one slot, transparent for
+	 * cells past TotalSlots.
+	 * 
+	 * @see Image_StatusOverlay
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game|Dieg|Grid|Status Rendering", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UMaterialInterface> StatusMaterial;
+
+	/**
+	 * @brief Texture parameter of StatusMaterial receiving the per-slot status texture.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Game|Dieg|Grid|Status Rendering", meta = (AllowPrivateAccess = "true"))
+	FName StatusTextureParameterName{TEXT("StatusTexture")};
+
 	/**
 	 * @brief Total number of slots in the grid.
 	 * 
@@ -119,28 +171,40 @@ public:
 	TSubclassOf<UDieg_Slot> SlotClass;
 	
 	/**
-	 * @brief Map of grid coordinates to slot widget instances.
+	 * @brief Slot widget instances, indexed by UDieg_UtilityLibrary::GetIndexFromPosition.
 	 * 
-	 * This map stores all the slot widgets indexed by their grid coordinates.
-	 * It's used for efficient lookup and management of individual slots.
+	 * Slots fill the grid row by row, so the array is dense and a coordinate
+	 * lookup is a bounds check and an index.
+	 * 
+	 * @see UDieg_Slot
+	 * @see FindSlot
+	 * @see GetSlots
+	 */
+	UPROPERTY(VisibleInstanceOnly, Category = "Game|Dieg|Grid|Diegetic Inventory", meta = (AllowPrivateAccess = "true"))
+	TArray<TObjectPtr<UDieg_Slot>> Slots;
+
+	/**
+	 * @brief Map of grid coordinates to slot widget instances, for Blueprints.
+	 * 
+	 * Built once with the slots in CreateEmptyGrid. C++ callers should use
+	 * FindSlot or GetSlots instead.
 	 * 
 	 * @see UDieg_Slot
-	 * @see GetSlotMap
 	 * @see GetSlotMapBP
 	 */
 	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Game|Dieg|Grid|Diegetic Inventory", meta = (AllowPrivateAccess = "true"))
 	TMap<FIntPoint, TObjectPtr<UDieg_Slot>> SlotMap;
 
 	/**
-	 * @brief Set of coordinates that are currently being hovered.
+	 * @brief Coordinates that are currently being hovered.
 	 * 
 	 * Tracks which slots are currently under the mouse cursor for visual
-	 * feedback and interaction purposes.
+	 * feedback and interaction purposes. Item shapes are small, so this is
+	 * an inline array searched linearly rather than a hashed set.
 	 * 
-	 * @see UpdateHoveringSlots
+	 * @see UpdateHoveringCoordinates
 	 */
-	UPROPERTY(EditInstanceOnly, BlueprintReadOnly, Category = "Game|Dieg|Grid|Diegetic Inventory", meta = (AllowPrivateAccess = "true"))
-	TSet<FIntPoint> SlotsHoveredSet;
+	TArray<FIntPoint, TInlineAllocator<16>> HoveredCoordinates;
 
 	/**
 	 * @brief Enable debug visualization in the design-time editor.
@@ -151,6 +215,28 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Grid|Diegetic Inventory", meta = (AllowPrivateAccess = "true"))
 	bool bDebugDesignTimeEditor{false};
 
+	/**
+	 * @brief Only create slot widgets for the cells in view, for very large grids.
+	 * 
+	 * Requires status batching (bBatchSlotStatus), since the status texture draws
+	 * every cell and gives the grid its size. Slot widgets
+	 * are then created for the visible cells plus VirtualizationMargin, recycled as
+	 * the view scrolls, and hover and clicks are routed to them from the pointer
+	 * position. GridPanel must sit at the top left of the grid, it is offset to the
+	 * first visible cell. Ignored at design time.
+	 * 
+	 * @see IsSlotsVirtualized
+	 * @see FindSlot
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Grid|Virtualization", meta = (AllowPrivateAccess = "true"))
+	bool bVirtualizeSlots{false};
+
+	/**
+	 * @brief Cells realized around the visible ones on each side, so scrolling doesn't show missing slots.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Game|Dieg|Grid|Virtualization", meta = (AllowPrivateAccess = "true", ClampMin = "0"))
+	int32 VirtualizationMargin{2};
+
 	/**
 	 * @brief Called before the widget is constructed.
 	 * 
@@ -174,29 +260,36 @@ public:
 	void CreateEmptyGrid(int32 TotalSlots_, int32 MaxColumns_);
 	
 	/**
-	 * @brief Gets the slot map (C++ only).
+	 * @brief Finds the slot widget at the given grid coordinates (C++ only).
 	 * 
-	 * Returns a reference to the slot map for efficient access and modification.
+	 * @param Coordinates Grid coordinates, X being the column
+	 * @return The slot, or nullptr if the coordinates are outside the grid or, when virtualized, out of view
 	 * 
-	 * @return Reference to the slot map
+	 * @see Slots
+	 */
+	UDieg_Slot* FindSlot(const FIntPoint& Coordinates) const;
+
+	/**
+	 * @brief Gets every slot widget (C++ only).
 	 * 
-	 * @see GetSlotMapBP
-	 * @see SlotMap
+	 * @return View of the slots in row-major order, valid until the grid is rebuilt
+	 * 
+	 * @see Slots
 	 */
-	TMap<FIntPoint, UDieg_Slot*>& GetSlotMap();
+	TConstArrayView<TObjectPtr<UDieg_Slot>> GetSlots() const { return Slots; }
 	
 	/**
 	 * @brief Gets the slot map (Blueprint compatible).
 	 * 
-	 * Blueprint-compatible version that returns the slot map by value.
+	 * Returns the map cached when the grid was created instead of rebuilding it per call.
 	 * 
 	 * @return Copy of the slot map
 	 * 
-	 * @see GetSlotMap
+	 * @see FindSlot
 	 * @see SlotMap
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Grid")
-	TMap<FIntPoint, UDieg_Slot*> GetSlotMapBP();
+	TMap<FIntPoint, UDieg_Slot*> GetSlotMapBP() const { return ObjectPtrDecay(SlotMap); }
 
 	/**
 	 * @brief Delegate fired when a slot is hovered.
@@ -248,12 +341,26 @@ public:
 	 * @param NewStatus The status to apply to the new coordinates
 	 * @param ResetStatus The status to apply to previously hovered slots
 	 * 
-	 * @see SlotsHoveredSet
+	 * @see HoveredCoordinates
 	 * @see EDieg_SlotStatus
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Grid")
 	void UpdateHoveringSlots(const TArray<FIntPoint>& NewCoordinates, EDieg_SlotStatus NewStatus, EDieg_SlotStatus ResetStatus);
 
+	/**
+	 * @brief Native version of UpdateHoveringSlots.
+	 * 
+	 * Takes a view so callers can pass inline arrays without converting them,
+	 * keeping the per-hover update free of heap allocations.
+	 * 
+	 * @param NewCoordinates Coordinates to set to the new status
+	 * @param NewStatus The status to apply to the new coordinates
+	 * @param ResetStatus The status to apply to previously hovered slots
+	 * 
+	 * @see UpdateHoveringSlots
+	 */
+	void UpdateHoveringCoordinates(TConstArrayView<FIntPoint> NewCoordinates, EDieg_SlotStatus NewStatus, EDieg_SlotStatus ResetStatus);
+
 	/**
 	 * @brief Modifies the appearance of all slots in the grid.
 	 * 
@@ -269,7 +376,173 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Grid")
 	void ModifyAllSlotsAppearance(bool IsAppearanceLocked, bool Override, EDieg_SlotStatus OverrideStatus);
 
+	/**
+	 * @brief Whether slot statuses are drawn from the status texture instead of each slot's own image.
+	 * 
+	 * @see bBatchSlotStatus
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Grid")
+	bool IsStatusBatched() const { return IsValid(StatusTexture); }
+
+	/**
+	 * @brief Writes the status color of one slot into the status texture.
+	 * 
+	 * The change is uploaded together with every other change of the frame on the next tick.
+	 * Does nothing unless IsStatusBatched.
+	 * 
+	 * @param Coordinates Grid coordinates of the slot
+	 * @param Status The status to draw
+	 */
+	void SetCellStatus(const FIntPoint& Coordinates, EDieg_SlotStatus Status);
+
+	/**
+	 * @brief Whether only the slots in view have widgets.
+	 * 
+	 * @see bVirtualizeSlots
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Grid")
+	bool IsSlotsVirtualized() const { return bSlotsVirtualized; }
+
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
+	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void BeginDestroy() override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
 private:
+	/**
+	 * @brief Native drawing of the status texture under the grid content, when Image_StatusOverlay isn't used.
+	 */
+	TSharedPtr<SDieg_GridStatusLayer> StatusLayer;
+
+
+	/**
+	 * @brief Status of every cell, row-major, including cells without a slot widget when virtualized.
+	 */
+	TArray<EDieg_SlotStatus> CellStatuses;
+
+	/**
+	 * @brief Last value given to ModifyAllSlotsAppearance, applied to slots realized later.
+	 */
+	bool bAllSlotsAppearanceLocked{false};
+
+	/**
+	 * @brief Whether the current grid was built virtualized.
+	 * 
+	 * @see bVirtualizeSlots
+	 */
+	bool bSlotsVirtualized{false};
+
+	/**
+	 * @brief Slot widgets out of view, kept for reuse.
+	 */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UDieg_Slot>> SlotPool;
+
+	/**
+	 * @brief Cells that have a slot widget when virtualized, inclusive min and exclusive max.
+	 */
+	FIntRect RealizedCells;
+
+	/**
+	 * @brief Cell under the pointer when virtualized, INDEX_NONE when the pointer is off the grid.
+	 */
+	FIntPoint PointerCell{INDEX_NONE, INDEX_NONE};
+
+	/**
+	 * @brief Size of one cell in the grid's local space, from the slot class.
+	 */
+	FVector2D CellSize{100.0f, 100.0f};
+
+	/**
+	 * @brief Slot widgets created by this grid, alive or pooled.
+	 */
+	int32 NumSlotWidgets{0};
+
+	/**
+	 * @brief One texel per slot, row-major, holding the slot's fill color.
+	 */
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> StatusTexture;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> StatusMaterialInstance;
+
+	/**
+	 * @brief CPU copy of StatusTexture, written by SetCellStatus and uploaded by FlushStatusTexture.
+	 */
+	TArray<FColor> StatusTexels;
+
+	/**
+	 * @brief Size of StatusTexture, columns by rows.
+	 */
+	FIntPoint StatusTextureSize{0, 0};
+
+	/**
+	 * @brief Fill color of each status, indexed by EDieg_SlotStatus, cached from the slot class.
+	 */
+	TArray<FColor> StatusColors;
+
+	/**
+	 * @brief Texels changed since the last upload, inclusive min and exclusive max.
+	 */
+	FIntRect DirtyStatusRect;
+
+	/**
+	 * @brief Creates the status texture for the current grid size and hands it to whatever draws it.
+	 */
+	void CreateStatusTexture();
+
+	/**
+	 * @brief Sets the status of a slot, writing the status texture when batched instead of calling into the slot widget.
+	 */
+	void ApplySlotStatus(const FIntPoint& Coordinates, EDieg_SlotStatus Status);
+
+	/**
+	 * @brief Cells visible through the clipping ancestors of the grid, plus VirtualizationMargin.
+	 */
+	FIntRect ComputeVisibleCells(const FGeometry& MyGeometry) const;
+
+	/**
+	 * @brief Gives a slot widget to every cell of the new rect, recycling the ones that went out of it.
+	 */
+	void UpdateRealizedCells(const FIntRect& NewRealizedCells);
+
+	/**
+	 * @brief Gives a cell a slot widget from the pool, or a new one, placed relative to RealizedCells.
+	 */
+	void RealizeSlot(const FIntPoint& Coordinates);
+
+	/**
+	 * @brief Takes the slot widget off a cell and returns it to the pool.
+	 */
+	void ReleaseSlot(const FIntPoint& Coordinates);
+
+	/**
+	 * @brief Cell under a screen position, INDEX_NONE if it is off the grid.
+	 */
+	FIntPoint GetCellAtPosition(const FGeometry& InGeometry, const FVector2D& ScreenPosition) const;
+
+	/**
+	 * @brief Sends leave and enter events to the slots when the pointer moves to another cell.
+	 */
+	void RoutePointerToCell(const FIntPoint& Cell, const FPointerEvent& InMouseEvent);
+
+	/**
+	 * @brief Creates a slot widget bound to this grid, not yet placed.
+	 */
+	UDieg_Slot* CreateSlotWidget();
+
+	/**
+	 * @brief Uploads DirtyStatusRect to the status texture as a single region.
+	 */
+	void FlushStatusTexture();
+
 	/**
 	 * @brief Creates a new slot widget at the specified coordinates.
 	 * 
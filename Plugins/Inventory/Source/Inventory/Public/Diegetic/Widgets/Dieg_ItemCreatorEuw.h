@@ -86,6 +86,7 @@ public:
 
 	virtual void NativePreConstruct() override;
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 	UFUNCTION(BlueprintCallable, Category = "Game|Dieg|Item Creator EUW")
 	void SetupGrid(int32 GridSize) const;
@@ -107,6 +108,9 @@ public:
 	UPROPERTY(EditInstanceOnly, Category = "Game|Dieg|Item Creator EUW|Properties")
 	TObjectPtr<UStaticMesh> Property_StaticMesh;
 
+	// Mesh of the selected data asset while it streams in; saved in place of an empty Property_StaticMesh.
+	TSoftObjectPtr<UStaticMesh> PendingStaticMesh;
+
 	// To bind to SinglePropertyView it caches its variable name. 
 	UPROPERTY(EditInstanceOnly, Category = "Game|Dieg|Item Creator EUW|Properties")
 	int32 Property_MaxQuantity;
@@ -161,4 +165,9 @@ private:
 
 	UFUNCTION(Category = "Game|Dieg|Item Creator EUW")
 	void HandleSpinBoxGridSizeChange(float InValue);
+
+	void HandleStaticMeshStreamed(TSoftObjectPtr<UStaticMesh> StaticMesh);
+
+	// The mesh to save, falling back to the one still streaming in.
+	TSoftObjectPtr<UStaticMesh> GetStaticMeshToSave() const;
 };
@@ -3,9 +3,16 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogInventory, Log, All);	
 
+DECLARE_STATS_GROUP(TEXT("Diegetic Inventory"), STATGROUP_DiegInventory, STATCAT_Advanced);
+
+// Synchronous line traces fired by the player's components, shared so batched and unbatched runs compare
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sync Trace Time"), STAT_Dieg_SyncTraceTime, STATGROUP_DiegInventory, INVENTORY_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sync Traces"), STAT_Dieg_SyncTraces, STATGROUP_DiegInventory, INVENTORY_API);
+
 class FInventoryModule : public IModuleInterface
 {
 public:
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "InventoryManagment/Containers/BPF_FastArray.h"
+#include "InventoryManagment/Containers/F_PlugInv_GridModel.h"
 #include "AC_PlugInv_InventoryComponent.generated.h"
 
 class UPlugInv_ItemComponent;
@@ -39,13 +40,22 @@ public:
 	UFUNCTION(Server, Reliable, Category = "Inventory")
 	void Server_AddStacksToItem(UPlugInv_ItemComponent* ItemComponent, int32 StackCount, int32 Remainder);
 
-	// Server RPC (Client->Server).
+	// Server RPCs (Client->Server), stacks still in the grid are taken from the placement covering GridIndex first.
 	UFUNCTION(Server, Reliable, Category = "Inventory")
-	void Server_DropItem(UPlugInv_InventoryItem* Item, int32 StackCount);
+	void Server_DropItem(UPlugInv_InventoryItem* Item, int32 StackCount, int32 GridIndex);
 
-	// Server RPC (Client->Server).
 	UFUNCTION(Server, Reliable, Category = "Inventory")
-	void Server_ConsumeItem(UPlugInv_InventoryItem* Item);
+	void Server_ConsumeItem(UPlugInv_InventoryItem* Item, int32 GridIndex);
+
+	// Server RPCs (Client->Server) mirroring grid edits made through the widgets.
+	UFUNCTION(Server, Reliable)
+	void Server_PlaceGridItem(UPlugInv_InventoryItem* Item, int32 Index, int32 StackCount);
+
+	UFUNCTION(Server, Reliable)
+	void Server_RemoveGridItem(EPlugInv_ItemCategory Category, int32 Index);
+
+	UFUNCTION(Server, Reliable)
+	void Server_SetGridStackCount(EPlugInv_ItemCategory Category, int32 Index, int32 StackCount);
 
 	UFUNCTION(Server, Reliable)
 	void Server_EquipSlotClicked(UPlugInv_InventoryItem* ItemToEquip, UPlugInv_InventoryItem* ItemToUnequip);
@@ -62,6 +72,27 @@ public:
 	void SpawnDroppedItem(UPlugInv_InventoryItem* Item, int32 StackCount) const;
 
 	UPlugInv_InventoryBase* GetInventoryMenu() const { return InventoryMenu; }
+
+	// Where an item would go in the grid model of its category, no widget involved so it also runs on a dedicated server.
+	FPlugInv_SlotAvailabilityResult HasRoomForItem(const FPlugInv_ItemManifest& ItemManifest, const int32 StackAmountOverride = -1) const;
+
+	// Grid model of a category, null if the category has no grid.
+	const FPlugInv_GridModel* GetGridModel(const EPlugInv_ItemCategory Category) const { return GridModels.Find(Category); }
+
+	// Sizes the grid model of a category from its widget when GridDimensions doesn't configure it.
+	void RegisterGrid(const EPlugInv_ItemCategory Category, const int32 Rows, const int32 Columns);
+
+	// Grid edits made by the widgets, applied locally and forwarded to the server.
+	void PlaceGridItem(UPlugInv_InventoryItem* Item, const int32 Index, const int32 StackCount);
+	void RemoveGridItem(const EPlugInv_ItemCategory Category, const int32 Index);
+	void SetGridStackCount(const EPlugInv_ItemCategory Category, const int32 Index, const int32 StackCount);
+
+	// Drops or consumes stacks of an item, the grid model is updated locally and on the server.
+	void DropItem(UPlugInv_InventoryItem* Item, const int32 StackCount, const int32 GridIndex = INDEX_NONE);
+	void ConsumeItem(UPlugInv_InventoryItem* Item, const int32 GridIndex);
+
+	// Places a newly added item in the grid model of its category, unless a grid edit already placed it.
+	void AddItemToGridModel(UPlugInv_InventoryItem* Item, const int32 StackCount);
 	
 	// CRUD Events.
 	FInventoryItemChange OnItemAdded;
@@ -90,6 +121,29 @@ private:
 	// Weak ptr holding a ref back to player without affecting GB (Garbage Collection).
 	TWeakObjectPtr<APlayerController> OwningPlayerController;
 
+	// Grid size (columns, rows) per item category, the grid widgets of a category must match it.
+	// Required on dedicated servers, where no widget is around to register its size. Defaults to 8x6 for every category.
+	UPROPERTY(EditAnywhere, Category = "Inventory")
+	TMap<EPlugInv_ItemCategory, FIntPoint> GridDimensions;
+
+	// Spatial state per category, computed on the server and mirrored on the owning client.
+	TMap<EPlugInv_ItemCategory, FPlugInv_GridModel> GridModels;
+
+	// Creates the grid models configured in GridDimensions.
+	void ConstructGridModels();
+
+	// Applies a grid edit to the local model, warns when the model rejects it.
+	void ApplyPlaceGridItem(UPlugInv_InventoryItem* Item, const int32 Index, const int32 StackCount);
+	void ApplyRemoveGridItem(const EPlugInv_ItemCategory Category, const int32 Index);
+	void ApplySetGridStackCount(const EPlugInv_ItemCategory Category, const int32 Index, const int32 StackCount);
+
+	// Takes stacks off the placements of an item until they hold at most TotalStackCount, removes them all at 0.
+	// Stacks come from the placement covering PreferredIndex first, then from the last placements.
+	void TrimGridPlacements(UPlugInv_InventoryItem* Item, const int32 TotalStackCount, const int32 PreferredIndex = INDEX_NONE);
+
+	// Clamps a stack count sent by a client to what a placement of the item at Index can hold.
+	int32 ClampGridStackCount(const FPlugInv_GridModel& GridModel, const UPlugInv_InventoryItem* Item, const int32 Index, const int32 StackCount) const;
+
 	// Inventory menu widget class.
 	UPROPERTY(EditAnywhere, Category = "Inventory")
 	TSubclassOf<UPlugInv_InventoryBase> InventoryMenuClass;
@@ -3,12 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Net/Serialization/FastArraySerializer.h"
 
 #include "BPF_FastArray.generated.h"
 
-struct FGameplayTag;
 class UPlugInv_InventoryComponent;
 class UPlugInv_InventoryItem;
 class UPlugInv_ItemComponent;
@@ -78,18 +78,38 @@ struct FPlugInv_InventoryFastArray : public FFastArraySerializer
 	// Adds an entry to the container accepting an Inventory Item.
 	TObjectPtr<UPlugInv_InventoryItem> AddEntry(TObjectPtr<UPlugInv_InventoryItem> Item);
 
-	// Removes an entry from the container.
+	// Removes an entry from the container, the last entry takes its place.
 	void RemoveEntry(TObjectPtr<UPlugInv_InventoryItem> Item);
 
 	// Return the first Item by type
 	TObjectPtr<UPlugInv_InventoryItem> FindFirstItemByType(const FGameplayTag& ItemType);
+
+	// Whether an Item has an entry in the container.
+	bool Contains(const UPlugInv_InventoryItem* Item) const;
 private:
 	friend UPlugInv_InventoryComponent;
 
+	// Lookup index upkeep, by entry index.
+	void IndexEntry(const int32 EntryIndex) const;
+	void UnindexEntry(const int32 EntryIndex) const;
+	void RemapEntry(const int32 FromIndex, const int32 ToIndex) const;
+
+	// Rebuilds the lookup indices when replication reordered the entries.
+	void RebuildIndicesIfStale() const;
+
 	// Container of entries.
 	UPROPERTY(VisibleAnywhere, Category = "Inventory")
 	TArray<FPlugInv_InventoryItemEntry> Entries;
 
+	// Entry indices per item type, in the order the entries were added.
+	mutable TMap<FGameplayTag, TArray<int32, TInlineAllocator<2>>> EntryIndicesByType;
+
+	// Entry index per item.
+	mutable TMap<const UPlugInv_InventoryItem*, int32> EntryIndexByItem;
+
+	// Set when replicated removals moved entries around, cleared by the next rebuild.
+	mutable bool bIndicesStale{false};
+
 	// Reference to the owner component, doesn't need to be replicated.
 	UPROPERTY(VisibleAnywhere, NotReplicated, Category = "Inventory")
 	TObjectPtr<UActorComponent> OwnerComponent;
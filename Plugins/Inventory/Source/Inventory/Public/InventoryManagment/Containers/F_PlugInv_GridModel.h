@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BPF_PlugInv_DataLibrary.h"
+
+#include "F_PlugInv_GridModel.generated.h"
+
+class UPlugInv_InventoryItem;
+struct FPlugInv_ItemManifest;
+
+/** One item placed in a grid model, a stackable item may be placed several times **/
+USTRUCT()
+struct FPlugInv_GridPlacement
+{
+	GENERATED_BODY()
+
+	// Placed item, null while the entry is on the free list.
+	TWeakObjectPtr<UPlugInv_InventoryItem> Item;
+
+	// Index of the upper left cell.
+	int32 UpperLeftIndex{INDEX_NONE};
+
+	// Cells covered, columns by rows.
+	FIntPoint Dimensions{1, 1};
+
+	// Stacks held by this placement, 0 for non stackable items.
+	int32 StackCount{0};
+};
+
+/**
+ * The spatial state of one category grid, without any widget.
+ * Each cell holds a placement handle, occupied cells are also kept in a bitmask so free space checks
+ * don't touch the placements. The inventory component owns one per category and computes placements
+ * with it on the server; the grid widgets only draw what it holds.
+ */
+USTRUCT()
+struct INVENTORY_API FPlugInv_GridModel
+{
+	GENERATED_BODY()
+
+	// Resets the model to an empty grid.
+	void Initialize(EPlugInv_ItemCategory InCategory, int32 InRows, int32 InColumns);
+
+	bool IsInitialized() const { return Rows > 0 && Columns > 0; }
+	EPlugInv_ItemCategory GetCategory() const { return Category; }
+	int32 GetRows() const { return Rows; }
+	int32 GetColumns() const { return Columns; }
+	int32 Num() const { return CellPlacements.Num(); }
+
+	// Where an item would go: stacks into placements of the same type first, then free cells, in index order.
+	FPlugInv_SlotAvailabilityResult HasRoomForItem(const FPlugInv_ItemManifest& ItemManifest, const int32 StackAmountOverride = -1) const;
+
+	// Claims the cells and stacks of a HasRoomForItem result for an item.
+	void ApplyResult(const FPlugInv_SlotAvailabilityResult& Result, UPlugInv_InventoryItem* Item);
+
+	// Places an item with its upper left cell at Index, fails if a cell is out of bounds or taken.
+	bool PlaceItem(UPlugInv_InventoryItem* Item, const int32 Index, const FIntPoint& Dimensions, const int32 StackCount);
+
+	// Frees the cells of the placement covering Index.
+	bool RemoveItemAt(const int32 Index);
+
+	// Sets the stacks of the placement covering Index.
+	bool SetStackCount(const int32 Index, const int32 StackCount);
+
+	bool IsOccupied(const int32 Index) const { return Occupied.IsValidIndex(Index) && Occupied[Index]; }
+	bool IsInGridBounds(const int32 StartIndex, const FIntPoint& Dimensions) const;
+
+	// Item, upper left index and stacks of the placement covering Index, null / INDEX_NONE / 0 when empty.
+	UPlugInv_InventoryItem* GetItemAt(const int32 Index) const;
+	int32 GetUpperLeftIndex(const int32 Index) const;
+	int32 GetStackCount(const int32 Index) const;
+
+	// Upper left indices of every placement of an item, in index order.
+	void GetItemPlacements(const UPlugInv_InventoryItem* Item, TArray<int32>& OutIndices) const;
+
+private:
+	// Placement covering Index, null when empty.
+	const FPlugInv_GridPlacement* FindPlacement(const int32 Index) const;
+
+	// Cells covered by a placement, by row, for placements known to be in bounds.
+	template<typename FuncT>
+	void ForEachCell(const int32 StartIndex, const FIntPoint& Dimensions, const FuncT& Function) const
+	{
+		for (int32 Row = 0; Row < Dimensions.Y; ++Row)
+		{
+			const int32 RowStart = StartIndex + Row * Columns;
+			for (int32 Column = 0; Column < Dimensions.X; ++Column)
+			{
+				Function(RowStart + Column);
+			}
+		}
+	}
+
+	EPlugInv_ItemCategory Category{EPlugInv_ItemCategory::None};
+	int32 Rows{0};
+	int32 Columns{0};
+
+	// One bit per cell, set when the cell is covered by a placement.
+	TBitArray<> Occupied;
+
+	// Placement handle per cell, INDEX_NONE when empty.
+	TArray<int32> CellPlacements;
+
+	// Placements by handle, entries listed in FreePlacements are unused.
+	TArray<FPlugInv_GridPlacement> Placements;
+
+	// Handles of removed placements, reused before Placements grows.
+	TArray<int32> FreePlacements;
+};
@@ -7,6 +7,7 @@
 #include "Items/Manifest/F_PlugInv_ItemManifest.h"
 #include "AC_PlugInv_ItemComponent.generated.h"
 
+class UPlugInv_ItemDefinition;
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent), Blueprintable)
 class INVENTORY_API UPlugInv_ItemComponent : public UActorComponent
@@ -19,9 +20,14 @@ public:
 
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
 
+	// Takes the manifest by value so callers handing over a temporary move it in.
 	void InitItemManifest(FPlugInv_ItemManifest CopyOfManifest);
-	// Manifest Getter.
-	FPlugInv_ItemManifest GetItemManifest() const
+	// Manifest Getters.
+	const FPlugInv_ItemManifest& GetItemManifest() const
+	{
+		return ItemManifest;
+	}
+	FPlugInv_ItemManifest& GetItemManifestMutable()
 	{
 		return ItemManifest;
 	}
@@ -34,6 +40,8 @@ public:
 
 	void PickUp();
 protected:
+	virtual void BeginPlay() override;
+
 	UFUNCTION(BlueprintImplementableEvent, Category = "Inventory")
 	void OnPickUp();
 private:
@@ -42,6 +50,10 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Inventory", Replicated)
 	FPlugInv_ItemManifest ItemManifest;
 
+	// Optional definition asset, replaces ItemManifest when set so inventory items can replicate compactly.
+	UPROPERTY(EditAnywhere, Category = "Inventory")
+	TObjectPtr<UPlugInv_ItemDefinition> ItemDefinition;
+
 	// The Pickup message when hovering onto the owning actor.
 	UPROPERTY(EditAnywhere, Category = "Inventory")
 	FString PickupMessage;
@@ -42,6 +42,13 @@ struct INVENTORY_API FPlugInv_ItemFragment
 
 	virtual void Manifest() {}
 
+	// Values rolled on manifest, in fragment order. Compact replication sends these next to the item definition.
+	virtual void CaptureRolledValues(TArray<float>& OutValues) const {}
+	virtual void RestoreRolledValues(const TArray<float>& Values, int32& InOutIndex) {}
+
+	// Whether every item needs its own copy, items made from a definition share the fragments without instance state.
+	virtual bool HasInstanceState() const { return false; }
+
 	const FGameplayTag& GetFragmentTag() const
 	{
 		return FragmentTag;
@@ -94,6 +101,9 @@ struct FPlugInv_LabeledNumberFragment : public FPlugInv_InventoryItemFragment
 
 	virtual void Assimilate(UPlugInv_CompositeBase* Composite) const override;
 	virtual void Manifest() override;
+	virtual void CaptureRolledValues(TArray<float>& OutValues) const override;
+	virtual void RestoreRolledValues(const TArray<float>& Values, int32& InOutIndex) override;
+	virtual bool HasInstanceState() const override { return true; }
 	float GetValue() const { return Value; }
 	// When manifesting for the first time, this fragment will randomize. However, onee equipped
 	// and dropped, an item should retain the same value, so randomization should not occur.
@@ -188,6 +198,8 @@ struct FPlugInv_StackableFragment : public FPlugInv_ItemFragment
 {
 	GENERATED_BODY()
 
+	virtual bool HasInstanceState() const override { return true; }
+
 	int32 GetMaxStackSize() const
 	{
 		return MaxStackSize;
@@ -233,6 +245,9 @@ struct FPlugInv_ConsumableFragment : public FPlugInv_InventoryItemFragment
 	virtual void OnConsume(APlayerController* PC);
 	virtual void Assimilate(UPlugInv_CompositeBase* Composite) const override;
 	virtual void Manifest() override;
+	virtual void CaptureRolledValues(TArray<float>& OutValues) const override;
+	virtual void RestoreRolledValues(const TArray<float>& Values, int32& InOutIndex) override;
+	virtual bool HasInstanceState() const override { return true; }
 
 private:
 	UPROPERTY(EditAnywhere, Category = "Inventory", meta = (ExcludeBaseStruct))
@@ -285,6 +300,9 @@ struct FPlugInv_EquipmentFragment : public FPlugInv_InventoryItemFragment
 	void OnUnequip(APlayerController* PC);
 	virtual void Assimilate(UPlugInv_CompositeBase* Composite) const override;
 	virtual void Manifest() override;
+	virtual void CaptureRolledValues(TArray<float>& OutValues) const override;
+	virtual void RestoreRolledValues(const TArray<float>& Values, int32& InOutIndex) override;
+	virtual bool HasInstanceState() const override { return true; }
 	
 	APlugInv_EquipActor* SpawnAttachedActor(USkeletalMeshComponent* AttachMesh) const;
 	void DestroyAttachedActor() const;
@@ -14,6 +14,7 @@
  */
 
 class UPlugInv_CompositeBase;
+class UPlugInv_ItemDefinition;
 struct FPlugInv_ItemFragment;
 
 USTRUCT(BlueprintType)
@@ -21,22 +22,28 @@ struct INVENTORY_API FPlugInv_ItemManifest
 {
 	GENERATED_BODY()
 
-	// Instance inventory item and instanced struct through manifest. 
+	// Instance inventory item and instanced struct through manifest, the fragments are moved into the item.
 	UPlugInv_InventoryItem* Manifest(UObject* Outer);
 
 	// Item category getter.
 	EPlugInv_ItemCategory GetItemCategory() const
 	{
-		return ItemCategory;
+		return GetSharedManifest().ItemCategory;
 	}
 
 	// Item Type getter.
 	FGameplayTag GetItemType() const
 	{
-		return ItemTypesTags.First();
+		return GetSharedManifest().ItemTypesTags.First();
 	}
 
-	TArray<TInstancedStruct<FPlugInv_ItemFragment>>& GetFragmentsMutable() { return Fragments; }
+	// Callers may add or remove fragments, so the manifest stops sharing its definition's and the fragment index is rebuilt on the next lookup.
+	TArray<TInstancedStruct<FPlugInv_ItemFragment>>& GetFragmentsMutable()
+	{
+		DetachFromDefinition();
+		bFragmentIndexBuilt = false;
+		return Fragments;
+	}
 	
 	void AssimilateInventoryFragments(UPlugInv_CompositeBase* Composite) const;
 
@@ -54,8 +61,33 @@ struct INVENTORY_API FPlugInv_ItemManifest
 
 	template<typename T> requires std::derived_from<T, FPlugInv_ItemFragment>
 	TArray<const T*> GetAllFragmentsOfType() const;
+
+	// Looks up several fragment types at once, e.g. GetFragmentsOfTypes<FPlugInv_GridFragment, FPlugInv_ImageFragment>().
+	template<typename... Ts> requires (std::derived_from<Ts, FPlugInv_ItemFragment> && ...)
+	TTuple<const Ts*...> GetFragmentsOfTypes() const
+	{
+		return MakeTuple(GetFragmentOfType<Ts>()...);
+	}
+
+	// Indexes the fragments by struct and by tag, lookups build it on demand when it's missing.
+	// Manifests made from a definition use the definition's index, their fragments line up with its fragments.
+	void BuildFragmentIndex() const;
 	
 	void SpawnPickupActor(const UObject* WorldContextObject, const FVector& SpawnLocation, const FRotator& SpawnRotation);
+
+	// Definition asset getter, null for manifests authored inline.
+	UPlugInv_ItemDefinition* GetDefinition() const { return Definition; }
+
+	// Manifest of a new instance of the given definition, this being its manifest.
+	// Only fragments with instance state are copied, the rest are read from the definition.
+	FPlugInv_ItemManifest MakeInstanceManifest(UPlugInv_ItemDefinition* InDefinition) const;
+
+	// Copies in everything still read from the definition and forgets it, for manifests that stop matching their definition.
+	void DetachFromDefinition();
+
+	// Instance state the definition doesn't hold: stack count and the values rolled on manifest.
+	void CaptureDynamicState(int32& OutStackCount, TArray<float>& OutRolledValues) const;
+	void RestoreDynamicState(const int32 StackCount, const TArray<float>& RolledValues);
 protected:
 
 	// Item category.
@@ -68,14 +100,41 @@ protected:
 
 	// TInstanced struct is a type safe wrapper of FInstancedStruct. This way ensures that it can be only of type FPlugInv_ItemFragment and children.
 	// With ExcludeBaseStruct we also ensure that it can't be only FPlugInv_ItemFragment but child structs.
+	// Manifests made from a definition leave the fragments without instance state empty (or the array short) and read the definition's.
 	UPROPERTY(EditAnywhere, Category = "Inventory", meta = (ExcludeBaseStruct))
 	TArray<TInstancedStruct<FPlugInv_ItemFragment>> Fragments;
 
 	UPROPERTY(EditAnywhere, Category = "Inventory")
 	TSubclassOf<AActor> PickupActorClass;
 
+	// Definition asset this manifest was made from, carried along when the item is dropped and picked up again.
+	// Its category, types, pickup class and static fragments are shared rather than copied.
+	UPROPERTY()
+	TObjectPtr<UPlugInv_ItemDefinition> Definition;
+
 	// Clear fragment ptrs
 	void ClearFragments();
+
+private:
+	// The manifest holding the static data: the definition's when there is one, this one otherwise.
+	const FPlugInv_ItemManifest& GetSharedManifest() const;
+
+	// Fragment at an index of the definition's list for manifests made from one, or of this manifest's own.
+	const TInstancedStruct<FPlugInv_ItemFragment>& GetFragmentAt(const int32 Index) const;
+	// Same, detaching from the definition first when the fragment is still shared.
+	TInstancedStruct<FPlugInv_ItemFragment>& GetFragmentAtMutable(const int32 Index);
+
+	// Fragment indices listed under a struct or a tag, empty when none match.
+	TConstArrayView<int32> FindFragmentIndicesByStruct(const UScriptStruct* FragmentStruct) const;
+	TConstArrayView<int32> FindFragmentIndicesByTag(const FGameplayTag& FragmentTag) const;
+
+	// Fragment indices by script struct, each fragment is listed under its own struct and every parent struct.
+	mutable TMap<const UScriptStruct*, TArray<int32, TInlineAllocator<2>>> FragmentIndicesByStruct;
+
+	// Fragment indices by fragment tag.
+	mutable TMap<FGameplayTag, TArray<int32, TInlineAllocator<1>>> FragmentIndicesByTag;
+
+	mutable bool bFragmentIndexBuilt{false};
 };
 
 /*
@@ -90,13 +149,10 @@ protected:
 template <typename T> requires std::derived_from<T, FPlugInv_ItemFragment>
 const T* FPlugInv_ItemManifest::GetFragmentOfTypeByTag(const FGameplayTag& FragmentTag) const
 {
-	for (const TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
+	for (const int32 Index : FindFragmentIndicesByTag(FragmentTag))
 	{
-		if (const T* FragmentPtr = Fragment.GetPtr<T>())
+		if (const T* FragmentPtr = GetFragmentAt(Index).template GetPtr<T>())
 		{
-			if (!FragmentPtr->GetFragmentTag().MatchesTagExact(FragmentTag))
-				continue;
-			
 			return FragmentPtr;
 		}
 	}
@@ -106,27 +162,18 @@ const T* FPlugInv_ItemManifest::GetFragmentOfTypeByTag(const FGameplayTag& Fragm
 template <typename T> requires std::derived_from<T, FPlugInv_ItemFragment>
 const T* FPlugInv_ItemManifest::GetFragmentOfType() const
 {
-	for (const TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
-	{
-		if (const T* FragmentPtr = Fragment.GetPtr<T>())
-		{
-			return FragmentPtr;
-		}
-	}
-	return nullptr;
+	const TConstArrayView<int32> Indices = FindFragmentIndicesByStruct(T::StaticStruct());
+	return Indices.IsEmpty() ? nullptr : GetFragmentAt(Indices[0]).template GetPtr<T>();
 }
 
 template <typename T> requires std::derived_from<T, FPlugInv_ItemFragment>
 T* FPlugInv_ItemManifest::GetFragmentOfTypeByTagMutable(const FGameplayTag& FragmentTag)
 {
-	for (TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
+	for (const int32 Index : FindFragmentIndicesByTag(FragmentTag))
 	{
-		if (T* FragmentPtr = Fragment.GetMutablePtr<T>())
+		if (GetFragmentAt(Index).template GetPtr<T>())
 		{
-			if (!FragmentPtr->GetFragmentTag().MatchesTagExact(FragmentTag))
-				continue;
-			
-			return FragmentPtr;
+			return GetFragmentAtMutable(Index).template GetMutablePtr<T>();
 		}
 	}
 	return nullptr;
@@ -135,26 +182,19 @@ T* FPlugInv_ItemManifest::GetFragmentOfTypeByTagMutable(const FGameplayTag& Frag
 template <typename T> requires std::derived_from<T, FPlugInv_ItemFragment>
 T* FPlugInv_ItemManifest::GetFragmentOfTypeMutable()
 {
-	for (TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
-	{
-		if (T* FragmentPtr = Fragment.GetMutablePtr<T>())
-		{
-			return FragmentPtr;
-		}
-	}
-	return nullptr;
+	const TConstArrayView<int32> Indices = FindFragmentIndicesByStruct(T::StaticStruct());
+	return Indices.IsEmpty() ? nullptr : GetFragmentAtMutable(Indices[0]).template GetMutablePtr<T>();
 }
 
 template <typename T> requires std::derived_from<T, FPlugInv_ItemFragment>
 TArray<const T*> FPlugInv_ItemManifest::GetAllFragmentsOfType() const
 {
+	const TConstArrayView<int32> Indices = FindFragmentIndicesByStruct(T::StaticStruct());
 	TArray<const T*> Result;
-	for (const TInstancedStruct<FPlugInv_ItemFragment>& Fragment : Fragments)
+	Result.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
 	{
-		if (const T* FragmentPtr = Fragment.GetPtr<T>())
-		{
-			Result.Add(FragmentPtr);
-		}
+		Result.Add(GetFragmentAt(Index).template GetPtr<T>());
 	}
 	return Result;
 }
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StructUtils/InstancedStruct.h"
+
+#include "F_PlugInv_ReplicatedItemManifest.generated.h"
+
+/**
+ * Inventory item manifest as it goes over the network.
+ * Manifests made from a definition that allows it replicate the definition reference plus stack count and rolled values,
+ * clients rebuild the rest from their own copy of the asset. Any other manifest replicates in full.
+ */
+USTRUCT()
+struct INVENTORY_API FPlugInv_ReplicatedItemManifest
+{
+	GENERATED_BODY()
+
+	// Starts with an empty manifest so readers never see an empty instanced struct.
+	FPlugInv_ReplicatedItemManifest();
+
+	// Constraint its inheritance capabilities to only FPlugInv_ItemManifest.
+	UPROPERTY(VisibleAnywhere, meta = (BaseStruct = "/Script/Inventory.FPlugInv_ItemManifest"), Category = "Inventory")
+	FInstancedStruct Manifest;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FPlugInv_ReplicatedItemManifest> : public TStructOpsTypeTraitsBase2<FPlugInv_ReplicatedItemManifest>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
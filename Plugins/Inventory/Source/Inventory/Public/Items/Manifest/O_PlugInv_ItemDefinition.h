@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Items/Manifest/F_PlugInv_ItemManifest.h"
+
+#include "O_PlugInv_ItemDefinition.generated.h"
+
+/**
+ * Static data of an item kept as an asset, so clients already have it and only instance state needs to replicate.
+ */
+UCLASS(BlueprintType)
+class INVENTORY_API UPlugInv_ItemDefinition : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Manifest of a new item of this definition, sharing the static fragments with it.
+	FPlugInv_ItemManifest MakeItemManifest();
+
+	// The Manifest every item of this definition starts from and reads its static fragments from.
+	const FPlugInv_ItemManifest& GetItemManifest() const { return ItemManifest; }
+
+	// Replaces the manifest, for definitions built at runtime.
+	void SetItemManifest(const FPlugInv_ItemManifest& InManifest);
+
+	bool ReplicatesCompact() const { return bReplicateCompact; }
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	// The Manifest every item of this definition starts from.
+	UPROPERTY(EditAnywhere, Category = "Inventory")
+	FPlugInv_ItemManifest ItemManifest;
+
+	// Replicate inventory items as this definition plus their stack count and rolled values instead of the full manifest.
+	UPROPERTY(EditAnywhere, Category = "Inventory")
+	bool bReplicateCompact{true};
+};
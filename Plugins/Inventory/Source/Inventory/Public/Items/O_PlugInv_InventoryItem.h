@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
 #include "Items/Manifest/F_PlugInv_ItemManifest.h"
+#include "Items/Manifest/F_PlugInv_ReplicatedItemManifest.h"
 
 #include "O_PlugInv_InventoryItem.generated.h"
 
@@ -27,8 +28,9 @@ public:
 	}
 	
 	void SetItemManifest(const FPlugInv_ItemManifest& Manifest);
-	const FPlugInv_ItemManifest& GetItemManifest() const{ return ItemManifest.Get<FPlugInv_ItemManifest>(); }
-	FPlugInv_ItemManifest& GetItemManifestMutable(){ return ItemManifest.GetMutable<FPlugInv_ItemManifest>(); }
+	void SetItemManifest(FPlugInv_ItemManifest&& Manifest);
+	const FPlugInv_ItemManifest& GetItemManifest() const{ return ItemManifest.Manifest.Get<FPlugInv_ItemManifest>(); }
+	FPlugInv_ItemManifest& GetItemManifestMutable(){ return ItemManifest.Manifest.GetMutable<FPlugInv_ItemManifest>(); }
 
 	bool IsStackable() const;
 	bool IsConsumable() const;
@@ -38,9 +40,9 @@ public:
 
 private:
 
-	// Constraint its inheritance capabilities to only FPlugInv_ItemManifest.
-	UPROPERTY(VisibleAnywhere, meta = (BaseStruct = "/Script/Inventory.FPlugInv_ItemManifest"), Replicated)
-	FInstancedStruct ItemManifest;
+	// Replicates as a definition reference plus instance state when the manifest comes from a definition asset.
+	UPROPERTY(VisibleAnywhere, Replicated)
+	FPlugInv_ReplicatedItemManifest ItemManifest;
 
 	UPROPERTY(Replicated)
 	int32 TotalStackCount{0};
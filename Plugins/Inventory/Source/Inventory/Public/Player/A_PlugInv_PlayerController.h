@@ -30,6 +30,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Initiating all stored Input Mapping Contexts.
 	void InitIMCSubsystem();
@@ -81,6 +82,12 @@ private:
 	// Function to trace for collisions that have item trace channel
 	void TraceForItem();
 
+	// Highlights and shows the pickup message of the actor an item trace hit.
+	void HandleItemTraceResult(const FHitResult& HitResult, bool bBlockingHit);
+
+	// Id of the item trace batched by the trace subsystem, INDEX_NONE when tracing on tick.
+	int32 ItemTraceId{INDEX_NONE};
+
 protected:
 
 	// Binding of the IA (Input Actions) and callback functions.
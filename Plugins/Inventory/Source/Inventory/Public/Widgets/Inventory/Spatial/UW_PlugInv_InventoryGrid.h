@@ -14,6 +14,7 @@ class UPlugInv_ItemPopUp;
 class UPlugInv_HoverItem;
 struct FPlugInv_GridFragment;
 class UPlugInv_SlottedItem;
+struct FPlugInv_GridModel;
 struct FPlugInv_ItemManifest;
 class UPlugInv_ItemComponent;
 class UPlugInv_InventoryComponent;
@@ -63,14 +64,36 @@ public:
 private:
 	// Function to construct the actual grid.
 	void ConstructGrid();
+
+	// The inventory component's model of this grid. Items, stacks and occupancy are read from it, slots only draw.
+	const FPlugInv_GridModel& GetGridModel() const;
+
+	// Sets the state of a cell, and of its slot widget if it has one.
+	void SetCellState(const int32 Index, const EPlugInv_GridSlotState State);
+
+	// Calls Function with the index of every cell of a range, skipping indices outside the grid.
+	template<typename FuncT>
+	void ForEachCell(const int32 Index, const FIntPoint& Dimensions, const FuncT& Function) const;
+
+	// Creates a grid slot widget bound to this grid, not yet placed.
+	UPlugInv_GridSlot* CreateGridSlot(const FName& Name);
+
+	// Gives a cell a slot widget from the pool, or a new one.
+	void RealizeSlot(const int32 Index);
+
+	// Takes the slot widget off a cell and returns it to the pool.
+	void ReleaseSlot(const int32 Index);
+
+	// Cells visible through the clipping ancestors of the canvas, plus VirtualizationMargin.
+	FIntRect ComputeVisibleCells() const;
+
+	// Gives a slot widget to every cell of the new rect, recycling the ones that went out of it.
+	void UpdateRealizedCells(const FIntRect& NewRealizedCells);
 	
-	// Overloads for HasRoomForItem
+	// Overloads for HasRoomForItem, answered by the inventory component's grid model.
 	FPlugInv_SlotAvailabilityResult HasRoomForItem(const UPlugInv_InventoryItem* InventoryItem, const int32 StackAmountOverride = -1);
 	FPlugInv_SlotAvailabilityResult HasRoomForItem(const FPlugInv_ItemManifest& ItemManifest, const int32 StackAmountOverride = -1);
 	
-	// Add Item to multiple indices if needed
-	void AddItemToIndices(const FPlugInv_SlotAvailabilityResult& Result, UPlugInv_InventoryItem* NewItem);
-	
 	// Add Item to single index
 	void AddItemToIndex(UPlugInv_InventoryItem* NewItem, const int32 Index, bool bStackable, int32 StackAmount);
 	
@@ -81,8 +104,8 @@ private:
 	// Adds the slotted item widget to the canvas panel
 	void AddSlottedItemToCanvas(const int32 Index, const FPlugInv_GridFragment* GridFragment, UPlugInv_SlottedItem* SlottedItem) const;
 
-	// Update grid slots
-	void UpdateGridSlots(UPlugInv_InventoryItem* NewItem, int32 Index, bool bStackableItem, int32 StackAmount);
+	// Marks the cells of a placement occupied, the grid model holds the item and stacks.
+	void UpdateGridSlots(const UPlugInv_InventoryItem* NewItem, int32 Index);
 	
 	// Draw size helper function
 	FVector2D GetDrawSize(const FPlugInv_GridFragment* GridFragment) const;
@@ -90,14 +113,7 @@ private:
 	// Slotted image helper function
 	void SetSlottedImage(const FPlugInv_GridFragment* GridFragment, const FPlugInv_ImageFragment* ImageFragment,const UPlugInv_SlottedItem* SlottedItem) const;
 
-	// New item addition functions
-	bool IsIndexClaimed(const TSet<int32>& CheckedIndices, const TObjectPtr<UPlugInv_GridSlot>& GridSlot);
 	bool IsInGridBounds(int32 StartIndex, const FIntPoint& ItemDimensions) const;
-	bool DoesItemTypeMatch(TWeakObjectPtr<UPlugInv_InventoryItem> SubItem, const FGameplayTag& ItemTypeTag) const;
-	bool CheckSlotConstraints(const FPlugInv_ItemManifest& ItemManifest, const UPlugInv_GridSlot* GridSlot, const UPlugInv_GridSlot* SubGridSlot, const
-	                          TSet<int32>& CheckedIndices, TSet<int32>
-	                          & OutTentativelyClaimedIndices) const;
-	int32 GetSlotStackAmount(const TObjectPtr<UPlugInv_GridSlot>& GridSlot);
 
 	// Hover, pickup, tiles updates functions...
 	bool IsRightClick(const FPointerEvent& MouseEvent) const;
@@ -166,10 +182,28 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"), Category = "Inventory")
 	EPlugInv_ItemCategory ItemCategory;
 
-	// Container of grid slots.
+	// Slot widget per cell, null for cells without one when virtualized.
 	UPROPERTY()
 	TArray<TObjectPtr<UPlugInv_GridSlot>> GridSlots;
 
+	// State of every cell, including cells without a slot widget when virtualized.
+	TArray<EPlugInv_GridSlotState> CellStates;
+
+	// Slot widgets out of view, kept for reuse.
+	UPROPERTY()
+	TArray<TObjectPtr<UPlugInv_GridSlot>> SlotPool;
+
+	// Only create slot widgets for the cells in view, for very large grids. The canvas keeps its size from the layout.
+	UPROPERTY(EditAnywhere, Category = "Inventory")
+	bool bVirtualizeSlots{false};
+
+	// Cells realized around the visible ones on each side, so scrolling doesn't show missing slots.
+	UPROPERTY(EditAnywhere, Category = "Inventory", meta = (ClampMin = "0"))
+	int32 VirtualizationMargin{2};
+
+	// Cells that have a slot widget when virtualized, inclusive min and exclusive max.
+	FIntRect RealizedCells;
+
 	// Type of the class of grid slot to create.
 	UPROPERTY(EditAnywhere, Category = "Inventory")
 	TSubclassOf<UPlugInv_GridSlot> GridSlotClass;